@@ -0,0 +1,88 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+
+#include <hopp/int.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Product of [first, last[ (product tree: the multiplications are balanced)
+hopp::bigint product(hopp::ullint const first, hopp::ullint const last)
+{
+	if (last - first == 1) { return first; }
+	if (last - first == 2) { return first * (first + 1); }
+	hopp::ullint const middle = first + (last - first) / 2;
+	return product(first, middle) * product(middle, last);
+}
+
+int main(int argc, char * argv[])
+{
+	hopp::ullint const n = (argc > 1) ? std::stoull(argv[1]) : 100000;
+	size_t const nb_digit = (argc > 2) ? std::stoul(argv[2]) : 1000000;
+	
+	// Factorial
+	
+	std::cout << "factorial(" << n << ")" << std::endl;
+	
+	hopp::time time;
+	hopp::bigint f = 1;
+	for (hopp::ullint i = 2; i <= n; ++i) { f *= i; }
+	time.end();
+	double const t_loop = time.seconds();
+	std::cout << "f *= i          = " << time.ms() << " ms (" << f.bit_length() << " bits)" << std::endl;
+	
+	time.start();
+	hopp::bigint const f_tree = product(1, n + 1);
+	time.end();
+	std::cout << "product tree    = " << time.ms() << " ms (" << f_tree.bit_length() << " bits, speedup = " << t_loop / time.seconds() << ", " << ((f == f_tree) ? "same" : "DIFFERENT") << ")" << std::endl;
+	
+	// Decimal conversion
+	
+	std::cout << std::endl;
+	std::cout << "Decimal conversion of a " << nb_digit << "-digit number" << std::endl;
+	
+	std::string digits(nb_digit, '0');
+	hopp::ullint x = 0x9E3779B97F4A7C15;
+	for (char & c : digits) { x = x * 6364136223846793005 + 1442695040888963407; c = char('0' + (x >> 33) % 10); }
+	digits[0] = '7';
+	
+	time.start();
+	hopp::bigint const big(digits);
+	time.end();
+	std::cout << "parse           = " << time.ms() << " ms (" << big.bit_length() << " bits)" << std::endl;
+	
+	time.start();
+	std::string const s = big.to_string();
+	time.end();
+	std::cout << "to_string       = " << time.ms() << " ms (" << ((s == digits) ? "same" : "DIFFERENT") << ")" << std::endl;
+	
+	// Multiplication and division of the big number
+	
+	std::cout << std::endl;
+	
+	hopp::bigint const half = big >> (big.bit_length() / 2);
+	time.start();
+	hopp::bigint const square = big * big;
+	time.end();
+	std::cout << "big * big       = " << time.ms() << " ms (" << square.bit_length() << " bits)" << std::endl;
+	
+	time.start();
+	auto const q_r = hopp::div_q_r(square, half);
+	time.end();
+	std::cout << "big^2 / (big/2) = " << time.ms() << " ms (" << ((q_r.q * half + q_r.r == square) ? "checked" : "WRONG") << ")" << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,87 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+
+#include <hopp/int.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 100000000;
+	hopp::ullint const denominator = (argc > 2) ? std::stoull(argv[2]) : 1000000007;
+	size_t const n_128 = n / 10;
+	
+	std::cout << n << " divisions by " << denominator << " (known at run time)" << std::endl;
+	std::cout << std::endl;
+	
+	// The numerators are generated in the loop (no memory access)
+	hopp::ullint const step = 0x9E3779B97F4A7C15;
+	
+	// 64-bit / 64-bit
+	
+	hopp::time time;
+	hopp::ullint sum = 0;
+	for (size_t i = 0; i < n; ++i) { sum += (hopp::ullint(i) * step) / denominator; }
+	time.end();
+	double const t_native = time.seconds();
+	std::cout << "64-bit: operator /                 = " << time.ms() << " ms (" << t_native * 1e9 / double(n) << " ns/op, " << sum << ")" << std::endl;
+	
+	hopp::divider<hopp::ullint> const divider(denominator);
+	time.start();
+	sum = 0;
+	for (size_t i = 0; i < n; ++i) { sum += (hopp::ullint(i) * step) / divider; }
+	time.end();
+	std::cout << "64-bit: hopp::divider              = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/op, " << sum << ", speedup = " << t_native / time.seconds() << ")" << std::endl;
+	
+	// 128-bit / 64-bit
+	
+	std::cout << std::endl;
+	std::cout << n_128 << " divisions of hopp::uint128 by " << denominator << std::endl;
+	
+	time.start();
+	hopp::uint128 check = 0;
+	for (size_t i = 0; i < n_128; ++i)
+	{
+		auto const q_r = hopp::div_q_r(hopp::uint128(hopp::ullint(i) * step, ~(hopp::ullint(i) * step)), hopp::uint128(denominator));
+		check += q_r.q + q_r.r;
+	}
+	time.end();
+	double const t_div_q_r = time.seconds();
+	std::cout << "128-bit: hopp::div_q_r             = " << time.ms() << " ms (" << t_div_q_r * 1e9 / double(n_128) << " ns/op, " << check << ")" << std::endl;
+	
+	time.start();
+	check = 0;
+	for (size_t i = 0; i < n_128; ++i)
+	{
+		auto const q_r = divider.div_q_r(hopp::uint128(hopp::ullint(i) * step, ~(hopp::ullint(i) * step)));
+		check += q_r.q + q_r.r;
+	}
+	time.end();
+	std::cout << "128-bit: hopp::divider             = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n_128) << " ns/op, " << check << ", speedup = " << t_div_q_r / time.seconds() << ")" << std::endl;
+	
+	time.start();
+	check = 0;
+	for (size_t i = 0; i < n_128 / 10; ++i)
+	{
+		auto const q_r = hopp::div_q_r<hopp::uint128>(hopp::uint128(hopp::ullint(i) * step, ~(hopp::ullint(i) * step)), hopp::uint128(denominator));
+		check += q_r.q + q_r.r;
+	}
+	time.end();
+	std::cout << "128-bit: bit by bit division       = " << time.ms() << " ms for " << n_128 / 10 << " divisions (" << time.seconds() * 1e9 / double(n_128 / 10) << " ns/op, " << check << ")" << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,95 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+#include <hopp/container/flat_map.hpp>
+#include <hopp/container/vector_pair.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Build and lookups with a map
+template <class map_t, class build_t, class find_t>
+double benchmark(std::string const & name, build_t const & build, find_t const & find, std::vector<std::uint64_t> const & lookups, double const t_ref)
+{
+	hopp::time time;
+	map_t const map = build();
+	time.end();
+	std::cout << name << ": build = " << time.ms() << " ms, ";
+	
+	time.start();
+	std::uint64_t sum = find(map, lookups);
+	time.end();
+	std::cout << lookups.size() << " lookups = " << time.ms() << " ms";
+	if (t_ref != 0) { std::cout << " (speedup = " << t_ref / time.seconds() << ")"; }
+	std::cout << " (sum = " << sum << ")" << std::endl;
+	return time.seconds();
+}
+
+int main(int argc, char * argv[])
+{
+	// 10^6 keys and 10^7 lookups by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	size_t const nb_lookup = (argc > 2) ? std::stoul(argv[2]) : 10000000;
+	
+	std::cout << n << " random std::uint64_t keys, " << nb_lookup << " lookups (half of them are missing)" << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 random(42);
+	std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs(n);
+	for (size_t i = 0; i < n; ++i) { pairs[i] = { random() & ~std::uint64_t(1), i }; }
+	std::vector<std::uint64_t> lookups(nb_lookup);
+	for (auto & key : lookups) { key = pairs[random() % n].first | (random() & 1); }
+	
+	using std_map = std::map<std::uint64_t, std::uint64_t>;
+	using std_unordered_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+	using vector_pair = hopp::vector_pair<std::uint64_t, std::uint64_t>;
+	using flat_map = hopp::flat_map<std::uint64_t, std::uint64_t>;
+	
+	auto const find = [](auto const & map, std::vector<std::uint64_t> const & keys)
+	{
+		std::uint64_t sum = 0;
+		for (auto const key : keys) { auto const it = map.find(key); if (it != map.end()) { sum += it->second; } }
+		return sum;
+	};
+	
+	double const t_ref = benchmark<std_map>("std::map                      ", [&]() { return std_map(pairs.begin(), pairs.end()); }, find, lookups, 0);
+	benchmark<std_unordered_map>("std::unordered_map            ", [&]() { return std_unordered_map(pairs.begin(), pairs.end()); }, find, lookups, t_ref);
+	benchmark<vector_pair>("hopp::vector_pair             ", [&]() { return vector_pair(pairs); }, find, lookups, t_ref);
+	benchmark<flat_map>("hopp::flat_map (binary)       ", [&]() { return flat_map(pairs, hopp::flat_map_search::binary); }, find, lookups, t_ref);
+	benchmark<flat_map>("hopp::flat_map (Eytzinger)    ", [&]() { return flat_map(pairs, hopp::flat_map_search::eytzinger); }, find, lookups, t_ref);
+	
+	auto const find_batch = [](flat_map const & map, std::vector<std::uint64_t> const & keys)
+	{
+		std::uint64_t sum = 0;
+		std::vector<size_t> positions(1024);
+		for (size_t first = 0; first < keys.size(); first += positions.size())
+		{
+			size_t const nb = std::min(positions.size(), keys.size() - first);
+			map.positions(keys.data() + first, nb, positions.data());
+			for (size_t i = 0; i < nb; ++i) { if (positions[i] != map.size()) { sum += map.data()[positions[i]].second; } }
+		}
+		return sum;
+	};
+	benchmark<flat_map>("hopp::flat_map (binary, batch)", [&]() { return flat_map(pairs, hopp::flat_map_search::binary); }, find_batch, lookups, t_ref);
+	benchmark<flat_map>("hopp::flat_map (Eytz., batch) ", [&]() { return flat_map(pairs, hopp::flat_map_search::eytzinger); }, find_batch, lookups, t_ref);
+	
+	return 0;
+}
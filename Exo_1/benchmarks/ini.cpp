@@ -0,0 +1,88 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+#include <hopp/parser/ini.hpp>
+#include <hopp/parser/ini_view.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 100 MB by default
+	size_t const size_mb = (argc > 1) ? std::stoul(argv[1]) : 100;
+	size_t const nb_key_per_section = 1000;
+	
+	// Generate the file
+	std::string const filename = (argc > 2) ? argv[2] : "benchmark__ini.ini";
+	size_t nb_key = 0;
+	{
+		std::ofstream file(filename);
+		file << "; Generated INI file" << std::endl;
+		size_t size = 0;
+		for (size_t section = 0; size < size_mb * 1000000; ++section)
+		{
+			std::string const header = "[section_" + std::to_string(section) + "]\n";
+			file << header;
+			size += header.size();
+			for (size_t key = 0; key < nb_key_per_section; ++key, ++nb_key)
+			{
+				std::string const line = "key_" + std::to_string(key) + " = value of the key " + std::to_string(nb_key) + " ; comment\n";
+				file << line;
+				size += line.size();
+			}
+		}
+	}
+	std::cout << "INI file \"" << filename << "\" of " << size_mb << " MB, " << nb_key << " keys" << std::endl;
+	std::cout << std::endl;
+	
+	// hopp::parser::ini (std::ifstream, std::string)
+	
+	hopp::time time;
+	auto const ini = hopp::parser::ini(filename);
+	time.end();
+	double const t_ini = time.seconds();
+	std::cout << "hopp::parser::ini                          = " << time.ms() << " ms (" << ini.size() << " sections)" << std::endl;
+	
+	// hopp::parser::ini_view (mmap, hopp::string_view)
+	
+	time.start();
+	hopp::parser::ini_view const ini_view(filename);
+	time.end();
+	std::cout << "hopp::parser::ini_view                     = " << time.ms() << " ms (" << ini_view.index().size() << " sections, " << ini_view.entries().size() << " entries, speedup = " << t_ini / time.seconds() << ")" << std::endl;
+	
+	time.start();
+	auto const materialized = ini_view.to_vector_pair();
+	time.end();
+	std::cout << "hopp::parser::ini_view::to_vector_pair     = " << time.ms() << " ms (" << ((materialized == ini) ? "same result as hopp::parser::ini" : "DIFFERENT RESULT") << ")" << std::endl;
+	
+	// Lookups
+	
+	time.start();
+	size_t total = 0;
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		total += ini_view.at("section_" + std::to_string(i % ini_view.index().size()), "key_" + std::to_string(i % nb_key_per_section)).size();
+	}
+	time.end();
+	std::cout << "hopp::parser::ini_view: 10^6 lookups       = " << time.ms() << " ms (" << total << " chars)" << std::endl;
+	
+	std::remove(filename.c_str());
+	
+	return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+#include <hopp/parser/ini.hpp>
+#include <hopp/parser/ini_config.hpp>
+#include <hopp/time/time.hpp>
+
+
+/// @brief Write a configuration file
+/// @param[in] filename   Filename
+/// @param[in] nb_section Number of sections
+/// @param[in] nb_key     Number of keys per section
+/// @param[in] revision   Revision (the value of one key per section depends on it)
+void write_config(std::string const & filename, size_t const nb_section, size_t const nb_key, size_t const revision)
+{
+	std::ofstream file(filename);
+	for (size_t section = 0; section < nb_section; ++section)
+	{
+		file << "[section_" << section << "]\n";
+		for (size_t key = 0; key < nb_key; ++key)
+		{
+			file << "key_" << key << " = " << ((key == 0) ? revision : key) << "\n";
+		}
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const nb_section = (argc > 1) ? std::stoul(argv[1]) : 100;
+	size_t const nb_key = (argc > 2) ? std::stoul(argv[2]) : 100;
+	size_t const nb_lookup = (argc > 3) ? std::stoul(argv[3]) : 10000000;
+	size_t const nb_reload = 100;
+	std::string const filename = "benchmark__ini_config.ini";
+	
+	write_config(filename, nb_section, nb_key, 0);
+	std::cout << "Configuration of " << nb_section << " sections x " << nb_key << " keys, " << nb_lookup << " lookups" << std::endl;
+	std::cout << std::endl;
+	
+	hopp::parser::ini_config config(filename);
+	
+	// The keys are built before the measures
+	std::vector<std::string> sections;
+	std::vector<std::string> keys;
+	for (size_t i = 0; i < nb_section; ++i) { sections.push_back("section_" + std::to_string(i)); }
+	for (size_t i = 0; i < nb_key; ++i) { keys.push_back("key_" + std::to_string(i)); }
+	
+	// Lookups in the current snapshot
+	
+	hopp::time time;
+	size_t total = 0;
+	for (size_t i = 0; i < nb_lookup; ++i) { total += config.read().at(sections[i % nb_section], keys[(i / nb_section) % nb_key]).size(); }
+	time.end();
+	std::cout << "hopp::parser::ini_config::read().at        = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(nb_lookup) << " ns/lookup, " << total << " chars)" << std::endl;
+	
+	time.start();
+	total = 0;
+	{
+		auto const reader = config.read();
+		for (size_t i = 0; i < nb_lookup; ++i) { total += reader.at(sections[i % nb_section], keys[(i / nb_section) % nb_key]).size(); }
+	}
+	time.end();
+	std::cout << "hopp::parser::ini_config::reader::at       = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(nb_lookup) << " ns/lookup, " << total << " chars)" << std::endl;
+	
+	// Reload without change (stat, and compare the content while the file is recent)
+	
+	time.start();
+	for (size_t i = 0; i < nb_reload; ++i) { config.reload(); }
+	time.end();
+	std::cout << "hopp::parser::ini_config::reload unchanged = " << time.ms() / double(nb_reload) << " ms/reload" << std::endl;
+	
+	// Reload with changes (read, parse, diff, publish)
+	
+	double t_reload = 0;
+	size_t nb_change = 0;
+	for (size_t i = 1; i <= nb_reload; ++i)
+	{
+		write_config(filename, nb_section, nb_key, i);
+		time.start();
+		config.reload();
+		time.end();
+		t_reload += time.seconds();
+		nb_change += config.changes().size();
+	}
+	std::cout << "hopp::parser::ini_config::reload modified  = " << t_reload * 1000 / double(nb_reload) << " ms/reload (" << nb_change / nb_reload << " changes/reload, version " << config.version() << ")" << std::endl;
+	
+	// Parse the file with hopp::parser::ini (what a reader does without snapshot)
+	
+	time.start();
+	for (size_t i = 0; i < nb_reload; ++i) { total += hopp::parser::ini(filename).size(); }
+	time.end();
+	std::cout << "hopp::parser::ini                          = " << time.ms() / double(nb_reload) << " ms/parse" << std::endl;
+	
+	std::remove(filename.c_str());
+	
+	return 0;
+}
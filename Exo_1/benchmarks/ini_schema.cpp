@@ -0,0 +1,85 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+
+#include <hopp/parser/ini_schema.hpp>
+#include <hopp/conversion/to_int.hpp>
+#include <hopp/conversion/to_double.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	size_t const nb_access = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	
+	std::string const text = "[network]\nport = 8080\ntimeout = 2.5\nhost = localhost\n[log]\nverbose = true\nlevel = 3\n";
+	hopp::parser::ini_view const ini(text.data(), text.size());
+	auto const strings = ini.to_vector_pair();
+	
+	std::cout << nb_access << " accesses to 3 values (int, double, int)" << std::endl;
+	std::cout << std::endl;
+	
+	// hopp::parser::ini result + hopp::to_int / hopp::to_double at each access
+	
+	hopp::time time;
+	double total = 0;
+	for (size_t i = 0; i < nb_access; ++i)
+	{
+		total += hopp::to_int(strings.at("network").at("port"));
+		total += hopp::to_double(strings.at("network").at("timeout"));
+		total += hopp::to_int(strings.at("log").at("level"));
+	}
+	time.end();
+	double const t_strings = time.seconds();
+	std::cout << "std::string + hopp::to_                    = " << time.ms() << " ms (" << total << ")" << std::endl;
+	
+	// hopp::parser::ini_typed
+	
+	time.start();
+	hopp::parser::ini_schema schema;
+	auto const port = schema.add<int>("network", "port");
+	auto const timeout = schema.add<double>("network", "timeout", 1.0);
+	auto const host = schema.add<std::string>("network", "host");
+	auto const verbose = schema.add<bool>("log", "verbose", false);
+	auto const level = schema.add<int>("log", "level", 0);
+	hopp::parser::ini_typed const config(ini, schema);
+	time.end();
+	std::cout << "hopp::parser::ini_typed: load              = " << time.ms() << " ms (" << config.get(host) << ", " << config.get(verbose) << ")" << std::endl;
+	
+	time.start();
+	total = 0;
+	for (size_t i = 0; i < nb_access; ++i)
+	{
+		total += config.get<int>("network", "port");
+		total += config.get<double>("network", "timeout");
+		total += config.get<int>("log", "level");
+	}
+	time.end();
+	std::cout << "hopp::parser::ini_typed::get (by name)     = " << time.ms() << " ms (" << total << ", speedup = " << t_strings / time.seconds() << ")" << std::endl;
+	
+	time.start();
+	total = 0;
+	for (size_t i = 0; i < nb_access; ++i)
+	{
+		total += config.get(port);
+		total += config.get(timeout);
+		total += config.get(level);
+	}
+	time.end();
+	std::cout << "hopp::parser::ini_typed::get (handle)      = " << time.ms() << " ms (" << total << ", speedup = " << t_strings / time.seconds() << ")" << std::endl;
+	
+	return 0;
+}
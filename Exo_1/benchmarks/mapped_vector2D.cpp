@@ -0,0 +1,92 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#include <hopp/container/mapped_vector2D.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Read the whole file in a std::vector<float>
+std::vector<float> read_into_vector(std::string const & filename, size_t & nb_row, size_t & nb_col)
+{
+	std::ifstream f(filename, std::ios::binary);
+	hopp::mapped_vector2D_header header;
+	f.read(reinterpret_cast<char *>(&header), sizeof(header));
+	nb_row = size_t(header.nb_row);
+	nb_col = size_t(header.nb_col);
+	std::vector<float> values(nb_row * nb_col);
+	f.read(reinterpret_cast<char *>(values.data()), std::streamsize(values.size() * sizeof(float)));
+	return values;
+}
+
+int main(int argc, char * argv[])
+{
+	// 8192 × 8192 float (256 MB) by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 8192;
+	std::string const filename = (argc > 2) ? argv[2] : "benchmark__mapped_vector2D.bin";
+	
+	std::cout << "File \"" << filename << "\" with " << n << " x " << n << " float (" << double(n * n * sizeof(float)) / 1e6 << " MB)" << std::endl;
+	{
+		hopp::time time;
+		hopp::mapped_vector2D<float> grid(filename, n, n);
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { grid(i, j) = float((i + j) % 10); } }
+		grid.flush();
+		time.end();
+		std::cout << "    create + write + flush = " << time.ms() << " ms" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	std::cout << "Open" << std::endl;
+	{
+		hopp::time time;
+		hopp::mapped_vector2D<float> const grid(filename, hopp::map_mode::read_only);
+		time.end();
+		std::cout << "    mmap                   = " << time.ms() << " ms" << std::endl;
+		
+		time.start();
+		double sum = 0;
+		for (size_t k = 0; k < 1000; ++k) { sum += double(grid((k * 7919) % n, (k * 104729) % n)); }
+		time.end();
+		std::cout << "    mmap 1000 random reads = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+		
+		time.start();
+		sum = 0;
+		for (auto const row : grid) { for (float const x : row) { sum += double(x); } }
+		time.end();
+		std::cout << "    mmap read all          = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	}
+	{
+		hopp::time time;
+		size_t nb_row = 0;
+		size_t nb_col = 0;
+		std::vector<float> const values = read_into_vector(filename, nb_row, nb_col);
+		time.end();
+		std::cout << "    std::vector read       = " << time.ms() << " ms" << std::endl;
+		
+		time.start();
+		double sum = 0;
+		for (float const x : values) { sum += double(x); }
+		time.end();
+		std::cout << "    std::vector read all   = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	}
+	
+	std::remove(filename.c_str());
+	
+	return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+
+#include <hopp/container/vector2D.hpp>
+#include <hopp/math/matrix.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Naive triple loop
+hopp::vector2D<double> naive_multiply(hopp::vector2D<double> const & a, hopp::vector2D<double> const & b)
+{
+	hopp::vector2D<double> c(a.nb_row(), b.nb_col());
+	for (size_t i = 0; i < a.nb_row(); ++i)
+	{
+		for (size_t j = 0; j < b.nb_col(); ++j)
+		{
+			double sum = 0;
+			for (size_t k = 0; k < a.nb_col(); ++k) { sum += a(i, k) * b(k, j); }
+			c(i, j) = sum;
+		}
+	}
+	return c;
+}
+
+// Naive transpose
+hopp::vector2D<double> naive_transpose(hopp::vector2D<double> const & a)
+{
+	hopp::vector2D<double> r(a.nb_col(), a.nb_row());
+	for (size_t i = 0; i < a.nb_row(); ++i)
+	{
+		for (size_t j = 0; j < a.nb_col(); ++j) { r(j, i) = a(i, j); }
+	}
+	return r;
+}
+
+// Matrix n × n with some values
+hopp::vector2D<double> make_matrix(size_t const n, double const seed)
+{
+	hopp::vector2D<double> m(n, n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t j = 0; j < n; ++j) { m(i, j) = std::sin(seed + double(i * n + j)); }
+	}
+	return m;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const n_max = (argc > 1) ? std::stoul(argv[1]) : 2048;
+	size_t const naive_max = (argc > 2) ? std::stoul(argv[2]) : 1024;
+	
+	std::cout << "Matrix multiplication (GFLOP/s)" << std::endl;
+	for (size_t n = 64; n <= n_max; n *= 2)
+	{
+		auto const a = make_matrix(n, 1);
+		auto const b = make_matrix(n, 2);
+		double const nb_flop = 2.0 * double(n) * double(n) * double(n);
+		
+		std::cout << "    n = " << n;
+		
+		hopp::time time;
+		auto const c = hopp::math::multiply(a, b);
+		time.end();
+		std::cout << " | blocked = " << nb_flop / time.seconds() / 1e9;
+		
+		if (n <= naive_max)
+		{
+			time.start();
+			auto const c_naive = naive_multiply(a, b);
+			time.end();
+			std::cout << " | naive = " << nb_flop / time.seconds() / 1e9;
+			
+			double error = 0;
+			for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { error = std::max(error, std::abs(c(i, j) - c_naive(i, j))); } }
+			std::cout << " | max error = " << error;
+		}
+		
+		std::cout << std::endl;
+	}
+	std::cout << std::endl;
+	
+	std::cout << "Matrix-vector multiplication (GFLOP/s)" << std::endl;
+	for (size_t n = 64; n <= n_max * 2; n *= 2)
+	{
+		auto const a = make_matrix(n, 1);
+		std::vector<double> const x(n, 0.5);
+		size_t const nb_repeat = std::max(size_t(1), (size_t(1) << 26) / (n * n));
+		
+		hopp::time time;
+		double checksum = 0;
+		for (size_t r = 0; r < nb_repeat; ++r) { checksum += hopp::math::multiply(a, x)[r % n]; }
+		time.end();
+		
+		std::cout << "    n = " << n << " | " << 2.0 * double(n) * double(n) * double(nb_repeat) / time.seconds() / 1e9 << " (checksum = " << checksum << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	std::cout << "Transpose (GB/s read + write)" << std::endl;
+	for (size_t n = 64; n <= n_max * 4; n *= 2)
+	{
+		auto const a = make_matrix(n, 1);
+		double const nb_byte = 2.0 * double(n) * double(n) * sizeof(double);
+		
+		hopp::time time;
+		auto const r = hopp::math::transpose(a);
+		time.end();
+		std::cout << "    n = " << n << " | blocked = " << nb_byte / time.seconds() / 1e9;
+		
+		time.start();
+		auto const r_naive = naive_transpose(a);
+		time.end();
+		std::cout << " | naive = " << nb_byte / time.seconds() / 1e9 << " | equal = " << (r == r_naive) << std::endl;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <random>
+
+#include <hopp/memory/pool.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Small node of a pointer graph
+class node_t
+{
+public:
+	
+	int value;
+	
+	node_t * father;
+	
+	node_t * next;
+	
+	node_t(int const value) : value(value), father(nullptr), next(nullptr) { }
+};
+
+// Allocate nb_object nodes, destroy them in a random order, nb_round times
+template <class ptr_t, class make_t>
+double churn(size_t const nb_object, size_t const nb_round, make_t const & make)
+{
+	std::vector<ptr_t> ptrs(nb_object);
+	std::vector<size_t> order(nb_object);
+	for (size_t i = 0; i < nb_object; ++i) { order[i] = i; }
+	std::shuffle(order.begin(), order.end(), std::mt19937(42));
+	
+	long long int checksum = 0;
+	
+	hopp::time time;
+	for (size_t round = 0; round < nb_round; ++round)
+	{
+		for (size_t i = 0; i < nb_object; ++i) { ptrs[i] = make(int(i)); }
+		for (size_t i = 0; i < nb_object; ++i) { checksum += ptrs[order[i]]->value; ptrs[order[i]].reset(); }
+	}
+	time.end();
+	
+	std::cout << "    (checksum = " << checksum << ")" << std::endl;
+	
+	return double(nb_object * nb_round) / time.seconds() / 1e6;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const nb_object = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	size_t const nb_round = (argc > 2) ? std::stoul(argv[2]) : 10;
+	
+	std::cout << "Allocate and destroy " << nb_object << " nodes (" << sizeof(node_t) << " bytes), " << nb_round << " times" << std::endl;
+	std::cout << std::endl;
+	
+	std::cout << "std::make_unique<T>" << std::endl;
+	double const mops_default = churn<std::unique_ptr<node_t>>(nb_object, nb_round, [](int const i) { return std::make_unique<node_t>(i); });
+	std::cout << "    " << mops_default << " M allocations/s" << std::endl;
+	std::cout << std::endl;
+	
+	std::cout << "hopp::make_pooled<T>" << std::endl;
+	double const mops_pool = churn<hopp::pooled_ptr<node_t>>(nb_object, nb_round, [](int const i) { return hopp::make_pooled<node_t>(i); });
+	std::cout << "    " << mops_pool << " M allocations/s" << std::endl;
+	std::cout << "    " << hopp::pool<node_t>::statistics() << std::endl;
+	std::cout << std::endl;
+	
+	std::cout << "Speedup = " << mops_pool / mops_default << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+
+#include <hopp/geometry.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Number of bits set
+size_t popcount(std::vector<std::uint64_t> const & mask)
+{
+	size_t r = 0;
+	for (std::uint64_t word : mask) { for (; word != 0; word &= word - 1) { ++r; } }
+	return r;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const nb_candidate = (argc > 1) ? std::stoul(argv[1]) : 4096;
+	size_t const nb_query = (argc > 2) ? std::stoul(argv[2]) : 100000;
+	
+	#if defined(__AVX__)
+		std::cout << "AVX enabled" << std::endl;
+	#else
+		std::cout << "AVX disabled (scalar version)" << std::endl;
+	#endif
+	std::cout << nb_query << " queries against " << nb_candidate << " rectangles (float)" << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 random(42);
+	std::uniform_real_distribution<float> random_position(0.f, 1000.f);
+	std::uniform_real_distribution<float> random_size(0.f, 50.f);
+	auto const random_rectangle = [&]() { return hopp::rectangle<float>(random_position(random), random_position(random), random_size(random), random_size(random)); };
+	
+	std::vector<hopp::rectangle<float>> candidates(nb_candidate);
+	for (auto & r : candidates) { r = random_rectangle(); }
+	hopp::soa_rectangle<float> const candidates_soa(candidates);
+	std::vector<hopp::rectangle<float>> queries(nb_query);
+	for (auto & r : queries) { r = random_rectangle(); }
+	
+	std::vector<std::uint64_t> mask((nb_candidate + 63) / 64);
+	
+	hopp::time time;
+	size_t nb_overlap = 0;
+	for (auto const & query : queries)
+	{
+		std::fill(mask.begin(), mask.end(), std::uint64_t(0));
+		for (size_t i = 0; i < nb_candidate; ++i)
+		{
+			if (hopp::geometry::overlap(query, candidates[i])) { mask[i / 64] |= std::uint64_t(1) << (i % 64); }
+		}
+		nb_overlap += popcount(mask);
+	}
+	time.end();
+	double const t_ref = time.seconds();
+	std::cout << "std::vector<hopp::rectangle<float>> + overlap(a, b) = " << time.ms() << " ms (" << nb_overlap << " overlaps)" << std::endl;
+	
+	time.start();
+	nb_overlap = 0;
+	for (auto const & query : queries)
+	{
+		hopp::geometry::overlap(query, candidates_soa.left(), candidates_soa.top(), candidates_soa.right(), candidates_soa.bottom(), nb_candidate, mask.data());
+		nb_overlap += popcount(mask);
+	}
+	time.end();
+	std::cout << "hopp::soa_rectangle<float> + overlap bitmask        = " << time.ms() << " ms (" << nb_overlap << " overlaps, speedup = " << t_ref / time.seconds() << ")" << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,121 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include <hopp/algo/parallel.hpp>
+#include <hopp/container/vector2D.hpp>
+#include <hopp/container/vector_view.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 10^8 float by default, pass 1000000000 for 10^9 values (4 GB)
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 100000000;
+	size_t const nb_col = 10000;
+	size_t const nb_row = n / nb_col;
+	
+	#ifdef _OPENMP
+		std::cout << "OpenMP threads = " << omp_get_max_threads() << std::endl;
+	#else
+		std::cout << "OpenMP is disabled" << std::endl;
+	#endif
+	std::cout << "hopp::vector2D<float> " << nb_row << " x " << nb_col << " (" << nb_row * nb_col << " values)" << std::endl;
+	std::cout << std::endl;
+	
+	hopp::vector2D<float> m(nb_row, nb_col);
+	hopp::parallel::for_each(m, [](float & x) { x = 0.1f; });
+	double const exact = double(0.1f) * double(nb_row * nb_col);
+	
+	// Sum
+	
+	std::cout << "Sum (exact = " << exact << ")" << std::endl;
+	{
+		hopp::time time;
+		float const sum = std::accumulate(m.data(), m.data() + nb_row * nb_col, 0.f);
+		time.end();
+		double const t_ref = time.seconds();
+		std::cout << "    std::accumulate        = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+		
+		time.start();
+		float const sum_pairwise = hopp::sum(m.data(), m.data() + nb_row * nb_col);
+		time.end();
+		std::cout << "    hopp::sum (pairwise)   = " << time.ms() << " ms (sum = " << sum_pairwise << ", speedup = " << t_ref / time.seconds() << ")" << std::endl;
+		
+		time.start();
+		float const sum_parallel = hopp::parallel::sum(m);
+		time.end();
+		std::cout << "    hopp::parallel::sum    = " << time.ms() << " ms (sum = " << sum_parallel << ", speedup = " << t_ref / time.seconds() << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// Reduce
+	
+	std::cout << "Reduce (max)" << std::endl;
+	{
+		m(nb_row / 2, nb_col / 2) = 42.f;
+		auto const max = [](float const a, float const b) { return std::max(a, b); };
+		
+		hopp::time time;
+		float const r = std::accumulate(m.data(), m.data() + nb_row * nb_col, 0.f, max);
+		time.end();
+		double const t_ref = time.seconds();
+		std::cout << "    std::accumulate        = " << time.ms() << " ms (max = " << r << ")" << std::endl;
+		
+		time.start();
+		float const r_parallel = hopp::parallel::reduce(m, 0.f, max);
+		time.end();
+		std::cout << "    hopp::parallel::reduce = " << time.ms() << " ms (max = " << r_parallel << ", speedup = " << t_ref / time.seconds() << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// for_each & transform
+	
+	std::cout << "for_each & transform" << std::endl;
+	{
+		hopp::time time;
+		std::for_each(m.data(), m.data() + nb_row * nb_col, [](float & x) { x = x * 0.5f + 1.f; });
+		time.end();
+		double const t_ref = time.seconds();
+		std::cout << "    std::for_each             = " << time.ms() << " ms" << std::endl;
+		
+		time.start();
+		hopp::parallel::for_each(m, [](float & x) { x = x * 0.5f + 1.f; });
+		time.end();
+		std::cout << "    hopp::parallel::for_each  = " << time.ms() << " ms (speedup = " << t_ref / time.seconds() << ")" << std::endl;
+		
+		time.start();
+		hopp::parallel::transform(m, m, [](float const x) { return x * 0.5f + 1.f; });
+		time.end();
+		std::cout << "    hopp::parallel::transform = " << time.ms() << " ms (speedup = " << t_ref / time.seconds() << ")" << std::endl;
+		
+		std::vector<float> & v = m.vector();
+		auto view = hopp::make_vector_view(v, 0, v.size() / 2);
+		time.start();
+		float const sum_view = hopp::parallel::sum(view);
+		time.end();
+		std::cout << "    hopp::parallel::sum (vector_view, half) = " << time.ms() << " ms (sum = " << sum_view << ")" << std::endl;
+	}
+	
+	return 0;
+}
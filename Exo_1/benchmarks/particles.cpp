@@ -0,0 +1,116 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include <hopp/container/vector3.hpp>
+#include <hopp/container/soa_vector3.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 10^7 particles by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	size_t const nb_frame = (argc > 2) ? std::stoul(argv[2]) : 10;
+	float const dt = 0.01f;
+	hopp::vector3<float> const gravity(0.f, 0.f, -9.81f);
+	
+	std::cout << n << " particles (position & velocity), " << nb_frame << " frames" << std::endl;
+	std::cout << std::endl;
+	
+	// Array of structures
+	
+	double t_aos = 0;
+	{
+		std::vector<hopp::vector3<float>> position(n);
+		std::vector<hopp::vector3<float>> velocity(n);
+		for (size_t i = 0; i < n; ++i) { velocity[i] = hopp::vector3<float>(float(i % 10), 1.f, 0.f); }
+		
+		hopp::time time;
+		for (size_t frame = 0; frame < nb_frame; ++frame)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				velocity[i] += gravity * dt;
+				position[i] += velocity[i] * dt;
+			}
+		}
+		time.end();
+		t_aos = time.seconds();
+		std::cout << "std::vector<hopp::vector3<float>>  = " << time.ms() / double(nb_frame) << " ms / frame (position[n - 1] = " << position[n - 1] << ")" << std::endl;
+	}
+	
+	// Structure of arrays
+	
+	{
+		hopp::soa_vector3<float> position(n);
+		hopp::soa_vector3<float> velocity(n);
+		for (size_t i = 0; i < n; ++i) { velocity.set(i, hopp::vector3<float>(float(i % 10), 1.f, 0.f)); }
+		
+		hopp::time time;
+		for (size_t frame = 0; frame < nb_frame; ++frame)
+		{
+			velocity.add(gravity * dt);
+			position.add_scaled(velocity, dt);
+		}
+		time.end();
+		std::cout << "hopp::soa_vector3<float> (bulk)   = " << time.ms() / double(nb_frame) << " ms / frame (position[n - 1] = " << position[n - 1] << ", speedup = " << t_aos / time.seconds() << ")" << std::endl;
+		
+		// One pass with the components (same memory traffic as the array of structures)
+		position = hopp::soa_vector3<float>(n);
+		for (size_t i = 0; i < n; ++i) { velocity.set(i, hopp::vector3<float>(float(i % 10), 1.f, 0.f)); }
+		float * const px = position.x();
+		float * const py = position.y();
+		float * const pz = position.z();
+		float * const vx = velocity.x();
+		float * const vy = velocity.y();
+		float * const vz = velocity.z();
+		time.start();
+		for (size_t frame = 0; frame < nb_frame; ++frame)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				vx[i] += gravity.x * dt; vy[i] += gravity.y * dt; vz[i] += gravity.z * dt;
+				px[i] += vx[i] * dt; py[i] += vy[i] * dt; pz[i] += vz[i] * dt;
+			}
+		}
+		time.end();
+		std::cout << "hopp::soa_vector3<float> (fused)  = " << time.ms() / double(nb_frame) << " ms / frame (position[n - 1] = " << position[n - 1] << ", speedup = " << t_aos / time.seconds() << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// Normalization (compute bound)
+	
+	{
+		std::vector<hopp::vector3<float>> aos(n);
+		for (size_t i = 0; i < n; ++i) { aos[i] = hopp::vector3<float>(float(i % 10) + 1.f, 1.f, 2.f); }
+		hopp::soa_vector3<float> soa(aos);
+		
+		hopp::time time;
+		for (auto & v : aos) { v = hopp::normalize(v); }
+		time.end();
+		double const t_ref = time.seconds();
+		std::cout << "Normalize std::vector<hopp::vector3<float>> = " << time.ms() << " ms (v[n - 1] = " << aos[n - 1] << ")" << std::endl;
+		
+		time.start();
+		soa.normalize();
+		time.end();
+		std::cout << "Normalize hopp::soa_vector3<float>          = " << time.ms() << " ms (v[n - 1] = " << soa[n - 1] << ", speedup = " << t_ref / time.seconds() << ")" << std::endl;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+
+#include <hopp/container/coo_matrix.hpp>
+#include <hopp/container/csr_matrix.hpp>
+#include <hopp/math/matrix.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 10^7 nonzeros by default, pass 100000000 for 10^8 nonzeros (about 2.5 GB)
+	size_t const nb_nonzero = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	size_t const nb_nonzero_per_row = (argc > 2) ? std::stoul(argv[2]) : 16;
+	size_t const n = nb_nonzero / nb_nonzero_per_row;
+	size_t const nb_repeat = 5;
+	
+	std::cout << "Sparse matrix " << n << " x " << n << " with " << nb_nonzero << " nonzeros (double, std::uint32_t indexes)" << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 random(42);
+	std::uniform_int_distribution<size_t> random_col(0, n - 1);
+	
+	hopp::time time;
+	hopp::coo_matrix<double> coo(n, n);
+	coo.reserve(nb_nonzero);
+	for (size_t k = 0; k < nb_nonzero; ++k) { coo.add(k / nb_nonzero_per_row, random_col(random), 1.0 + double(k % 7)); }
+	time.end();
+	std::cout << "Build" << std::endl;
+	std::cout << "    hopp::coo_matrix       = " << time.ms() << " ms" << std::endl;
+	
+	time.start();
+	hopp::csr_matrix<double> const csr(coo);
+	time.end();
+	std::cout << "    hopp::csr_matrix(coo)  = " << time.ms() << " ms" << std::endl;
+	std::cout << std::endl;
+	
+	std::cout << "Memory" << std::endl;
+	std::cout << "    dense (hopp::vector2D) = " << double(n) * double(n) * sizeof(double) / 1e9 << " GB" << std::endl;
+	std::cout << "    hopp::coo_matrix       = " << double(coo.memory()) / 1e9 << " GB" << std::endl;
+	std::cout << "    hopp::csr_matrix       = " << double(csr.memory()) / 1e9 << " GB" << std::endl;
+	std::cout << std::endl;
+	
+	std::vector<double> const x(n, 0.5);
+	double const nb_flop = 2.0 * double(csr.nb_nonzero()) * double(nb_repeat);
+	
+	std::cout << "Sparse matrix-vector multiplication (GFLOP/s)" << std::endl;
+	{
+		time.start();
+		double checksum = 0;
+		for (size_t r = 0; r < nb_repeat; ++r) { checksum += hopp::math::multiply(coo, x)[r]; }
+		time.end();
+		std::cout << "    hopp::coo_matrix       = " << nb_flop / time.seconds() / 1e9 << " (checksum = " << checksum << ")" << std::endl;
+	}
+	{
+		time.start();
+		double checksum = 0;
+		for (size_t r = 0; r < nb_repeat; ++r) { checksum += hopp::math::multiply(csr, x)[r]; }
+		time.end();
+		std::cout << "    hopp::csr_matrix       = " << nb_flop / time.seconds() / 1e9 << " (checksum = " << checksum << ")" << std::endl;
+	}
+	
+	return 0;
+}
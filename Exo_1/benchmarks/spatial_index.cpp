@@ -0,0 +1,115 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+
+#include <hopp/geometry.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Insert, query and all-pairs overlap with a spatial index
+template <class index_t>
+void benchmark(std::string const & name, index_t & index, std::vector<hopp::rectangle<float>> const & queries, std::vector<hopp::rectangle<float>> const & moves)
+{
+	hopp::time time;
+	size_t nb_overlap = 0;
+	index.for_each_overlap([&nb_overlap](size_t, size_t) { ++nb_overlap; });
+	time.end();
+	std::cout << "    " << name << " all pairs = " << time.ms() << " ms (" << nb_overlap << " pairs)" << std::endl;
+	
+	time.start();
+	size_t nb_result = 0;
+	for (auto const & query : queries) { index.query(query, [&nb_result](size_t) { ++nb_result; }); }
+	time.end();
+	std::cout << "    " << name << " " << queries.size() << " queries = " << time.ms() << " ms (" << nb_result << " results)" << std::endl;
+	
+	time.start();
+	for (size_t id = 0; id < moves.size(); ++id) { index.update(id, moves[id]); }
+	time.end();
+	std::cout << "    " << name << " " << moves.size() << " updates = " << time.ms() << " ms" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+	// 10^6 rectangles by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	size_t const n_brute_force = std::min(n, size_t(10000));
+	float const world_size = 10000.f;
+	float const max_size = 10.f;
+	
+	std::cout << n << " rectangles (size <= " << max_size << ") in " << world_size << " x " << world_size << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 random(42);
+	std::uniform_real_distribution<float> random_position(0.f, world_size - max_size);
+	std::uniform_real_distribution<float> random_size(0.f, max_size);
+	auto const random_rectangle = [&]() { return hopp::rectangle<float>(random_position(random), random_position(random), random_size(random), random_size(random)); };
+	
+	std::vector<hopp::rectangle<float>> rectangles(n);
+	for (auto & r : rectangles) { r = random_rectangle(); }
+	std::vector<hopp::rectangle<float>> queries(10000);
+	for (auto & r : queries) { r = hopp::rectangle<float>(random_position(random), random_position(random), 100.f, 100.f); }
+	std::vector<hopp::rectangle<float>> moves(n / 10);
+	for (size_t id = 0; id < moves.size(); ++id) { moves[id] = rectangles[id]; moves[id].left += 1.f; }
+	
+	// Brute force
+	
+	std::cout << "Brute force with hopp::geometry::overlap (" << n_brute_force << " rectangles)" << std::endl;
+	{
+		hopp::time time;
+		size_t nb_overlap = 0;
+		for (size_t a = 0; a < n_brute_force; ++a)
+		{
+			for (size_t b = a + 1; b < n_brute_force; ++b) { if (hopp::geometry::overlap(rectangles[a], rectangles[b])) { ++nb_overlap; } }
+		}
+		time.end();
+		double const factor = double(n) / double(n_brute_force);
+		std::cout << "    all pairs = " << time.ms() << " ms (" << nb_overlap << " pairs, about " << time.seconds() * factor * factor << " s for " << n << " rectangles)" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// Uniform grid
+	
+	std::cout << "hopp::grid_index<float>" << std::endl;
+	{
+		hopp::time time;
+		hopp::grid_index<float> index(hopp::rectangle<float>(0.f, 0.f, world_size, world_size), 2 * max_size, rectangles);
+		time.end();
+		std::cout << "    grid bulk load = " << time.ms() << " ms (" << index.nb_cell_x() << " x " << index.nb_cell_y() << " cells)" << std::endl;
+		benchmark("grid", index, queries, moves);
+	}
+	std::cout << std::endl;
+	
+	// Bounding volume hierarchy
+	
+	std::cout << "hopp::bvh<float>" << std::endl;
+	{
+		hopp::time time;
+		hopp::bvh<float> index(rectangles);
+		time.end();
+		std::cout << "    bvh bulk load = " << time.ms() << " ms (height = " << index.height() << ")" << std::endl;
+		benchmark("bvh", index, queries, moves);
+		
+		time.start();
+		hopp::bvh<float> index_inserted;
+		for (auto const & r : rectangles) { index_inserted.insert(r); }
+		time.end();
+		std::cout << "    bvh " << n << " inserts = " << time.ms() << " ms (height = " << index_inserted.height() << ")" << std::endl;
+	}
+	
+	return 0;
+}
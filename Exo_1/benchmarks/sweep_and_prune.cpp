@@ -0,0 +1,110 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <iterator>
+
+#include <hopp/geometry.hpp>
+#include <hopp/container/vector2.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 10^5 rectangles by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 100000;
+	size_t const nb_tick = (argc > 2) ? std::stoul(argv[2]) : 100;
+	float const max_speed = (argc > 3) ? std::stof(argv[3]) : 0.05f;
+	float const world_size = 3000.f;
+	float const max_size = 10.f;
+	
+	std::cout << n << " moving rectangles (size <= " << max_size << ") in " << world_size << " x " << world_size << ", " << nb_tick << " ticks" << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 random(42);
+	std::uniform_real_distribution<float> random_position(0.f, world_size - max_size);
+	std::uniform_real_distribution<float> random_size(0.f, max_size);
+	std::uniform_real_distribution<float> random_velocity(-max_speed, max_speed);
+	
+	std::vector<hopp::rectangle<float>> rectangles_initial(n);
+	std::vector<hopp::vector2<float>> velocities(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		rectangles_initial[i] = hopp::rectangle<float>(random_position(random), random_position(random), random_size(random), random_size(random));
+		velocities[i] = hopp::vector2<float>(random_velocity(random), random_velocity(random));
+	}
+	auto const move = [&velocities](std::vector<hopp::rectangle<float>> & rectangles, size_t const i)
+	{
+		rectangles[i].left += velocities[i].x;
+		rectangles[i].top += velocities[i].y;
+	};
+	
+	// From scratch every tick (started and ended pairs with a difference of the sorted pairs)
+	
+	double t_ref = 0;
+	{
+		std::vector<hopp::rectangle<float>> rectangles = rectangles_initial;
+		std::vector<std::pair<size_t, size_t>> pairs;
+		std::vector<std::pair<size_t, size_t>> previous_pairs = hopp::grid_index<float>(hopp::rectangle<float>(0.f, 0.f, world_size, world_size), 2 * max_size, rectangles).overlaps();
+		std::sort(previous_pairs.begin(), previous_pairs.end());
+		std::vector<std::pair<size_t, size_t>> events;
+		size_t nb_event = 0;
+		hopp::time time;
+		for (size_t tick = 0; tick < nb_tick; ++tick)
+		{
+			for (size_t i = 0; i < n; ++i) { move(rectangles, i); }
+			hopp::grid_index<float> const index(hopp::rectangle<float>(0.f, 0.f, world_size, world_size), 2 * max_size, rectangles);
+			pairs = index.overlaps();
+			std::sort(pairs.begin(), pairs.end());
+			events.clear();
+			std::set_symmetric_difference(pairs.begin(), pairs.end(), previous_pairs.begin(), previous_pairs.end(), std::back_inserter(events));
+			nb_event += events.size();
+			pairs.swap(previous_pairs);
+		}
+		time.end();
+		t_ref = time.seconds();
+		std::cout << "hopp::grid_index<float> rebuilt every tick = " << time.ms() / double(nb_tick) << " ms / tick (" << previous_pairs.size() << " pairs at the end, " << double(nb_event) / double(nb_tick) << " started or ended / tick)" << std::endl;
+	}
+	
+	// Incremental
+	
+	{
+		std::vector<hopp::rectangle<float>> rectangles = rectangles_initial;
+		hopp::time time;
+		hopp::sweep_and_prune<float> broad_phase(rectangles);
+		time.end();
+		std::cout << "hopp::sweep_and_prune<float> construction  = " << time.ms() << " ms" << std::endl;
+		
+		size_t nb_event = 0;
+		time.start();
+		for (size_t tick = 0; tick < nb_tick; ++tick)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				move(rectangles, i);
+				broad_phase.set(i, rectangles[i]);
+			}
+			broad_phase.update();
+			nb_event += broad_phase.started().size() + broad_phase.ended().size();
+		}
+		time.end();
+		std::cout << "hopp::sweep_and_prune<float> update        = " << time.ms() / double(nb_tick) << " ms / tick (" << broad_phase.nb_overlap() << " pairs at the end, " << double(nb_event) / double(nb_tick) << " started or ended / tick, speedup = " << t_ref / time.seconds() << ")" << std::endl;
+	}
+	
+	return 0;
+}
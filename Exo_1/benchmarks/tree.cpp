@@ -0,0 +1,183 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+
+#include <hopp/container/tree.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Nested layout: each node owns the vector of its children
+
+struct nested_node
+{
+	int value;
+	std::vector<nested_node> children;
+};
+
+// Node i has the children fanout * i + 1, ..., fanout * i + fanout (if < n)
+
+void nested_build(nested_node & node, size_t const i, size_t const n, size_t const fanout)
+{
+	node.value = int(i % 100);
+	for (size_t c = fanout * i + 1; c <= fanout * i + fanout && c < n; ++c)
+	{
+		node.children.push_back(nested_node());
+		nested_build(node.children.back(), c, n, fanout);
+	}
+}
+
+long nested_preorder(nested_node const & node)
+{
+	long sum = node.value;
+	for (auto const & child : node.children) { sum += nested_preorder(child); }
+	return sum;
+}
+
+long nested_postorder(nested_node const & node, long & last)
+{
+	long sum = 0;
+	for (auto const & child : node.children) { sum += nested_postorder(child, last); }
+	last = node.value;
+	return sum + node.value;
+}
+
+long nested_breadth_first(nested_node const & root)
+{
+	long sum = 0;
+	std::deque<nested_node const *> queue(1, &root);
+	while (queue.empty() == false)
+	{
+		nested_node const & node = *queue.front();
+		queue.pop_front();
+		sum += node.value;
+		for (auto const & child : node.children) { queue.push_back(&child); }
+	}
+	return sum;
+}
+
+size_t nested_size(nested_node const & node)
+{
+	size_t size = 1;
+	for (auto const & child : node.children) { size += nested_size(child); }
+	return size;
+}
+
+int main(int argc, char * argv[])
+{
+	// 10^7 nodes by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	size_t const fanout = (argc > 2) ? std::stoul(argv[2]) : 4;
+	
+	std::cout << "Tree of " << n << " nodes, " << fanout << " children per node" << std::endl;
+	std::cout << std::endl;
+	
+	// Nested vectors
+	
+	double t_build, t_preorder, t_postorder, t_breadth_first, t_size;
+	{
+		hopp::time time;
+		nested_node root;
+		nested_build(root, 0, n, fanout);
+		time.end();
+		t_build = time.seconds();
+		std::cout << "Nested vectors: construction  = " << time.ms() << " ms" << std::endl;
+		
+		time.start();
+		long const sum = nested_preorder(root);
+		time.end();
+		t_preorder = time.seconds();
+		std::cout << "Nested vectors: pre-order     = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+		
+		long last = 0;
+		time.start();
+		long const sum_post = nested_postorder(root, last);
+		time.end();
+		t_postorder = time.seconds();
+		std::cout << "Nested vectors: post-order    = " << time.ms() << " ms (sum = " << sum_post << ")" << std::endl;
+		
+		time.start();
+		long const sum_bfs = nested_breadth_first(root);
+		time.end();
+		t_breadth_first = time.seconds();
+		std::cout << "Nested vectors: breadth-first = " << time.ms() << " ms (sum = " << sum_bfs << ")" << std::endl;
+		
+		time.start();
+		size_t const size = nested_size(root);
+		time.end();
+		t_size = time.seconds();
+		std::cout << "Nested vectors: subtree size  = " << time.ms() << " ms (size = " << size << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// Flat array
+	
+	{
+		hopp::time time;
+		hopp::tree<int> tree(0);
+		tree.reserve(n);
+		for (size_t i = 1; i < n; ++i) { tree.add_child((i - 1) / fanout, int(i % 100)); }
+		time.end();
+		std::cout << "hopp::tree: construction      = " << time.ms() << " ms (speedup = " << t_build / time.seconds() << ")" << std::endl;
+		
+		auto const traversals = [&](std::string const & name)
+		{
+			hopp::tree<int> const & t = tree;
+			
+			hopp::time time;
+			long sum = 0;
+			for (int const value : t) { sum += value; }
+			time.end();
+			std::cout << "hopp::tree" << name << ": pre-order     = " << time.ms() << " ms (sum = " << sum << ", speedup = " << t_preorder / time.seconds() << ")" << std::endl;
+			
+			time.start();
+			sum = 0;
+			for (int const value : t.postorder(t.root())) { sum += value; }
+			time.end();
+			std::cout << "hopp::tree" << name << ": post-order    = " << time.ms() << " ms (sum = " << sum << ", speedup = " << t_postorder / time.seconds() << ")" << std::endl;
+			
+			time.start();
+			sum = 0;
+			for (int const value : t.breadth_first(t.root())) { sum += value; }
+			time.end();
+			std::cout << "hopp::tree" << name << ": breadth-first = " << time.ms() << " ms (sum = " << sum << ", speedup = " << t_breadth_first / time.seconds() << ")" << std::endl;
+			
+			time.start();
+			size_t const size = t.subtree_size(t.root());
+			time.end();
+			std::cout << "hopp::tree" << name << ": subtree size  = " << time.ms() << " ms (size = " << size << ", speedup = " << t_size / time.seconds() << ", first call)" << std::endl;
+			
+			time.start();
+			size_t sizes = 0;
+			for (auto it = t.begin(); it != t.end(); ++it) { sizes += t.subtree_size(it.index()); }
+			time.end();
+			std::cout << "hopp::tree" << name << ": all sizes     = " << time.ms() << " ms (sum = " << sizes << ", cached)" << std::endl;
+		};
+		
+		traversals("            ");
+		std::cout << std::endl;
+		
+		// Nodes in pre-order
+		time.start();
+		tree.compact();
+		time.end();
+		std::cout << "hopp::tree: compact           = " << time.ms() << " ms" << std::endl;
+		traversals(" (compacted)");
+	}
+	
+	return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include <hopp/container/tree_index.hpp>
+#include <hopp/time/time.hpp>
+
+
+// LCA walking the parents: O(depth)
+size_t lca_walk(hopp::tree<int> const & tree, size_t a, size_t b)
+{
+	size_t depth_a = tree.depth(a);
+	size_t depth_b = tree.depth(b);
+	while (depth_a > depth_b) { a = tree.parent(a); --depth_a; }
+	while (depth_b > depth_a) { b = tree.parent(b); --depth_b; }
+	while (a != b) { a = tree.parent(a); b = tree.parent(b); }
+	return a;
+}
+
+// Parent of node i is random in [i - window, i)
+void benchmark(size_t const n, size_t const nb_query, size_t const window)
+{
+	std::mt19937_64 random(42);
+	
+	hopp::tree<int> tree(0);
+	tree.reserve(n);
+	for (size_t i = 1; i < n; ++i) { tree.add_child(i - 1 - random() % std::min(i, window), int(i % 100)); }
+	
+	std::vector<std::pair<size_t, size_t>> queries(nb_query);
+	for (auto & q : queries) { q = { random() % n, random() % n }; }
+	
+	size_t max_depth = 0;
+	for (size_t i = 0; i < n; i += 1000) { max_depth = std::max(max_depth, tree.depth(i)); }
+	std::cout << "Tree of " << n << " nodes, parent in [i - " << window << ", i), depth >= " << max_depth << std::endl;
+	
+	// Walk
+	size_t const nb_query_walk = std::min(nb_query, size_t(100000));
+	hopp::time time;
+	size_t check_walk = 0;
+	for (size_t i = 0; i < nb_query_walk; ++i) { check_walk += lca_walk(tree, queries[i].first, queries[i].second); }
+	time.end();
+	double const t_walk = time.seconds() * double(nb_query) / double(nb_query_walk);
+	std::cout << "    Walk parents       : " << nb_query << " LCA = " << t_walk * 1000 << " ms (extrapolated from " << nb_query_walk << " queries)" << std::endl;
+	
+	// Index
+	hopp::tree_index<int> index(tree);
+	time.start();
+	index.update();
+	time.end();
+	std::cout << "    hopp::tree_index   : build = " << time.ms() << " ms" << std::endl;
+	
+	time.start();
+	size_t check_index = 0;
+	size_t sum = 0;
+	for (size_t i = 0; i < nb_query; ++i)
+	{
+		size_t const lca = index.lca(queries[i].first, queries[i].second);
+		if (i < nb_query_walk) { check_index += lca; }
+		sum += lca;
+	}
+	time.end();
+	std::cout << "    hopp::tree_index   : " << nb_query << " LCA = " << time.ms() << " ms (speedup = " << t_walk / time.seconds() << ", " << ((check_walk == check_index) ? "same results" : "DIFFERENT RESULTS") << ", sum = " << sum << ")" << std::endl;
+	
+	time.start();
+	size_t nb_ancestor = 0;
+	for (auto const & q : queries) { if (index.is_ancestor(q.first, q.second)) { ++nb_ancestor; } }
+	time.end();
+	std::cout << "    hopp::tree_index   : " << nb_query << " is_ancestor = " << time.ms() << " ms (" << nb_ancestor << " true)" << std::endl;
+	
+	time.start();
+	long sum_subtree = 0;
+	for (auto const & q : queries) { sum_subtree += index.subtree_sum(q.first); }
+	time.end();
+	std::cout << "    hopp::tree_index   : " << nb_query << " subtree_sum = " << time.ms() << " ms (sum = " << sum_subtree << ")" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+	// 10^6 nodes and 10^7 queries by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	size_t const nb_query = (argc > 2) ? std::stoul(argv[2]) : 10000000;
+	
+	// Shallow (random recursive tree) and deep trees
+	benchmark(n, nb_query, n);
+	std::cout << std::endl;
+	benchmark(n, nb_query, 100);
+	
+	return 0;
+}
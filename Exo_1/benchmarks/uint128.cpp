@@ -0,0 +1,97 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+
+#include <hopp/int.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	size_t const n_slow = n / 10;
+	
+	#ifdef HOPP_INT_UINT128_NATIVE
+		std::cout << "hopp::uint128 with unsigned __int128" << std::endl;
+	#else
+		std::cout << "hopp::uint128 with two 64-bit halves" << std::endl;
+	#endif
+	std::cout << n << " values" << std::endl;
+	std::cout << std::endl;
+	
+	// Random values (the divisors have between 1 and 128 bits)
+	std::mt19937_64 generator(42);
+	std::vector<hopp::uint128> a(n);
+	std::vector<hopp::uint128> b(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		a[i] = hopp::uint128(generator(), generator());
+		b[i] = (hopp::uint128(generator(), generator()) >> (unsigned int)(generator() % 128)) | 1;
+	}
+	
+	hopp::time time;
+	
+	// +
+	
+	hopp::uint128 sum = 0;
+	time.start();
+	for (size_t i = 0; i < n; ++i) { sum += a[i] + b[i]; }
+	time.end();
+	std::cout << "a + b                  = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/op, " << sum << ")" << std::endl;
+	
+	// *
+	
+	hopp::uint128 product = 1;
+	time.start();
+	for (size_t i = 0; i < n; ++i) { product ^= a[i] * b[i]; }
+	time.end();
+	std::cout << "a * b                  = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/op, " << product << ")" << std::endl;
+	
+	// div_q_r
+	
+	hopp::uint128 check = 0;
+	time.start();
+	for (size_t i = 0; i < n; ++i)
+	{
+		auto const q_r = hopp::div_q_r(a[i], b[i]);
+		check ^= q_r.q ^ q_r.r;
+	}
+	time.end();
+	double const t_div = time.seconds() / double(n);
+	std::cout << "div_q_r(a, b)          = " << time.ms() << " ms (" << t_div * 1e9 << " ns/op, " << check << ")" << std::endl;
+	
+	hopp::uint128 check_generic = 0;
+	time.start();
+	for (size_t i = 0; i < n_slow; ++i)
+	{
+		auto const q_r = hopp::div_q_r<hopp::uint128>(a[i], b[i]);
+		check_generic ^= q_r.q ^ q_r.r;
+	}
+	time.end();
+	std::cout << "div_q_r<T>(a, b), bits = " << time.ms() << " ms for " << n_slow << " values (" << time.seconds() * 1e9 / double(n_slow) << " ns/op, " << (time.seconds() / double(n_slow)) / t_div << "x slower)" << std::endl;
+	
+	// to_string
+	
+	size_t nb_char = 0;
+	time.start();
+	for (size_t i = 0; i < n; ++i) { nb_char += hopp::to_string(a[i]).size(); }
+	time.end();
+	std::cout << "hopp::to_string(a)     = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/op, " << nb_char << " chars)" << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include <hopp/int.hpp>
+#include <hopp/time/time.hpp>
+
+
+// One digit at a time with 128-bit divisions (the previous hopp::to_string)
+char * to_chars_digit_by_digit(char * const first, hopp::uint128 i)
+{
+	char * last = first;
+	do
+	{
+		auto const q_r = hopp::div_q_r(i, hopp::uint128(10));
+		*last++ = char('0' + q_r.r.lo);
+		i = q_r.q;
+	}
+	while (i != 0);
+	std::reverse(first, last);
+	return last;
+}
+
+// One digit at a time with 128-bit multiplications (the previous hopp::uint128 constructor)
+hopp::uint128 from_chars_digit_by_digit(char const * first, char const * const last)
+{
+	hopp::uint128 r = 0;
+	for (; first != last; ++first) { r = r * 10 + hopp::uint128(hopp::ullint(*first - '0')); }
+	return r;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+	
+	std::cout << n << " hopp::uint128 (between 1 and 39 digits)" << std::endl;
+	std::cout << std::endl;
+	
+	std::mt19937_64 generator(42);
+	std::vector<hopp::uint128> values(n);
+	for (auto & v : values) { v = hopp::uint128(generator(), generator()) >> unsigned(generator() % 128); }
+	
+	// Print in a buffer
+	
+	std::vector<char> buffer(n * 40);
+	std::vector<char *> ends(n);
+	
+	hopp::time time;
+	char * p = buffer.data();
+	for (size_t i = 0; i < n; ++i) { p = to_chars_digit_by_digit(p, values[i]); *p++ = ' '; }
+	time.end();
+	double const t_print = time.seconds();
+	std::cout << "print: digit by digit       = " << time.ms() << " ms (" << t_print * 1e9 / double(n) << " ns/value, " << (p - buffer.data()) << " chars)" << std::endl;
+	
+	time.start();
+	p = buffer.data();
+	for (size_t i = 0; i < n; ++i) { p = hopp::to_chars(p, p + 39, values[i]); ends[i] = p; *p++ = ' '; }
+	time.end();
+	std::cout << "print: hopp::to_chars       = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/value, " << (p - buffer.data()) << " chars, speedup = " << t_print / time.seconds() << ")" << std::endl;
+	
+	std::vector<char> buffer_16(n * 33);
+	time.start();
+	char * p_16 = buffer_16.data();
+	for (size_t i = 0; i < n; ++i) { p_16 = hopp::to_chars(p_16, p_16 + 32, values[i], 16); *p_16++ = ' '; }
+	time.end();
+	std::cout << "print: hopp::to_chars (hex) = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/value, " << (p_16 - buffer_16.data()) << " chars)" << std::endl;
+	
+	time.start();
+	std::ostringstream out;
+	for (size_t i = 0; i < n; ++i) { out << values[i] << ' '; }
+	time.end();
+	std::cout << "print: std::ostream <<      = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/value, " << out.str().size() << " chars)" << std::endl;
+	
+	// Parse the buffer
+	
+	std::cout << std::endl;
+	
+	time.start();
+	hopp::uint128 check = 0;
+	char const * first = buffer.data();
+	for (size_t i = 0; i < n; ++i) { check += from_chars_digit_by_digit(first, ends[i]); first = ends[i] + 1; }
+	time.end();
+	double const t_parse = time.seconds();
+	std::cout << "parse: digit by digit       = " << time.ms() << " ms (" << t_parse * 1e9 / double(n) << " ns/value, " << check << ")" << std::endl;
+	
+	time.start();
+	check = 0;
+	size_t nb_error = 0;
+	first = buffer.data();
+	for (size_t i = 0; i < n; ++i)
+	{
+		hopp::uint128 v;
+		first = hopp::from_chars(first, ends[i], v) + 1;
+		check += v;
+		if (v != values[i]) { ++nb_error; }
+	}
+	time.end();
+	std::cout << "parse: hopp::from_chars     = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/value, " << check << ", speedup = " << t_parse / time.seconds() << ", " << nb_error << " errors)" << std::endl;
+	
+	time.start();
+	check = 0;
+	first = buffer_16.data();
+	char const * const last_16 = p_16;
+	while (first < last_16)
+	{
+		hopp::uint128 v;
+		first = hopp::from_chars(first, last_16, v, 16) + 1;
+		check += v;
+	}
+	time.end();
+	std::cout << "parse: hopp::from_chars (hex) = " << time.ms() << " ms (" << time.seconds() * 1e9 / double(n) << " ns/value, " << check << ")" << std::endl;
+	
+	return 0;
+}
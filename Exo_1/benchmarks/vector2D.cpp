@@ -0,0 +1,128 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+
+#include <hopp/container/vector2D.hpp>
+#include <hopp/container/vector_view.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Previous layout of hopp::vector2D<T>: values + a table of rows rebuilt after each copy or move
+template <class T>
+class vector2D_with_rows
+{
+public:
+	
+	size_t nb_row;
+	
+	size_t nb_col;
+	
+	std::vector<T> values;
+	
+	std::vector<hopp::vector_view<std::vector<T>>> rows;
+	
+	vector2D_with_rows(size_t const nb_row, size_t const nb_col) :
+		nb_row(nb_row), nb_col(nb_col), values(nb_row * nb_col), rows()
+	{
+		update_rows();
+	}
+	
+	vector2D_with_rows(vector2D_with_rows && m) :
+		nb_row(m.nb_row), nb_col(m.nb_col), values(std::move(m.values)), rows()
+	{
+		update_rows();
+	}
+	
+	void update_rows()
+	{
+		rows.resize(nb_row);
+		for (size_t i = 0; i < nb_row; ++i) { rows[i] = hopp::make_vector_view(values, i * nb_col, (i + 1) * nb_col); }
+	}
+};
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 4096;
+	size_t const nb_small = (argc > 2) ? std::stoul(argv[2]) : 10000;
+	size_t const small_size = (argc > 3) ? std::stoul(argv[3]) : 4;
+	
+	std::cout << "sizeof(vector2D_with_rows<double>) = " << sizeof(vector2D_with_rows<double>) << std::endl;
+	std::cout << "sizeof(hopp::vector2D<double>)     = " << sizeof(hopp::vector2D<double>) << std::endl;
+	std::cout << std::endl;
+	
+	// Row-major traversal
+	
+	std::cout << "Row-major traversal of a " << n << " x " << n << " matrix" << std::endl;
+	{
+		vector2D_with_rows<double> m(n, n);
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { m.values[i * n + j] = double(i + j); } }
+		
+		hopp::time time;
+		double sum = 0;
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { sum += m.rows[i][j]; } }
+		time.end();
+		std::cout << "    vector2D_with_rows rows[i][j] = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	}
+	{
+		hopp::vector2D<double> m(n, n);
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { m(i, j) = double(i + j); } }
+		
+		hopp::time time;
+		double sum = 0;
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { sum += m[i][j]; } }
+		time.end();
+		std::cout << "    hopp::vector2D m[i][j]        = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+		
+		time.start();
+		sum = 0;
+		for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { sum += m(i, j); } }
+		time.end();
+		std::cout << "    hopp::vector2D m(i, j)        = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+		
+		time.start();
+		sum = 0;
+		for (auto const row : m) { for (double const & e : row) { sum += e; } }
+		time.end();
+		std::cout << "    hopp::vector2D for rows       = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// Construction & move of small matrices
+	
+	std::cout << "Construction and move of " << nb_small << " matrices " << small_size << " x " << small_size << std::endl;
+	{
+		hopp::time time;
+		std::vector<vector2D_with_rows<double>> v;
+		for (size_t i = 0; i < nb_small; ++i) { v.push_back(vector2D_with_rows<double>(small_size, small_size)); }
+		std::vector<vector2D_with_rows<double>> moved;
+		for (auto & m : v) { moved.push_back(std::move(m)); }
+		time.end();
+		std::cout << "    vector2D_with_rows = " << time.ms() << " ms" << std::endl;
+	}
+	{
+		hopp::time time;
+		std::vector<hopp::vector2D<double>> v;
+		for (size_t i = 0; i < nb_small; ++i) { v.push_back(hopp::vector2D<double>(small_size, small_size)); }
+		std::vector<hopp::vector2D<double>> moved;
+		for (auto & m : v) { moved.push_back(std::move(m)); }
+		time.end();
+		std::cout << "    hopp::vector2D     = " << time.ms() << " ms" << std::endl;
+	}
+	
+	return 0;
+}
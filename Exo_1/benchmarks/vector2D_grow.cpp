@@ -0,0 +1,89 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+#include <hopp/container/vector2D.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Previous hopp::vector2D<T>::add_col_before: copy all values in a new hopp::vector2D<T>
+template <class T>
+void add_col_by_copy(hopp::vector2D<T> & m, T const & value)
+{
+	hopp::vector2D<T> tmp(m.nb_row(), m.nb_col() + 1);
+	for (size_t row = 0; row < m.nb_row(); ++row)
+	{
+		for (size_t col = 0; col < m.nb_col(); ++col) { tmp(row, col) = m(row, col); }
+		tmp(row, m.nb_col()) = value;
+	}
+	m = std::move(tmp);
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 2000;
+	size_t const n_copy = (argc > 2) ? std::stoul(argv[2]) : 1000;
+	
+	std::cout << "Grow a " << n << " x 0 table column by column (up to " << n << " x " << n << ")" << std::endl;
+	{
+		hopp::vector2D<double> m(n, 0);
+		hopp::time time;
+		for (size_t j = 0; j < n; ++j) { m.add_cols(1, double(j)); }
+		time.end();
+		std::cout << "    add_cols(1)             = " << time.ms() << " ms (row_pitch = " << m.row_pitch() << ")" << std::endl;
+	}
+	{
+		hopp::vector2D<double> m(n, 0);
+		hopp::time time;
+		for (size_t j = 0; j < n; j += 64) { m.add_cols(std::min(size_t(64), n - j), double(j)); }
+		time.end();
+		std::cout << "    add_cols(64)            = " << time.ms() << " ms" << std::endl;
+	}
+	{
+		hopp::vector2D<double> m(n, 0);
+		m.reserve(n, n);
+		hopp::time time;
+		for (size_t j = 0; j < n; ++j) { m.add_cols(1, double(j)); }
+		time.end();
+		std::cout << "    reserve + add_cols(1)   = " << time.ms() << " ms" << std::endl;
+	}
+	{
+		hopp::vector2D<double> m(n_copy, 0);
+		hopp::time time;
+		for (size_t j = 0; j < n_copy; ++j) { add_col_by_copy(m, double(j)); }
+		time.end();
+		std::cout << "    copy (" << n_copy << " x " << n_copy << ") = " << time.ms() << " ms" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	std::cout << "Grow a 0 x " << n << " table row by row, then remove 100 columns in the middle one by one" << std::endl;
+	{
+		hopp::vector2D<double> m(0, n);
+		hopp::time time;
+		for (size_t i = 0; i < n; ++i) { m.add_rows(1, double(i)); }
+		time.end();
+		std::cout << "    add_rows(1)             = " << time.ms() << " ms (row_capacity = " << m.row_capacity() << ")" << std::endl;
+		
+		time.start();
+		for (size_t k = 0; k < 100 && m.nb_col() != 0; ++k) { m.remove_cols(m.nb_col() / 2, m.nb_col() / 2 + 1); }
+		time.end();
+		std::cout << "    remove_cols(j, j + 1)   = " << time.ms() << " ms" << std::endl;
+	}
+	
+	return 0;
+}
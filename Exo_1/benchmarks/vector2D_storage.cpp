@@ -0,0 +1,86 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string>
+
+#include <hopp/container/vector2D.hpp>
+#include <hopp/time/time.hpp>
+
+
+// Row sums, column sums, 5-point stencil and storage-order traversal of a n × n matrix
+template <class storage>
+void benchmark(std::string const & name, size_t const n)
+{
+	hopp::vector2D<double, storage> m(n, n);
+	for (size_t i = 0; i < n; ++i) { for (size_t j = 0; j < n; ++j) { m(i, j) = double((i + j) % 7); } }
+	
+	std::cout << name << std::endl;
+	
+	hopp::time time;
+	double sum = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		double row_sum = 0;
+		for (size_t j = 0; j < n; ++j) { row_sum += m(i, j); }
+		sum += row_sum;
+	}
+	time.end();
+	std::cout << "    row sums      = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	
+	time.start();
+	sum = 0;
+	for (size_t j = 0; j < n; ++j)
+	{
+		double col_sum = 0;
+		for (size_t i = 0; i < n; ++i) { col_sum += m(i, j); }
+		sum += col_sum;
+	}
+	time.end();
+	std::cout << "    column sums   = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	
+	hopp::vector2D<double, storage> r(n, n);
+	time.start();
+	for (size_t i = 1; i + 1 < n; ++i)
+	{
+		for (size_t j = 1; j + 1 < n; ++j)
+		{
+			r(i, j) = 0.2 * (m(i, j) + m(i - 1, j) + m(i + 1, j) + m(i, j - 1) + m(i, j + 1));
+		}
+	}
+	time.end();
+	std::cout << "    stencil       = " << time.ms() << " ms (r(1, 1) = " << r(1, 1) << ")" << std::endl;
+	
+	time.start();
+	sum = 0;
+	for (double const & e : m.vector()) { sum += e; }
+	time.end();
+	std::cout << "    vector()      = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 4096;
+	
+	std::cout << "Matrix " << n << " x " << n << " of double" << std::endl;
+	std::cout << std::endl;
+	
+	benchmark<hopp::storage2D::row_major>("hopp::storage2D::row_major", n);
+	benchmark<hopp::storage2D::col_major>("hopp::storage2D::col_major", n);
+	benchmark<hopp::storage2D::tiled<8>>("hopp::storage2D::tiled<8>", n);
+	benchmark<hopp::storage2D::tiled<16>>("hopp::storage2D::tiled<16>", n);
+	benchmark<hopp::storage2D::tiled<64>>("hopp::storage2D::tiled<64>", n);
+	
+	return 0;
+}
@@ -0,0 +1,110 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+
+#include <hopp/container/vector_pair.hpp>
+#include <hopp/time/time.hpp>
+
+
+int main(int argc, char * argv[])
+{
+	// 10^6 keys by default
+	size_t const n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	size_t const n_linear = std::min(n, size_t(10000));
+	
+	std::cout << n << " std::string keys, " << n << " inserts and " << n << " lookups" << std::endl;
+	std::cout << std::endl;
+	
+	std::vector<std::string> keys(n);
+	for (size_t i = 0; i < n; ++i) { keys[i] = "section.key_" + std::to_string(i); }
+	std::vector<std::string> lookups(keys);
+	std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(42));
+	
+	// Linear search (previous implementation): O(n^2)
+	
+	double t_linear_insert, t_linear_find;
+	{
+		std::vector<std::pair<std::string, size_t>> pairs;
+		auto const find = [&pairs](std::string const & key)
+		{
+			return std::find_if(pairs.begin(), pairs.end(), [&key](std::pair<std::string, size_t> const & pair) { return pair.first == key; });
+		};
+		
+		hopp::time time;
+		for (size_t i = 0; i < n_linear; ++i)
+		{
+			auto const it = find(keys[i]);
+			if (it == pairs.end()) { pairs.emplace_back(keys[i], i); } else { it->second = i; }
+		}
+		time.end();
+		double const factor = double(n) / double(n_linear);
+		t_linear_insert = time.seconds() * factor * factor;
+		std::cout << "Linear search  : inserts = " << t_linear_insert * 1000 << " ms (extrapolated from " << n_linear << " keys)" << std::endl;
+		
+		time.start();
+		size_t sum = 0;
+		for (size_t i = 0; i < n_linear; ++i) { sum += find(keys[(i * 7919) % n_linear])->second; }
+		time.end();
+		t_linear_find = time.seconds() * factor * factor;
+		std::cout << "Linear search  : lookups = " << t_linear_find * 1000 << " ms (extrapolated from " << n_linear << " keys, sum = " << sum << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// std::unordered_map (no insertion order)
+	
+	{
+		hopp::time time;
+		std::unordered_map<std::string, size_t> map;
+		for (size_t i = 0; i < n; ++i) { map[keys[i]] = i; }
+		time.end();
+		std::cout << "std::unordered_map: inserts = " << time.ms() << " ms" << std::endl;
+		
+		time.start();
+		size_t sum = 0;
+		for (auto const & key : lookups) { sum += map.find(key)->second; }
+		time.end();
+		std::cout << "std::unordered_map: lookups = " << time.ms() << " ms (sum = " << sum << ")" << std::endl;
+	}
+	std::cout << std::endl;
+	
+	// hopp::vector_pair
+	
+	{
+		hopp::time time;
+		hopp::vector_pair<std::string, size_t> pairs;
+		for (size_t i = 0; i < n; ++i) { pairs[keys[i]] = i; }
+		time.end();
+		std::cout << "hopp::vector_pair : inserts = " << time.ms() << " ms (speedup = " << t_linear_insert / time.seconds() << ")" << std::endl;
+		
+		time.start();
+		size_t sum = 0;
+		for (auto const & key : lookups) { sum += pairs.find(key)->second; }
+		time.end();
+		std::cout << "hopp::vector_pair : lookups = " << time.ms() << " ms (speedup = " << t_linear_find / time.seconds() << ", sum = " << sum << ")" << std::endl;
+		
+		time.start();
+		size_t total = 0;
+		for (auto const & pair : pairs) { total += pair.second; }
+		time.end();
+		std::cout << "hopp::vector_pair : iteration in insertion order = " << time.ms() << " ms (sum = " << total << ")" << std::endl;
+	}
+	
+	return 0;
+}
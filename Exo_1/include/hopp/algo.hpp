@@ -23,6 +23,7 @@
 
 #include "algo/compare_range.hpp"
 #include "algo/find_range.hpp"
+#include "algo/parallel.hpp"
 #include "algo/random_element.hpp"
 #include "algo/replace.hpp"
 #include "algo/replace_all.hpp"
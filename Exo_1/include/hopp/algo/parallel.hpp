@@ -0,0 +1,409 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_ALGO_PARALLEL_HPP
+#define HOPP_ALGO_PARALLEL_HPP
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#include "sum.hpp"
+#include "../container/vector2D.hpp"
+#include "../container/vector2D_view.hpp"
+#include "../container/vector_view.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Parallel algorithms on contiguous ranges, hopp::vector2D, hopp::vector2D_view and hopp::vector_view
+	 *
+	 * The work is split in one chunk per thread if OpenMP is enabled (sequential otherwise). @n
+		 * The loops which call f are not annotated with omp simd (f can have side effects or call functions), the compiler can still vectorize them when f is inlined. @n
+	 * The functions are called concurrently and in an unspecified order: they must not depend on each other. @n
+	 * The reduction operations must be associative, the chunks are combined in order (the result does not depend on the scheduling).
+	 *
+	 * @code
+	   #include <hopp/algo/parallel.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::vector2D<double> m(10000, 10000, 0.1);
+	   hopp::parallel::for_each(m, [](double & x) { x *= 2; });
+	   double const sum = hopp::parallel::sum(m); // pairwise sum per chunk
+	   double const max = hopp::parallel::reduce(m, m(0, 0), [](double const a, double const b) { return std::max(a, b); });
+	   @endcode
+	 *
+	 * @ingroup hopp_algo
+	 */
+	namespace parallel
+	{
+		/// Minimal number of values to use several threads
+		constexpr size_t min_size = 1 << 15;
+		
+		/// @brief Number of chunks to split n values (one per thread, 1 if n is small or without OpenMP)
+		/// @param[in] n Number of values
+		/// @return the number of chunks
+		/// @ingroup hopp_algo
+		inline size_t nb_chunk(size_t const n)
+		{
+			#ifdef _OPENMP
+				if (n >= hopp::parallel::min_size) { return std::min(size_t(omp_get_max_threads()), n / hopp::parallel::min_size); }
+			#else
+				static_cast<void>(n);
+			#endif
+			
+			return 1;
+		}
+		
+		// Contiguous range
+		
+		/// @brief Apply f on each value of [first, last)
+		/// @param[in] first Pointer to the first value
+		/// @param[in] last  Pointer to the end (not included)
+		/// @param[in] f     Function called with a T &
+		/// @ingroup hopp_algo
+		template <class T, class function_t>
+		void for_each(T * const first, T * const last, function_t f)
+		{
+			size_t const n = size_t(last - first);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (n >= hopp::parallel::min_size)
+			#endif
+			for (size_t i = 0; i < n; ++i) { f(first[i]); }
+		}
+		
+		/// @brief Store f(value) in d_first for each value of [first, last)
+		/// @param[in]  first   Pointer to the first value
+		/// @param[in]  last    Pointer to the end (not included)
+		/// @param[out] d_first Pointer to the first result (last - first values, can be first)
+		/// @param[in]  f       Function called with a T const &
+		/// @ingroup hopp_algo
+		template <class T, class U, class function_t>
+		void transform(T const * const first, T const * const last, U * const d_first, function_t f)
+		{
+			size_t const n = size_t(last - first);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (n >= hopp::parallel::min_size)
+			#endif
+			for (size_t i = 0; i < n; ++i) { d_first[i] = f(first[i]); }
+		}
+		
+		/// @brief Reduce the values of [first, last) with an associative operation
+		/// @param[in] first Pointer to the first value
+		/// @param[in] last  Pointer to the end (not included)
+		/// @param[in] init  Initial value
+		/// @param[in] op    Associative operation (U, T) -> U and (U, U) -> U
+		/// @return op(op(init, first[0]), first[1])...
+		/// @ingroup hopp_algo
+		template <class T, class U, class operation_t>
+		U reduce(T const * const first, T const * const last, U init, operation_t op)
+		{
+			size_t const n = size_t(last - first);
+			size_t const nb_chunk = hopp::parallel::nb_chunk(n);
+			
+			if (nb_chunk == 1)
+			{
+				for (size_t i = 0; i < n; ++i) { init = op(init, first[i]); }
+				return init;
+			}
+			
+			std::vector<U> partial(nb_chunk, init);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				size_t const i_begin = n * c / nb_chunk;
+				size_t const i_end = n * (c + 1) / nb_chunk;
+				U chunk = U(first[i_begin]);
+				for (size_t i = i_begin + 1; i < i_end; ++i) { chunk = op(chunk, first[i]); }
+				partial[c] = chunk;
+			}
+			
+			for (U const & chunk : partial) { init = op(init, chunk); }
+			return init;
+		}
+		
+		/// @brief Sum of the values of [first, last) (pairwise sum per chunk, see hopp::pairwise_sum)
+		/// @param[in] first Pointer to the first value
+		/// @param[in] last  Pointer to the end (not included)
+		/// @return the sum
+		/// @ingroup hopp_algo
+		template <class T>
+		std::remove_const_t<T> sum(T * const first, T * const last)
+		{
+			using sum_t = std::remove_const_t<T>;
+			
+			size_t const n = size_t(last - first);
+			size_t const nb_chunk = hopp::parallel::nb_chunk(n);
+			
+			if (nb_chunk == 1) { return hopp::sum(first, last); }
+			
+			std::vector<sum_t> partial(nb_chunk);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				partial[c] = hopp::sum(first + n * c / nb_chunk, first + n * (c + 1) / nb_chunk);
+			}
+			
+			return hopp::sum(partial);
+		}
+		
+		// hopp::vector2D_view
+		
+		/// @brief Apply f on each value of a hopp::vector2D_view<T>
+		/// @param[in] view A hopp::vector2D_view<T>
+		/// @param[in] f    Function called with a T &
+		/// @ingroup hopp_algo
+		template <class T, class function_t>
+		void for_each(hopp::vector2D_view<T> view, function_t f)
+		{
+			if (view.is_contiguous()) { hopp::parallel::for_each(view.data(), view.data() + view.nb_row() * view.nb_col(), f); return; }
+			
+			size_t const nb_row = view.nb_row();
+			size_t const nb_col = view.nb_col();
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (nb_row * nb_col >= hopp::parallel::min_size)
+			#endif
+			for (size_t i = 0; i < nb_row; ++i)
+			{
+				T * const row = view.data() + i * view.row_pitch();
+				for (size_t j = 0; j < nb_col; ++j) { f(row[j]); }
+			}
+		}
+		
+		/// @brief Store f(value) in r for each value of a
+		/// @param[in]  a A hopp::vector2D_view<T const>
+		/// @param[out] r A hopp::vector2D_view<U> with the same size (can be a)
+		/// @param[in]  f Function called with a T const &
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_algo
+		template <class T, class U, class function_t>
+		void transform(hopp::vector2D_view<T const> const & a, hopp::vector2D_view<U> r, function_t f)
+		{
+			#ifndef NDEBUG
+				if (a.nb_row() != r.nb_row() || a.nb_col() != r.nb_col()) { throw std::invalid_argument("hopp::parallel::transform(a, r, f): invalid sizes"); }
+			#endif
+			
+			if (a.is_contiguous() && r.is_contiguous())
+			{
+				hopp::parallel::transform(a.data(), a.data() + a.nb_row() * a.nb_col(), r.data(), f);
+				return;
+			}
+			
+			size_t const nb_row = a.nb_row();
+			size_t const nb_col = a.nb_col();
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (nb_row * nb_col >= hopp::parallel::min_size)
+			#endif
+			for (size_t i = 0; i < nb_row; ++i)
+			{
+				T const * const a_i = a.data() + i * a.row_pitch();
+				U * const r_i = r.data() + i * r.row_pitch();
+				for (size_t j = 0; j < nb_col; ++j) { r_i[j] = f(a_i[j]); }
+			}
+		}
+		
+		/// @brief Reduce the values of a hopp::vector2D_view<T> (row by row) with an associative operation
+		/// @param[in] view A hopp::vector2D_view<T>
+		/// @param[in] init Initial value
+		/// @param[in] op   Associative operation (U, T) -> U and (U, U) -> U
+		/// @return the reduction
+		/// @ingroup hopp_algo
+		template <class T, class U, class operation_t>
+		U reduce(hopp::vector2D_view<T> const & view, U init, operation_t op)
+		{
+			if (view.is_contiguous()) { return hopp::parallel::reduce(view.data(), view.data() + view.nb_row() * view.nb_col(), init, op); }
+			
+			size_t const nb_row = view.nb_row();
+			size_t const nb_col = view.nb_col();
+			size_t const nb_chunk = std::min(hopp::parallel::nb_chunk(nb_row * nb_col), nb_row);
+			
+			if (nb_chunk <= 1)
+			{
+				for (size_t i = 0; i < nb_row; ++i) { init = hopp::parallel::reduce(view.data() + i * view.row_pitch(), view.data() + i * view.row_pitch() + nb_col, init, op); }
+				return init;
+			}
+			
+			std::vector<U> partial(nb_chunk, init);
+			
+			// Several chunks: each chunk has at least one row and nb_col > 0
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				size_t const i_begin = nb_row * c / nb_chunk;
+				T const * const first_row = view.data() + i_begin * view.row_pitch();
+				U chunk = hopp::parallel::reduce(first_row + 1, first_row + nb_col, U(first_row[0]), op);
+				for (size_t i = i_begin + 1; i < nb_row * (c + 1) / nb_chunk; ++i)
+				{
+					chunk = hopp::parallel::reduce(view.data() + i * view.row_pitch(), view.data() + i * view.row_pitch() + nb_col, chunk, op);
+				}
+				partial[c] = chunk;
+			}
+			
+			for (U const & chunk : partial) { init = op(init, chunk); }
+			return init;
+		}
+		
+		/// @brief Sum of the values of a hopp::vector2D_view<T> (pairwise sum per row)
+		/// @param[in] view A hopp::vector2D_view<T>
+		/// @return the sum
+		/// @ingroup hopp_algo
+		template <class T>
+		std::remove_const_t<T> sum(hopp::vector2D_view<T> const & view)
+		{
+			using sum_t = std::remove_const_t<T>;
+			
+			if (view.is_contiguous()) { return hopp::parallel::sum(view.data(), view.data() + view.nb_row() * view.nb_col()); }
+			
+			size_t const nb_row = view.nb_row();
+			size_t const nb_col = view.nb_col();
+			size_t const nb_chunk = std::max(std::min(hopp::parallel::nb_chunk(nb_row * nb_col), nb_row), size_t(1));
+			
+			std::vector<sum_t> partial(nb_chunk);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (nb_chunk > 1)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				std::vector<sum_t> row_sums;
+				for (size_t i = nb_row * c / nb_chunk; i < nb_row * (c + 1) / nb_chunk; ++i)
+				{
+					row_sums.push_back(hopp::sum(view.data() + i * view.row_pitch(), view.data() + i * view.row_pitch() + nb_col));
+				}
+				partial[c] = hopp::sum(row_sums);
+			}
+			
+			return hopp::sum(partial);
+		}
+		
+		// hopp::vector2D
+		
+		/// @brief Apply f on each value of a hopp::vector2D<T>
+		/// @param[in,out] vector2D A hopp::vector2D<T>
+		/// @param[in]     f        Function called with a T &
+		/// @ingroup hopp_algo
+		template <class T, class function_t>
+		void for_each(hopp::vector2D<T> & vector2D, function_t f)
+		{
+			hopp::parallel::for_each(vector2D.view(), f);
+		}
+		
+		/// @brief Store f(value) in r for each value of a
+		/// @param[in]  a A hopp::vector2D<T>
+		/// @param[out] r A hopp::vector2D<U> with the same size (can be a)
+		/// @param[in]  f Function called with a T const &
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_algo
+		template <class T, class U, class function_t>
+		void transform(hopp::vector2D<T> const & a, hopp::vector2D<U> & r, function_t f)
+		{
+			hopp::parallel::transform(a.view(), r.view(), f);
+		}
+		
+		/// @brief Reduce the values of a hopp::vector2D<T> with an associative operation
+		/// @param[in] vector2D A hopp::vector2D<T>
+		/// @param[in] init     Initial value
+		/// @param[in] op       Associative operation (U, T) -> U and (U, U) -> U
+		/// @return the reduction
+		/// @ingroup hopp_algo
+		template <class T, class U, class operation_t>
+		U reduce(hopp::vector2D<T> const & vector2D, U init, operation_t op)
+		{
+			return hopp::parallel::reduce(vector2D.view(), init, op);
+		}
+		
+		/// @brief Sum of the values of a hopp::vector2D<T>
+		/// @param[in] vector2D A hopp::vector2D<T>
+		/// @return the sum
+		/// @ingroup hopp_algo
+		template <class T>
+		T sum(hopp::vector2D<T> const & vector2D)
+		{
+			return hopp::parallel::sum(vector2D.view());
+		}
+		
+		// hopp::vector_view
+		
+		/// @brief Apply f on each value of a hopp::vector_view<container_t>
+		/// @param[in] view A hopp::vector_view<container_t> (on a contiguous container)
+		/// @param[in] f    Function called with a value_type &
+		/// @ingroup hopp_algo
+		template <class container_t, class function_t>
+		void for_each(hopp::vector_view<container_t> view, function_t f)
+		{
+			hopp::parallel::for_each(view.data(), view.data() + view.size(), f);
+		}
+		
+		/// @brief Store f(value) in r for each value of a
+		/// @param[in]  a A hopp::vector_view<container_t> (on a contiguous container)
+		/// @param[out] r A hopp::vector_view<container_r_t> with the same size (on a contiguous container, can be a)
+		/// @param[in]  f Function called with a value_type const &
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_algo
+		template <class container_t, class container_r_t, class function_t>
+		void transform(hopp::vector_view<container_t> const & a, hopp::vector_view<container_r_t> r, function_t f)
+		{
+			#ifndef NDEBUG
+				if (a.size() != r.size()) { throw std::invalid_argument("hopp::parallel::transform(a, r, f): invalid sizes"); }
+			#endif
+			
+			hopp::parallel::transform(a.data(), a.data() + a.size(), r.data(), f);
+		}
+		
+		/// @brief Reduce the values of a hopp::vector_view<container_t> with an associative operation
+		/// @param[in] view A hopp::vector_view<container_t> (on a contiguous container)
+		/// @param[in] init Initial value
+		/// @param[in] op   Associative operation (U, value_type) -> U and (U, U) -> U
+		/// @return the reduction
+		/// @ingroup hopp_algo
+		template <class container_t, class U, class operation_t>
+		U reduce(hopp::vector_view<container_t> const & view, U init, operation_t op)
+		{
+			return hopp::parallel::reduce(view.data(), view.data() + view.size(), init, op);
+		}
+		
+		/// @brief Sum of the values of a hopp::vector_view<container_t>
+		/// @param[in] view A hopp::vector_view<container_t> (on a contiguous container)
+		/// @return the sum
+		/// @ingroup hopp_algo
+		template <class container_t>
+		typename container_t::value_type sum(hopp::vector_view<container_t> const & view)
+		{
+			return hopp::parallel::sum(view.data(), view.data() + view.size());
+		}
+	}
+}
+
+#endif
@@ -18,23 +18,82 @@
 
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 
 namespace hopp
 {
+	/// @brief Pairwise sum of elements between two random access iterators (the rounding error grows in O(log n) instead of O(n))
+	/// @param[in] first Iterator to the first element
+	/// @param[in] last  Iterator to the last element (not included)
+	/// @return the sum
+	/// @note Blocks of 128 elements are summed with a vectorizable loop, unlike Kahan summation the result stays accurate with -ffast-math
+	/// @ingroup hopp_algo
+	template <class random_access_iterator_t>
+	auto pairwise_sum(random_access_iterator_t const & first, random_access_iterator_t const & last) -> typename std::decay<decltype(*first)>::type
+	{
+		using sum_t = typename std::decay<decltype(*first)>::type;
+		
+		auto const n = last - first;
+		
+		if (n <= 128)
+		{
+			sum_t sum = sum_t();
+			#ifdef _OPENMP
+				#pragma omp simd reduction(+:sum)
+			#endif
+			for (decltype(last - first) i = 0; i < n; ++i) { sum += first[i]; }
+			return sum;
+		}
+		
+		auto const middle = first + n / 2;
+		return hopp::pairwise_sum(first, middle) + hopp::pairwise_sum(middle, last);
+	}
+	
+	namespace
+	{
+		// Sum of elements between two iterators
+		template <class forward_iterator_t>
+		class sum_
+		{
+		public:
+			
+			using sum_t = typename std::decay<decltype(*std::declval<forward_iterator_t>())>::type;
+			
+			static sum_t call(forward_iterator_t const & first, forward_iterator_t const & last)
+			{
+				return call(first, last, std::integral_constant<bool, std::is_floating_point<sum_t>::value && std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<forward_iterator_t>::iterator_category>::value>());
+			}
+			
+		private:
+			
+			// Sequential sum
+			static sum_t call(forward_iterator_t const & first, forward_iterator_t const & last, std::false_type /*tag*/)
+			{
+				sum_t sum = sum_t();
+				for (auto it = first; it != last; ++it) { sum += *it; }
+				return sum;
+			}
+			
+			// Floating point & random access iterator: pairwise sum
+			static sum_t call(forward_iterator_t const & first, forward_iterator_t const & last, std::true_type /*tag*/)
+			{
+				return hopp::pairwise_sum(first, last);
+			}
+		};
+	}
+	
 	/// @brief Sum of elements between two iterators
 	/// @param[in] first Iterator to the first element
 	/// @param[in] last  Iterator to the last element (not included)
 	/// @return the sum
-	/// @note Consider std::accumulate
+	/// @note Floating point values between random access iterators are summed with hopp::pairwise_sum
+	/// @note Consider std::accumulate, see hopp::parallel::sum for a parallel version
 	/// @ingroup hopp_algo
 	template <class forward_iterator_t>
 	auto sum(forward_iterator_t const & first, forward_iterator_t const & last) -> typename std::decay<decltype(*first)>::type
 	{
-		using sum_t = typename std::decay<decltype(*first)>::type; // typename std::iterator_traits<forward_iterator_t>::value_type;
-		sum_t sum = sum_t();
-		for (auto it = first; it != last; ++it) { sum += *it; }
-		return sum;
+		return sum_<forward_iterator_t>::call(first, last);
 	}
 	
 	/// @brief Sum of elements of a container
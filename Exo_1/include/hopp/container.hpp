@@ -18,13 +18,23 @@
 
 /**
  * @defgroup hopp_container Container
- * @brief Container (vector2, vector3, vector2D, optional)
+ * @brief Container (vector2, vector3, soa_vector3, vector2D, tree, vector_pair, flat_map, optional, slot_map, views)
  */
 
 #include "container/tree.hpp"
+#include "container/tree_index.hpp"
+#include "container/coo_matrix.hpp"
+#include "container/csr_matrix.hpp"
+#include "container/flat_map.hpp"
+#include "container/mapped_vector2D.hpp"
 #include "container/optional.hpp"
+#include "container/slot_map.hpp"
+#include "container/soa_vector3.hpp"
+#include "container/storage2D.hpp"
+#include "container/strided_view.hpp"
 #include "container/vector2.hpp"
 #include "container/vector2D.hpp"
+#include "container/vector2D_view.hpp"
 #include "container/vector3.hpp"
 #include "container/vector_view.hpp"
 #include "container/vector_pair.hpp"
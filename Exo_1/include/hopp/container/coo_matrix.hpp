@@ -0,0 +1,256 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_COO_MATRIX_HPP
+#define HOPP_CONTAINER_COO_MATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "vector2D.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Sparse matrix in coordinate format (COO): a list of (row, column, value)
+	 *
+	 * Fast to build (add() is a push_back), use hopp::csr_matrix<T> for the computations. @n
+	 * The values can be in any order and there can be several values for the same (i, j) (they are summed), see sort().
+	 *
+	 * @code
+	   #include <hopp/container/coo_matrix.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::coo_matrix<double> a(1000000, 1000000);
+	   a.add(0, 42, 1.0);
+	   a.add(999999, 0, 2.0);
+	   hopp::csr_matrix<double> const b(a);
+	   @endcode
+	 *
+	 * @tparam T       Value type
+	 * @tparam index_t Type of the row and column indexes (std::uint32_t by default)
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class index_t = std::uint32_t>
+	class coo_matrix
+	{
+	public:
+		
+		/// Value type
+		using value_type = T;
+		
+		/// Index type
+		using index_type = index_t;
+		
+	private:
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+		/// Row indexes
+		std::vector<index_t> m_rows;
+		
+		/// Column indexes
+		std::vector<index_t> m_cols;
+		
+		/// Values
+		std::vector<T> m_values;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::length_error if the row or column indexes do not fit in an index_t
+		coo_matrix(size_t const nb_row = 0, size_t const nb_col = 0) :
+			m_nb_row(nb_row), m_nb_col(nb_col), m_rows(), m_cols(), m_values()
+		{
+			if (is_size_valid(nb_row, nb_col) == false)
+			{
+				throw std::length_error("hopp::coo_matrix<T, index_t>: " + std::to_string(nb_row) + " × " + std::to_string(nb_col) + " is too large for index_t");
+			}
+		}
+		
+		/// @brief Constructor from a hopp::vector2D<T> (the values equal to T() are not stored)
+		/// @param[in] vector2D A hopp::vector2D<T>
+		/// @exception std::length_error if the row or column indexes do not fit in an index_t
+		explicit coo_matrix(hopp::vector2D<T> const & vector2D) :
+			coo_matrix(vector2D.nb_row(), vector2D.nb_col())
+		{
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t j = 0; j < nb_col(); ++j)
+				{
+					if (vector2D(i, j) != T()) { add(i, j, vector2D(i, j)); }
+				}
+			}
+		}
+		
+		/// @brief Test if the row and column indexes fit in an index_t
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @return true if nb_row - 1 and nb_col - 1 fit in an index_t, false otherwise
+		static bool is_size_valid(size_t const nb_row, size_t const nb_col)
+		{
+			std::uintmax_t const max = std::uintmax_t(std::numeric_limits<index_t>::max());
+			return (nb_row == 0 || nb_row - 1 <= max) && (nb_col == 0 || nb_col - 1 <= max);
+		}
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Return the number of stored values
+		/// @return the number of stored values
+		size_t nb_nonzero() const { return m_values.size(); }
+		
+		/// @brief Return the memory used by the values and the indexes (in bytes)
+		/// @return the memory used by the values and the indexes
+		size_t memory() const { return m_values.capacity() * sizeof(T) + (m_rows.capacity() + m_cols.capacity()) * sizeof(index_t); }
+		
+		/// @brief Get the row indexes
+		/// @return the row indexes
+		std::vector<index_t> const & rows() const { return m_rows; }
+		
+		/// @brief Get the column indexes
+		/// @return the column indexes
+		std::vector<index_t> const & cols() const { return m_cols; }
+		
+		/// @brief Get the values
+		/// @return the values
+		std::vector<T> const & values() const { return m_values; }
+		
+		/// @brief Get the values
+		/// @return the values
+		std::vector<T> & values() { return m_values; }
+		
+		/// @brief Reserve memory for nb_nonzero values
+		/// @param[in] nb_nonzero Number of values
+		void reserve(size_t const nb_nonzero)
+		{
+			m_rows.reserve(nb_nonzero);
+			m_cols.reserve(nb_nonzero);
+			m_values.reserve(nb_nonzero);
+		}
+		
+		/// @brief Add a value (summed with the other values at (i, j))
+		/// @param[in] i     Row index
+		/// @param[in] j     Column index
+		/// @param[in] value Value
+		/// @exception std::out_of_range if NDEBUG is not defined and if i >= number of rows or j >= number of columns
+		void add(size_t const i, size_t const j, T const & value)
+		{
+			#ifndef NDEBUG
+				if (i >= nb_row()) { throw std::out_of_range("hopp::coo_matrix<T>::add(i, j, value): invalid i index"); }
+				if (j >= nb_col()) { throw std::out_of_range("hopp::coo_matrix<T>::add(i, j, value): invalid j index"); }
+			#endif
+			
+			m_rows.push_back(index_t(i));
+			m_cols.push_back(index_t(j));
+			m_values.push_back(value);
+		}
+		
+		/// @brief Remove all the values
+		void clear()
+		{
+			m_rows.clear();
+			m_cols.clear();
+			m_values.clear();
+		}
+		
+		/// @brief Sort the values row by row (then column by column) and sum the values with the same (i, j)
+		void sort()
+		{
+			std::vector<size_t> order(nb_nonzero());
+			std::iota(order.begin(), order.end(), size_t(0));
+			std::sort
+			(
+				order.begin(), order.end(),
+				[this](size_t const a, size_t const b)
+				{ return m_rows[a] < m_rows[b] || (m_rows[a] == m_rows[b] && m_cols[a] < m_cols[b]); }
+			);
+			
+			std::vector<index_t> rows;
+			std::vector<index_t> cols;
+			std::vector<T> values;
+			rows.reserve(order.size());
+			cols.reserve(order.size());
+			values.reserve(order.size());
+			
+			for (size_t const k : order)
+			{
+				if (rows.empty() == false && rows.back() == m_rows[k] && cols.back() == m_cols[k])
+				{
+					values.back() += m_values[k];
+				}
+				else
+				{
+					rows.push_back(m_rows[k]);
+					cols.push_back(m_cols[k]);
+					values.push_back(m_values[k]);
+				}
+			}
+			
+			m_rows.swap(rows);
+			m_cols.swap(cols);
+			m_values.swap(values);
+		}
+		
+		/// @brief Convert into a hopp::vector2D<T>
+		/// @return the dense hopp::vector2D<T>
+		hopp::vector2D<T> to_vector2D() const
+		{
+			hopp::vector2D<T> r(nb_row(), nb_col());
+			for (size_t k = 0; k < nb_nonzero(); ++k) { r(m_rows[k], m_cols[k]) += m_values[k]; }
+			return r;
+		}
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::coo_matrix<T, index_t>
+	/// @param[in,out] out    A std::ostream
+	/// @param[in]     matrix A hopp::coo_matrix<T, index_t>
+	/// @return out
+	/// @relates hopp::coo_matrix
+	template <class T, class index_t>
+	std::ostream & operator <<(std::ostream & out, hopp::coo_matrix<T, index_t> const & matrix)
+	{
+		out << "{";
+		for (size_t k = 0; k < matrix.nb_nonzero(); ++k)
+		{
+			out << ((k == 0) ? " " : ", ") << "(" << matrix.rows()[k] << ", " << matrix.cols()[k] << ") = " << matrix.values()[k];
+		}
+		out << " }";
+		return out;
+	}
+}
+
+#endif
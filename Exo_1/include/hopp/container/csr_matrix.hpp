@@ -0,0 +1,483 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_CSR_MATRIX_HPP
+#define HOPP_CONTAINER_CSR_MATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "coo_matrix.hpp"
+#include "strided_view.hpp"
+#include "vector2D.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Row of a hopp::csr_matrix<T, index_t>: the column indexes and the values of the stored values (sorted by column)
+	 *
+	 * @code
+	   #include <hopp/container/csr_matrix.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class index_t>
+	class csr_row
+	{
+	private:
+		
+		/// Column indexes
+		index_t const * m_cols;
+		
+		/// Values
+		T * m_values;
+		
+		/// Number of stored values
+		size_t m_size;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] cols   Column indexes
+		/// @param[in] values Values
+		/// @param[in] size   Number of stored values
+		csr_row(index_t const * const cols, T * const values, size_t const size) :
+			m_cols(cols), m_values(values), m_size(size)
+		{ }
+		
+		/// @brief Return the number of stored values
+		/// @return the number of stored values
+		size_t size() const { return m_size; }
+		
+		/// @brief Return true if there is no stored value
+		/// @return true if there is no stored value, false otherwise
+		bool empty() const { return m_size == 0; }
+		
+		/// @brief Get the column index of the k-th stored value
+		/// @param[in] k Index
+		/// @return the column index of the k-th stored value
+		size_t col(size_t const k) const { return m_cols[k]; }
+		
+		/// @brief Get the k-th stored value
+		/// @param[in] k Index
+		/// @return the k-th stored value
+		T & value(size_t const k) const { return m_values[k]; }
+		
+		/// @brief Get the column indexes
+		/// @return the column indexes
+		hopp::strided_view<index_t const> cols() const { return hopp::strided_view<index_t const>(m_cols, m_size); }
+		
+		/// @brief Get the values
+		/// @return the values
+		hopp::strided_view<T> values() const { return hopp::strided_view<T>(m_values, m_size); }
+	};
+	
+	/**
+	 * @brief Forward iterator on the rows of a hopp::csr_matrix<T, index_t> (a hopp::csr_row is returned by value)
+	 *
+	 * @code
+	   #include <hopp/container/csr_matrix.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class index_t>
+	class csr_row_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = hopp::csr_row<T, index_t>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = void;
+		
+		/// Reference type (the row is returned by value)
+		using reference = hopp::csr_row<T, index_t>;
+		
+	private:
+		
+		/// Row offsets (current row)
+		size_t const * m_offset;
+		
+		/// Column indexes
+		index_t const * m_cols;
+		
+		/// Values
+		T * m_values;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] offset Row offsets (current row)
+		/// @param[in] cols   Column indexes
+		/// @param[in] values Values
+		csr_row_iterator(size_t const * const offset, index_t const * const cols, T * const values) :
+			m_offset(offset), m_cols(cols), m_values(values)
+		{ }
+		
+		/// @brief Get the current row
+		/// @return the current row
+		hopp::csr_row<T, index_t> operator *() const
+		{
+			return hopp::csr_row<T, index_t>(m_cols + m_offset[0], m_values + m_offset[0], m_offset[1] - m_offset[0]);
+		}
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::csr_row_iterator<T, index_t> & operator ++() { ++m_offset; return *this; }
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::csr_row_iterator<T, index_t> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::csr_row_iterator<T, index_t> const & it) const { return m_offset == it.m_offset; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::csr_row_iterator<T, index_t> const & it) const { return m_offset != it.m_offset; }
+	};
+	
+	/**
+	 * @brief Sparse matrix in compressed sparse row format (CSR)
+	 *
+	 * The stored values of the row i are values()[row_offsets()[i]] to values()[row_offsets()[i + 1]] (excluded), sorted by column. @n
+	 * Use hopp::coo_matrix<T, index_t> to build it, see hopp::math::multiply for the (parallel) sparse matrix-vector multiplication.
+	 *
+	 * @code
+	   #include <hopp/container/csr_matrix.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::csr_matrix<double> const a(coo);
+	   for (auto const row : a)
+	   {
+	   	for (size_t k = 0; k < row.size(); ++k) { std::cout << row.col(k) << " " << row.value(k) << std::endl; }
+	   }
+	   std::vector<double> const y = hopp::math::multiply(a, x);
+	   @endcode
+	 *
+	 * @tparam T       Value type
+	 * @tparam index_t Type of the column indexes (std::uint32_t by default)
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class index_t = std::uint32_t>
+	class csr_matrix
+	{
+	public:
+		
+		/// Value type
+		using value_type = T;
+		
+		/// Index type
+		using index_type = index_t;
+		
+		/// Row type
+		using row_t = hopp::csr_row<T, index_t>;
+		
+		/// Const row type
+		using const_row_t = hopp::csr_row<T const, index_t>;
+		
+		/// Iterator type (on rows)
+		using iterator = hopp::csr_row_iterator<T, index_t>;
+		
+		/// Const iterator type (on rows)
+		using const_iterator = hopp::csr_row_iterator<T const, index_t>;
+		
+	private:
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+		/// Index of the first value of each row (nb_row + 1 offsets)
+		std::vector<size_t> m_row_offsets;
+		
+		/// Column indexes
+		std::vector<index_t> m_cols;
+		
+		/// Values
+		std::vector<T> m_values;
+		
+	public:
+		
+		/// @brief Constructor (no stored value)
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @exception std::length_error if the column indexes do not fit in an index_t
+		csr_matrix(size_t const nb_row = 0, size_t const nb_col = 0) :
+			m_nb_row(nb_row), m_nb_col(nb_col), m_row_offsets(), m_cols(), m_values()
+		{
+			if (is_size_valid(nb_col) == false)
+			{
+				throw std::length_error("hopp::csr_matrix<T, index_t>: " + std::to_string(nb_col) + " columns is too large for index_t");
+			}
+			m_row_offsets.assign(nb_row + 1, 0);
+		}
+		
+		/// @brief Constructor from a hopp::coo_matrix<T, index_t> (O(nb_nonzero) + sort of each row, duplicates are summed)
+		/// @param[in] coo A hopp::coo_matrix<T, index_t>
+		explicit csr_matrix(hopp::coo_matrix<T, index_t> const & coo) :
+			csr_matrix(coo.nb_row(), coo.nb_col())
+		{
+			// Counting sort by row
+			for (index_t const i : coo.rows()) { ++m_row_offsets[size_t(i) + 1]; }
+			for (size_t i = 0; i < nb_row(); ++i) { m_row_offsets[i + 1] += m_row_offsets[i]; }
+			
+			std::vector<size_t> next(m_row_offsets.begin(), m_row_offsets.end() - 1);
+			std::vector<index_t> cols(coo.nb_nonzero());
+			std::vector<T> values(coo.nb_nonzero());
+			for (size_t k = 0; k < coo.nb_nonzero(); ++k)
+			{
+				size_t const dst = next[coo.rows()[k]]++;
+				cols[dst] = coo.cols()[k];
+				values[dst] = coo.values()[k];
+			}
+			
+			// Sort each row by column and sum the duplicates
+			m_cols.reserve(cols.size());
+			m_values.reserve(values.size());
+			std::vector<size_t> order;
+			size_t row_begin = 0;
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				size_t const row_end = m_row_offsets[i + 1];
+				
+				order.resize(row_end - row_begin);
+				for (size_t k = 0; k < order.size(); ++k) { order[k] = row_begin + k; }
+				std::sort(order.begin(), order.end(), [&cols](size_t const a, size_t const b) { return cols[a] < cols[b]; });
+				
+				size_t const new_row_begin = m_cols.size();
+				for (size_t const k : order)
+				{
+					if (m_cols.size() != new_row_begin && m_cols.back() == cols[k]) { m_values.back() += values[k]; }
+					else { m_cols.push_back(cols[k]); m_values.push_back(values[k]); }
+				}
+				
+				row_begin = row_end;
+				m_row_offsets[i + 1] = m_cols.size();
+			}
+		}
+		
+		/// @brief Constructor from a hopp::vector2D<T> (the values equal to T() are not stored)
+		/// @param[in] vector2D A hopp::vector2D<T>
+		/// @exception std::length_error if the column indexes do not fit in an index_t
+		explicit csr_matrix(hopp::vector2D<T> const & vector2D) :
+			csr_matrix(vector2D.nb_row(), vector2D.nb_col())
+		{
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t j = 0; j < nb_col(); ++j)
+				{
+					if (vector2D(i, j) != T()) { m_cols.push_back(index_t(j)); m_values.push_back(vector2D(i, j)); }
+				}
+				m_row_offsets[i + 1] = m_cols.size();
+			}
+		}
+		
+		// Size & Data
+		
+		/// @brief Test if the column indexes fit in an index_t
+		/// @param[in] nb_col Number of columns
+		/// @return true if nb_col - 1 fits in an index_t, false otherwise
+		static bool is_size_valid(size_t const nb_col)
+		{
+			return nb_col == 0 || nb_col - 1 <= std::uintmax_t(std::numeric_limits<index_t>::max());
+		}
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t size() const { return nb_row(); }
+		
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Return the number of stored values
+		/// @return the number of stored values
+		size_t nb_nonzero() const { return m_values.size(); }
+		
+		/// @brief Return the memory used by the values and the indexes (in bytes)
+		/// @return the memory used by the values and the indexes
+		size_t memory() const { return m_values.capacity() * sizeof(T) + m_cols.capacity() * sizeof(index_t) + m_row_offsets.capacity() * sizeof(size_t); }
+		
+		/// @brief Get the row offsets (nb_row + 1 offsets)
+		/// @return the row offsets
+		std::vector<size_t> const & row_offsets() const { return m_row_offsets; }
+		
+		/// @brief Get the column indexes
+		/// @return the column indexes
+		std::vector<index_t> const & cols() const { return m_cols; }
+		
+		/// @brief Get the values
+		/// @return the values
+		std::vector<T> const & values() const { return m_values; }
+		
+		/// @brief Get the values
+		/// @return the values
+		std::vector<T> & values() { return m_values; }
+		
+		// Access
+		
+		/// @brief Get the value at (i, j) (binary search in the row i)
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @return the value at (i, j), T() if there is no stored value
+		T operator ()(size_t const i, size_t const j) const
+		{
+			auto const first = m_cols.begin() + ptrdiff_t(m_row_offsets[i]);
+			auto const last = m_cols.begin() + ptrdiff_t(m_row_offsets[i + 1]);
+			auto const it = std::lower_bound(first, last, index_t(j));
+			if (it == last || *it != index_t(j)) { return T(); }
+			return m_values[size_t(it - m_cols.begin())];
+		}
+		
+		/// @brief Safe access to the value at (i, j)
+		/// @param[in] i Row index
+		/// @param[in] j Column index
+		/// @return the value at (i, j), T() if there is no stored value
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T at(size_t const i, size_t const j) const
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::csr_matrix<T>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::csr_matrix<T>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		/// @brief Const row access
+		/// @param[in] i Row index
+		/// @return the row i
+		const_row_t row(size_t const i) const
+		{
+			return const_row_t(m_cols.data() + m_row_offsets[i], m_values.data() + m_row_offsets[i], m_row_offsets[i + 1] - m_row_offsets[i]);
+		}
+		
+		/// @brief Row access (the values can be modified, not the structure)
+		/// @param[in] i Row index
+		/// @return the row i
+		row_t row(size_t const i)
+		{
+			return row_t(m_cols.data() + m_row_offsets[i], m_values.data() + m_row_offsets[i], m_row_offsets[i + 1] - m_row_offsets[i]);
+		}
+		
+		// Iterator (on rows, a row is returned by value)
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return const_iterator(m_row_offsets.data(), m_cols.data(), m_values.data()); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return iterator(m_row_offsets.data(), m_cols.data(), m_values.data()); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return const_iterator(m_row_offsets.data() + nb_row(), m_cols.data(), m_values.data()); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return iterator(m_row_offsets.data() + nb_row(), m_cols.data(), m_values.data()); }
+		
+		// Conversion
+		
+		/// @brief Convert into a hopp::vector2D<T>
+		/// @return the dense hopp::vector2D<T>
+		hopp::vector2D<T> to_vector2D() const
+		{
+			hopp::vector2D<T> r(nb_row(), nb_col());
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t k = m_row_offsets[i]; k < m_row_offsets[i + 1]; ++k) { r(i, m_cols[k]) = m_values[k]; }
+			}
+			return r;
+		}
+		
+		/// @brief Convert into a hopp::coo_matrix<T, index_t> (sorted)
+		/// @return the hopp::coo_matrix<T, index_t>
+		hopp::coo_matrix<T, index_t> to_coo_matrix() const
+		{
+			hopp::coo_matrix<T, index_t> r(nb_row(), nb_col());
+			r.reserve(nb_nonzero());
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t k = m_row_offsets[i]; k < m_row_offsets[i + 1]; ++k) { r.add(i, m_cols[k], m_values[k]); }
+			}
+			return r;
+		}
+	};
+	
+	/// @brief Operator == between two hopp::csr_matrix<T, index_t> (same stored values)
+	/// @param[in] a A hopp::csr_matrix<T, index_t>
+	/// @param[in] b A hopp::csr_matrix<T, index_t>
+	/// @return true if a and b have the same sizes and the same stored values, false otherwise
+	/// @relates hopp::csr_matrix
+	template <class T, class index_t>
+	bool operator ==(hopp::csr_matrix<T, index_t> const & a, hopp::csr_matrix<T, index_t> const & b)
+	{
+		return
+			a.nb_row() == b.nb_row() && a.nb_col() == b.nb_col() &&
+			a.row_offsets() == b.row_offsets() && a.cols() == b.cols() && a.values() == b.values();
+	}
+	
+	/// @brief Operator != between two hopp::csr_matrix<T, index_t>
+	/// @param[in] a A hopp::csr_matrix<T, index_t>
+	/// @param[in] b A hopp::csr_matrix<T, index_t>
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::csr_matrix
+	template <class T, class index_t>
+	bool operator !=(hopp::csr_matrix<T, index_t> const & a, hopp::csr_matrix<T, index_t> const & b)
+	{
+		return (a == b) == false;
+	}
+	
+	/// @brief Operator << between a std::ostream and a hopp::csr_matrix<T, index_t>
+	/// @param[in,out] out    A std::ostream
+	/// @param[in]     matrix A hopp::csr_matrix<T, index_t>
+	/// @return out
+	/// @relates hopp::csr_matrix
+	template <class T, class index_t>
+	std::ostream & operator <<(std::ostream & out, hopp::csr_matrix<T, index_t> const & matrix)
+	{
+		return out << matrix.to_coo_matrix();
+	}
+}
+
+#endif
@@ -0,0 +1,481 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_FLAT_MAP_HPP
+#define HOPP_CONTAINER_FLAT_MAP_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+#include "../conversion/to_string.hpp"
+#include "../stream/ostreamable.hpp"
+#include "../type/is_iterator.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Search algorithm of a hopp::flat_map
+	 *
+	 * @code
+	   #include <hopp/container/flat_map.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	enum class flat_map_search
+	{
+		/// Binary search in the sorted pairs
+		binary,
+		
+		/// Search in a copy of the keys in Eytzinger (breadth-first) layout: the first levels of the implicit tree share cache lines, so it is faster for large maps
+		eytzinger
+	};
+	
+	/**
+	 * @brief Associative container that contains key-value pairs sorted by key, in a contiguous array
+	 *
+	 * It is designed for read-mostly dictionaries: the bulk construction sorts and removes the duplicated keys once, the lookups are O(log n) without pointer chasing and the iteration is a linear scan in key order.
+	 *
+	 * With hopp::flat_map_search::eytzinger (by default), a copy of the keys is stored in Eytzinger layout for the lookups (memory: n pairs + n keys + n indices). The batch lookup (positions) interleaves several searches to overlap the cache misses.
+	 *
+	 * insert and erase are O(n).
+	 *
+	 * @code
+	   #include <hopp/container/flat_map.hpp>
+	   @endcode
+	 *
+	 * Example:
+	 * @code
+	   hopp::flat_map<std::string, int> map({ { "two", 2 }, { "one", 1 }, { "three", 4 }, { "three", 3 } });
+	   
+	   std::cout << map << std::endl; // { { one, 1 }, { three, 3 }, { two, 2 } }
+	   std::cout << map.at("two") << std::endl; // 2
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class key_t, class T, class compare_t = std::less<key_t>>
+	class flat_map
+	{
+	public:
+		
+		/// Key type
+		using key_type = key_t;
+		
+		/// Mapped type
+		using mapped_type = T;
+		
+		/// Value type
+		using value_type = typename std::pair<key_t, T>;
+		
+		/// Const reference type
+		using const_reference = value_type const &;
+		
+		/// Reference type
+		using reference = value_type &;
+		
+		/// Const pointer type
+		using const_pointer = value_type const *;
+		
+		/// Pointer type
+		using pointer = value_type *;
+		
+		/// Const iterator type
+		using const_iterator = typename std::vector<value_type>::const_iterator;
+		
+		/// Iterator type
+		using iterator = typename std::vector<value_type>::iterator;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Size type
+		using size_type = size_t;
+		
+		/// Key compare type
+		using key_compare = compare_t;
+		
+		/// Number of searches interleaved by the batch lookup
+		static constexpr size_t batch_size = 16;
+		
+	private:
+		
+		/// Pairs sorted by key
+		std::vector<std::pair<key_t, T>> m_pairs;
+		
+		/// Search algorithm
+		hopp::flat_map_search m_search;
+		
+		/// Keys in Eytzinger layout (1-based, the first key is not used)
+		std::vector<key_t> m_eytzinger_keys;
+		
+		/// Position in m_pairs of each key of m_eytzinger_keys
+		std::vector<size_t> m_eytzinger_positions;
+		
+		/// Key compare
+		compare_t m_compare;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] search Search algorithm
+		explicit flat_map(hopp::flat_map_search const search = hopp::flat_map_search::eytzinger) :
+			m_pairs(), m_search(search), m_eytzinger_keys(), m_eytzinger_positions(), m_compare()
+		{ }
+		
+		/// @brief Bulk constructor from unsorted pairs (the last pair wins for duplicated keys)
+		/// @param[in] pairs  A std::vector<std::pair<key_t, T>>
+		/// @param[in] search Search algorithm
+		explicit flat_map(std::vector<std::pair<key_t, T>> pairs, hopp::flat_map_search const search = hopp::flat_map_search::eytzinger) :
+			flat_map(search)
+		{
+			assign(std::move(pairs));
+		}
+		
+		/// @brief Bulk constructor from unsorted pairs (the last pair wins for duplicated keys)
+		/// @param[in] initializer_list A std::initializer_list<std::pair<key_t, T>>
+		flat_map(std::initializer_list<std::pair<key_t, T>> const & initializer_list) :
+			flat_map(std::vector<std::pair<key_t, T>>(initializer_list))
+		{ }
+		
+		/// @brief Bulk constructor from iterators on unsorted pairs (the last pair wins for duplicated keys)
+		/// @param[in] first  Iterator to the first element
+		/// @param[in] last   Iterator to the last element (not included)
+		/// @param[in] search Search algorithm
+		template <class input_iterator_t>
+		flat_map(input_iterator_t const & first, input_iterator_t const & last, hopp::flat_map_search const search = hopp::flat_map_search::eytzinger) :
+			flat_map(std::vector<std::pair<key_t, T>>(first, last), search)
+		{
+			static_assert(hopp::is_iterator<input_iterator_t>::value, "hopp::flat_map<key_t, T>::flat_map:  error: input_iterator_t is not an iterator");
+		}
+		
+		/// @brief Replace the content with unsorted pairs in O(n log n) (the last pair wins for duplicated keys)
+		/// @param[in] pairs A std::vector<std::pair<key_t, T>>
+		void assign(std::vector<std::pair<key_t, T>> pairs)
+		{
+			auto const compare = [this](std::pair<key_t, T> const & a, std::pair<key_t, T> const & b) { return m_compare(a.first, b.first); };
+			std::stable_sort(pairs.begin(), pairs.end(), compare);
+			
+			// Keep the last pair of each key
+			m_pairs.clear();
+			m_pairs.reserve(pairs.size());
+			for (size_t i = 0; i < pairs.size(); ++i)
+			{
+				if (i + 1 == pairs.size() || compare(pairs[i], pairs[i + 1])) { m_pairs.push_back(std::move(pairs[i])); }
+			}
+			m_pairs.shrink_to_fit();
+			
+			build_eytzinger();
+		}
+		
+		// Data
+		
+		/// @brief Pairs access
+		/// @return the pairs sorted by key
+		std::vector<std::pair<key_t, T>> const & data() const { return m_pairs; }
+		
+		/// @brief Get the search algorithm
+		/// @return the search algorithm
+		hopp::flat_map_search search() const { return m_search; }
+		
+		// Size
+		
+		/// @brief Is empty?
+		/// @return true if the flat_map is empty, false otherwise
+		bool empty() const { return m_pairs.empty(); }
+		
+		/// @brief Size
+		/// @return the size
+		size_t size() const { return m_pairs.size(); }
+		
+		// Find
+		
+		/// @brief Find the position of a key
+		/// @param[in] key A key
+		/// @return the position of the key in data(), size() if not found
+		size_t position(key_t const & key) const
+		{
+			if (m_search == hopp::flat_map_search::binary)
+			{
+				auto const it = lower_bound(key);
+				return (it != m_pairs.cend() && m_compare(key, it->first) == false) ? size_t(it - m_pairs.cbegin()) : size();
+			}
+			return eytzinger_position(key, eytzinger_descent(1, key));
+		}
+		
+		/// @brief Find the positions of several keys (the searches are interleaved)
+		/// @param[in]  keys      Keys
+		/// @param[in]  n         Number of keys
+		/// @param[out] positions Position of each key in data(), size() if not found
+		void positions(key_t const * const keys, size_t const n, size_t * const positions) const
+		{
+			if (m_search == hopp::flat_map_search::binary)
+			{
+				for (size_t i = 0; i < n; ++i) { positions[i] = position(keys[i]); }
+				return;
+			}
+			
+			size_t const nb_key = m_pairs.size();
+			for (size_t first = 0; first < n; first += batch_size)
+			{
+				size_t const nb = std::min(batch_size, n - first);
+				
+				// Descend the levels in lockstep: the loads of the batch are independent
+				size_t k[batch_size];
+				for (size_t j = 0; j < nb; ++j) { k[j] = 1; }
+				for (bool active = true; active; )
+				{
+					active = false;
+					for (size_t j = 0; j < nb; ++j)
+					{
+						if (k[j] <= nb_key)
+						{
+							k[j] = 2 * k[j] + (m_compare(m_eytzinger_keys[k[j]], keys[first + j]) ? 1 : 0);
+							active = true;
+						}
+					}
+				}
+				
+				for (size_t j = 0; j < nb; ++j) { positions[first + j] = eytzinger_position(keys[first + j], k[j]); }
+			}
+		}
+		
+		/// @brief Find the positions of several keys (the searches are interleaved)
+		/// @param[in] keys Keys
+		/// @return the position of each key in data(), size() if not found
+		std::vector<size_t> positions(std::vector<key_t> const & keys) const
+		{
+			std::vector<size_t> r(keys.size());
+			positions(keys.data(), keys.size(), r.data());
+			return r;
+		}
+		
+		/// @brief Find element with a key
+		/// @param[in] key A key
+		/// @return the iterator the element found, end iterator if not found
+		const_iterator find(key_t const & key) const { return m_pairs.cbegin() + difference_type(position(key)); }
+		
+		/// @brief Find element with a key
+		/// @param[in] key A key
+		/// @return the iterator the element found, end iterator if not found
+		/// @warning Do not modify the key
+		iterator find(key_t const & key) { return m_pairs.begin() + difference_type(position(key)); }
+		
+		/// @brief Count the elements with a key
+		/// @param[in] key A key
+		/// @return 1 if the key exists, 0 otherwise
+		size_t count(key_t const & key) const { return (position(key) == size()) ? 0 : 1; }
+		
+		/// @brief Get the first element whose key is not less than a key (binary search)
+		/// @param[in] key A key
+		/// @return the first element whose key is not less than key
+		const_iterator lower_bound(key_t const & key) const
+		{
+			return std::lower_bound(m_pairs.cbegin(), m_pairs.cend(), key, [this](std::pair<key_t, T> const & pair, key_t const & k) { return m_compare(pair.first, k); });
+		}
+		
+		/// @brief Get the first element whose key is greater than a key (binary search)
+		/// @param[in] key A key
+		/// @return the first element whose key is greater than key
+		const_iterator upper_bound(key_t const & key) const
+		{
+			return std::upper_bound(m_pairs.cbegin(), m_pairs.cend(), key, [this](key_t const & k, std::pair<key_t, T> const & pair) { return m_compare(k, pair.first); });
+		}
+		
+		// Access
+		
+		/// @brief Value access
+		/// @param[in] key A key
+		/// @return the value at key
+		/// @exception std::out_of_range if key does not exist
+		T const & at(key_t const & key) const
+		{
+			size_t const p = position(key);
+			
+			if (p == size())
+			{
+				throw std::out_of_range("hopp::flat_map<key_t, T>::at: invalid key \"" + hopp::to_string(key) + "\"");
+			}
+			return m_pairs[p].second;
+		}
+		
+		/// @brief Value access
+		/// @param[in] key A key
+		/// @return the value at key
+		/// @exception std::out_of_range if key does not exist
+		T & at(key_t const & key)
+		{
+			size_t const p = position(key);
+			
+			if (p == size())
+			{
+				throw std::out_of_range("hopp::flat_map<key_t, T>::at: invalid key \"" + hopp::to_string(key) + "\"");
+			}
+			return m_pairs[p].second;
+		}
+		
+		// insert, erase & clear
+		
+		/// @brief Insert or replace an element in O(n)
+		/// @param[in] key   A key
+		/// @param[in] value A value
+		/// @return a iterator to the element
+		iterator insert(key_t const & key, T const & value)
+		{
+			auto const it = m_pairs.begin() + (lower_bound(key) - m_pairs.cbegin());
+			
+			if (it != m_pairs.end() && m_compare(key, it->first) == false)
+			{
+				it->second = value;
+				return it;
+			}
+			
+			auto const r = m_pairs.emplace(it, key, value);
+			build_eytzinger();
+			return r;
+		}
+		
+		/// @brief Erase an element in O(n)
+		/// @param[in] key A key
+		/// @return the number of elements erased (0 or 1)
+		size_t erase(key_t const & key)
+		{
+			size_t const p = position(key);
+			if (p == size()) { return 0; }
+			m_pairs.erase(m_pairs.begin() + difference_type(p));
+			build_eytzinger();
+			return 1;
+		}
+		
+		/// @brief Remove all elements
+		void clear() { m_pairs.clear(); build_eytzinger(); }
+		
+		// Iterator
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return m_pairs.begin(); }
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator cbegin() const { return m_pairs.cbegin(); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return m_pairs.end(); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator cend() const { return m_pairs.cend(); }
+		
+	private:
+		
+		/// @brief Build the Eytzinger layout of the keys in O(n)
+		void build_eytzinger()
+		{
+			m_eytzinger_keys.clear();
+			m_eytzinger_positions.clear();
+			if (m_search != hopp::flat_map_search::eytzinger) { return; }
+			
+			m_eytzinger_keys.resize(m_pairs.size() + 1);
+			m_eytzinger_positions.resize(m_pairs.size() + 1);
+			build_eytzinger(0, 1);
+		}
+		
+		/// @brief Fill the subtree of a node of the Eytzinger layout with an in-order traversal
+		/// @param[in] position Next position in m_pairs
+		/// @param[in] k        Node (1-based)
+		/// @return the next position in m_pairs after the subtree
+		size_t build_eytzinger(size_t position, size_t const k)
+		{
+			if (k <= m_pairs.size())
+			{
+				position = build_eytzinger(position, 2 * k);
+				m_eytzinger_keys[k] = m_pairs[position].first;
+				m_eytzinger_positions[k] = position;
+				position = build_eytzinger(position + 1, 2 * k + 1);
+			}
+			return position;
+		}
+		
+		/// @brief Descend the Eytzinger layout
+		/// @param[in] k   First node
+		/// @param[in] key A key
+		/// @return the node after the last level (2 * node + 1 when going right)
+		size_t eytzinger_descent(size_t k, key_t const & key) const
+		{
+			while (k <= m_pairs.size()) { k = 2 * k + (m_compare(m_eytzinger_keys[k], key) ? 1 : 0); }
+			return k;
+		}
+		
+		/// @brief Get the position of a key from the end of its descent
+		/// @param[in] key A key
+		/// @param[in] k   Node after the last level
+		/// @return the position of the key in m_pairs, size() if not found
+		size_t eytzinger_position(key_t const & key, size_t k) const
+		{
+			// The lower bound is the last node where the descent went left: remove the right moves and the last left move
+			while (k & 1) { k >>= 1; }
+			k >>= 1;
+			if (k == 0 || m_compare(key, m_eytzinger_keys[k])) { return size(); }
+			return m_eytzinger_positions[k];
+		}
+	};
+	
+	// Out-of-class definition (the constant is odr-used)
+	template <class key_t, class T, class compare_t>
+	constexpr size_t hopp::flat_map<key_t, T, compare_t>::batch_size;
+	
+	/// @brief Operator << between a std::ostream and a hopp::flat_map<key_t, T>
+	/// @param[in,out] out      A std::ostream
+	/// @param[in]     flat_map A hopp::flat_map<key_t, T>
+	/// @return out
+	/// @relates hopp::flat_map
+	template <class key_t, class T, class compare_t>
+	std::ostream & operator <<(std::ostream & out, hopp::flat_map<key_t, T, compare_t> const & flat_map)
+	{
+		out << hopp::ostreamable(flat_map.data());
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::flat_map<key_t, T>
+	/// @param[in] a A hopp::flat_map<key_t, T>
+	/// @param[in] b A hopp::flat_map<key_t, T>
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::flat_map
+	template <class key_t, class T, class compare_t>
+	bool operator ==(hopp::flat_map<key_t, T, compare_t> const & a, hopp::flat_map<key_t, T, compare_t> const & b)
+	{
+		return a.data() == b.data();
+	}
+	
+	/// @brief Operator != between two hopp::flat_map<key_t, T>
+	/// @param[in] a A hopp::flat_map<key_t, T>
+	/// @param[in] b A hopp::flat_map<key_t, T>
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::flat_map
+	template <class key_t, class T, class compare_t>
+	bool operator !=(hopp::flat_map<key_t, T, compare_t> const & a, hopp::flat_map<key_t, T, compare_t> const & b)
+	{
+		return (a == b) == false;
+	}
+}
+
+#endif
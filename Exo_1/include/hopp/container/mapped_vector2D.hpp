@@ -0,0 +1,560 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_MAPPED_VECTOR2D_HPP
+#define HOPP_CONTAINER_MAPPED_VECTOR2D_HPP
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+#if defined(hopp_unix) || defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/types.h>
+	#define HOPP_MAPPED_VECTOR2D_MMAP
+#endif
+
+#include "index.hpp"
+#include "strided_view.hpp"
+#include "vector2D_view.hpp"
+#include "../except/file_not_found.hpp"
+#include "../except/incomplete_implementation.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Header of a hopp::mapped_vector2D<T> file (64 bytes, the values follow the header, row by row)
+	 *
+	 * @code
+	   #include <hopp/container/mapped_vector2D.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	struct mapped_vector2D_header
+	{
+		/// "hopp2D" followed by two 0
+		char magic[8];
+		
+		/// Number of rows
+		std::uint64_t nb_row;
+		
+		/// Number of columns
+		std::uint64_t nb_col;
+		
+		/// Element type: kind (1 signed integer, 2 unsigned integer, 3 floating point, 4 other) << 16 | sizeof(T)
+		std::uint32_t element_type;
+		
+		/// sizeof(T)
+		std::uint32_t element_size;
+		
+		/// Unused (0)
+		char padding[32];
+		
+		/// @brief Element type of T
+		/// @return the element type of T
+		template <class T>
+		static std::uint32_t element_type_of()
+		{
+			std::uint32_t const kind =
+				std::is_floating_point<T>::value ? 3 :
+				std::is_integral<T>::value ? (std::is_signed<T>::value ? 1 : 2) :
+				4;
+			return (kind << 16) | std::uint32_t(sizeof(T));
+		}
+	};
+	
+	static_assert(sizeof(hopp::mapped_vector2D_header) == 64, "hopp::mapped_vector2D_header must be 64 bytes");
+	
+	/// Mode to open a hopp::mapped_vector2D<T>
+	/// @ingroup hopp_container
+	enum class map_mode
+	{
+		/// Read only (writing a value is undefined behavior)
+		read_only,
+		
+		/// Read and write (modified values are written back to the file)
+		read_write
+	};
+	
+	/**
+	 * @brief 2D container backed by a memory-mapped binary file (for grids bigger than the RAM)
+	 *
+	 * The file is a hopp::mapped_vector2D_header followed by the nb_row × nb_col values row by row. @n
+	 * The values are not read when the file is opened: the OS loads the pages on demand and can evict them. @n
+	 * Modified values are written back to the file by the OS, flush() forces the write. @n
+	 * Same (i, j), at(i, j) and rows interface as hopp::vector2D<T> (rows are hopp::strided_view<T>), without adding or removing rows and columns.
+	 *
+	 * @code
+	   #include <hopp/container/mapped_vector2D.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   {
+	   	hopp::mapped_vector2D<float> grid("grid.bin", 100000, 100000); // 40 GB file, nothing is allocated
+	   	grid(42, 42) = 1.f;
+	   	grid.flush();
+	   }
+	   hopp::mapped_vector2D<float> grid("grid.bin", hopp::map_mode::read_only);
+	   std::cout << grid(42, 42) << std::endl;
+	   @endcode
+	 *
+	 * @pre T is trivially copyable
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class mapped_vector2D
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "hopp::mapped_vector2D<T>: T must be trivially copyable");
+		
+	public:
+		
+		/// Row type
+		using row_t = hopp::strided_view<T>;
+		
+		/// Const row type
+		using const_row_t = hopp::strided_view<T const>;
+		
+		/// Column type
+		using col_t = hopp::strided_view<T>;
+		
+		/// Const column type
+		using const_col_t = hopp::strided_view<T const>;
+		
+		/// View type
+		using view_t = hopp::vector2D_view<T>;
+		
+		/// Const view type
+		using const_view_t = hopp::vector2D_view<T const>;
+		
+		/// Value type
+		using value_type = T;
+		
+		/// Const iterator type (on rows)
+		using const_iterator = hopp::vector2D_row_iterator<T const>;
+		
+		/// Iterator type (on rows)
+		using iterator = hopp::vector2D_row_iterator<T>;
+		
+		/// Size type
+		using size_type = size_t;
+		
+	private:
+		
+		/// Filename
+		std::string m_filename;
+		
+		/// Mode
+		hopp::map_mode m_mode;
+		
+		/// File descriptor
+		int m_fd;
+		
+		/// Mapped memory (header + values)
+		void * m_mapping;
+		
+		/// Size of the mapped memory
+		size_t m_mapping_size;
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+	public:
+		
+		/// @brief Default constructor (no file)
+		mapped_vector2D() :
+			m_filename(), m_mode(hopp::map_mode::read_only), m_fd(-1), m_mapping(nullptr), m_mapping_size(0), m_nb_row(0), m_nb_col(0)
+		{ }
+		
+		/// @brief Constructor: create (or truncate) a file of nb_row × nb_col values (T() if T is arithmetic, the file is sparse)
+		/// @param[in] filename Filename
+		/// @param[in] nb_row   Number of rows
+		/// @param[in] nb_col   Number of columns
+		/// @exception std::runtime_error if the file can not be created or mapped
+		mapped_vector2D(std::string const & filename, size_t const nb_row, size_t const nb_col) :
+			m_filename(filename), m_mode(hopp::map_mode::read_write), m_fd(-1), m_mapping(nullptr), m_mapping_size(0), m_nb_row(nb_row), m_nb_col(nb_col)
+		{
+			create();
+		}
+		
+		/// @brief Constructor: create (or truncate) a file of nb_row × nb_col values equal to default_value
+		/// @param[in] filename      Filename
+		/// @param[in] nb_row        Number of rows
+		/// @param[in] nb_col        Number of columns
+		/// @param[in] default_value Default value (all the pages are written)
+		/// @exception std::runtime_error if the file can not be created or mapped
+		mapped_vector2D(std::string const & filename, size_t const nb_row, size_t const nb_col, T const & default_value) :
+			mapped_vector2D(filename, nb_row, nb_col)
+		{
+			std::fill(data(), data() + nb_row * nb_col, default_value);
+		}
+		
+		/// @brief Constructor: open an existing file
+		/// @param[in] filename Filename
+		/// @param[in] mode     hopp::map_mode::read_write (by default) or hopp::map_mode::read_only
+		/// @exception hopp::except::file_not_found if the file can not be opened
+		/// @exception std::runtime_error if the header is invalid (or for another T) or if the file can not be mapped
+		explicit mapped_vector2D(std::string const & filename, hopp::map_mode const mode = hopp::map_mode::read_write) :
+			m_filename(filename), m_mode(mode), m_fd(-1), m_mapping(nullptr), m_mapping_size(0), m_nb_row(0), m_nb_col(0)
+		{
+			open();
+		}
+		
+		/// @brief Move constructor
+		/// @param[in] m A hopp::mapped_vector2D<T>
+		mapped_vector2D(hopp::mapped_vector2D<T> && m) noexcept :
+			mapped_vector2D()
+		{
+			swap(*this, m);
+		}
+		
+		/// @brief Move assignment operator
+		/// @param[in] m A hopp::mapped_vector2D<T>
+		/// @return the hopp::mapped_vector2D<T>
+		hopp::mapped_vector2D<T> & operator =(hopp::mapped_vector2D<T> && m) noexcept
+		{
+			swap(*this, m);
+			return *this;
+		}
+		
+		/// @brief Deleted copy constructor
+		mapped_vector2D(hopp::mapped_vector2D<T> const &) = delete;
+		
+		/// @brief Deleted copy assignment operator
+		hopp::mapped_vector2D<T> & operator =(hopp::mapped_vector2D<T> const &) = delete;
+		
+		/// @brief Destructor (unmap the file, modified pages are written back by the OS)
+		~mapped_vector2D() { close(); }
+		
+		/// @brief Swap two hopp::mapped_vector2D<T>
+		/// @param[in] a A hopp::mapped_vector2D<T>
+		/// @param[in] b A hopp::mapped_vector2D<T>
+		friend void swap(hopp::mapped_vector2D<T> & a, hopp::mapped_vector2D<T> & b) noexcept
+		{
+			std::swap(a.m_filename, b.m_filename);
+			std::swap(a.m_mode, b.m_mode);
+			std::swap(a.m_fd, b.m_fd);
+			std::swap(a.m_mapping, b.m_mapping);
+			std::swap(a.m_mapping_size, b.m_mapping_size);
+			std::swap(a.m_nb_row, b.m_nb_row);
+			std::swap(a.m_nb_col, b.m_nb_col);
+		}
+		
+		// File
+		
+		/// @brief Get the filename
+		/// @return the filename
+		std::string const & filename() const { return m_filename; }
+		
+		/// @brief Get the mode
+		/// @return the mode
+		hopp::map_mode mode() const { return m_mode; }
+		
+		/// @brief Return true if a file is mapped
+		/// @return true if a file is mapped, false otherwise
+		bool is_open() const { return m_mapping != nullptr; }
+		
+		/// @brief Write the modified values to the file (blocks until the write is done)
+		/// @exception std::runtime_error if the write fails
+		void flush()
+		{
+			#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+				if (m_mapping != nullptr && m_mode == hopp::map_mode::read_write && ::msync(m_mapping, m_mapping_size, MS_SYNC) != 0)
+				{
+					throw std::runtime_error("hopp::mapped_vector2D<T>::flush(): msync failed for \"" + m_filename + "\"");
+				}
+			#endif
+		}
+		
+		// Size & Data
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t size() const { return nb_row(); }
+		
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Get data
+		/// @return data
+		T const * data() const { return (m_mapping == nullptr) ? nullptr : reinterpret_cast<T const *>(static_cast<char const *>(m_mapping) + sizeof(hopp::mapped_vector2D_header)); }
+		
+		/// @brief Get data
+		/// @return data
+		T * data() { return (m_mapping == nullptr) ? nullptr : reinterpret_cast<T *>(static_cast<char *>(m_mapping) + sizeof(hopp::mapped_vector2D_header)); }
+		
+		/// @brief Get a 2D view on all values
+		/// @return a 2D view on all values
+		const_view_t view() const { return const_view_t(data(), nb_row(), nb_col()); }
+		
+		/// @brief Get a 2D view on all values
+		/// @return a 2D view on all values
+		view_t view() { return view_t(data(), nb_row(), nb_col()); }
+		
+		// Access
+		
+		/// @brief Const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T const & operator ()(size_t const i, size_t const j) const { return data()[hopp::index2D::to_index1D(i, j, nb_col())]; }
+		
+		/// @brief Value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T & operator ()(size_t const i, size_t const j) { return data()[hopp::index2D::to_index1D(i, j, nb_col())]; }
+		
+		/// @brief Safe const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T const & at(size_t const i, size_t const j) const
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::mapped_vector2D<T>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::mapped_vector2D<T>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		/// @brief Value safe access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T & at(size_t const i, size_t const j)
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::mapped_vector2D<T>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::mapped_vector2D<T>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		/// @brief Const row access
+		/// @param i Row index
+		/// @return row at i
+		const_row_t operator [](size_t const i) const { return row(i); }
+		
+		/// @brief Row access
+		/// @param i Row index
+		/// @return row at i
+		row_t operator [](size_t const i) { return row(i); }
+		
+		/// @brief Const row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		const_row_t row(size_t const i) const { return const_row_t(data() + i * nb_col(), nb_col()); }
+		
+		/// @brief Row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		row_t row(size_t const i) { return row_t(data() + i * nb_col(), nb_col()); }
+		
+		/// @brief Const column access
+		/// @param j Column index
+		/// @return column at j (stride of nb_col)
+		const_col_t col(size_t const j) const { return const_col_t(data() + j, nb_row(), ptrdiff_t(nb_col())); }
+		
+		/// @brief Column access
+		/// @param j Column index
+		/// @return column at j (stride of nb_col)
+		col_t col(size_t const j) { return col_t(data() + j, nb_row(), ptrdiff_t(nb_col())); }
+		
+		// Iterator (on rows, a row is returned by value)
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return const_iterator(data(), 0, nb_col(), nb_col()); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return iterator(data(), 0, nb_col(), nb_col()); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return const_iterator(data(), nb_row(), nb_col(), nb_col()); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return iterator(data(), nb_row(), nb_col(), nb_col()); }
+		
+	private:
+		
+		#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+		
+		/// @brief Test if the header and nb_row × nb_col values fit in a size_t (and in an off_t)
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @return true if the size does not overflow, false otherwise
+		static bool is_size_valid(std::uint64_t const nb_row, std::uint64_t const nb_col)
+		{
+			std::uint64_t const max = std::min<std::uint64_t>(SIZE_MAX, std::uint64_t(std::numeric_limits<off_t>::max()));
+			return nb_col == 0 || nb_row <= (max - sizeof(hopp::mapped_vector2D_header)) / sizeof(T) / nb_col;
+		}
+		
+		#endif
+		
+		/// @brief Create the file and map it
+		void create()
+		{
+			#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+				
+				// Check the size before the file is truncated
+				if (is_size_valid(m_nb_row, m_nb_col) == false)
+				{
+					throw std::runtime_error("hopp::mapped_vector2D<T>: " + std::to_string(m_nb_row) + " × " + std::to_string(m_nb_col) + " values are too large for \"" + m_filename + "\"");
+				}
+				
+				m_fd = ::open(m_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+				if (m_fd < 0) { throw std::runtime_error("hopp::mapped_vector2D<T>: can not create \"" + m_filename + "\""); }
+				
+				m_mapping_size = sizeof(hopp::mapped_vector2D_header) + m_nb_row * m_nb_col * sizeof(T);
+				if (::ftruncate(m_fd, off_t(m_mapping_size)) != 0)
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: can not resize \"" + m_filename + "\"");
+				}
+				
+				map();
+				
+				hopp::mapped_vector2D_header header;
+				std::memset(&header, 0, sizeof(header));
+				std::memcpy(header.magic, "hopp2D", 6);
+				header.nb_row = m_nb_row;
+				header.nb_col = m_nb_col;
+				header.element_type = hopp::mapped_vector2D_header::element_type_of<T>();
+				header.element_size = std::uint32_t(sizeof(T));
+				std::memcpy(m_mapping, &header, sizeof(header));
+				
+			#else
+				
+				throw hopp::except::incomplete_implementation("hopp::mapped_vector2D is not implemented on your platform, please write a bug report or send a mail https://gitorious.org/hopp");
+				
+			#endif
+		}
+		
+		/// @brief Open the file, check the header and map it
+		void open()
+		{
+			#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+				
+				m_fd = ::open(m_filename.c_str(), (m_mode == hopp::map_mode::read_only) ? O_RDONLY : O_RDWR);
+				if (m_fd < 0) { throw hopp::except::file_not_found("hopp::mapped_vector2D<T>: can not open \"" + m_filename + "\""); }
+				
+				struct stat s;
+				hopp::mapped_vector2D_header header;
+				if (::fstat(m_fd, &s) != 0 || size_t(s.st_size) < sizeof(header) || ::pread(m_fd, &header, sizeof(header), 0) != ssize_t(sizeof(header)))
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: can not read the header of \"" + m_filename + "\"");
+				}
+				
+				if (std::memcmp(header.magic, "hopp2D\0\0", 8) != 0)
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: \"" + m_filename + "\" is not a hopp::mapped_vector2D file");
+				}
+				
+				if (header.element_type != hopp::mapped_vector2D_header::element_type_of<T>() || header.element_size != sizeof(T))
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: \"" + m_filename + "\" contains another type of values");
+				}
+				
+				// The header is not trusted: nb_row × nb_col × sizeof(T) must not overflow
+				if (is_size_valid(header.nb_row, header.nb_col) == false)
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: \"" + m_filename + "\" has an invalid size in its header");
+				}
+				
+				m_nb_row = size_t(header.nb_row);
+				m_nb_col = size_t(header.nb_col);
+				m_mapping_size = sizeof(header) + m_nb_row * m_nb_col * sizeof(T);
+				
+				if (size_t(s.st_size) < m_mapping_size)
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: \"" + m_filename + "\" is truncated");
+				}
+				
+				map();
+				
+			#else
+				
+				throw hopp::except::incomplete_implementation("hopp::mapped_vector2D is not implemented on your platform, please write a bug report or send a mail https://gitorious.org/hopp");
+				
+			#endif
+		}
+		
+		/// @brief Map the file
+		void map()
+		{
+			#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+				int const protection = (m_mode == hopp::map_mode::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+				void * const mapping = ::mmap(nullptr, m_mapping_size, protection, MAP_SHARED, m_fd, 0);
+				if (mapping == MAP_FAILED)
+				{
+					close();
+					throw std::runtime_error("hopp::mapped_vector2D<T>: can not map \"" + m_filename + "\"");
+				}
+				m_mapping = mapping;
+			#endif
+		}
+		
+		/// @brief Unmap and close the file
+		void close()
+		{
+			#ifdef HOPP_MAPPED_VECTOR2D_MMAP
+				if (m_mapping != nullptr) { ::munmap(m_mapping, m_mapping_size); }
+				if (m_fd >= 0) { ::close(m_fd); }
+			#endif
+			m_mapping = nullptr;
+			m_mapping_size = 0;
+			m_fd = -1;
+		}
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::mapped_vector2D<T>
+	/// @param[in,out] out    A std::ostream
+	/// @param[in]     vector A hopp::mapped_vector2D<T>
+	/// @return out
+	/// @relates hopp::mapped_vector2D
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::mapped_vector2D<T> const & vector)
+	{
+		return out << vector.view();
+	}
+}
+
+#endif
@@ -0,0 +1,436 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_SLOT_MAP_HPP
+#define HOPP_CONTAINER_SLOT_MAP_HPP
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <utility>
+
+#include "../int/uint.hpp"
+#include "../memory/view_ptr.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Handle on a value of a hopp::slot_map<T> (index and generation)
+	 *
+	 * @code
+	   #include <hopp/container/slot_map.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	class slot_handle
+	{
+	public:
+		
+		/// Index of the slot
+		size_t index;
+		
+		/// Generation of the slot when the handle was created
+		hopp::uint generation;
+		
+		/// @brief Default constructor (invalid handle)
+		slot_handle() : index(std::numeric_limits<size_t>::max()), generation(0) { }
+		
+		/// @brief Constructor
+		/// @param[in] index      Index of the slot
+		/// @param[in] generation Generation of the slot
+		slot_handle(size_t const index, hopp::uint const generation) : index(index), generation(generation) { }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::slot_handle
+	/// @param[in,out] out    A std::ostream
+	/// @param[in]     handle A hopp::slot_handle
+	/// @return out
+	/// @relates hopp::slot_handle
+	inline std::ostream & operator <<(std::ostream & out, hopp::slot_handle const & handle)
+	{
+		out << "{ " << handle.index << ", " << handle.generation << " }";
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::slot_handle
+	/// @param[in] a A hopp::slot_handle
+	/// @param[in] b A hopp::slot_handle
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::slot_handle
+	inline bool operator ==(hopp::slot_handle const & a, hopp::slot_handle const & b)
+	{
+		return a.index == b.index && a.generation == b.generation;
+	}
+	
+	/// @brief Operator != between two hopp::slot_handle
+	/// @param[in] a A hopp::slot_handle
+	/// @param[in] b A hopp::slot_handle
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::slot_handle
+	inline bool operator !=(hopp::slot_handle const & a, hopp::slot_handle const & b)
+	{
+		return (a == b) == false;
+	}
+	
+	/**
+	 * @brief Container where values are referenced by hopp::slot_handle
+	 *
+	 * Values are stored contiguously (iteration is on alive values only).
+	 * A handle is checked in O(1): when a value is erased, the generation of its slot is incremented, so the old handles become invalid (unlike hopp::view_ptr).
+	 *
+	 * @code
+	   #include <hopp/container/slot_map.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::slot_map<std::string> names;
+	   auto h = names.insert("hopp");
+	   std::cout << names[h] << std::endl; // hopp
+	   names.erase(h);
+	   std::cout << names.contains(h) << std::endl; // 0
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class slot_map
+	{
+	public:
+		
+		/// Handle type
+		using handle = hopp::slot_handle;
+		
+		/// Value type
+		using value_type = T;
+		
+		/// Const reference type
+		using const_reference = T const &;
+		
+		/// Reference type
+		using reference = T &;
+		
+		/// Const pointer type
+		using const_pointer = T const *;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Const iterator type
+		using const_iterator = typename std::vector<T>::const_iterator;
+		
+		/// Iterator type
+		using iterator = typename std::vector<T>::iterator;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Size type
+		using size_type = size_t;
+		
+	private:
+		
+		/// Slot
+		class slot_t
+		{
+		public:
+			
+			/// Index of the value if the slot is used, index of the next free slot otherwise
+			size_t index;
+			
+			/// Generation
+			hopp::uint generation;
+		};
+		
+		/// No free slot
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+		
+		/// Values (contiguous)
+		std::vector<T> m_values;
+		
+		/// Slot index of each value
+		std::vector<size_t> m_value_slots;
+		
+		/// Slots
+		std::vector<slot_t> m_slots;
+		
+		/// First free slot
+		size_t m_free;
+		
+	public:
+		
+		/// @brief Default constructor
+		slot_map() : m_values(), m_value_slots(), m_slots(), m_free(npos) { }
+		
+		// Size & Data
+		
+		/// @brief Return the number of values
+		/// @return the number of values
+		size_t size() const { return m_values.size(); }
+		
+		/// @brief Return true if there is no value
+		/// @return true if there is no value, false otherwise
+		bool empty() const { return m_values.empty(); }
+		
+		/// @brief Reserve memory for n values
+		/// @param[in] n Number of values
+		void reserve(size_t const n)
+		{
+			m_values.reserve(n);
+			m_value_slots.reserve(n);
+			m_slots.reserve(n);
+		}
+		
+		/// @brief Get values (the order is not the insertion order)
+		/// @return values
+		std::vector<T> const & values() const { return m_values; }
+		
+		/// @brief Get data
+		/// @return data
+		const_pointer data() const { return m_values.data(); }
+		
+		/// @brief Get data
+		/// @return data
+		pointer data() { return m_values.data(); }
+		
+		// Insert & Erase
+		
+		/// @brief Insert a value
+		/// @param[in] value A value
+		/// @return the handle on the value
+		handle insert(T const & value) { return emplace(value); }
+		
+		/// @brief Insert a value
+		/// @param[in] value A value
+		/// @return the handle on the value
+		handle insert(T && value) { return emplace(std::move(value)); }
+		
+		/// @brief Construct a value in place
+		/// @param[in] args Arguments for the T constructor
+		/// @return the handle on the value
+		template <class ... args_t>
+		handle emplace(args_t && ... args)
+		{
+			// New free slot (the slot map stays valid if the construction throws)
+			if (m_free == npos)
+			{
+				m_slots.push_back(slot_t{ npos, 0 });
+				m_free = m_slots.size() - 1;
+			}
+			
+			// Construct the value
+			m_values.emplace_back(std::forward<args_t>(args)...);
+			try
+			{
+				m_value_slots.push_back(m_free);
+			}
+			catch (...)
+			{
+				m_values.pop_back();
+				throw;
+			}
+			
+			// Use the free slot
+			size_t const slot_index = m_free;
+			m_free = m_slots[slot_index].index;
+			m_slots[slot_index].index = m_values.size() - 1;
+			
+			return handle(slot_index, m_slots[slot_index].generation);
+		}
+		
+		/// @brief Erase a value
+		/// @param[in] h Handle on the value
+		/// @return true if the value was erased, false if the handle is invalid
+		bool erase(handle const & h)
+		{
+			if (contains(h) == false) { return false; }
+			
+			slot_t & slot = m_slots[h.index];
+			size_t const i = slot.index;
+			
+			// Move the last value in the hole
+			if (i != m_values.size() - 1)
+			{
+				m_values[i] = std::move(m_values.back());
+				m_value_slots[i] = m_value_slots.back();
+				m_slots[m_value_slots[i]].index = i;
+			}
+			m_values.pop_back();
+			m_value_slots.pop_back();
+			
+			// Invalidate the handles and free the slot
+			++slot.generation;
+			slot.index = m_free;
+			m_free = h.index;
+			
+			return true;
+		}
+		
+		/// @brief Erase all values (all handles become invalid)
+		void clear()
+		{
+			while (m_value_slots.empty() == false)
+			{
+				erase(handle(m_value_slots.back(), m_slots[m_value_slots.back()].generation));
+			}
+		}
+		
+		// Access
+		
+		/// @brief Return true if the handle references a value
+		/// @param[in] h A handle
+		/// @return true if the handle references a value, false otherwise
+		bool contains(handle const & h) const
+		{
+			if (h.index >= m_slots.size() || m_slots[h.index].generation != h.generation) { return false; }
+			
+			// The slot is used (a free slot has the generation of the next handle, and its index is the next free slot)
+			size_t const i = m_slots[h.index].index;
+			return i < m_value_slots.size() && m_value_slots[i] == h.index;
+		}
+		
+		/// @brief Const value access
+		/// @param[in] h Handle on the value
+		/// @pre The handle is valid
+		/// @return the value
+		/// @exception std::out_of_range if NDEBUG is not defined and if the handle is invalid
+		T const & operator [](handle const & h) const
+		{
+			#ifndef NDEBUG
+				if (contains(h) == false) { throw std::out_of_range("hopp::slot_map<T>::operator [](h): invalid handle"); }
+			#endif
+			
+			return m_values[m_slots[h.index].index];
+		}
+		
+		/// @brief Value access
+		/// @param[in] h Handle on the value
+		/// @pre The handle is valid
+		/// @return the value
+		/// @exception std::out_of_range if NDEBUG is not defined and if the handle is invalid
+		T & operator [](handle const & h)
+		{
+			#ifndef NDEBUG
+				if (contains(h) == false) { throw std::out_of_range("hopp::slot_map<T>::operator [](h): invalid handle"); }
+			#endif
+			
+			return m_values[m_slots[h.index].index];
+		}
+		
+		/// @brief Safe const value access
+		/// @param[in] h Handle on the value
+		/// @return the value
+		/// @exception std::out_of_range if the handle is invalid
+		T const & at(handle const & h) const
+		{
+			if (contains(h) == false) { throw std::out_of_range("hopp::slot_map<T>::at(h): invalid handle"); }
+			return (*this)[h];
+		}
+		
+		/// @brief Safe value access
+		/// @param[in] h Handle on the value
+		/// @return the value
+		/// @exception std::out_of_range if the handle is invalid
+		T & at(handle const & h)
+		{
+			if (contains(h) == false) { throw std::out_of_range("hopp::slot_map<T>::at(h): invalid handle"); }
+			return (*this)[h];
+		}
+		
+		/// @brief Find a value
+		/// @param[in] h Handle on the value
+		/// @return a hopp::view_ptr on the value, nullptr if the handle is invalid
+		/// @warning The hopp::view_ptr is invalidated by insert and erase
+		hopp::view_ptr<T const> find(handle const & h) const
+		{
+			if (contains(h) == false) { return nullptr; }
+			return (*this)[h];
+		}
+		
+		/// @brief Find a value
+		/// @param[in] h Handle on the value
+		/// @return a hopp::view_ptr on the value, nullptr if the handle is invalid
+		/// @warning The hopp::view_ptr is invalidated by insert and erase
+		hopp::view_ptr<T> find(handle const & h)
+		{
+			if (contains(h) == false) { return nullptr; }
+			return (*this)[h];
+		}
+		
+		/// @brief Get the handle of the value at index i (of the values)
+		/// @param[in] i Index of the value
+		/// @pre i < number of values
+		/// @return the handle of the value
+		handle handle_of(size_t const i) const
+		{
+			return handle(m_value_slots[i], m_slots[m_value_slots[i]].generation);
+		}
+		
+		// Iterator
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return m_values.begin(); }
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator cbegin() const { return m_values.cbegin(); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return m_values.begin(); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return m_values.end(); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator cend() const { return m_values.cend(); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return m_values.end(); }
+	};
+	
+	template <class T>
+	constexpr size_t slot_map<T>::npos;
+	
+	/// @brief Operator << between a std::ostream and a hopp::slot_map<T>
+	/// @param[in,out] out      A std::ostream
+	/// @param[in]     slot_map A hopp::slot_map<T>
+	/// @return out
+	/// @relates hopp::slot_map
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::slot_map<T> const & slot_map)
+	{
+		out << "{";
+		for (size_t i = 0; i < slot_map.size(); ++i)
+		{
+			if (i == 0) { out << " "; }
+			else { out << ", "; }
+			
+			out << slot_map.handle_of(i) << ": " << slot_map.values()[i];
+		}
+		out << " }";
+		
+		return out;
+	}
+}
+
+#endif
@@ -0,0 +1,406 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_SOA_VECTOR3_HPP
+#define HOPP_CONTAINER_SOA_VECTOR3_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "vector3.hpp"
+#include "../algo/parallel.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Structure of arrays of hopp::vector3<T>: all the x, then all the y, then all the z
+	 *
+	 * Same values as a std::vector<hopp::vector3<T>> but each component is contiguous, the bulk operations are vectorized by the compiler (8 float per instruction with AVX, 16 with AVX-512) and split between the threads if OpenMP is enabled. @n
+	 * The bulk operations require two hopp::soa_vector3<T> with the same size.
+	 *
+	 * @code
+	   #include <hopp/container/soa_vector3.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::soa_vector3<float> position(10000000);
+	   hopp::soa_vector3<float> velocity(10000000, hopp::vector3<float>(1.f, 0.f, 0.f));
+	   position.add_scaled(velocity, 0.01f); // position += velocity * dt
+	   hopp::vector3<float> const p = position[42];
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class soa_vector3
+	{
+	public:
+		
+		/// Value type
+		using value_type = hopp::vector3<T>;
+		
+	private:
+		
+		/// X components
+		std::vector<T> m_x;
+		
+		/// Y components
+		std::vector<T> m_y;
+		
+		/// Z components
+		std::vector<T> m_z;
+		
+		/// @brief Call f(i) for i in [0, n), vectorized (and parallel if OpenMP is enabled)
+		/// @param[in] n Number of iterations
+		/// @param[in] f Function called with a size_t (the iterations must be independent)
+		template <class function_t>
+		static void loop(size_t const n, function_t f)
+		{
+			size_t const nb_chunk = hopp::parallel::nb_chunk(n);
+			
+			if (nb_chunk == 1)
+			{
+				for (size_t i = 0; i < n; ++i) { f(i); }
+				return;
+			}
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				size_t const last = n * (c + 1) / nb_chunk;
+				for (size_t i = n * c / nb_chunk; i < last; ++i) { f(i); }
+			}
+		}
+		
+		/// @brief Check the size of an other hopp::soa_vector3<T>
+		/// @param[in] b        A hopp::soa_vector3<T>
+		/// @param[in] function Name of the function (for the exception message)
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		void check_size(hopp::soa_vector3<T> const & b, char const * const function) const
+		{
+			#ifndef NDEBUG
+				if (b.size() != size()) { throw std::invalid_argument(std::string("hopp::soa_vector3<T>::") + function + ": the sizes are different"); }
+			#else
+				static_cast<void>(b);
+				static_cast<void>(function);
+			#endif
+		}
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] size  Number of hopp::vector3<T>
+		/// @param[in] value Initial value
+		explicit soa_vector3(size_t const size = 0, hopp::vector3<T> const & value = hopp::vector3<T>()) :
+			m_x(size, value.x), m_y(size, value.y), m_z(size, value.z)
+		{ }
+		
+		/// @brief Constructor from an array of structures
+		/// @param[in] values A std::vector<hopp::vector3<T>>
+		explicit soa_vector3(std::vector<hopp::vector3<T>> const & values) :
+			m_x(values.size()), m_y(values.size()), m_z(values.size())
+		{
+			for (size_t i = 0; i < values.size(); ++i) { set(i, values[i]); }
+		}
+		
+		/// @brief Return the number of hopp::vector3<T>
+		/// @return the number of hopp::vector3<T>
+		size_t size() const { return m_x.size(); }
+		
+		/// @brief Return true if there is no hopp::vector3<T>
+		/// @return true if there is no hopp::vector3<T>, false otherwise
+		bool empty() const { return m_x.empty(); }
+		
+		/// @brief Resize
+		/// @param[in] size  New number of hopp::vector3<T>
+		/// @param[in] value Value of the new hopp::vector3<T>
+		void resize(size_t const size, hopp::vector3<T> const & value = hopp::vector3<T>())
+		{
+			m_x.resize(size, value.x);
+			m_y.resize(size, value.y);
+			m_z.resize(size, value.z);
+		}
+		
+		/// @brief Reserve memory
+		/// @param[in] capacity Number of hopp::vector3<T>
+		void reserve(size_t const capacity)
+		{
+			m_x.reserve(capacity);
+			m_y.reserve(capacity);
+			m_z.reserve(capacity);
+		}
+		
+		/// @brief Remove all the hopp::vector3<T>
+		void clear()
+		{
+			m_x.clear();
+			m_y.clear();
+			m_z.clear();
+		}
+		
+		/// @brief Add a hopp::vector3<T> at the end
+		/// @param[in] value A hopp::vector3<T>
+		void push_back(hopp::vector3<T> const & value)
+		{
+			m_x.push_back(value.x);
+			m_y.push_back(value.y);
+			m_z.push_back(value.z);
+		}
+		
+		/// @brief Get the hopp::vector3<T> i (a copy)
+		/// @param[in] i Index
+		/// @return the hopp::vector3<T> i
+		hopp::vector3<T> operator [](size_t const i) const { return hopp::vector3<T>(m_x[i], m_y[i], m_z[i]); }
+		
+		/// @brief Get the hopp::vector3<T> i (a copy)
+		/// @param[in] i Index
+		/// @return the hopp::vector3<T> i
+		/// @exception std::out_of_range if i >= size()
+		hopp::vector3<T> at(size_t const i) const
+		{
+			if (i >= size()) { throw std::out_of_range("hopp::soa_vector3<T>::at(i): invalid index"); }
+			return (*this)[i];
+		}
+		
+		/// @brief Set the hopp::vector3<T> i
+		/// @param[in] i     Index
+		/// @param[in] value A hopp::vector3<T>
+		void set(size_t const i, hopp::vector3<T> const & value)
+		{
+			m_x[i] = value.x;
+			m_y[i] = value.y;
+			m_z[i] = value.z;
+		}
+		
+		/// @brief Get the X components
+		/// @return a pointer to the size() X components
+		T * x() { return m_x.data(); }
+		
+		/// @brief Get the X components
+		/// @return a pointer to the size() X components
+		T const * x() const { return m_x.data(); }
+		
+		/// @brief Get the Y components
+		/// @return a pointer to the size() Y components
+		T * y() { return m_y.data(); }
+		
+		/// @brief Get the Y components
+		/// @return a pointer to the size() Y components
+		T const * y() const { return m_y.data(); }
+		
+		/// @brief Get the Z components
+		/// @return a pointer to the size() Z components
+		T * z() { return m_z.data(); }
+		
+		/// @brief Get the Z components
+		/// @return a pointer to the size() Z components
+		T const * z() const { return m_z.data(); }
+		
+		/// @brief Convert into an array of structures
+		/// @return a std::vector<hopp::vector3<T>>
+		std::vector<hopp::vector3<T>> to_vector() const
+		{
+			std::vector<hopp::vector3<T>> r(size());
+			for (size_t i = 0; i < size(); ++i) { r[i] = (*this)[i]; }
+			return r;
+		}
+		
+		/// @brief Operator += (component-wise)
+		/// @param[in] b A hopp::soa_vector3<T> with the same size
+		/// @return the hopp::soa_vector3<T>
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		soa_vector3 & operator +=(hopp::soa_vector3<T> const & b)
+		{
+			return add_scaled(b, T(1));
+		}
+		
+		/// @brief Operator -= (component-wise)
+		/// @param[in] b A hopp::soa_vector3<T> with the same size
+		/// @return the hopp::soa_vector3<T>
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		soa_vector3 & operator -=(hopp::soa_vector3<T> const & b)
+		{
+			return add_scaled(b, T(-1));
+		}
+		
+		/// @brief Operator *= with a scalar
+		/// @param[in] s A scalar
+		/// @return the hopp::soa_vector3<T>
+		soa_vector3 & operator *=(T const & s)
+		{
+			T * const x = m_x.data();
+			T * const y = m_y.data();
+			T * const z = m_z.data();
+			loop(size(), [=](size_t const i) { x[i] *= s; y[i] *= s; z[i] *= s; });
+			return *this;
+		}
+		
+		/// @brief Add b * s (this += b * s, i.e. position += velocity * dt)
+		/// @param[in] b A hopp::soa_vector3<T> with the same size
+		/// @param[in] s A scalar
+		/// @return the hopp::soa_vector3<T>
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		soa_vector3 & add_scaled(hopp::soa_vector3<T> const & b, T const & s)
+		{
+			check_size(b, "add_scaled(b, s)");
+			T * const x = m_x.data();
+			T * const y = m_y.data();
+			T * const z = m_z.data();
+			T const * const bx = b.x();
+			T const * const by = b.y();
+			T const * const bz = b.z();
+			loop(size(), [=](size_t const i) { x[i] += bx[i] * s; y[i] += by[i] * s; z[i] += bz[i] * s; });
+			return *this;
+		}
+		
+		/// @brief Add the same hopp::vector3<T> to all the hopp::vector3<T> (i.e. velocity += gravity * dt)
+		/// @param[in] v A hopp::vector3<T>
+		/// @return the hopp::soa_vector3<T>
+		soa_vector3 & add(hopp::vector3<T> const & v)
+		{
+			T * const x = m_x.data();
+			T * const y = m_y.data();
+			T * const z = m_z.data();
+			loop(size(), [=](size_t const i) { x[i] += v.x; y[i] += v.y; z[i] += v.z; });
+			return *this;
+		}
+		
+		/// @brief Normalize all the hopp::vector3<T> (their lengths must not be 0)
+		/// @return the hopp::soa_vector3<T>
+		soa_vector3 & normalize()
+		{
+			T * const x = m_x.data();
+			T * const y = m_y.data();
+			T * const z = m_z.data();
+			loop
+			(
+				size(),
+				[=](size_t const i)
+				{
+					T const inverse_length = T(1) / T(std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]));
+					x[i] *= inverse_length;
+					y[i] *= inverse_length;
+					z[i] *= inverse_length;
+				}
+			);
+			return *this;
+		}
+		
+		/// @brief Compute the dot products a[i] · b[i]
+		/// @param[in]  b      A hopp::soa_vector3<T> with the same size
+		/// @param[out] result Pointer to the size() results
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		void dot(hopp::soa_vector3<T> const & b, T * const result) const
+		{
+			check_size(b, "dot(b, result)");
+			T const * const x = m_x.data();
+			T const * const y = m_y.data();
+			T const * const z = m_z.data();
+			T const * const bx = b.x();
+			T const * const by = b.y();
+			T const * const bz = b.z();
+			loop(size(), [=](size_t const i) { result[i] = x[i] * bx[i] + y[i] * by[i] + z[i] * bz[i]; });
+		}
+		
+		/// @brief Compute the cross products a[i] × b[i]
+		/// @param[in]  b      A hopp::soa_vector3<T> with the same size
+		/// @param[out] result A hopp::soa_vector3<T> (resized, must not be a or b)
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes are different
+		void cross(hopp::soa_vector3<T> const & b, hopp::soa_vector3<T> & result) const
+		{
+			check_size(b, "cross(b, result)");
+			result.resize(size());
+			T const * const x = m_x.data();
+			T const * const y = m_y.data();
+			T const * const z = m_z.data();
+			T const * const bx = b.x();
+			T const * const by = b.y();
+			T const * const bz = b.z();
+			T * const rx = result.x();
+			T * const ry = result.y();
+			T * const rz = result.z();
+			loop
+			(
+				size(),
+				[=](size_t const i)
+				{
+					rx[i] = y[i] * bz[i] - z[i] * by[i];
+					ry[i] = z[i] * bx[i] - x[i] * bz[i];
+					rz[i] = x[i] * by[i] - y[i] * bx[i];
+				}
+			);
+		}
+		
+		/// @brief Compute the lengths of all the hopp::vector3<T>
+		/// @param[out] result Pointer to the size() results
+		void length(T * const result) const
+		{
+			T const * const x = m_x.data();
+			T const * const y = m_y.data();
+			T const * const z = m_z.data();
+			loop(size(), [=](size_t const i) { result[i] = T(std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i])); });
+		}
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::soa_vector3<T>
+	/// @param[in,out] out         A std::ostream
+	/// @param[in]     soa_vector3 A hopp::soa_vector3<T>
+	/// @return out
+	/// @relates hopp::soa_vector3
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::soa_vector3<T> const & soa_vector3)
+	{
+		out << "{";
+		for (size_t i = 0; i < soa_vector3.size(); ++i) { out << ((i == 0) ? " " : ", ") << soa_vector3[i]; }
+		out << " }";
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::soa_vector3<T>
+	/// @param[in] a A hopp::soa_vector3<T>
+	/// @param[in] b A hopp::soa_vector3<T>
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::soa_vector3
+	template <class T>
+	bool operator ==(hopp::soa_vector3<T> const & a, hopp::soa_vector3<T> const & b)
+	{
+		return
+			a.size() == b.size() &&
+			std::equal(a.x(), a.x() + a.size(), b.x()) &&
+			std::equal(a.y(), a.y() + a.size(), b.y()) &&
+			std::equal(a.z(), a.z() + a.size(), b.z());
+	}
+	
+	/// @brief Operator != between two hopp::soa_vector3<T>
+	/// @param[in] a A hopp::soa_vector3<T>
+	/// @param[in] b A hopp::soa_vector3<T>
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::soa_vector3
+	template <class T>
+	bool operator !=(hopp::soa_vector3<T> const & a, hopp::soa_vector3<T> const & b)
+	{
+		return (a == b) == false;
+	}
+}
+
+#endif
@@ -0,0 +1,338 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_STORAGE2D_HPP
+#define HOPP_CONTAINER_STORAGE2D_HPP
+
+#include <iterator>
+#include <type_traits>
+
+#include "index.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Storage policies of a 2D container (where the value (i, j) is stored in a 1D array)
+	 *
+	 * A storage policy provides:
+	 * - static constexpr bool padded: true if the 1D array contains values which are not in the nb_row × nb_col table
+	 * - static size_t size(nb_row, nb_col): number of values of the 1D array
+	 * - static size_t index(i, j, nb_row, nb_col): index of the value (i, j) in the 1D array
+	 * - static bool position(k, nb_row, nb_col, i, j): get the (i, j) of the index k, return false if k is a padding value
+	 *
+	 * @code
+	   #include <hopp/container/storage2D.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	namespace storage2D
+	{
+		/// @brief Row-major storage: (i, j) is at i * nb_col + j, rows are contiguous
+		/// @ingroup hopp_container
+		struct row_major
+		{
+			/// No padding value
+			static constexpr bool padded = false;
+			
+			/// @brief Number of values
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_row × nb_col
+			static size_t size(size_t const nb_row, size_t const nb_col) { return nb_row * nb_col; }
+			
+			/// @brief Index of the value (i, j)
+			/// @param[in] i Row index
+			/// @param[in] j Column index
+			/// @return i * nb_col + j
+			static size_t index(size_t const i, size_t const j, size_t const /*nb_row*/, size_t const nb_col)
+			{
+				return hopp::index2D::to_index1D(i, j, nb_col);
+			}
+			
+			/// @brief Position of the index k
+			/// @param[in]  k      Index in the 1D array
+			/// @param[in]  nb_col Number of columns
+			/// @param[out] i      Row index
+			/// @param[out] j      Column index
+			/// @return true
+			static bool position(size_t const k, size_t const /*nb_row*/, size_t const nb_col, size_t & i, size_t & j)
+			{
+				i = k / nb_col;
+				j = k % nb_col;
+				return true;
+			}
+		};
+		
+		/// @brief Column-major storage: (i, j) is at j * nb_row + i, columns are contiguous
+		/// @ingroup hopp_container
+		struct col_major
+		{
+			/// No padding value
+			static constexpr bool padded = false;
+			
+			/// @brief Number of values
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_row × nb_col
+			static size_t size(size_t const nb_row, size_t const nb_col) { return nb_row * nb_col; }
+			
+			/// @brief Index of the value (i, j)
+			/// @param[in] i      Row index
+			/// @param[in] j      Column index
+			/// @param[in] nb_row Number of rows
+			/// @return j * nb_row + i
+			static size_t index(size_t const i, size_t const j, size_t const nb_row, size_t const /*nb_col*/)
+			{
+				return hopp::index2D::to_index1D(j, i, nb_row);
+			}
+			
+			/// @brief Position of the index k
+			/// @param[in]  k      Index in the 1D array
+			/// @param[in]  nb_row Number of rows
+			/// @param[out] i      Row index
+			/// @param[out] j      Column index
+			/// @return true
+			static bool position(size_t const k, size_t const nb_row, size_t const /*nb_col*/, size_t & i, size_t & j)
+			{
+				i = k % nb_row;
+				j = k / nb_row;
+				return true;
+			}
+		};
+		
+		/// @brief Spread the 16 lower bits of x on the even bits (0b1011 becomes 0b1000101)
+		/// @param[in] x An integer
+		/// @return x with a 0 bit inserted between each bit
+		/// @ingroup hopp_container
+		inline size_t spread_bits(size_t x)
+		{
+			x &= 0xFFFF;
+			x = (x | (x << 8)) & 0x00FF00FF;
+			x = (x | (x << 4)) & 0x0F0F0F0F;
+			x = (x | (x << 2)) & 0x33333333;
+			x = (x | (x << 1)) & 0x55555555;
+			return x;
+		}
+		
+		/// @brief Compact the even bits of x (inverse of hopp::storage2D::spread_bits)
+		/// @param[in] x An integer
+		/// @return the even bits of x
+		/// @ingroup hopp_container
+		inline size_t compact_bits(size_t x)
+		{
+			x &= 0x55555555;
+			x = (x | (x >> 1)) & 0x33333333;
+			x = (x | (x >> 2)) & 0x0F0F0F0F;
+			x = (x | (x >> 4)) & 0x00FF00FF;
+			x = (x | (x >> 8)) & 0x0000FFFF;
+			return x;
+		}
+		
+		/**
+		 * @brief Tiled storage: square tiles of tile_size × tile_size values, values of a tile are in Z-order (Morton order)
+		 *
+		 * Tiles are stored row by row, the last row and the last column of tiles are padded. @n
+		 * Close values (in any direction) are close in memory: neighborhood accesses (stencils) and column scans stay in cache.
+		 *
+		 * @tparam tile_size Size of a tile (a power of 2, 16 by default: 256 values)
+		 *
+		 * @ingroup hopp_container
+		 */
+		template <size_t tile_size = 16>
+		struct tiled
+		{
+			static_assert(tile_size != 0 && (tile_size & (tile_size - 1)) == 0, "hopp::storage2D::tiled<tile_size>: tile_size must be a power of 2");
+			static_assert(tile_size <= (size_t(1) << 16), "hopp::storage2D::tiled<tile_size>: tile_size is too big");
+			
+			/// Number of values in a tile
+			static constexpr size_t tile_area = tile_size * tile_size;
+			
+			/// The last tiles are padded
+			static constexpr bool padded = true;
+			
+			/// @brief Number of tiles to cover n values
+			/// @param[in] n Number of values
+			/// @return ceil(n / tile_size)
+			static size_t nb_tile(size_t const n) { return (n + tile_size - 1) / tile_size; }
+			
+			/// @brief Number of values
+			/// @param[in] nb_row Number of rows
+			/// @param[in] nb_col Number of columns
+			/// @return nb_row × nb_col rounded to full tiles
+			static size_t size(size_t const nb_row, size_t const nb_col) { return nb_tile(nb_row) * nb_tile(nb_col) * tile_area; }
+			
+			/// @brief Index of the value (i, j)
+			/// @param[in] i      Row index
+			/// @param[in] j      Column index
+			/// @param[in] nb_col Number of columns
+			/// @return the index of the value (i, j)
+			static size_t index(size_t const i, size_t const j, size_t const /*nb_row*/, size_t const nb_col)
+			{
+				size_t const tile = hopp::index2D::to_index1D(i / tile_size, j / tile_size, nb_tile(nb_col));
+				return tile * tile_area + ((spread_bits(i % tile_size) << 1) | spread_bits(j % tile_size));
+			}
+			
+			/// @brief Position of the index k
+			/// @param[in]  k      Index in the 1D array
+			/// @param[in]  nb_row Number of rows
+			/// @param[in]  nb_col Number of columns
+			/// @param[out] i      Row index
+			/// @param[out] j      Column index
+			/// @return true if (i, j) is in the nb_row × nb_col table, false if k is a padding value
+			static bool position(size_t const k, size_t const nb_row, size_t const nb_col, size_t & i, size_t & j)
+			{
+				size_t const tile = k / tile_area;
+				size_t const in_tile = k % tile_area;
+				i = (tile / nb_tile(nb_col)) * tile_size + compact_bits(in_tile >> 1);
+				j = (tile % nb_tile(nb_col)) * tile_size + compact_bits(in_tile);
+				return i < nb_row && j < nb_col;
+			}
+		};
+	}
+	
+	/**
+	 * @brief Forward iterator on the values of a 2D storage, in the storage order (the padding values are skipped)
+	 *
+	 * @code
+	   #include <hopp/container/storage2D.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class storage>
+	class storage2D_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = std::remove_const_t<T>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Reference type
+		using reference = T &;
+		
+	private:
+		
+		/// Data
+		T * m_data;
+		
+		/// Index of the current value
+		size_t m_k;
+		
+		/// Number of values (padding values included)
+		size_t m_size;
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+	public:
+		
+		/// @brief Default constructor
+		storage2D_iterator() : m_data(nullptr), m_k(0), m_size(0), m_nb_row(0), m_nb_col(0) { }
+		
+		/// @brief Constructor
+		/// @param[in] data   Data
+		/// @param[in] k      Index of the current value
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		storage2D_iterator(T * const data, size_t const k, size_t const nb_row, size_t const nb_col) :
+			m_data(data), m_k(k), m_size(storage::size(nb_row, nb_col)), m_nb_row(nb_row), m_nb_col(nb_col)
+		{
+			skip_padding();
+		}
+		
+		/// @brief Conversion from iterator to const iterator
+		/// @param[in] it A hopp::storage2D_iterator<value_type, storage>
+		template <class U, class = std::enable_if_t<std::is_same<U const, T>::value && std::is_const<T>::value>>
+		storage2D_iterator(hopp::storage2D_iterator<U, storage> const & it) :
+			m_data(it.data()), m_k(it.k()), m_size(storage::size(it.nb_row(), it.nb_col())), m_nb_row(it.nb_row()), m_nb_col(it.nb_col())
+		{ }
+		
+		/// @brief Get the data
+		/// @return the data
+		T * data() const { return m_data; }
+		
+		/// @brief Get the index of the current value in the storage
+		/// @return the index of the current value in the storage
+		size_t k() const { return m_k; }
+		
+		/// @brief Get the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Get the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Get the row index of the current value
+		/// @return the row index of the current value
+		size_t i() const { size_t i, j; storage::position(m_k, m_nb_row, m_nb_col, i, j); return i; }
+		
+		/// @brief Get the column index of the current value
+		/// @return the column index of the current value
+		size_t j() const { size_t i, j; storage::position(m_k, m_nb_row, m_nb_col, i, j); return j; }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		T & operator *() const { return m_data[m_k]; }
+		
+		/// @brief Get the current value
+		/// @return a pointer to the current value
+		T * operator ->() const { return m_data + m_k; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::storage2D_iterator<T, storage> & operator ++() { ++m_k; skip_padding(); return *this; }
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::storage2D_iterator<T, storage> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::storage2D_iterator<T, storage> const & it) const { return m_data + m_k == it.m_data + it.m_k; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::storage2D_iterator<T, storage> const & it) const { return (*this == it) == false; }
+		
+	private:
+		
+		/// @brief Advance to the next value which is not a padding value
+		void skip_padding()
+		{
+			if (storage::padded == false) { return; }
+			size_t i, j;
+			while (m_k < m_size && storage::position(m_k, m_nb_row, m_nb_col, i, j) == false) { ++m_k; }
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,484 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_STRIDED_VIEW_HPP
+#define HOPP_CONTAINER_STRIDED_VIEW_HPP
+
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+
+
+namespace hopp
+{
+	/**
+	 * @brief Random access iterator on values separated by a stride
+	 *
+	 * @code
+	   #include <hopp/container/strided_view.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class strided_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::random_access_iterator_tag;
+		
+		/// Value type
+		using value_type = std::remove_const_t<T>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Reference type
+		using reference = T &;
+		
+	private:
+		
+		/// Pointer to the first value of the view
+		T * m_data;
+		
+		/// Index of the current value (the end iterator does not point past the last value, data + size × stride can overflow)
+		ptrdiff_t m_i;
+		
+		/// Stride (in number of values)
+		ptrdiff_t m_stride;
+		
+	public:
+		
+		/// @brief Default constructor
+		strided_iterator() : m_data(nullptr), m_i(0), m_stride(1) { }
+		
+		/// @brief Constructor
+		/// @param[in] data   Pointer to the first value of the view
+		/// @param[in] i      Index of the current value
+		/// @param[in] stride Stride (in number of values)
+		strided_iterator(T * const data, ptrdiff_t const i, ptrdiff_t const stride) : m_data(data), m_i(i), m_stride(stride) { }
+		
+		/// @brief Conversion from iterator to const iterator
+		/// @param[in] it A hopp::strided_iterator<value_type>
+		template <class U, class = std::enable_if_t<std::is_same<U const, T>::value && std::is_const<T>::value>>
+		strided_iterator(hopp::strided_iterator<U> const & it) : m_data(it.data()), m_i(it.index()), m_stride(it.stride()) { }
+		
+		/// @brief Get the pointer to the first value of the view
+		/// @return the pointer to the first value of the view
+		T * data() const { return m_data; }
+		
+		/// @brief Get the index of the current value
+		/// @return the index of the current value
+		ptrdiff_t index() const { return m_i; }
+		
+		/// @brief Get the stride
+		/// @return the stride
+		ptrdiff_t stride() const { return m_stride; }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		T & operator *() const { return m_data[m_i * m_stride]; }
+		
+		/// @brief Access to the members of the current value
+		/// @return the pointer to the current value
+		T * operator ->() const { return m_data + m_i * m_stride; }
+		
+		/// @brief Get the value at n
+		/// @param[in] n Offset
+		/// @return the value at n
+		T & operator [](ptrdiff_t const n) const { return m_data[(m_i + n) * m_stride]; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::strided_iterator<T> & operator ++() { ++m_i; return *this; }
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::strided_iterator<T> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Pre-decrement
+		/// @return the iterator
+		hopp::strided_iterator<T> & operator --() { --m_i; return *this; }
+		
+		/// @brief Post-decrement
+		/// @return the iterator before the decrement
+		hopp::strided_iterator<T> operator --(int) { auto tmp = *this; --(*this); return tmp; }
+		
+		/// @brief Advance the iterator
+		/// @param[in] n Offset
+		/// @return the iterator
+		hopp::strided_iterator<T> & operator +=(ptrdiff_t const n) { m_i += n; return *this; }
+		
+		/// @brief Advance the iterator backward
+		/// @param[in] n Offset
+		/// @return the iterator
+		hopp::strided_iterator<T> & operator -=(ptrdiff_t const n) { m_i -= n; return *this; }
+		
+		/// @brief Get an advanced iterator
+		/// @param[in] n Offset
+		/// @return the advanced iterator
+		hopp::strided_iterator<T> operator +(ptrdiff_t const n) const { return hopp::strided_iterator<T>(m_data, m_i + n, m_stride); }
+		
+		/// @brief Get an iterator advanced backward
+		/// @param[in] n Offset
+		/// @return the iterator advanced backward
+		hopp::strided_iterator<T> operator -(ptrdiff_t const n) const { return hopp::strided_iterator<T>(m_data, m_i - n, m_stride); }
+		
+		/// @brief Distance between two iterators (of the same view)
+		/// @param[in] it An iterator
+		/// @return the distance between the two iterators
+		ptrdiff_t operator -(hopp::strided_iterator<T> const & it) const { return m_i - it.m_i; }
+		
+		/// @brief Operator == (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::strided_iterator<T> const & it) const { return m_i == it.m_i; }
+		
+		/// @brief Operator != (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::strided_iterator<T> const & it) const { return m_i != it.m_i; }
+		
+		/// @brief Operator < (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if this iterator is before it, false otherwise
+		bool operator <(hopp::strided_iterator<T> const & it) const { return m_i < it.m_i; }
+		
+		/// @brief Operator > (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if this iterator is after it, false otherwise
+		bool operator >(hopp::strided_iterator<T> const & it) const { return m_i > it.m_i; }
+		
+		/// @brief Operator <= (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if this iterator is before or equal to it, false otherwise
+		bool operator <=(hopp::strided_iterator<T> const & it) const { return m_i <= it.m_i; }
+		
+		/// @brief Operator >= (iterators of the same view)
+		/// @param[in] it An iterator
+		/// @return true if this iterator is after or equal to it, false otherwise
+		bool operator >=(hopp::strided_iterator<T> const & it) const { return m_i >= it.m_i; }
+	};
+	
+	/// @brief Get an advanced iterator
+	/// @param[in] n  Offset
+	/// @param[in] it An iterator
+	/// @return the advanced iterator
+	/// @relates hopp::strided_iterator
+	template <class T>
+	hopp::strided_iterator<T> operator +(ptrdiff_t const n, hopp::strided_iterator<T> const & it)
+	{
+		return it + n;
+	}
+	
+	/**
+	 * @brief View on values separated by a stride (in number of values)
+	 *
+	 * Unlike hopp::vector_view, the view stores a pointer to the first value, there is no indirection through the container. @n
+	 * When the view is contiguous (stride is 1), data() can be given to algorithms which work on pointers.
+	 *
+	 * @code
+	   #include <hopp/container/strided_view.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   std::vector<int> v = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	   auto even = hopp::make_strided_view(v, 0, v.size(), 2);
+	   std::cout << even << std::endl; // { 0, 2, 4, 6, 8 }
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class strided_view
+	{
+	public:
+		
+		/// Value type
+		using value_type = std::remove_const_t<T>;
+		
+		/// Const reference type
+		using const_reference = T const &;
+		
+		/// Reference type
+		using reference = T &;
+		
+		/// Const pointer type
+		using const_pointer = T const *;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Const iterator type
+		using const_iterator = hopp::strided_iterator<T const>;
+		
+		/// Iterator type
+		using iterator = hopp::strided_iterator<T>;
+		
+		/// Const reverse iterator type
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		
+		/// Reverse iterator type
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Size type
+		using size_type = size_t;
+		
+	private:
+		
+		/// Pointer to the first value
+		T * m_data;
+		
+		/// Number of values
+		size_t m_size;
+		
+		/// Stride (in number of values)
+		ptrdiff_t m_stride;
+		
+	public:
+		
+		/// @brief Default constructor
+		strided_view() : m_data(nullptr), m_size(0), m_stride(1) { }
+		
+		/// @brief Constructor
+		/// @param[in] data   Pointer to the first value
+		/// @param[in] size   Number of values
+		/// @param[in] stride Stride (in number of values, 1 by default)
+		strided_view(T * const data, size_t const size, ptrdiff_t const stride = 1) :
+			m_data(data), m_size(size), m_stride(stride)
+		{ }
+		
+		/// @brief Conversion to a const view
+		/// @return the const view
+		operator hopp::strided_view<T const>() const { return hopp::strided_view<T const>(m_data, m_size, m_stride); }
+		
+		// Size, Stride & Data
+		
+		/// @brief Return the number of values
+		/// @return the number of values
+		size_t size() const { return m_size; }
+		
+		/// @brief Return true if the view is empty
+		/// @return true if the view is empty, false otherwise
+		bool empty() const { return m_size == 0; }
+		
+		/// @brief Return the stride
+		/// @return the stride
+		ptrdiff_t stride() const { return m_stride; }
+		
+		/// @brief Return true if the values are contiguous
+		/// @return true if the values are contiguous, false otherwise
+		bool is_contiguous() const { return m_stride == 1 || m_size <= 1; }
+		
+		/// @brief Get data (pointer to the first value)
+		/// @return data
+		/// @note [data(), data() + size()) are the values only if is_contiguous()
+		T const * data() const { return m_data; }
+		
+		/// @brief Get data (pointer to the first value)
+		/// @return data
+		/// @note [data(), data() + size()) are the values only if is_contiguous()
+		T * data() { return m_data; }
+		
+		// Access: operator [i]
+		
+		/// @brief Const value access
+		/// @param i Index
+		/// @return value at i
+		T const & operator [](size_t const i) const { return m_data[ptrdiff_t(i) * m_stride]; }
+		
+		/// @brief Value access
+		/// @param i Index
+		/// @return value at i
+		T & operator [](size_t const i) { return m_data[ptrdiff_t(i) * m_stride]; }
+		
+		// Access: .at(i)
+		
+		/// @brief Const safe value access
+		/// @param i Index
+		/// @return value at i
+		/// @exception std::out_of_range if i >= number of values
+		T const & at(size_t const i) const
+		{
+			if (i >= size()) { throw std::out_of_range("hopp::strided_view<T>::at(i): invalid i index"); }
+			return (*this)[i];
+		}
+		
+		/// @brief Safe value access
+		/// @param i Index
+		/// @return value at i
+		/// @exception std::out_of_range if i >= number of values
+		T & at(size_t const i)
+		{
+			if (i >= size()) { throw std::out_of_range("hopp::strided_view<T>::at(i): invalid i index"); }
+			return (*this)[i];
+		}
+		
+		// front, back
+		
+		/// @brief Get first value
+		/// @pre Number of values is not zero
+		/// @return first value
+		T const & front() const { return (*this)[0]; }
+		
+		/// @brief Get first value
+		/// @pre Number of values is not zero
+		/// @return first value
+		T & front() { return (*this)[0]; }
+		
+		/// @brief Get last value
+		/// @pre Number of values is not zero
+		/// @return last value
+		T const & back() const { return (*this)[size() - 1]; }
+		
+		/// @brief Get last value
+		/// @pre Number of values is not zero
+		/// @return last value
+		T & back() { return (*this)[size() - 1]; }
+		
+		// Iterator
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return const_iterator(m_data, 0, m_stride); }
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator cbegin() const { return const_iterator(m_data, 0, m_stride); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return iterator(m_data, 0, m_stride); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return const_iterator(m_data, ptrdiff_t(m_size), m_stride); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator cend() const { return const_iterator(m_data, ptrdiff_t(m_size), m_stride); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return iterator(m_data, ptrdiff_t(m_size), m_stride); }
+		
+		// Reverse iterator
+		
+		/// @brief Get const reverse iterator to reverse beginning
+		/// @return const reverse iterator to reverse beginning
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		
+		/// @brief Get const reverse iterator to reverse beginning
+		/// @return const reverse iterator to reverse beginning
+		const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+		
+		/// @brief Get reverse iterator to reverse beginning
+		/// @return reverse iterator to reverse beginning
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		
+		/// @brief Get const reverse iterator to reverse end
+		/// @return const reverse iterator to reverse end
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+		
+		/// @brief Get const reverse iterator to reverse end
+		/// @return const reverse iterator to reverse end
+		const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+		
+		/// @brief Get reverse iterator to reverse end
+		/// @return reverse iterator to reverse end
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::strided_view<T>
+	/// @param[in,out] out          A std::ostream
+	/// @param[in]     strided_view A hopp::strided_view<T>
+	/// @return out
+	/// @relates hopp::strided_view
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::strided_view<T> const & strided_view)
+	{
+		out << "{";
+		for (size_t i = 0; i < strided_view.size(); ++i)
+		{
+			if (i == 0) { out << " "; }
+			else { out << ", "; }
+			
+			out << strided_view[i];
+		}
+		out << " }";
+		
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::strided_view<T> (compare values)
+	/// @param[in] a A hopp::strided_view<T>
+	/// @param[in] b A hopp::strided_view<T>
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::strided_view
+	template <class T>
+	bool operator ==(hopp::strided_view<T> const & a, hopp::strided_view<T> const & b)
+	{
+		if (a.size() != b.size()) { return false; }
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			if ((a[i] == b[i]) == false) { return false; }
+		}
+		return true;
+	}
+	
+	/// @brief Operator != between two hopp::strided_view<T> (compare values)
+	/// @param[in] a A hopp::strided_view<T>
+	/// @param[in] b A hopp::strided_view<T>
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::strided_view
+	template <class T>
+	bool operator !=(hopp::strided_view<T> const & a, hopp::strided_view<T> const & b)
+	{
+		return (a == b) == false;
+	}
+	
+	/// @brief Create a hopp::strided_view<T> on a contiguous container (std::vector, hopp::vector_view, ...)
+	/// @param[in] container A contiguous container with data()
+	/// @param[in] i_begin   Index of the beginning
+	/// @param[in] i_end     Index of the end (not included)
+	/// @param[in] stride    Stride (1 by default)
+	/// @return the hopp::strided_view<T> on container[i_begin], container[i_begin + stride], ... (before i_end)
+	/// @exception std::invalid_argument if NDEBUG is not defined and if stride is 0
+	/// @relates hopp::strided_view
+	template <class container_t>
+	auto make_strided_view(container_t & container, size_t const i_begin, size_t const i_end, size_t const stride = 1)
+	-> hopp::strided_view<std::remove_pointer_t<decltype(container.data())>>
+	{
+		#ifndef NDEBUG
+			if (stride == 0) { throw std::invalid_argument("hopp::make_strided_view(container, i_begin, i_end, stride): stride is 0"); }
+		#endif
+		
+		using T = std::remove_pointer_t<decltype(container.data())>;
+		size_t const size = (i_end > i_begin) ? (i_end - i_begin + stride - 1) / stride : 0;
+		return hopp::strided_view<T>(container.data() + i_begin, size, ptrdiff_t(stride));
+	}
+}
+
+#endif
@@ -18,21 +18,21 @@
 
 #include <iostream>
 #include <vector>
-
-#include "vector_view.hpp"
-#include "../type/is_iterator.hpp"
+#include <deque>
+#include <iterator>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
 
 
 namespace hopp
 {
-	// Forward
-	template <class T>
-	class tree;
-	
 	// Node
 	
 	/**
-	 * @brief Node for tree
+	 * @brief Node of a hopp::tree
+	 *
+	 * The nodes of a hopp::tree are stored in a flat array, the links between the nodes are indices in this array (hopp::tree<T>::null_node if there is no such node)
 	 *
 	 * @code
 	   #include <hopp/container/tree.hpp>
@@ -43,41 +43,22 @@ namespace hopp
 	template <class T>
 	class node
 	{
-	private:
-		
-		/// Data
-		T m_data;
-		
-		/// Children
-		hopp::tree<T> m_children;
-		
-		/// Father
-		hopp::view_ptr<hopp::node<T>> m_father;
-		
 	public:
 		
-		/// @brief Constructor
-		node(T const & data = T()) :
-			m_data(data),
-			m_children(),
-			m_father(nullptr)
-		{ }
+		/// Value
+		T value;
 		
-		/// @brief Get children
-		/// @return children
-		hopp::tree<T> const & children() const { return m_children; }
+		/// Parent
+		size_t parent;
 		
-		/// @brief Get children
-		/// @return children
-		hopp::tree<T> & children() { return m_children; }
+		/// First child
+		size_t first_child;
 		
-		/// @brief Get father
-		/// @return father
-		hopp::node<T> const & father() const { return *m_father; }
+		/// Last child
+		size_t last_child;
 		
-		/// @brief Get father
-		/// @return father
-		hopp::node<T> & father() { return *m_father; }
+		/// Next sibling
+		size_t next_sibling;
 	};
 	
 	/// @brief Operator << between a std::ostream and a hopp::node<T>
@@ -88,20 +69,24 @@ namespace hopp
 	template <class T>
 	std::ostream & operator <<(std::ostream & out, hopp::node<T> const & node)
 	{
-		// TODO
+		out << node.value;
 		return out;
 	}
 	
 	/// @brief Operator == between two hopp::node<T>
 	/// @param[in] a A hopp::node<T>
 	/// @param[in] b A hopp::node<T>
-	/// @return true if a == b, false otherwise
+	/// @return true if a == b (same value and same links), false otherwise
 	/// @relates hopp::node
 	template <class T>
 	bool operator ==(hopp::node<T> const & a, hopp::node<T> const & b)
 	{
-		// TODO
-		return false;
+		return
+			a.value == b.value &&
+			a.parent == b.parent &&
+			a.first_child == b.first_child &&
+			a.last_child == b.last_child &&
+			a.next_sibling == b.next_sibling;
 	}
 	
 	/// @brief Operator != between two hopp::node<T>
@@ -112,14 +97,418 @@ namespace hopp
 	template <class T>
 	bool operator !=(hopp::node<T> const & a, hopp::node<T> const & b)
 	{
-		// TODO
-		return false;
+		return (a == b) == false;
 	}
 	
+	// Iterators
+	
+	/**
+	 * @brief Pre-order iterator of a hopp::tree (a node is visited before its children)
+	 *
+	 * The traversal uses the links of the nodes only (no stack)
+	 *
+	 * @code
+	   #include <hopp/container/tree.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class tree_t>
+	class tree_preorder_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = typename std::remove_const_t<tree_t>::value_type;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = std::conditional_t<std::is_const<tree_t>::value, value_type const *, value_type *>;
+		
+		/// Reference type
+		using reference = std::conditional_t<std::is_const<tree_t>::value, value_type const &, value_type &>;
+		
+	private:
+		
+		/// Tree
+		tree_t * m_tree;
+		
+		/// Root of the traversal
+		size_t m_root;
+		
+		/// Current node (tree_t::null_node at the end)
+		size_t m_node;
+		
+	public:
+		
+		/// @brief Default constructor
+		tree_preorder_iterator() : m_tree(nullptr), m_root(tree_t::null_node), m_node(tree_t::null_node) { }
+		
+		/// @brief Constructor
+		/// @param[in] tree Tree
+		/// @param[in] root Root of the traversal (tree_t::null_node for the end)
+		tree_preorder_iterator(tree_t & tree, size_t const root) : m_tree(&tree), m_root(root), m_node(root) { }
+		
+		/// @brief Get the index of the current node
+		/// @return the index of the current node
+		size_t index() const { return m_node; }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		reference operator *() const { return (*m_tree)[m_node]; }
+		
+		/// @brief Get the current value
+		/// @return a pointer to the current value
+		pointer operator ->() const { return &(*m_tree)[m_node]; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::tree_preorder_iterator<tree_t> & operator ++()
+		{
+			size_t const child = m_tree->first_child(m_node);
+			if (child != tree_t::null_node) { m_node = child; return *this; }
+			while (m_node != m_root && m_tree->next_sibling(m_node) == tree_t::null_node) { m_node = m_tree->parent(m_node); }
+			m_node = (m_node == m_root) ? tree_t::null_node : m_tree->next_sibling(m_node);
+			return *this;
+		}
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::tree_preorder_iterator<tree_t> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::tree_preorder_iterator<tree_t> const & it) const { return m_node == it.m_node; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::tree_preorder_iterator<tree_t> const & it) const { return (*this == it) == false; }
+	};
+	
+	/**
+	 * @brief Post-order iterator of a hopp::tree (a node is visited after its children)
+	 *
+	 * The traversal uses the links of the nodes only (no stack)
+	 *
+	 * @code
+	   #include <hopp/container/tree.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class tree_t>
+	class tree_postorder_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = typename std::remove_const_t<tree_t>::value_type;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = std::conditional_t<std::is_const<tree_t>::value, value_type const *, value_type *>;
+		
+		/// Reference type
+		using reference = std::conditional_t<std::is_const<tree_t>::value, value_type const &, value_type &>;
+		
+	private:
+		
+		/// Tree
+		tree_t * m_tree;
+		
+		/// Root of the traversal
+		size_t m_root;
+		
+		/// Current node (tree_t::null_node at the end)
+		size_t m_node;
+		
+	public:
+		
+		/// @brief Default constructor
+		tree_postorder_iterator() : m_tree(nullptr), m_root(tree_t::null_node), m_node(tree_t::null_node) { }
+		
+		/// @brief Constructor
+		/// @param[in] tree Tree
+		/// @param[in] root Root of the traversal (tree_t::null_node for the end)
+		tree_postorder_iterator(tree_t & tree, size_t const root) :
+			m_tree(&tree), m_root(root), m_node((root == tree_t::null_node) ? root : first_leaf(root))
+		{ }
+		
+		/// @brief Get the index of the current node
+		/// @return the index of the current node
+		size_t index() const { return m_node; }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		reference operator *() const { return (*m_tree)[m_node]; }
+		
+		/// @brief Get the current value
+		/// @return a pointer to the current value
+		pointer operator ->() const { return &(*m_tree)[m_node]; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::tree_postorder_iterator<tree_t> & operator ++()
+		{
+			if (m_node == m_root) { m_node = tree_t::null_node; }
+			else if (m_tree->next_sibling(m_node) != tree_t::null_node) { m_node = first_leaf(m_tree->next_sibling(m_node)); }
+			else { m_node = m_tree->parent(m_node); }
+			return *this;
+		}
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::tree_postorder_iterator<tree_t> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::tree_postorder_iterator<tree_t> const & it) const { return m_node == it.m_node; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::tree_postorder_iterator<tree_t> const & it) const { return (*this == it) == false; }
+		
+	private:
+		
+		/// @brief Get the first node of a subtree in post-order
+		/// @param[in] node A node
+		/// @return the first leaf reached following the first children from node
+		size_t first_leaf(size_t node) const
+		{
+			while (m_tree->first_child(node) != tree_t::null_node) { node = m_tree->first_child(node); }
+			return node;
+		}
+	};
+	
+	/**
+	 * @brief Breadth-first iterator of a hopp::tree (level by level)
+	 *
+	 * The iterator owns the queue of the nodes to visit, copy it with care
+	 *
+	 * @code
+	   #include <hopp/container/tree.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class tree_t>
+	class tree_breadth_first_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = typename std::remove_const_t<tree_t>::value_type;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = std::conditional_t<std::is_const<tree_t>::value, value_type const *, value_type *>;
+		
+		/// Reference type
+		using reference = std::conditional_t<std::is_const<tree_t>::value, value_type const &, value_type &>;
+		
+	private:
+		
+		/// Tree
+		tree_t * m_tree;
+		
+		/// Nodes to visit (the front is the current node)
+		std::deque<size_t> m_queue;
+		
+	public:
+		
+		/// @brief Default constructor
+		tree_breadth_first_iterator() : m_tree(nullptr), m_queue() { }
+		
+		/// @brief Constructor
+		/// @param[in] tree Tree
+		/// @param[in] root Root of the traversal (tree_t::null_node for the end)
+		tree_breadth_first_iterator(tree_t & tree, size_t const root) : m_tree(&tree), m_queue()
+		{
+			if (root != tree_t::null_node) { m_queue.push_back(root); }
+		}
+		
+		/// @brief Get the index of the current node
+		/// @return the index of the current node
+		size_t index() const { return m_queue.empty() ? tree_t::null_node : m_queue.front(); }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		reference operator *() const { return (*m_tree)[m_queue.front()]; }
+		
+		/// @brief Get the current value
+		/// @return a pointer to the current value
+		pointer operator ->() const { return &(*m_tree)[m_queue.front()]; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::tree_breadth_first_iterator<tree_t> & operator ++()
+		{
+			for (size_t child = m_tree->first_child(m_queue.front()); child != tree_t::null_node; child = m_tree->next_sibling(child))
+			{
+				m_queue.push_back(child);
+			}
+			m_queue.pop_front();
+			return *this;
+		}
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::tree_breadth_first_iterator<tree_t> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::tree_breadth_first_iterator<tree_t> const & it) const { return index() == it.index(); }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::tree_breadth_first_iterator<tree_t> const & it) const { return (*this == it) == false; }
+	};
+	
+	/**
+	 * @brief Iterator on the children of a node of a hopp::tree
+	 *
+	 * @code
+	   #include <hopp/container/tree.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class tree_t>
+	class tree_children_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::forward_iterator_tag;
+		
+		/// Value type
+		using value_type = typename std::remove_const_t<tree_t>::value_type;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = std::conditional_t<std::is_const<tree_t>::value, value_type const *, value_type *>;
+		
+		/// Reference type
+		using reference = std::conditional_t<std::is_const<tree_t>::value, value_type const &, value_type &>;
+		
+	private:
+		
+		/// Tree
+		tree_t * m_tree;
+		
+		/// Current node (tree_t::null_node at the end)
+		size_t m_node;
+		
+	public:
+		
+		/// @brief Default constructor
+		tree_children_iterator() : m_tree(nullptr), m_node(tree_t::null_node) { }
+		
+		/// @brief Constructor
+		/// @param[in] tree Tree
+		/// @param[in] node First child to visit (tree_t::null_node for the end)
+		tree_children_iterator(tree_t & tree, size_t const node) : m_tree(&tree), m_node(node) { }
+		
+		/// @brief Get the index of the current node
+		/// @return the index of the current node
+		size_t index() const { return m_node; }
+		
+		/// @brief Get the current value
+		/// @return the current value
+		reference operator *() const { return (*m_tree)[m_node]; }
+		
+		/// @brief Get the current value
+		/// @return a pointer to the current value
+		pointer operator ->() const { return &(*m_tree)[m_node]; }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::tree_children_iterator<tree_t> & operator ++() { m_node = m_tree->next_sibling(m_node); return *this; }
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::tree_children_iterator<tree_t> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::tree_children_iterator<tree_t> const & it) const { return m_node == it.m_node; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::tree_children_iterator<tree_t> const & it) const { return (*this == it) == false; }
+	};
+	
+	/**
+	 * @brief Range [begin, end) of a traversal of a hopp::tree (for range-based for loops)
+	 *
+	 * @code
+	   #include <hopp/container/tree.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class iterator_t>
+	class tree_range
+	{
+	private:
+		
+		/// Begin
+		iterator_t m_begin;
+		
+		/// End
+		iterator_t m_end;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] begin Begin
+		/// @param[in] end   End
+		tree_range(iterator_t const & begin, iterator_t const & end) : m_begin(begin), m_end(end) { }
+		
+		/// @brief Get the begin
+		/// @return the begin
+		iterator_t begin() const { return m_begin; }
+		
+		/// @brief Get the end
+		/// @return the end
+		iterator_t end() const { return m_end; }
+	};
+	
 	// Tree
 	
 	/**
-	 * @brief Node for tree
+	 * @brief Tree whose nodes are stored in a single flat array
+	 *
+	 * Each node knows its parent, its first child, its last child and its next sibling (hopp::node), so the parent access is O(1) and the traversals (pre-order, post-order, breadth-first, children) do not allocate (except the breadth-first queue).
+	 *
+	 * A node is identified by its index in the array. Indices stay valid until the node is erased or hopp::tree::compact is called; indices of erased nodes are reused.
+	 *
+	 * The subtree sizes are cached: they are computed in O(n) at the first call to hopp::tree::subtree_size after a modification, then each call is O(1).
 	 *
 	 * @code
 	   #include <hopp/container/tree.hpp>
@@ -147,17 +536,11 @@ namespace hopp
 		/// Pointer type
 		using pointer = T *;
 		
-		/// Const iterator type
-		//using const_iterator = TODO
-		
-		/// Iterator type
-		//using iterator = TODO
-		
-		/// Const reverse iterator type
-		//using const_reverse_iterator = TODO
+		/// Const iterator type (pre-order)
+		using const_iterator = hopp::tree_preorder_iterator<hopp::tree<T> const>;
 		
-		/// Reverse iterator type
-		//using reverse_iterator = TODO
+		/// Iterator type (pre-order)
+		using iterator = hopp::tree_preorder_iterator<hopp::tree<T>>;
 		
 		/// Difference type
 		using difference_type = ptrdiff_t;
@@ -165,35 +548,424 @@ namespace hopp
 		/// Size type
 		using size_type = size_t;
 		
+		/// Index of no node
+		static constexpr size_t null_node = size_t(-1);
+		
 	private:
 		
-		/// Nodes
-		std::vector<hopp::node<T>> nodes;
+		/// Nodes (an erased node is its own parent)
+		std::vector<hopp::node<T>> m_nodes;
+		
+		/// Root
+		size_t m_root;
+		
+		/// Number of nodes
+		size_t m_size;
+		
+		/// Erased nodes
+		std::vector<size_t> m_free_nodes;
+		
+		/// Subtree sizes (valid if m_subtree_sizes_ok)
+		mutable std::vector<size_t> m_subtree_sizes;
+		
+		/// Are the subtree sizes up to date?
+		mutable bool m_subtree_sizes_ok;
+		
+		/// Number of structural modifications
+		size_t m_version;
 		
 	public:
 		
-		/// @brief Default constructor
-		tree() : nodes()
+		/// @brief Default constructor (empty tree)
+		tree() : m_nodes(), m_root(null_node), m_size(0), m_free_nodes(), m_subtree_sizes(), m_subtree_sizes_ok(false), m_version(0)
 		{ }
 		
-		/// @brief Constructor
-		/// @param[in] size          Size (0 by default)
-		/// @param[in] default_value Default value (T() by default)
-		tree(size_t const size, T const & default_value = T()) :
-			nodes(size, default_value)
-		{ }
+		/// @brief Constructor with a root
+		/// @param[in] root_value Value of the root
+		explicit tree(T const & root_value) : tree()
+		{
+			add_root(root_value);
+		}
+		
+		// Size
+		
+		/// @brief Get the number of nodes
+		/// @return the number of nodes
+		size_t size() const { return m_size; }
+		
+		/// @brief Test if the tree is empty
+		/// @return true if the tree is empty, false otherwise
+		bool empty() const { return m_size == 0; }
 		
-		/// @brief Constructor from iterators
-		/// @param[in] first Iterator to the first element
-		/// @param[in] last  Iterator to the last element (not included)
-		template <class input_iterator_t>
-		tree(input_iterator_t const & first, input_iterator_t const & last) :
-			nodes(first, last)
+		/// @brief Reserve memory for nodes
+		/// @param[in] size Number of nodes
+		void reserve(size_t const size) { m_nodes.reserve(size); }
+		
+		/// @brief Remove all nodes
+		void clear()
 		{
-			static_assert(hopp::is_iterator<input_iterator_t>::value, "hopp::tree<T>::tree:  error: input_iterator_t is not an iterator");
+			m_nodes.clear();
+			m_root = null_node;
+			m_size = 0;
+			m_free_nodes.clear();
+			m_subtree_sizes_ok = false;
+			++m_version;
+		}
+		
+		// Nodes
+		
+		/// @brief Get the number of structural modifications (to detect that a structure built over the tree is outdated)
+		/// @return the number of structural modifications
+		size_t version() const { return m_version; }
+		
+		/// @brief Get the root
+		/// @return the root (hopp::tree::null_node if the tree is empty)
+		size_t root() const { return m_root; }
+		
+		/// @brief Get the flat array of nodes (erased nodes included)
+		/// @return the flat array of nodes
+		std::vector<hopp::node<T>> const & nodes() const { return m_nodes; }
+		
+		/// @brief Test if a node exists
+		/// @param[in] node A node
+		/// @return true if the node exists, false otherwise
+		bool contains(size_t const node) const { return node < m_nodes.size() && m_nodes[node].parent != node; }
+		
+		/// @brief Get the value of a node
+		/// @param[in] node A node
+		/// @return the value of the node
+		T const & operator [](size_t const node) const { return m_nodes[node].value; }
+		
+		/// @brief Get the value of a node
+		/// @param[in] node A node
+		/// @return the value of the node
+		T & operator [](size_t const node) { return m_nodes[node].value; }
+		
+		/// @brief Get the value of a node with bounds checking
+		/// @param[in] node A node
+		/// @return the value of the node
+		/// @exception std::out_of_range if the node does not exist
+		T const & at(size_t const node) const { check_node(node, "at"); return m_nodes[node].value; }
+		
+		/// @brief Get the value of a node with bounds checking
+		/// @param[in] node A node
+		/// @return the value of the node
+		/// @exception std::out_of_range if the node does not exist
+		T & at(size_t const node) { check_node(node, "at"); return m_nodes[node].value; }
+		
+		/// @brief Get the parent of a node in O(1)
+		/// @param[in] node A node
+		/// @return the parent of the node (hopp::tree::null_node for the root)
+		size_t parent(size_t const node) const { return m_nodes[node].parent; }
+		
+		/// @brief Get the first child of a node
+		/// @param[in] node A node
+		/// @return the first child of the node (hopp::tree::null_node for a leaf)
+		size_t first_child(size_t const node) const { return m_nodes[node].first_child; }
+		
+		/// @brief Get the last child of a node
+		/// @param[in] node A node
+		/// @return the last child of the node (hopp::tree::null_node for a leaf)
+		size_t last_child(size_t const node) const { return m_nodes[node].last_child; }
+		
+		/// @brief Get the next sibling of a node
+		/// @param[in] node A node
+		/// @return the next sibling of the node (hopp::tree::null_node for the last child)
+		size_t next_sibling(size_t const node) const { return m_nodes[node].next_sibling; }
+		
+		/// @brief Test if a node is a leaf
+		/// @param[in] node A node
+		/// @return true if the node has no child, false otherwise
+		bool is_leaf(size_t const node) const { return m_nodes[node].first_child == null_node; }
+		
+		/// @brief Get the number of children of a node in O(number of children)
+		/// @param[in] node A node
+		/// @return the number of children of the node
+		size_t nb_children(size_t const node) const
+		{
+			size_t n = 0;
+			for (size_t child = first_child(node); child != null_node; child = next_sibling(child)) { ++n; }
+			return n;
+		}
+		
+		/// @brief Get the depth of a node in O(depth)
+		/// @param[in] node A node
+		/// @return the depth of the node (0 for the root)
+		size_t depth(size_t node) const
+		{
+			size_t d = 0;
+			while (parent(node) != null_node) { node = parent(node); ++d; }
+			return d;
+		}
+		
+		/// @brief Get the number of nodes of the subtree of a node
+		/// @param[in] node A node
+		/// @return the number of nodes of the subtree (node included)
+		size_t subtree_size(size_t const node) const
+		{
+			#ifndef NDEBUG
+			check_node(node, "subtree_size");
+			#endif
+			
+			if (m_subtree_sizes_ok == false) { update_subtree_sizes(); }
+			return m_subtree_sizes[node];
+		}
+		
+		// Modification
+		
+		/// @brief Add a root; the old root (if any) becomes its only child
+		/// @param[in] value Value of the new root
+		/// @return the new root
+		size_t add_root(T const & value)
+		{
+			size_t const old_root = m_root;
+			m_root = new_node(value, null_node);
+			if (old_root != null_node)
+			{
+				m_nodes[old_root].parent = m_root;
+				m_nodes[m_root].first_child = old_root;
+				m_nodes[m_root].last_child = old_root;
+			}
+			return m_root;
+		}
+		
+		/// @brief Add a child after the last child of a node
+		/// @param[in] parent A node
+		/// @param[in] value  Value of the new child
+		/// @return the new child
+		size_t add_child(size_t const parent, T const & value)
+		{
+			#ifndef NDEBUG
+			check_node(parent, "add_child");
+			#endif
+			
+			size_t const child = new_node(value, parent);
+			if (m_nodes[parent].first_child == null_node) { m_nodes[parent].first_child = child; }
+			else { m_nodes[m_nodes[parent].last_child].next_sibling = child; }
+			m_nodes[parent].last_child = child;
+			return child;
+		}
+		
+		/// @brief Erase a node and its subtree in O(subtree size + number of siblings)
+		/// @param[in] node A node
+		void erase(size_t const node)
+		{
+			#ifndef NDEBUG
+			check_node(node, "erase");
+			#endif
+			
+			if (node == m_root) { clear(); return; }
+			
+			// Unlink
+			auto & p = m_nodes[parent(node)];
+			if (p.first_child == node)
+			{
+				p.first_child = next_sibling(node);
+				if (p.last_child == node) { p.last_child = null_node; }
+			}
+			else
+			{
+				size_t previous = p.first_child;
+				while (next_sibling(previous) != node) { previous = next_sibling(previous); }
+				m_nodes[previous].next_sibling = next_sibling(node);
+				if (p.last_child == node) { p.last_child = previous; }
+			}
+			m_nodes[node].next_sibling = null_node;
+			
+			// Free the subtree
+			std::vector<size_t> subtree;
+			auto const range = preorder(node);
+			for (auto it = range.begin(); it != range.end(); ++it) { subtree.push_back(it.index()); }
+			for (size_t const n : subtree)
+			{
+				m_nodes[n].parent = n;
+				m_nodes[n].first_child = null_node;
+				m_nodes[n].last_child = null_node;
+				m_nodes[n].next_sibling = null_node;
+				m_free_nodes.push_back(n);
+			}
+			m_size -= subtree.size();
+			m_subtree_sizes_ok = false;
+			++m_version;
+		}
+		
+		/// @brief Store the nodes in pre-order without erased nodes (better locality for traversals)
+		/// @return the new index of each old node (hopp::tree::null_node for the erased nodes)
+		/// @warning All indices are invalidated
+		std::vector<size_t> compact()
+		{
+			std::vector<size_t> new_index(m_nodes.size(), null_node);
+			if (empty()) { clear(); return new_index; }
+			
+			std::vector<hopp::node<T>> nodes;
+			nodes.reserve(m_size);
+			for (auto it = begin(); it != end(); ++it) { new_index[it.index()] = nodes.size(); nodes.push_back(m_nodes[it.index()]); }
+			
+			auto const map = [&](size_t const n) { return (n == null_node) ? null_node : new_index[n]; };
+			for (auto & n : nodes)
+			{
+				n.parent = map(n.parent);
+				n.first_child = map(n.first_child);
+				n.last_child = map(n.last_child);
+				n.next_sibling = map(n.next_sibling);
+			}
+			
+			m_nodes = std::move(nodes);
+			m_root = 0;
+			m_free_nodes.clear();
+			m_subtree_sizes_ok = false;
+			++m_version;
+			return new_index;
+		}
+		
+		// Iterators
+		
+		/// @brief Get the begin of the pre-order traversal
+		/// @return the begin of the pre-order traversal
+		const_iterator begin() const { return const_iterator(*this, m_root); }
+		
+		/// @brief Get the begin of the pre-order traversal
+		/// @return the begin of the pre-order traversal
+		iterator begin() { return iterator(*this, m_root); }
+		
+		/// @brief Get the end of the pre-order traversal
+		/// @return the end of the pre-order traversal
+		const_iterator end() const { return const_iterator(*this, null_node); }
+		
+		/// @brief Get the end of the pre-order traversal
+		/// @return the end of the pre-order traversal
+		iterator end() { return iterator(*this, null_node); }
+		
+		/// @brief Pre-order traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<const_iterator> preorder(size_t const node) const
+		{
+			return { const_iterator(*this, node), const_iterator(*this, null_node) };
+		}
+		
+		/// @brief Pre-order traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<iterator> preorder(size_t const node)
+		{
+			return { iterator(*this, node), iterator(*this, null_node) };
+		}
+		
+		/// @brief Post-order traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<hopp::tree_postorder_iterator<hopp::tree<T> const>> postorder(size_t const node) const
+		{
+			return traversal<hopp::tree_postorder_iterator<hopp::tree<T> const>>(*this, node);
+		}
+		
+		/// @brief Post-order traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<hopp::tree_postorder_iterator<hopp::tree<T>>> postorder(size_t const node)
+		{
+			return traversal<hopp::tree_postorder_iterator<hopp::tree<T>>>(*this, node);
+		}
+		
+		/// @brief Breadth-first traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<hopp::tree_breadth_first_iterator<hopp::tree<T> const>> breadth_first(size_t const node) const
+		{
+			return traversal<hopp::tree_breadth_first_iterator<hopp::tree<T> const>>(*this, node);
+		}
+		
+		/// @brief Breadth-first traversal of a subtree
+		/// @param[in] node Root of the subtree
+		/// @return the range of the traversal
+		hopp::tree_range<hopp::tree_breadth_first_iterator<hopp::tree<T>>> breadth_first(size_t const node)
+		{
+			return traversal<hopp::tree_breadth_first_iterator<hopp::tree<T>>>(*this, node);
+		}
+		
+		/// @brief Children of a node
+		/// @param[in] node A node
+		/// @return the range of the children
+		hopp::tree_range<hopp::tree_children_iterator<hopp::tree<T> const>> children(size_t const node) const
+		{
+			return traversal<hopp::tree_children_iterator<hopp::tree<T> const>>(*this, first_child(node));
+		}
+		
+		/// @brief Children of a node
+		/// @param[in] node A node
+		/// @return the range of the children
+		hopp::tree_range<hopp::tree_children_iterator<hopp::tree<T>>> children(size_t const node)
+		{
+			return traversal<hopp::tree_children_iterator<hopp::tree<T>>>(*this, first_child(node));
+		}
+		
+	private:
+		
+		/// @brief Create a range
+		/// @param[in] tree A hopp::tree<T>
+		/// @param[in] node Node given to the begin iterator
+		/// @return the range
+		template <class iterator_t, class tree_t>
+		static hopp::tree_range<iterator_t> traversal(tree_t & tree, size_t const node)
+		{
+			return { iterator_t(tree, node), iterator_t(tree, null_node) };
+		}
+		
+		/// @brief Get a node, reusing an erased one if possible
+		/// @param[in] value  Value
+		/// @param[in] parent Parent
+		/// @return the node
+		size_t new_node(T const & value, size_t const parent)
+		{
+			size_t node;
+			if (m_free_nodes.empty())
+			{
+				node = m_nodes.size();
+				m_nodes.push_back(hopp::node<T>{ value, parent, null_node, null_node, null_node });
+			}
+			else
+			{
+				node = m_free_nodes.back();
+				m_free_nodes.pop_back();
+				m_nodes[node] = hopp::node<T>{ value, parent, null_node, null_node, null_node };
+			}
+			++m_size;
+			m_subtree_sizes_ok = false;
+			++m_version;
+			return node;
+		}
+		
+		/// @brief Compute all subtree sizes in O(n)
+		void update_subtree_sizes() const
+		{
+			m_subtree_sizes.assign(m_nodes.size(), 1);
+			if (m_root != null_node)
+			{
+				for (auto it = postorder(m_root).begin(); it.index() != m_root; ++it)
+				{
+					m_subtree_sizes[parent(it.index())] += m_subtree_sizes[it.index()];
+				}
+			}
+			m_subtree_sizes_ok = true;
+		}
+		
+		/// @brief Throw if a node does not exist
+		/// @param[in] node     A node
+		/// @param[in] function Name of the caller
+		void check_node(size_t const node, char const * const function) const
+		{
+			if (contains(node) == false)
+			{
+				throw std::out_of_range("hopp::tree<T>::" + std::string(function) + ": node " + std::to_string(node) + " does not exist");
+			}
 		}
 	};
 	
+	// Out-of-class definition (the constant is odr-used)
+	template <class T>
+	constexpr size_t hopp::tree<T>::null_node;
+	
 	/// @brief Operator << between a std::ostream and a hopp::tree<T>
 	/// @param[in,out] out  A std::ostream
 	/// @param[in]     tree A hopp::tree<T>
@@ -202,20 +974,50 @@ namespace hopp
 	template <class T>
 	std::ostream & operator <<(std::ostream & out, hopp::tree<T> const & tree)
 	{
-		// TODO
+		// { root { child, child { grandchild } } }
+		out << "{";
+		size_t node = tree.root();
+		while (node != hopp::tree<T>::null_node)
+		{
+			out << " " << tree[node];
+			if (tree.is_leaf(node) == false) { out << " {"; node = tree.first_child(node); continue; }
+			while (node != tree.root() && tree.next_sibling(node) == hopp::tree<T>::null_node) { node = tree.parent(node); out << " }"; }
+			if (node == tree.root()) { break; }
+			out << ",";
+			node = tree.next_sibling(node);
+		}
+		out << " }";
 		return out;
 	}
 	
 	/// @brief Operator == between two hopp::tree<T>
 	/// @param[in] a A hopp::tree<T>
 	/// @param[in] b A hopp::tree<T>
-	/// @return true if a == b, false otherwise
+	/// @return true if a and b have the same shape and the same values, false otherwise
 	/// @relates hopp::tree
 	template <class T>
 	bool operator ==(hopp::tree<T> const & a, hopp::tree<T> const & b)
 	{
-		// TODO
-		return false;
+		if (a.size() != b.size()) { return false; }
+		
+		// The pre-order sequence of (value, is_leaf, is_last_child) defines the tree
+		auto it_a = a.begin();
+		auto it_b = b.begin();
+		for (; it_a != a.end(); ++it_a, ++it_b)
+		{
+			size_t const na = it_a.index();
+			size_t const nb = it_b.index();
+			if (
+				(*it_a == *it_b) == false ||
+				a.is_leaf(na) != b.is_leaf(nb) ||
+				(na == a.root()) != (nb == b.root()) ||
+				(na != a.root() && (a.next_sibling(na) == hopp::tree<T>::null_node) != (b.next_sibling(nb) == hopp::tree<T>::null_node))
+			)
+			{
+				return false;
+			}
+		}
+		return true;
 	}
 	
 	/// @brief Operator != between two hopp::tree<T>
@@ -226,8 +1028,7 @@ namespace hopp
 	template <class T>
 	bool operator !=(hopp::tree<T> const & a, hopp::tree<T> const & b)
 	{
-		// TODO
-		return false;
+		return (a == b) == false;
 	}
 }
 
@@ -0,0 +1,277 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_TREE_INDEX_HPP
+#define HOPP_CONTAINER_TREE_INDEX_HPP
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "tree.hpp"
+#include "../compiler/unused.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Index over a hopp::tree for ancestor and subtree queries
+	 *
+	 * The index stores the pre-order of the tree: the subtree of a node is a contiguous range of this order. The lowest common ancestor of two nodes is the parent of the shallowest node between them in pre-order, found in O(1) with a sparse table.
+	 *
+	 * | Query                                  | Complexity |
+	 * | -------------------------------------- | ---------- |
+	 * | lca, is_ancestor, depth, distance      | O(1)       |
+	 * | subtree_size, subtree_range            | O(1)       |
+	 * | subtree_sum                            | O(1)       |
+	 *
+	 * The index is rebuilt in O(n log n) at the first query after a structural modification of the tree (detected with hopp::tree::version). The values are not tracked: call invalidate() after changing values used by subtree_sum, or after assigning the tree.
+	 *
+	 * Memory: the sparse table has about n × log2(n) std::uint64_t (about 150 MB for 10^6 nodes), plus 4 size_t and one byte per node.
+	 *
+	 * @warning The const queries are not thread-safe: they rebuild the index (and the prefix sums of subtree_sum) in mutable members. Before concurrent queries, call update() (and subtree_sum once if it is used) in one thread; then the queries only read while the tree is not modified.
+	 *
+	 * @code
+	   #include <hopp/container/tree_index.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class tree_index
+	{
+	private:
+		
+		/// Tree
+		hopp::tree<T> const * m_tree;
+		
+		/// Version of the tree when the index was built
+		mutable size_t m_version;
+		
+		/// Is the index up to date (except the version)?
+		mutable bool m_ok;
+		
+		/// Nodes in pre-order
+		mutable std::vector<size_t> m_order;
+		
+		/// Position of each node in pre-order
+		mutable std::vector<size_t> m_position;
+		
+		/// Size of the subtree of each node
+		mutable std::vector<size_t> m_size;
+		
+		/// Depth of each node
+		mutable std::vector<size_t> m_depth;
+		
+		/// Sparse table: m_table[k][i] = min of (depth << 32 | position) on the positions [i, i + 2^k)
+		mutable std::vector<std::vector<std::uint64_t>> m_table;
+		
+		/// Floor of log2 of each range length
+		mutable std::vector<unsigned char> m_log2;
+		
+		/// Prefix sums of the values in pre-order (m_prefix_sums[i] = sum of the i first values)
+		mutable std::vector<T> m_prefix_sums;
+		
+		/// Are the prefix sums up to date?
+		mutable bool m_prefix_sums_ok;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] tree A hopp::tree<T> (it must outlive the index)
+		explicit tree_index(hopp::tree<T> const & tree) :
+			m_tree(&tree), m_version(0), m_ok(false), m_order(), m_position(), m_size(), m_depth(), m_table(), m_log2(), m_prefix_sums(), m_prefix_sums_ok(false)
+		{ }
+		
+		/// @brief Get the tree
+		/// @return the tree
+		hopp::tree<T> const & tree() const { return *m_tree; }
+		
+		/// @brief Force a rebuild at the next query
+		void invalidate() { m_ok = false; m_prefix_sums_ok = false; }
+		
+		/// @brief Rebuild the index if the tree was modified
+		void update() const
+		{
+			if (m_ok == false || m_version != m_tree->version()) { rebuild(); }
+		}
+		
+		/// @brief Get the nodes in pre-order
+		/// @return the nodes in pre-order
+		std::vector<size_t> const & preorder() const { update(); return m_order; }
+		
+		/// @brief Get the depth of a node
+		/// @param[in] node A node
+		/// @return the depth of the node (0 for the root)
+		size_t depth(size_t const node) const { update(); check_node(node, "depth"); return m_depth[node]; }
+		
+		/// @brief Get the number of nodes of the subtree of a node
+		/// @param[in] node A node
+		/// @return the number of nodes of the subtree (node included)
+		size_t subtree_size(size_t const node) const { update(); check_node(node, "subtree_size"); return m_size[node]; }
+		
+		/// @brief Get the range of the subtree of a node in pre-order
+		/// @param[in] node A node
+		/// @return the positions [first, last) of the subtree in preorder()
+		std::pair<size_t, size_t> subtree_range(size_t const node) const
+		{
+			update();
+			check_node(node, "subtree_range");
+			return { m_position[node], m_position[node] + m_size[node] };
+		}
+		
+		/// @brief Test if a node is an ancestor of another node
+		/// @param[in] ancestor A node
+		/// @param[in] node     A node
+		/// @return true if ancestor is an ancestor of node (or node itself), false otherwise
+		bool is_ancestor(size_t const ancestor, size_t const node) const
+		{
+			update();
+			check_node(ancestor, "is_ancestor");
+			check_node(node, "is_ancestor");
+			return m_position[ancestor] <= m_position[node] && m_position[node] < m_position[ancestor] + m_size[ancestor];
+		}
+		
+		/// @brief Get the lowest common ancestor of two nodes
+		/// @param[in] a A node
+		/// @param[in] b A node
+		/// @return the deepest node which is an ancestor of a and b
+		size_t lca(size_t const a, size_t const b) const
+		{
+			update();
+			check_node(a, "lca");
+			check_node(b, "lca");
+			
+			if (a == b) { return a; }
+			
+			size_t first = m_position[a];
+			size_t last = m_position[b];
+			if (first > last) { std::swap(first, last); }
+			
+			// The shallowest node in (first, last] is a child of the LCA
+			++first;
+			size_t const k = m_log2[last - first + 1];
+			std::uint64_t const key = std::min(m_table[k][first], m_table[k][last + 1 - (size_t(1) << k)]);
+			return m_tree->parent(m_order[size_t(key & 0xFFFFFFFF)]);
+		}
+		
+		/// @brief Get the distance between two nodes
+		/// @param[in] a A node
+		/// @param[in] b A node
+		/// @return the number of edges on the path between a and b
+		size_t distance(size_t const a, size_t const b) const
+		{
+			return depth(a) + depth(b) - 2 * depth(lca(a, b));
+		}
+		
+		/// @brief Get the sum of the values of the subtree of a node
+		/// @param[in] node A node
+		/// @return the sum of the values of the subtree (node included)
+		/// @pre T() is the neutral element of T + T and T - T is defined
+		T subtree_sum(size_t const node) const
+		{
+			update();
+			check_node(node, "subtree_sum");
+			
+			if (m_prefix_sums_ok == false)
+			{
+				m_prefix_sums.assign(1, T());
+				m_prefix_sums.reserve(m_order.size() + 1);
+				for (size_t const n : m_order) { m_prefix_sums.push_back(m_prefix_sums.back() + (*m_tree)[n]); }
+				m_prefix_sums_ok = true;
+			}
+			
+			return m_prefix_sums[m_position[node] + m_size[node]] - m_prefix_sums[m_position[node]];
+		}
+		
+	private:
+		
+		/// @brief Rebuild the index in O(n log n)
+		void rebuild() const
+		{
+			size_t const n = m_tree->size();
+			if (n >= (std::uint64_t(1) << 32))
+			{
+				throw std::length_error("hopp::tree_index<T>::rebuild: the tree has too many nodes (" + std::to_string(n) + ")");
+			}
+			
+			size_t const nb_node = m_tree->nodes().size();
+			m_order.clear();
+			m_order.reserve(n);
+			m_position.assign(nb_node, hopp::tree<T>::null_node);
+			m_size.assign(nb_node, 1);
+			m_depth.assign(nb_node, 0);
+			
+			// Pre-order (a parent is reached before its children)
+			for (auto it = m_tree->begin(); it != m_tree->end(); ++it)
+			{
+				size_t const node = it.index();
+				m_position[node] = m_order.size();
+				m_order.push_back(node);
+				if (node != m_tree->root()) { m_depth[node] = m_depth[m_tree->parent(node)] + 1; }
+			}
+			
+			// Subtree sizes (children are after their parent in pre-order)
+			for (size_t i = n; i > 1; --i)
+			{
+				size_t const node = m_order[i - 1];
+				m_size[m_tree->parent(node)] += m_size[node];
+			}
+			
+			// Sparse table
+			m_log2.assign(n + 1, 0);
+			for (size_t i = 2; i <= n; ++i) { m_log2[i] = static_cast<unsigned char>(m_log2[i / 2] + 1); }
+			m_table.resize((n == 0) ? 0 : size_t(m_log2[n]) + 1);
+			if (n != 0)
+			{
+				m_table[0].resize(n);
+				for (size_t i = 0; i < n; ++i) { m_table[0][i] = (std::uint64_t(m_depth[m_order[i]]) << 32) | std::uint64_t(i); }
+			}
+			for (size_t k = 1; k < m_table.size(); ++k)
+			{
+				size_t const half = size_t(1) << (k - 1);
+				auto const & previous = m_table[k - 1];
+				auto & level = m_table[k];
+				level.resize(n + 1 - 2 * half);
+				for (size_t i = 0; i < level.size(); ++i) { level[i] = std::min(previous[i], previous[i + half]); }
+			}
+			
+			m_version = m_tree->version();
+			m_ok = true;
+			m_prefix_sums_ok = false;
+		}
+		
+		/// @brief Throw if a node is not in the tree
+		/// @param[in] node     A node
+		/// @param[in] function Name of the caller
+		void check_node(size_t const node, char const * const function) const
+		{
+			#ifndef NDEBUG
+			if (node >= m_position.size() || m_position[node] == hopp::tree<T>::null_node)
+			{
+				throw std::out_of_range("hopp::tree_index<T>::" + std::string(function) + ": node " + std::to_string(node) + " is not in the tree");
+			}
+			#else
+			hopp_unused(node);
+			hopp_unused(function);
+			#endif
+		}
+	};
+}
+
+#endif
@@ -17,6 +17,7 @@
 #define HOPP_CONTAINER_VECTOR2_HPP
 
 #include <iostream>
+#include <cmath>
 
 
 namespace hopp
@@ -50,6 +51,46 @@ namespace hopp
 		/// @param[in] y Y
 		vector2(T const & x, T const & y) : x(x), y(y)
 		{ }
+		
+		/// @brief Operator +=
+		/// @param[in] b A hopp::vector2<T>
+		/// @return the hopp::vector2<T>
+		vector2 & operator +=(hopp::vector2<T> const & b)
+		{
+			x += b.x;
+			y += b.y;
+			return *this;
+		}
+		
+		/// @brief Operator -=
+		/// @param[in] b A hopp::vector2<T>
+		/// @return the hopp::vector2<T>
+		vector2 & operator -=(hopp::vector2<T> const & b)
+		{
+			x -= b.x;
+			y -= b.y;
+			return *this;
+		}
+		
+		/// @brief Operator *= with a scalar
+		/// @param[in] s A scalar
+		/// @return the hopp::vector2<T>
+		vector2 & operator *=(T const & s)
+		{
+			x *= s;
+			y *= s;
+			return *this;
+		}
+		
+		/// @brief Operator /= with a scalar
+		/// @param[in] s A scalar
+		/// @return the hopp::vector2<T>
+		vector2 & operator /=(T const & s)
+		{
+			x /= s;
+			y /= s;
+			return *this;
+		}
 	};
 	
 	/// @brief Operator << between a std::ostream and a hopp::vector2<T>
@@ -130,6 +171,123 @@ namespace hopp
 	{
 		return (a < b) == false;
 	}
+	
+	/// @brief Operator + between two hopp::vector2<T>
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] b A hopp::vector2<T>
+	/// @return a + b
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator +(hopp::vector2<T> const & a, hopp::vector2<T> const & b)
+	{
+		return hopp::vector2<T>(a.x + b.x, a.y + b.y);
+	}
+	
+	/// @brief Operator - between two hopp::vector2<T>
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] b A hopp::vector2<T>
+	/// @return a - b
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator -(hopp::vector2<T> const & a, hopp::vector2<T> const & b)
+	{
+		return hopp::vector2<T>(a.x - b.x, a.y - b.y);
+	}
+	
+	/// @brief Unary operator - for a hopp::vector2<T>
+	/// @param[in] a A hopp::vector2<T>
+	/// @return -a
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator -(hopp::vector2<T> const & a)
+	{
+		return hopp::vector2<T>(-a.x, -a.y);
+	}
+	
+	/// @brief Operator * between a hopp::vector2<T> and a scalar
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] s A scalar
+	/// @return a * s
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator *(hopp::vector2<T> const & a, T const & s)
+	{
+		return hopp::vector2<T>(a.x * s, a.y * s);
+	}
+	
+	/// @brief Operator * between a scalar and a hopp::vector2<T>
+	/// @param[in] s A scalar
+	/// @param[in] a A hopp::vector2<T>
+	/// @return s * a
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator *(T const & s, hopp::vector2<T> const & a)
+	{
+		return hopp::vector2<T>(s * a.x, s * a.y);
+	}
+	
+	/// @brief Operator / between a hopp::vector2<T> and a scalar
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] s A scalar
+	/// @return a / s
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> operator /(hopp::vector2<T> const & a, T const & s)
+	{
+		return hopp::vector2<T>(a.x / s, a.y / s);
+	}
+	
+	/// @brief Dot product of two hopp::vector2<T>
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] b A hopp::vector2<T>
+	/// @return a · b
+	/// @relates hopp::vector2
+	template <class T>
+	T dot(hopp::vector2<T> const & a, hopp::vector2<T> const & b)
+	{
+		return a.x * b.x + a.y * b.y;
+	}
+	
+	/// @brief Cross product of two hopp::vector2<T> (z component of the 3D cross product)
+	/// @param[in] a A hopp::vector2<T>
+	/// @param[in] b A hopp::vector2<T>
+	/// @return a × b (> 0 if b is counterclockwise from a)
+	/// @relates hopp::vector2
+	template <class T>
+	T cross(hopp::vector2<T> const & a, hopp::vector2<T> const & b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+	
+	/// @brief Squared length of a hopp::vector2<T> (no square root)
+	/// @param[in] a A hopp::vector2<T>
+	/// @return a · a
+	/// @relates hopp::vector2
+	template <class T>
+	T squared_length(hopp::vector2<T> const & a)
+	{
+		return hopp::dot(a, a);
+	}
+	
+	/// @brief Length (Euclidean norm) of a hopp::vector2<T>
+	/// @param[in] a A hopp::vector2<T>
+	/// @return the length of a
+	/// @relates hopp::vector2
+	template <class T>
+	T length(hopp::vector2<T> const & a)
+	{
+		return T(std::sqrt(hopp::dot(a, a)));
+	}
+	
+	/// @brief Normalize a hopp::vector2<T> (the length of a must not be 0)
+	/// @param[in] a A hopp::vector2<T>
+	/// @return a with a length of 1
+	/// @relates hopp::vector2
+	template <class T>
+	hopp::vector2<T> normalize(hopp::vector2<T> const & a)
+	{
+		return a / hopp::length(a);
+	}
 }
 
 #endif
@@ -20,16 +20,28 @@
 #include <vector>
 #include <stdexcept>
 #include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
 
 #include "index.hpp"
-#include "vector_view.hpp"
+#include "storage2D.hpp"
+#include "vector2D_view.hpp"
 #include "vector2.hpp"
 
 
 namespace hopp
 {
+	// Declaration
+	template <class T, class storage = hopp::storage2D::row_major>
+	class vector2D;
+	
 	/**
-	 * @brief 2D container
+	 * @brief 2D container (row-major storage, default hopp::vector2D)
+	 *
+	 * Values are stored row by row in a std::vector<T>, a row uses row_pitch() >= nb_col() values and there is room for row_capacity() >= nb_row() rows. @n
+	 * The spare columns and rows make adding rows and columns amortized (like std::vector::push_back): values are shifted in place (with std::memmove if T is trivially copyable) and the storage grows geometrically. @n
+	 * Rows are computed on the fly (hopp::strided_view<T> by value), there is no table of rows to rebuild after a copy or a move.
 	 *
 	 * @code
 	   #include <hopp/container/vector2D.hpp>
@@ -38,15 +50,27 @@ namespace hopp
 	 * @ingroup hopp_container
 	 */
 	template <class T>
-	class vector2D
+	class vector2D<T, hopp::storage2D::row_major>
 	{
 	public:
 		
 		/// Row type
-		using row_t = hopp::vector_view<std::vector<T>>;
+		using row_t = hopp::strided_view<T>;
+		
+		/// Const row type
+		using const_row_t = hopp::strided_view<T const>;
+		
+		/// Column type
+		using col_t = hopp::strided_view<T>;
+		
+		/// Const column type
+		using const_col_t = hopp::strided_view<T const>;
 		
-		/// Rows type
-		using rows_t = std::vector<row_t>;
+		/// View type
+		using view_t = hopp::vector2D_view<T>;
+		
+		/// Const view type
+		using const_view_t = hopp::vector2D_view<T const>;
 		
 	public:
 		
@@ -65,17 +89,17 @@ namespace hopp
 		/// Pointer type
 		using pointer = T *;
 		
-		/// Const iterator type
-		using const_iterator = typename rows_t::const_iterator;
+		/// Const iterator type (on rows)
+		using const_iterator = hopp::vector2D_row_iterator<T const>;
 		
-		/// Iterator type
-		using iterator = typename rows_t::iterator;
+		/// Iterator type (on rows)
+		using iterator = hopp::vector2D_row_iterator<T>;
 		
-		/// Const reverse iterator type
-		using const_reverse_iterator = typename rows_t::const_reverse_iterator;
+		/// Const reverse iterator type (on rows)
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 		
-		/// Reverse iterator type
-		using reverse_iterator = typename rows_t::reverse_iterator;
+		/// Reverse iterator type (on rows)
+		using reverse_iterator = std::reverse_iterator<iterator>;
 		
 		/// Difference type
 		using difference_type = ptrdiff_t;
@@ -96,11 +120,14 @@ namespace hopp
 		/// Number of columns
 		size_t m_nb_col;
 		
-		/// Vector
-		std::vector<T> m_vector;
+		/// Number of values allocated for a row (>= number of columns)
+		size_t m_row_pitch;
 		
-		/// Rows
-		rows_t m_rows;
+		/// Number of rows allocated (>= number of rows)
+		size_t m_row_capacity;
+		
+		/// Vector (row_capacity × row_pitch values)
+		std::vector<T> m_vector;
 		
 	public:
 		
@@ -109,8 +136,9 @@ namespace hopp
 			print_inline(false),
 			m_nb_row(0),
 			m_nb_col(0),
-			m_vector(),
-			m_rows()
+			m_row_pitch(0),
+			m_row_capacity(0),
+			m_vector()
 		{ }
 		
 		/// @brief Constructor
@@ -125,11 +153,10 @@ namespace hopp
 			print_inline(false),
 			m_nb_row(nb_row),
 			m_nb_col(nb_col),
-			m_vector(m_nb_row * m_nb_col, default_value),
-			m_rows(m_nb_row)
-		{
-			update_rows();
-		}
+			m_row_pitch(nb_col),
+			m_row_capacity(nb_row),
+			m_vector(m_nb_row * m_nb_col, default_value)
+		{ }
 		
 		/// @brief Constructor from std::vector<std::vector<T>>
 		/// @param[in] values A std::vector<std::vector<T>>
@@ -145,28 +172,45 @@ namespace hopp
 			}
 		}
 		
+		/// @brief Constructor from a hopp::vector2D<T> with another storage
+		/// @param[in] vector2D A hopp::vector2D<T, other_storage>
+		template <class other_storage, class = std::enable_if_t<std::is_same<other_storage, hopp::storage2D::row_major>::value == false>>
+		explicit vector2D(hopp::vector2D<T, other_storage> const & vector2D) :
+			hopp::vector2D<T>(vector2D.nb_row(), vector2D.nb_col())
+		{
+			print_inline = vector2D.print_inline;
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t j = 0; j < nb_col(); ++j) { (*this)(i, j) = vector2D(i, j); }
+			}
+		}
+		
 		/// @brief Copy constructor
 		/// @param[in] vector2D A hopp::vector2D<T>
 		vector2D(hopp::vector2D<T> const & vector2D) :
 			print_inline(vector2D.print_inline),
 			m_nb_row(vector2D.nb_row()),
-			m_nb_col(vector2D.nb_row()),
-			m_vector(vector2D.vector()),
-			m_rows()
-		{
-			update_rows();
-		}
+			m_nb_col(vector2D.nb_col()),
+			m_row_pitch(vector2D.row_pitch()),
+			m_row_capacity(vector2D.row_capacity()),
+			m_vector(vector2D.vector())
+		{ }
 		
-		/// @brief Move constructor
+		/// @brief Move constructor (O(1), vector2D becomes empty)
 		/// @param[in] vector2D A hopp::vector2D<T>
-		vector2D(hopp::vector2D<T> && vector2D) :
+		vector2D(hopp::vector2D<T> && vector2D) noexcept :
 			print_inline(vector2D.print_inline),
 			m_nb_row(vector2D.nb_row()),
-			m_nb_col(vector2D.nb_row()),
-			m_vector(std::move(vector2D.m_vector)),
-			m_rows()
+			m_nb_col(vector2D.nb_col()),
+			m_row_pitch(vector2D.row_pitch()),
+			m_row_capacity(vector2D.row_capacity()),
+			m_vector(std::move(vector2D.m_vector))
 		{
-			update_rows();
+			vector2D.m_nb_row = 0;
+			vector2D.m_nb_col = 0;
+			vector2D.m_row_pitch = 0;
+			vector2D.m_row_capacity = 0;
+			vector2D.m_vector.clear();
 		}
 		
 		/// @brief Assignment operator
@@ -179,10 +223,10 @@ namespace hopp
 			return *this;
 		}
 		
-		/// @brief Move assignment operator
+		/// @brief Move assignment operator (O(1))
 		/// @param[in] vector2D A hopp::vector2D<T>
 		/// @return the vector2D
-		hopp::vector2D<T> const & operator =(hopp::vector2D<T> && vector2D)
+		hopp::vector2D<T> const & operator =(hopp::vector2D<T> && vector2D) noexcept
 		{
 			swap(*this, vector2D);
 			return *this;
@@ -196,10 +240,9 @@ namespace hopp
 			std::swap(a.print_inline, b.print_inline);
 			std::swap(a.m_nb_row, b.m_nb_row);
 			std::swap(a.m_nb_col, b.m_nb_col);
+			std::swap(a.m_row_pitch, b.m_row_pitch);
+			std::swap(a.m_row_capacity, b.m_row_capacity);
 			std::swap(a.m_vector, b.m_vector);
-			std::swap(a.m_rows, b.m_rows);
-			a.update_rows();
-			b.update_rows();
 		}
 		
 		// Size, Vector & Data
@@ -216,12 +259,25 @@ namespace hopp
 		/// @return the number of columns
 		size_t nb_col() const { return m_nb_col; }
 		
-		/// @brief Get vector
+		/// @brief Return the number of values allocated for a row (>= number of columns)
+		/// @return the number of values allocated for a row
+		size_t row_pitch() const { return m_row_pitch; }
+		
+		/// @brief Return the number of rows allocated (>= number of rows)
+		/// @return the number of rows allocated
+		size_t row_capacity() const { return m_row_capacity; }
+		
+		/// @brief Return true if the values are contiguous (no spare column)
+		/// @return true if the values are contiguous, false otherwise
+		bool is_contiguous() const { return m_row_pitch == m_nb_col; }
+		
+		/// @brief Get vector (row_capacity() × row_pitch() values, see shrink_to_fit())
 		/// @return vector
 		std::vector<T> const & vector() const { return m_vector; }
 		
-		/// @brief Get vector
+		/// @brief Get vector (row_capacity() × row_pitch() values, see shrink_to_fit())
 		/// @return vector
+		/// @warning Do not change the size of the vector
 		std::vector<T> & vector() { return m_vector; }
 		
 		/// @brief Get data
@@ -232,6 +288,14 @@ namespace hopp
 		/// @return data
 		pointer data() { return m_vector.data(); }
 		
+		/// @brief Get a 2D view on all values
+		/// @return a 2D view on all values
+		const_view_t view() const { return const_view_t(data(), nb_row(), nb_col(), row_pitch()); }
+		
+		/// @brief Get a 2D view on all values
+		/// @return a 2D view on all values
+		view_t view() { return view_t(data(), nb_row(), nb_col(), row_pitch()); }
+		
 		// Access: operator (i, j)
 		
 		/// @brief Const value access
@@ -240,7 +304,7 @@ namespace hopp
 		/// @return the value at (i, j)
 		T const & operator ()(size_t const i, size_t const j) const
 		{
-			return m_vector[hopp::index2D::to_index1D(i, j, nb_col())];
+			return m_vector[hopp::index2D::to_index1D(i, j, row_pitch())];
 		}
 		
 		/// @brief Value access
@@ -249,7 +313,7 @@ namespace hopp
 		/// @return the value at (i, j)
 		T & operator ()(size_t const i, size_t const j)
 		{
-			return m_vector[hopp::index2D::to_index1D(i, j, nb_col())];
+			return m_vector[hopp::index2D::to_index1D(i, j, row_pitch())];
 		}
 		
 		// Access: .at(i, j)
@@ -283,12 +347,12 @@ namespace hopp
 		/// @brief Const row access
 		/// @param i Row index
 		/// @return row at i
-		row_t const & operator [](size_t const i) const { return m_rows[i]; }
+		const_row_t operator [](size_t const i) const { return row(i); }
 		
 		/// @brief Line access
 		/// @param i Row index
 		/// @return row at i
-		row_t & operator [](size_t const i) { return m_rows[i]; }
+		row_t operator [](size_t const i) { return row(i); }
 		
 		// Access: .at(i)
 		
@@ -296,129 +360,192 @@ namespace hopp
 		/// @param i Row index
 		/// @return row at i
 		/// @exception std::out_of_range if i >= number of rows
-		row_t const & at(size_t const i) const
+		const_row_t at(size_t const i) const
 		{
 			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D<T>:at(i): invalid i index"); }
-			return m_rows[i];
+			return row(i);
 		}
 		
 		/// @brief Safe row access
 		/// @param i Row index
 		/// @return row at i
 		/// @exception std::out_of_range if i >= number of rows
-		row_t & at(size_t const i)
+		row_t at(size_t const i)
 		{
 			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D<T>:at(i): invalid i index"); }
-			return m_rows[i];
+			return row(i);
 		}
 		
+		// Rows & Columns
+		
+		/// @brief Const row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		const_row_t row(size_t const i) const { return const_row_t(data() + i * row_pitch(), nb_col()); }
+		
+		/// @brief Row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		row_t row(size_t const i) { return row_t(data() + i * row_pitch(), nb_col()); }
+		
+		/// @brief Const column access
+		/// @param j Column index
+		/// @return column at j (stride of row_pitch)
+		const_col_t col(size_t const j) const { return const_col_t(data() + j, nb_row(), ptrdiff_t(row_pitch())); }
+		
+		/// @brief Column access
+		/// @param j Column index
+		/// @return column at j (stride of row_pitch)
+		col_t col(size_t const j) { return col_t(data() + j, nb_row(), ptrdiff_t(row_pitch())); }
+		
 		// front, back
 		
 		/// @brief Get first row
 		/// @pre Number of rows is not zero
 		/// @return first row
-		row_t const & front() const { return m_rows.front(); }
+		const_row_t front() const { return row(0); }
 		
 		/// @brief Get first row
 		/// @pre Number of rows is not zero
 		/// @return first row
-		row_t & front() { return m_rows.front(); }
+		row_t front() { return row(0); }
 		
 		/// @brief Get last row
 		/// @pre Number of rows is not zero
 		/// @return last row
-		row_t const & back() const { return m_rows.back(); }
+		const_row_t back() const { return row(nb_row() - 1); }
 		
 		/// @brief Get last row
 		/// @pre Number of rows is not zero
 		/// @return last row
-		row_t & back() { return m_rows.back(); }
+		row_t back() { return row(nb_row() - 1); }
 		
-		// Iterator
+		// Iterator (on rows, a row is returned by value)
 		
 		/// @brief Get const iterator to beginning
 		/// @return const iterator to beginning
-		const_iterator begin() const { return m_rows.begin(); }
+		const_iterator begin() const { return const_iterator(data(), 0, nb_col(), row_pitch()); }
 		
 		/// @brief Get const iterator to beginning
 		/// @return const iterator to beginning
-		const_iterator cbegin() const { return m_rows.cbegin(); }
+		const_iterator cbegin() const { return const_iterator(data(), 0, nb_col(), row_pitch()); }
 		
 		/// @brief Get iterator to beginning
 		/// @return iterator to beginning
-		iterator begin() { return m_rows.begin(); }
+		iterator begin() { return iterator(data(), 0, nb_col(), row_pitch()); }
 		
 		/// @brief Get const iterator to end
 		/// @return const iterator to end
-		const_iterator end() const { return m_rows.end(); }
+		const_iterator end() const { return const_iterator(data(), nb_row(), nb_col(), row_pitch()); }
 		
 		/// @brief Get const iterator to end
 		/// @return const iterator to end
-		const_iterator cend() const { return m_rows.cend(); }
+		const_iterator cend() const { return const_iterator(data(), nb_row(), nb_col(), row_pitch()); }
 		
 		/// @brief Get iterator to end
 		/// @return iterator to end
-		iterator end() { return m_rows.end(); }
+		iterator end() { return iterator(data(), nb_row(), nb_col(), row_pitch()); }
 		
 		// Reverse iterator
 		
 		/// @brief Get const reverse iterator to reverse beginning
 		/// @return const reverse iterator to reverse beginning
-		const_reverse_iterator rbegin() const { return m_rows.rbegin(); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
 		
 		/// @brief Get const reverse iterator to reverse beginning
 		/// @return const reverse iterator to reverse beginning
-		const_reverse_iterator crbegin() const { return m_rows.crbegin(); }
+		const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
 		
 		/// @brief Get reverse iterator to reverse beginning
 		/// @return reverse iterator to reverse beginning
-		reverse_iterator bregin() { return m_rows.rbegin(); }
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		
+		/// @brief Get reverse iterator to reverse beginning
+		/// @return reverse iterator to reverse beginning
+		/// @deprecated Use rbegin()
+		reverse_iterator bregin() { return rbegin(); }
 		
 		/// @brief Get const reverse iterator to reverse end
 		/// @return const reverse iterator to reverse end
-		const_reverse_iterator rend() const { return m_rows.rend(); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
 		
 		/// @brief Get const reverse iterator to reverse end
 		/// @return const reverse iterator to reverse end
-		const_reverse_iterator crend() const { return m_rows.crend(); }
+		const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
 		
 		/// @brief Get reverse iterator to reverse end
 		/// @return reverse iterator to reverse end
-		reverse_iterator rend() { return m_rows.rend(); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		
+		// Capacity
+		
+		/// @brief Reserve memory for nb_row rows and nb_col columns
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		void reserve(size_t const nb_row, size_t const nb_col)
+		{
+			if (nb_row <= row_capacity() && nb_col <= row_pitch()) { return; }
+			relayout(std::max(nb_row, row_capacity()), std::max(nb_col, row_pitch()), this->nb_col(), 0);
+		}
+		
+		/// @brief Remove the spare rows and columns (values become contiguous)
+		void shrink_to_fit()
+		{
+			if (row_capacity() == nb_row() && row_pitch() == nb_col()) { return; }
+			relayout(nb_row(), nb_col(), nb_col(), 0);
+		}
 		
 		// Add
 		
-		/// @brief Add a row before an index
+		/// @brief Add rows before an index (amortized O(number of moved values))
 		/// @param[in] i             Row index
+		/// @param[in] n             Number of rows
 		/// @param[in] default_value Default value (T() by default)
 		/// @exception std::out_of_range if NDEBUG is not defined and if i > number of rows
-		void add_row_before(size_t const i, T const & default_value = T())
+		void add_rows_before(size_t const i, size_t const n, T const & default_value = T())
 		{
 			#ifndef NDEBUG
-				if (i > nb_row()) { throw std::out_of_range("hopp::vector2D<T>:add_row_before(i): invalid i index"); }
+				if (i > nb_row()) { throw std::out_of_range("hopp::vector2D<T>:add_rows_before(i, n): invalid i index"); }
 			#endif
 			
-			hopp::vector2D<T> tmp(nb_row() + 1, nb_col());
+			if (n == 0) { return; }
 			
-			// Copy rows before new row
-			for (size_t row = 0; row < i; ++row)
+			if (nb_row() + n > row_capacity())
 			{
-				for (size_t col = 0; col < nb_col(); ++col)
-				{ tmp(row, col) = (*this)(row, col); }
+				relayout(std::max(nb_row() + n, 2 * row_capacity()), row_pitch(), nb_col(), 0);
 			}
-			// Insert line
-			for (size_t col = 0; col < tmp.nb_col(); ++col)
-			{
-				tmp(i, col) = default_value;
-			}
-			// Copy rows after new row
-			for (size_t row = i; row < nb_row(); ++row)
+			
+			// Move rows after i
+			shift(i * row_pitch(), nb_row() * row_pitch(), (i + n) * row_pitch());
+			
+			// Insert rows
+			for (size_t row = i; row < i + n; ++row)
 			{
-				for (size_t col = 0; col < nb_col(); ++col)
-				{ tmp(row + 1, col) = (*this)(row, col); }
+				std::fill(data() + row * row_pitch(), data() + row * row_pitch() + nb_col(), default_value);
 			}
 			
-			*this = std::move(tmp);
+			m_nb_row += n;
+		}
+		
+		/// @brief Add rows at the end (amortized O(n × number of columns))
+		/// @param[in] n             Number of rows
+		/// @param[in] default_value Default value (T() by default)
+		void add_rows(size_t const n, T const & default_value = T())
+		{
+			add_rows_before(nb_row(), n, default_value);
+		}
+		
+		/// @brief Add a row before an index
+		/// @param[in] i             Row index
+		/// @param[in] default_value Default value (T() by default)
+		/// @exception std::out_of_range if NDEBUG is not defined and if i > number of rows
+		void add_row_before(size_t const i, T const & default_value = T())
+		{
+			#ifndef NDEBUG
+				if (i > nb_row()) { throw std::out_of_range("hopp::vector2D<T>:add_row_before(i): invalid i index"); }
+			#endif
+			
+			add_rows_before(i, 1, default_value);
 		}
 		
 		/// @brief Add a row after an index
@@ -430,36 +557,61 @@ namespace hopp
 			add_row_before(i + 1, default_value);
 		}
 		
-		/// @brief Add a column before an index
+		/// @brief Add columns before an index (amortized O(number of moved values))
 		/// @param[in] j             Column index
+		/// @param[in] n             Number of columns
 		/// @param[in] default_value Default value (T() by default)
 		/// @exception std::out_of_range if NDEBUG is not defined and if j > number of columns
-		void add_col_before(size_t const j, T const & default_value = T())
+		void add_cols_before(size_t const j, size_t const n, T const & default_value = T())
 		{
 			#ifndef NDEBUG
-				if (j > nb_col()) { throw std::out_of_range("hopp::vector2D<T>:add_col_before(j): invalid j index"); }
+				if (j > nb_col()) { throw std::out_of_range("hopp::vector2D<T>:add_cols_before(j, n): invalid j index"); }
 			#endif
 			
-			hopp::vector2D<T> tmp(nb_row(), nb_col() + 1);
+			if (n == 0) { return; }
 			
-			// Copy rows before new row
-			for (size_t row = 0; row < nb_row(); ++row)
+			if (nb_col() + n > row_pitch())
 			{
-				// Copy all col before new col
-				for (size_t col = 0; col < j; ++col)
-				{
-					tmp(row, col) = (*this)(row, col);
-				}
-				// Insert value
-				tmp(row, j) = default_value;
-				// Copy all col after new col
-				for (size_t col = j; col < nb_col(); ++col)
+				// New storage with the new columns already inserted
+				relayout(row_capacity(), std::max(nb_col() + n, 2 * row_pitch()), j, n);
+			}
+			else
+			{
+				// Move columns after j in each row
+				for (size_t row = 0; row < nb_row(); ++row)
 				{
-					tmp(row, col + 1) = (*this)(row, col);
+					shift(row * row_pitch() + j, row * row_pitch() + nb_col(), row * row_pitch() + j + n);
 				}
 			}
 			
-			*this = std::move(tmp);
+			// Insert columns
+			for (size_t row = 0; row < nb_row(); ++row)
+			{
+				std::fill(data() + row * row_pitch() + j, data() + row * row_pitch() + j + n, default_value);
+			}
+			
+			m_nb_col += n;
+		}
+		
+		/// @brief Add columns at the end (amortized O(n × number of rows))
+		/// @param[in] n             Number of columns
+		/// @param[in] default_value Default value (T() by default)
+		void add_cols(size_t const n, T const & default_value = T())
+		{
+			add_cols_before(nb_col(), n, default_value);
+		}
+		
+		/// @brief Add a column before an index
+		/// @param[in] j             Column index
+		/// @param[in] default_value Default value (T() by default)
+		/// @exception std::out_of_range if NDEBUG is not defined and if j > number of columns
+		void add_col_before(size_t const j, T const & default_value = T())
+		{
+			#ifndef NDEBUG
+				if (j > nb_col()) { throw std::out_of_range("hopp::vector2D<T>:add_col_before(j): invalid j index"); }
+			#endif
+			
+			add_cols_before(j, 1, default_value);
 		}
 		
 		/// @brief Add a column after an index
@@ -473,6 +625,25 @@ namespace hopp
 		
 		// Remove
 		
+		/// @brief Remove the rows [i_begin, i_end) (in place, the capacity is kept)
+		/// @param[in] i_begin Index of the first row
+		/// @param[in] i_end   Index of the end (not included)
+		/// @exception std::out_of_range if NDEBUG is not defined and if i_begin > i_end or i_end > number of rows
+		void remove_rows(size_t const i_begin, size_t const i_end)
+		{
+			#ifndef NDEBUG
+			if (i_begin > i_end || i_end > nb_row()) { throw std::out_of_range("hopp::vector2D<T>:remove_rows(i_begin, i_end): invalid range"); }
+			#endif
+			
+			size_t const n = i_end - i_begin;
+			if (n == 0) { return; }
+			
+			shift(i_end * row_pitch(), nb_row() * row_pitch(), i_begin * row_pitch());
+			release((nb_row() - n) * row_pitch(), nb_row() * row_pitch());
+			
+			m_nb_row -= n;
+		}
+		
 		/// @brief Remove a row
 		/// @param[in] i Row index
 		/// @exception std::out_of_range if NDEBUG is not defined and if i >= number of rows
@@ -482,22 +653,29 @@ namespace hopp
 			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D<T>:remove_row(i): invalid i index"); }
 			#endif
 			
-			hopp::vector2D<T> tmp(nb_row() - 1, nb_col());
+			remove_rows(i, i + 1);
+		}
+		
+		/// @brief Remove the columns [j_begin, j_end) (in place, the capacity is kept)
+		/// @param[in] j_begin Index of the first column
+		/// @param[in] j_end   Index of the end (not included)
+		/// @exception std::out_of_range if NDEBUG is not defined and if j_begin > j_end or j_end > number of columns
+		void remove_cols(size_t const j_begin, size_t const j_end)
+		{
+			#ifndef NDEBUG
+			if (j_begin > j_end || j_end > nb_col()) { throw std::out_of_range("hopp::vector2D<T>:remove_cols(j_begin, j_end): invalid range"); }
+			#endif
 			
-			// Copy rows before i
-			for (size_t row = 0; row < i; ++row)
-			{
-				for (size_t col = 0; col < nb_col(); ++col)
-				{ tmp(row, col) = (*this)(row, col); }
-			}
-			// Copy rows after i
-			for (size_t row = i + 1; row < nb_row(); ++row)
+			size_t const n = j_end - j_begin;
+			if (n == 0) { return; }
+			
+			for (size_t row = 0; row < nb_row(); ++row)
 			{
-				for (size_t col = 0; col < nb_col(); ++col)
-				{ tmp(row - 1, col) = (*this)(row, col); }
+				shift(row * row_pitch() + j_end, row * row_pitch() + nb_col(), row * row_pitch() + j_begin);
+				release(row * row_pitch() + nb_col() - n, row * row_pitch() + nb_col());
 			}
 			
-			*this = std::move(tmp);
+			m_nb_col -= n;
 		}
 		
 		/// @brief Remove a column
@@ -509,42 +687,66 @@ namespace hopp
 			if (j >= nb_col()) { throw std::out_of_range("hopp::vector2D<T>:remove_col(j): invalid j index"); }
 			#endif
 			
-			hopp::vector2D<T> tmp(nb_row(), nb_col() - 1);
+			remove_cols(j, j + 1);
+		}
+		
+	private:
+		
+		/// @brief Move the values [first, last) of the vector to d_first (ranges can overlap)
+		/// @param[in] first   Index of the first value
+		/// @param[in] last    Index of the end (not included)
+		/// @param[in] d_first Index of the destination
+		void shift(size_t const first, size_t const last, size_t const d_first)
+		{
+			if (first >= last || first == d_first) { return; }
 			
-			// Copy rows
-			for (size_t row = 0; row < nb_row(); ++row)
+			T * const p = data();
+			
+			if (std::is_trivially_copyable<T>::value)
 			{
-				// Copy columns bejore j
-				for (size_t col = 0; col < j; ++col)
-				{
-					tmp(row, col) = (*this)(row, col);
-				}
-				// Copy columns after j
-				for (size_t col = j + 1; col < nb_col(); ++col)
-				{
-					tmp(row, col - 1) = (*this)(row, col);
-				}
+				std::memmove(static_cast<void *>(p + d_first), static_cast<void const *>(p + first), (last - first) * sizeof(T));
+			}
+			else if (d_first > first)
+			{
+				std::move_backward(p + first, p + last, p + d_first + (last - first));
+			}
+			else
+			{
+				std::move(p + first, p + last, p + d_first);
 			}
-			
-			*this = std::move(tmp);
 		}
 		
-	private:
+		/// @brief Reset the unused values [first, last) to T() to release their resources (nothing if T is trivially copyable)
+		/// @param[in] first Index of the first value
+		/// @param[in] last  Index of the end (not included)
+		void release(size_t const first, size_t const last)
+		{
+			if (std::is_trivially_copyable<T>::value == false)
+			{
+				std::fill(data() + first, data() + last, T());
+			}
+		}
 		
-		/// @brief Update rows
-		void update_rows()
+		/// @brief Move the values in a new vector
+		/// @param[in] row_capacity New number of rows allocated
+		/// @param[in] row_pitch    New number of values allocated for a row
+		/// @param[in] j_gap        Column index of the gap to insert in each row
+		/// @param[in] gap          Number of columns of the gap
+		void relayout(size_t const row_capacity, size_t const row_pitch, size_t const j_gap, size_t const gap)
 		{
-			m_rows.resize(nb_row());
+			std::vector<T> tmp(row_capacity * row_pitch);
 			
-			for (size_t i = 0; i < nb_row(); ++i)
+			for (size_t row = 0; row < nb_row(); ++row)
 			{
-				m_rows[i] = hopp::make_vector_view
-				            (
-				            	vector(),
-				            	hopp::index2D::to_index1D(i, size_t(0), nb_col()),
-				            	hopp::index2D::to_index1D(i, nb_col(), nb_col())
-				            );
+				T * const src = data() + row * this->row_pitch();
+				T * const dst = tmp.data() + row * row_pitch;
+				std::move(src, src + j_gap, dst);
+				std::move(src + j_gap, src + nb_col(), dst + j_gap + gap);
 			}
+			
+			m_vector.swap(tmp);
+			m_row_capacity = row_capacity;
+			m_row_pitch = row_pitch;
 		}
 	};
 	
@@ -595,7 +797,7 @@ namespace hopp
 			}
 			out << "\n}";
 		}
-
+		
 		return out;
 	}
 	
@@ -607,7 +809,12 @@ namespace hopp
 	template <class T>
 	bool operator ==(hopp::vector2D<T> const & a, hopp::vector2D<T> const & b)
 	{
-		return a.nb_row() == b.nb_row() && a.nb_col() == b.nb_col() && a.vector() == b.vector();
+		if (a.nb_row() != b.nb_row() || a.nb_col() != b.nb_col()) { return false; }
+		for (size_t i = 0; i < a.nb_row(); ++i)
+		{
+			if (std::equal(a.row(i).begin(), a.row(i).end(), b.row(i).begin()) == false) { return false; }
+		}
+		return true;
 	}
 	
 	/// @brief Operator != between two hopp::vector2D<T>
@@ -620,6 +827,281 @@ namespace hopp
 	{
 		return (a == b) == false;
 	}
+	
+	/**
+	 * @brief 2D container with a storage policy (hopp::storage2D::col_major, hopp::storage2D::tiled, ...)
+	 *
+	 * Same (i, j) and at(i, j) interface as the row-major hopp::vector2D<T>, the value (i, j) is at storage::index(i, j, nb_row, nb_col). @n
+	 * Iterators walk on the values in the storage order (the fastest traversal), use it.i() and it.j() to get the position of a value.
+	 *
+	 * @code
+	   #include <hopp/container/vector2D.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::vector2D<double, hopp::storage2D::col_major> m(1000, 1000);
+	   double col_sum = 0;
+	   for (size_t i = 0; i < m.nb_row(); ++i) { col_sum += m(i, 42); } // contiguous
+	   for (auto it = m.begin(); it != m.end(); ++it) { *it = double(it.i() + it.j()); }
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T, class storage>
+	class vector2D
+	{
+	public:
+		
+		/// Storage policy
+		using storage_t = storage;
+		
+		/// Value type
+		using value_type = T;
+		
+		/// Const reference type
+		using const_reference = T const &;
+		
+		/// Reference type
+		using reference = T &;
+		
+		/// Const pointer type
+		using const_pointer = T const *;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Const iterator type (on values, in the storage order)
+		using const_iterator = hopp::storage2D_iterator<T const, storage>;
+		
+		/// Iterator type (on values, in the storage order)
+		using iterator = hopp::storage2D_iterator<T, storage>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Size type
+		using size_type = size_t;
+		
+	public:
+		
+		/// Print inline
+		bool print_inline;
+		
+	private:
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+		/// Vector (storage::size(nb_row, nb_col) values)
+		std::vector<T> m_vector;
+		
+	public:
+		
+		/// @brief Default constructor
+		vector2D() : print_inline(false), m_nb_row(0), m_nb_col(0), m_vector() { }
+		
+		/// @brief Constructor
+		/// @param[in] nb_row        Number of rows
+		/// @param[in] nb_col        Number of columns
+		/// @param[in] default_value Default value (T() by default)
+		vector2D(size_t const nb_row, size_t const nb_col, T const & default_value = T()) :
+			print_inline(false),
+			m_nb_row(nb_row),
+			m_nb_col(nb_col),
+			m_vector(storage::size(nb_row, nb_col), default_value)
+		{ }
+		
+		/// @brief Constructor from std::vector<std::vector<T>>
+		/// @param[in] values A std::vector<std::vector<T>>
+		vector2D(std::vector<std::vector<T>> const & values) :
+			vector2D(values.size(), values.empty() ? 0 : values[0].size())
+		{
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t j = 0; j < nb_col(); ++j) { (*this)(i, j) = values[i][j]; }
+			}
+		}
+		
+		/// @brief Constructor from a hopp::vector2D<T> with another storage
+		/// @param[in] vector2D A hopp::vector2D<T, other_storage>
+		template <class other_storage, class = std::enable_if_t<std::is_same<other_storage, storage>::value == false>>
+		explicit vector2D(hopp::vector2D<T, other_storage> const & vector2D) :
+			print_inline(vector2D.print_inline),
+			m_nb_row(vector2D.nb_row()),
+			m_nb_col(vector2D.nb_col()),
+			m_vector(storage::size(vector2D.nb_row(), vector2D.nb_col()))
+		{
+			for (size_t i = 0; i < nb_row(); ++i)
+			{
+				for (size_t j = 0; j < nb_col(); ++j) { (*this)(i, j) = vector2D(i, j); }
+			}
+		}
+		
+		/// @brief Swap two hopp::vector2D<T, storage>
+		/// @param[in] a A hopp::vector2D<T, storage>
+		/// @param[in] b A hopp::vector2D<T, storage>
+		friend void swap(hopp::vector2D<T, storage> & a, hopp::vector2D<T, storage> & b) noexcept
+		{
+			std::swap(a.print_inline, b.print_inline);
+			std::swap(a.m_nb_row, b.m_nb_row);
+			std::swap(a.m_nb_col, b.m_nb_col);
+			std::swap(a.m_vector, b.m_vector);
+		}
+		
+		// Size, Vector & Data
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Get vector (storage::size(nb_row, nb_col) values, in the storage order)
+		/// @return vector
+		std::vector<T> const & vector() const { return m_vector; }
+		
+		/// @brief Get vector (storage::size(nb_row, nb_col) values, in the storage order)
+		/// @return vector
+		/// @warning Do not change the size of the vector
+		std::vector<T> & vector() { return m_vector; }
+		
+		/// @brief Get data
+		/// @return data
+		const_pointer data() const { return m_vector.data(); }
+		
+		/// @brief Get data
+		/// @return data
+		pointer data() { return m_vector.data(); }
+		
+		// Access: operator (i, j)
+		
+		/// @brief Const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T const & operator ()(size_t const i, size_t const j) const
+		{
+			return m_vector[storage::index(i, j, nb_row(), nb_col())];
+		}
+		
+		/// @brief Value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T & operator ()(size_t const i, size_t const j)
+		{
+			return m_vector[storage::index(i, j, nb_row(), nb_col())];
+		}
+		
+		// Access: .at(i, j)
+		
+		/// @brief Safe const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T const & at(size_t const i, size_t const j) const
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D<T, storage>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::vector2D<T, storage>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		/// @brief Value safe access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T & at(size_t const i, size_t const j)
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D<T, storage>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::vector2D<T, storage>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		// Iterator (on values, in the storage order)
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return const_iterator(data(), 0, nb_row(), nb_col()); }
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator cbegin() const { return begin(); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return iterator(data(), 0, nb_row(), nb_col()); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return const_iterator(data(), m_vector.size(), nb_row(), nb_col()); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator cend() const { return end(); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return iterator(data(), m_vector.size(), nb_row(), nb_col()); }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::vector2D<T, storage>
+	/// @param[in,out] out      A std::ostream
+	/// @param[in]     vector2D A hopp::vector2D<T, storage>
+	/// @return out
+	/// @relates hopp::vector2D
+	template <class T, class storage>
+	std::ostream & operator <<(std::ostream & out, hopp::vector2D<T, storage> const & vector2D)
+	{
+		if (vector2D.nb_row() == 0) { return out << "{ }"; }
+		
+		out << (vector2D.print_inline ? "{ " : "{\n");
+		for (size_t row = 0; row < vector2D.nb_row(); ++row)
+		{
+			if (row != 0) { out << (vector2D.print_inline ? ", " : ",\n"); }
+			if (vector2D.print_inline == false) { out << "\t"; }
+			
+			out << "{ ";
+			for (size_t col = 0; col < vector2D.nb_col(); ++col)
+			{
+				if (col != 0) { out << ", "; }
+				out << vector2D(row, col);
+			}
+			out << " }";
+		}
+		out << (vector2D.print_inline ? " }" : "\n}");
+		
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::vector2D<T, storage>
+	/// @param[in] a A hopp::vector2D<T, storage>
+	/// @param[in] b A hopp::vector2D<T, storage>
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::vector2D
+	template <class T, class storage>
+	bool operator ==(hopp::vector2D<T, storage> const & a, hopp::vector2D<T, storage> const & b)
+	{
+		return a.nb_row() == b.nb_row() && a.nb_col() == b.nb_col() && std::equal(a.begin(), a.end(), b.begin());
+	}
+	
+	/// @brief Operator != between two hopp::vector2D<T, storage>
+	/// @param[in] a A hopp::vector2D<T, storage>
+	/// @param[in] b A hopp::vector2D<T, storage>
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::vector2D
+	template <class T, class storage>
+	bool operator !=(hopp::vector2D<T, storage> const & a, hopp::vector2D<T, storage> const & b)
+	{
+		return (a == b) == false;
+	}
 }
 
 #endif
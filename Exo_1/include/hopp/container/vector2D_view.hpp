@@ -0,0 +1,500 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_CONTAINER_VECTOR2D_VIEW_HPP
+#define HOPP_CONTAINER_VECTOR2D_VIEW_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "strided_view.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Random access iterator on the rows of a 2D layout (rows are separated by row_pitch values)
+	 *
+	 * The rows are computed on the fly: operator * returns a hopp::strided_view<T> by value. @n
+	 * The iterator holds the row index, so end() - begin() is the number of rows even without column (row_pitch of 0).
+	 *
+	 * @code
+	   #include <hopp/container/vector2D_view.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class vector2D_row_iterator
+	{
+	public:
+		
+		/// Iterator category
+		using iterator_category = std::random_access_iterator_tag;
+		
+		/// Value type
+		using value_type = hopp::strided_view<T>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Pointer type
+		using pointer = void;
+		
+		/// Reference type (the row is returned by value)
+		using reference = hopp::strided_view<T>;
+		
+	private:
+		
+		/// Pointer to the first value of the first row
+		T * m_data;
+		
+		/// Index of the current row
+		size_t m_i;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+		/// Distance between two rows (in number of values)
+		size_t m_row_pitch;
+		
+	public:
+		
+		/// @brief Default constructor
+		vector2D_row_iterator() : m_data(nullptr), m_i(0), m_nb_col(0), m_row_pitch(0) { }
+		
+		/// @brief Constructor
+		/// @param[in] data      Pointer to the first value of the first row
+		/// @param[in] i         Index of the current row
+		/// @param[in] nb_col    Number of columns
+		/// @param[in] row_pitch Distance between two rows (in number of values)
+		vector2D_row_iterator(T * const data, size_t const i, size_t const nb_col, size_t const row_pitch) :
+			m_data(data), m_i(i), m_nb_col(nb_col), m_row_pitch(row_pitch)
+		{ }
+		
+		/// @brief Conversion from iterator to const iterator
+		/// @param[in] it A hopp::vector2D_row_iterator<value_type>
+		template <class U, class = std::enable_if_t<std::is_same<U const, T>::value && std::is_const<T>::value>>
+		vector2D_row_iterator(hopp::vector2D_row_iterator<U> const & it) :
+			m_data(it.data()), m_i(it.i()), m_nb_col(it.nb_col()), m_row_pitch(it.row_pitch())
+		{ }
+		
+		/// @brief Get the pointer to the first value of the first row
+		/// @return the pointer to the first value of the first row
+		T * data() const { return m_data; }
+		
+		/// @brief Get the index of the current row
+		/// @return the index of the current row
+		size_t i() const { return m_i; }
+		
+		/// @brief Get the pointer to the first value of the current row
+		/// @return the pointer to the first value of the current row
+		T * ptr() const { return m_data + m_i * m_row_pitch; }
+		
+		/// @brief Get the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Get the distance between two rows
+		/// @return the distance between two rows
+		size_t row_pitch() const { return m_row_pitch; }
+		
+		/// @brief Get the current row
+		/// @return the current row
+		hopp::strided_view<T> operator *() const { return hopp::strided_view<T>(ptr(), m_nb_col); }
+		
+		/// @brief Get the row at n
+		/// @param[in] n Offset
+		/// @return the row at n
+		hopp::strided_view<T> operator [](ptrdiff_t const n) const { return *(*this + n); }
+		
+		/// @brief Pre-increment
+		/// @return the iterator
+		hopp::vector2D_row_iterator<T> & operator ++() { ++m_i; return *this; }
+		
+		/// @brief Post-increment
+		/// @return the iterator before the increment
+		hopp::vector2D_row_iterator<T> operator ++(int) { auto tmp = *this; ++(*this); return tmp; }
+		
+		/// @brief Pre-decrement
+		/// @return the iterator
+		hopp::vector2D_row_iterator<T> & operator --() { --m_i; return *this; }
+		
+		/// @brief Post-decrement
+		/// @return the iterator before the decrement
+		hopp::vector2D_row_iterator<T> operator --(int) { auto tmp = *this; --(*this); return tmp; }
+		
+		/// @brief Advance the iterator
+		/// @param[in] n Offset
+		/// @return the iterator
+		hopp::vector2D_row_iterator<T> & operator +=(ptrdiff_t const n) { m_i = size_t(ptrdiff_t(m_i) + n); return *this; }
+		
+		/// @brief Advance the iterator backward
+		/// @param[in] n Offset
+		/// @return the iterator
+		hopp::vector2D_row_iterator<T> & operator -=(ptrdiff_t const n) { m_i = size_t(ptrdiff_t(m_i) - n); return *this; }
+		
+		/// @brief Get an advanced iterator
+		/// @param[in] n Offset
+		/// @return the advanced iterator
+		hopp::vector2D_row_iterator<T> operator +(ptrdiff_t const n) const { auto tmp = *this; tmp += n; return tmp; }
+		
+		/// @brief Get an iterator advanced backward
+		/// @param[in] n Offset
+		/// @return the iterator advanced backward
+		hopp::vector2D_row_iterator<T> operator -(ptrdiff_t const n) const { auto tmp = *this; tmp -= n; return tmp; }
+		
+		/// @brief Distance between two iterators
+		/// @param[in] it An iterator
+		/// @return the distance between the two iterators
+		ptrdiff_t operator -(hopp::vector2D_row_iterator<T> const & it) const { return ptrdiff_t(m_i) - ptrdiff_t(it.m_i); }
+		
+		/// @brief Operator ==
+		/// @param[in] it An iterator
+		/// @return true if the iterators are equal, false otherwise
+		bool operator ==(hopp::vector2D_row_iterator<T> const & it) const { return m_i == it.m_i; }
+		
+		/// @brief Operator !=
+		/// @param[in] it An iterator
+		/// @return true if the iterators are different, false otherwise
+		bool operator !=(hopp::vector2D_row_iterator<T> const & it) const { return m_i != it.m_i; }
+		
+		/// @brief Operator <
+		/// @param[in] it An iterator
+		/// @return true if this iterator is before it, false otherwise
+		bool operator <(hopp::vector2D_row_iterator<T> const & it) const { return m_i < it.m_i; }
+		
+		/// @brief Operator >
+		/// @param[in] it An iterator
+		/// @return true if this iterator is after it, false otherwise
+		bool operator >(hopp::vector2D_row_iterator<T> const & it) const { return it < *this; }
+		
+		/// @brief Operator <=
+		/// @param[in] it An iterator
+		/// @return true if this iterator is before or equal to it, false otherwise
+		bool operator <=(hopp::vector2D_row_iterator<T> const & it) const { return (*this > it) == false; }
+		
+		/// @brief Operator >=
+		/// @param[in] it An iterator
+		/// @return true if this iterator is after or equal to it, false otherwise
+		bool operator >=(hopp::vector2D_row_iterator<T> const & it) const { return (*this < it) == false; }
+	};
+	
+	/**
+	 * @brief 2D view (nb_row × nb_col values, rows are separated by row_pitch values)
+	 *
+	 * Rows are contiguous hopp::strided_view<T>, columns are hopp::strided_view<T> with a stride of row_pitch. @n
+	 * When row_pitch == nb_col, all the values are contiguous and data() can be given to algorithms which work on pointers.
+	 *
+	 * @code
+	   #include <hopp/container/vector2D_view.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   std::vector<int> v(4 * 5);
+	   auto m = hopp::make_vector2D_view(v, 4, 5);
+	   auto col = m.col(2); // stride of 5
+	   std::fill(col.begin(), col.end(), 42);
+	   auto sub = m.sub(1, 1, 2, 3); // 2 × 3 view with row_pitch 5
+	   @endcode
+	 *
+	 * @ingroup hopp_container
+	 */
+	template <class T>
+	class vector2D_view
+	{
+	public:
+		
+		/// Row type
+		using row_t = hopp::strided_view<T>;
+		
+		/// Const row type
+		using const_row_t = hopp::strided_view<T const>;
+		
+		/// Column type
+		using col_t = hopp::strided_view<T>;
+		
+		/// Const column type
+		using const_col_t = hopp::strided_view<T const>;
+		
+		/// Value type
+		using value_type = std::remove_const_t<T>;
+		
+		/// Const reference type
+		using const_reference = T const &;
+		
+		/// Reference type
+		using reference = T &;
+		
+		/// Const pointer type
+		using const_pointer = T const *;
+		
+		/// Pointer type
+		using pointer = T *;
+		
+		/// Const iterator type (on rows)
+		using const_iterator = hopp::vector2D_row_iterator<T const>;
+		
+		/// Iterator type (on rows)
+		using iterator = hopp::vector2D_row_iterator<T>;
+		
+		/// Difference type
+		using difference_type = ptrdiff_t;
+		
+		/// Size type
+		using size_type = size_t;
+		
+	private:
+		
+		/// Pointer to the value (0, 0)
+		T * m_data;
+		
+		/// Number of rows
+		size_t m_nb_row;
+		
+		/// Number of columns
+		size_t m_nb_col;
+		
+		/// Distance between two rows (in number of values)
+		size_t m_row_pitch;
+		
+	public:
+		
+		/// @brief Default constructor
+		vector2D_view() : m_data(nullptr), m_nb_row(0), m_nb_col(0), m_row_pitch(0) { }
+		
+		/// @brief Constructor
+		/// @param[in] data      Pointer to the value (0, 0)
+		/// @param[in] nb_row    Number of rows
+		/// @param[in] nb_col    Number of columns
+		/// @param[in] row_pitch Distance between two rows (in number of values)
+		vector2D_view(T * const data, size_t const nb_row, size_t const nb_col, size_t const row_pitch) :
+			m_data(data), m_nb_row(nb_row), m_nb_col(nb_col), m_row_pitch(row_pitch)
+		{ }
+		
+		/// @brief Constructor (contiguous rows)
+		/// @param[in] data   Pointer to the value (0, 0)
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		vector2D_view(T * const data, size_t const nb_row, size_t const nb_col) :
+			vector2D_view(data, nb_row, nb_col, nb_col)
+		{ }
+		
+		/// @brief Conversion to a const view
+		/// @return the const view
+		operator hopp::vector2D_view<T const>() const { return hopp::vector2D_view<T const>(m_data, m_nb_row, m_nb_col, m_row_pitch); }
+		
+		// Size, Pitch & Data
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t nb_row() const { return m_nb_row; }
+		
+		/// @brief Return the number of rows
+		/// @return the number of rows
+		size_t size() const { return nb_row(); }
+		
+		/// @brief Return the number of columns
+		/// @return the number of columns
+		size_t nb_col() const { return m_nb_col; }
+		
+		/// @brief Return the distance between two rows (in number of values)
+		/// @return the distance between two rows
+		size_t row_pitch() const { return m_row_pitch; }
+		
+		/// @brief Return true if all values are contiguous
+		/// @return true if all values are contiguous, false otherwise
+		bool is_contiguous() const { return m_row_pitch == m_nb_col || m_nb_row <= 1; }
+		
+		/// @brief Get data (pointer to the value (0, 0))
+		/// @return data
+		T const * data() const { return m_data; }
+		
+		/// @brief Get data (pointer to the value (0, 0))
+		/// @return data
+		T * data() { return m_data; }
+		
+		// Access: operator (i, j)
+		
+		/// @brief Const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T const & operator ()(size_t const i, size_t const j) const { return m_data[i * m_row_pitch + j]; }
+		
+		/// @brief Value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		T & operator ()(size_t const i, size_t const j) { return m_data[i * m_row_pitch + j]; }
+		
+		// Access: .at(i, j)
+		
+		/// @brief Safe const value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T const & at(size_t const i, size_t const j) const
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D_view<T>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::vector2D_view<T>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		/// @brief Safe value access
+		/// @param i Row index
+		/// @param j Column index
+		/// @return the value at (i, j)
+		/// @exception std::out_of_range if i >= number of rows or j >= number of columns
+		T & at(size_t const i, size_t const j)
+		{
+			if (i >= nb_row()) { throw std::out_of_range("hopp::vector2D_view<T>:at(i, j): invalid i index"); }
+			if (j >= nb_col()) { throw std::out_of_range("hopp::vector2D_view<T>:at(i, j): invalid j index"); }
+			return (*this)(i, j);
+		}
+		
+		// Rows & Columns
+		
+		/// @brief Const row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		const_row_t operator [](size_t const i) const { return row(i); }
+		
+		/// @brief Row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		row_t operator [](size_t const i) { return row(i); }
+		
+		/// @brief Const row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		const_row_t row(size_t const i) const { return const_row_t(m_data + i * m_row_pitch, m_nb_col); }
+		
+		/// @brief Row access
+		/// @param i Row index
+		/// @return row at i (contiguous)
+		row_t row(size_t const i) { return row_t(m_data + i * m_row_pitch, m_nb_col); }
+		
+		/// @brief Const column access
+		/// @param j Column index
+		/// @return column at j (stride of row_pitch)
+		const_col_t col(size_t const j) const { return const_col_t(m_data + j, m_nb_row, ptrdiff_t(m_row_pitch)); }
+		
+		/// @brief Column access
+		/// @param j Column index
+		/// @return column at j (stride of row_pitch)
+		col_t col(size_t const j) { return col_t(m_data + j, m_nb_row, ptrdiff_t(m_row_pitch)); }
+		
+		/// @brief Get a const sub view
+		/// @param[in] i      Row index of the first value
+		/// @param[in] j      Column index of the first value
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @return the sub view (same row_pitch)
+		/// @exception std::out_of_range if NDEBUG is not defined and if the sub view is not inside the view
+		hopp::vector2D_view<T const> sub(size_t const i, size_t const j, size_t const nb_row, size_t const nb_col) const
+		{
+			#ifndef NDEBUG
+				if (i + nb_row > m_nb_row || j + nb_col > m_nb_col) { throw std::out_of_range("hopp::vector2D_view<T>:sub(i, j, nb_row, nb_col): invalid sub view"); }
+			#endif
+			
+			return hopp::vector2D_view<T const>(m_data + i * m_row_pitch + j, nb_row, nb_col, m_row_pitch);
+		}
+		
+		/// @brief Get a sub view
+		/// @param[in] i      Row index of the first value
+		/// @param[in] j      Column index of the first value
+		/// @param[in] nb_row Number of rows
+		/// @param[in] nb_col Number of columns
+		/// @return the sub view (same row_pitch)
+		/// @exception std::out_of_range if NDEBUG is not defined and if the sub view is not inside the view
+		hopp::vector2D_view<T> sub(size_t const i, size_t const j, size_t const nb_row, size_t const nb_col)
+		{
+			#ifndef NDEBUG
+				if (i + nb_row > m_nb_row || j + nb_col > m_nb_col) { throw std::out_of_range("hopp::vector2D_view<T>:sub(i, j, nb_row, nb_col): invalid sub view"); }
+			#endif
+			
+			return hopp::vector2D_view<T>(m_data + i * m_row_pitch + j, nb_row, nb_col, m_row_pitch);
+		}
+		
+		// Iterator (on rows)
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator begin() const { return const_iterator(m_data, 0, m_nb_col, m_row_pitch); }
+		
+		/// @brief Get const iterator to beginning
+		/// @return const iterator to beginning
+		const_iterator cbegin() const { return const_iterator(m_data, 0, m_nb_col, m_row_pitch); }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		iterator begin() { return iterator(m_data, 0, m_nb_col, m_row_pitch); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator end() const { return const_iterator(m_data, m_nb_row, m_nb_col, m_row_pitch); }
+		
+		/// @brief Get const iterator to end
+		/// @return const iterator to end
+		const_iterator cend() const { return const_iterator(m_data, m_nb_row, m_nb_col, m_row_pitch); }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		iterator end() { return iterator(m_data, m_nb_row, m_nb_col, m_row_pitch); }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::vector2D_view<T>
+	/// @param[in,out] out           A std::ostream
+	/// @param[in]     vector2D_view A hopp::vector2D_view<T>
+	/// @return out
+	/// @relates hopp::vector2D_view
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::vector2D_view<T> const & vector2D_view)
+	{
+		out << "{";
+		for (size_t row = 0; row < vector2D_view.nb_row(); ++row)
+		{
+			if (row == 0) { out << " "; }
+			else { out << ", "; }
+			
+			out << vector2D_view.row(row);
+		}
+		out << " }";
+		
+		return out;
+	}
+	
+	/// @brief Create a hopp::vector2D_view<T> on a contiguous container (std::vector, hopp::vector2D, ...)
+	/// @param[in] container A contiguous container with data()
+	/// @param[in] nb_row    Number of rows
+	/// @param[in] nb_col    Number of columns
+	/// @param[in] row_pitch Distance between two rows (nb_col by default)
+	/// @param[in] offset    Index of the value (0, 0) in the container (0 by default)
+	/// @return the hopp::vector2D_view<T>
+	/// @relates hopp::vector2D_view
+	template <class container_t>
+	auto make_vector2D_view(container_t & container, size_t const nb_row, size_t const nb_col, size_t const row_pitch = 0, size_t const offset = 0)
+	-> hopp::vector2D_view<std::remove_pointer_t<decltype(container.data())>>
+	{
+		using T = std::remove_pointer_t<decltype(container.data())>;
+		return hopp::vector2D_view<T>(container.data() + offset, nb_row, nb_col, (row_pitch == 0) ? nb_col : row_pitch);
+	}
+}
+
+#endif
@@ -17,6 +17,7 @@
 #define HOPP_CONTAINER_VECTOR3_HPP
 
 #include <iostream>
+#include <cmath>
 
 
 namespace hopp
@@ -54,6 +55,50 @@ namespace hopp
 		/// @param[in] z Z
 		vector3(T const & x, T const & y, T const & z) : x(x), y(y), z(z)
 		{ }
+		
+		/// @brief Operator +=
+		/// @param[in] b A hopp::vector3<T>
+		/// @return the hopp::vector3<T>
+		vector3 & operator +=(hopp::vector3<T> const & b)
+		{
+			x += b.x;
+			y += b.y;
+			z += b.z;
+			return *this;
+		}
+		
+		/// @brief Operator -=
+		/// @param[in] b A hopp::vector3<T>
+		/// @return the hopp::vector3<T>
+		vector3 & operator -=(hopp::vector3<T> const & b)
+		{
+			x -= b.x;
+			y -= b.y;
+			z -= b.z;
+			return *this;
+		}
+		
+		/// @brief Operator *= with a scalar
+		/// @param[in] s A scalar
+		/// @return the hopp::vector3<T>
+		vector3 & operator *=(T const & s)
+		{
+			x *= s;
+			y *= s;
+			z *= s;
+			return *this;
+		}
+		
+		/// @brief Operator /= with a scalar
+		/// @param[in] s A scalar
+		/// @return the hopp::vector3<T>
+		vector3 & operator /=(T const & s)
+		{
+			x /= s;
+			y /= s;
+			z /= s;
+			return *this;
+		}
 	};
 	
 	/// @brief Operator << between a std::ostream and a hopp::vector3<T>
@@ -135,6 +180,123 @@ namespace hopp
 	{
 		return (a < b) == false;
 	}
+	
+	/// @brief Operator + between two hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] b A hopp::vector3<T>
+	/// @return a + b
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator +(hopp::vector3<T> const & a, hopp::vector3<T> const & b)
+	{
+		return hopp::vector3<T>(a.x + b.x, a.y + b.y, a.z + b.z);
+	}
+	
+	/// @brief Operator - between two hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] b A hopp::vector3<T>
+	/// @return a - b
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator -(hopp::vector3<T> const & a, hopp::vector3<T> const & b)
+	{
+		return hopp::vector3<T>(a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+	
+	/// @brief Unary operator - for a hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @return -a
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator -(hopp::vector3<T> const & a)
+	{
+		return hopp::vector3<T>(-a.x, -a.y, -a.z);
+	}
+	
+	/// @brief Operator * between a hopp::vector3<T> and a scalar
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] s A scalar
+	/// @return a * s
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator *(hopp::vector3<T> const & a, T const & s)
+	{
+		return hopp::vector3<T>(a.x * s, a.y * s, a.z * s);
+	}
+	
+	/// @brief Operator * between a scalar and a hopp::vector3<T>
+	/// @param[in] s A scalar
+	/// @param[in] a A hopp::vector3<T>
+	/// @return s * a
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator *(T const & s, hopp::vector3<T> const & a)
+	{
+		return hopp::vector3<T>(s * a.x, s * a.y, s * a.z);
+	}
+	
+	/// @brief Operator / between a hopp::vector3<T> and a scalar
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] s A scalar
+	/// @return a / s
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> operator /(hopp::vector3<T> const & a, T const & s)
+	{
+		return hopp::vector3<T>(a.x / s, a.y / s, a.z / s);
+	}
+	
+	/// @brief Dot product of two hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] b A hopp::vector3<T>
+	/// @return a · b
+	/// @relates hopp::vector3
+	template <class T>
+	T dot(hopp::vector3<T> const & a, hopp::vector3<T> const & b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+	
+	/// @brief Cross product of two hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @param[in] b A hopp::vector3<T>
+	/// @return a × b
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> cross(hopp::vector3<T> const & a, hopp::vector3<T> const & b)
+	{
+		return hopp::vector3<T>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+	}
+	
+	/// @brief Squared length of a hopp::vector3<T> (no square root)
+	/// @param[in] a A hopp::vector3<T>
+	/// @return a · a
+	/// @relates hopp::vector3
+	template <class T>
+	T squared_length(hopp::vector3<T> const & a)
+	{
+		return hopp::dot(a, a);
+	}
+	
+	/// @brief Length (Euclidean norm) of a hopp::vector3<T>
+	/// @param[in] a A hopp::vector3<T>
+	/// @return the length of a
+	/// @relates hopp::vector3
+	template <class T>
+	T length(hopp::vector3<T> const & a)
+	{
+		return T(std::sqrt(hopp::dot(a, a)));
+	}
+	
+	/// @brief Normalize a hopp::vector3<T> (the length of a must not be 0)
+	/// @param[in] a A hopp::vector3<T>
+	/// @return a with a length of 1
+	/// @relates hopp::vector3
+	template <class T>
+	hopp::vector3<T> normalize(hopp::vector3<T> const & a)
+	{
+		return a / hopp::length(a);
+	}
 }
 
 #endif
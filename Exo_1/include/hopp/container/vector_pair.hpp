@@ -1,5 +1,5 @@
 // Copyright © 2015 Rodolphe Cargnello, rodolphe.cargnello@gmail.com
-// Copyright © 2015 Lénaïc Bagnères, hnc@singularity.fr
+// Copyright © 2015, 2016 Lénaïc Bagnères, hnc@singularity.fr
 
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,16 +22,35 @@
 #include <vector>
 #include <cstddef>
 #include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <type_traits>
 
 #include "../conversion/to_string.hpp"
 #include "../stream/ostreamable.hpp"
+#include "../type/is_hashable.hpp"
 #include "../type/is_iterator.hpp"
 
 
 namespace hopp
 {
+	/// @brief Hash type of a hopp::vector_pair without hash index (the keys are searched linearly)
+	/// @ingroup hopp_container
+	class vector_pair_no_hash
+	{ };
+	
+	/// @brief Default hash type of a hopp::vector_pair (std::hash<key_t> if it is usable, hopp::vector_pair_no_hash otherwise)
+	/// @ingroup hopp_container
+	template <class key_t>
+	using vector_pair_default_hash = typename std::conditional<hopp::is_hashable<key_t>::value, std::hash<key_t>, hopp::vector_pair_no_hash>::type;
+	
 	/**
-	 * @brief Associative container that contains key-value pairs
+	 * @brief Associative container that contains key-value pairs in insertion order
+	 *
+	 * The pairs are stored contiguously in insertion order; a hash index (open addressing with linear probing) gives the position of each key, so find, at, operator [] and insert are O(1) on average. Erasing is O(n) (the pairs after the erased ones are moved and the index is rebuilt). @n
+	 * If std::hash<key_t> is not usable (and no hash_t is given), or if hash_t is hopp::vector_pair_no_hash, there is no index and the keys are searched linearly (O(n)).
+	 *
+	 * @warning Do not modify a key through data() or an iterator, nor add or remove pairs through data() (push_back, erase, ...), without calling rehash(): the stale index gives wrong positions (out of bounds access after a removal)
 	 *
 	 * @code
 	   #include <hopp/container.hpp>
@@ -40,18 +59,18 @@ namespace hopp
 	 * Example:
 	 * @code
 	   hopp::vector_pair<std::string, int> pairs;
-	   
+	
 	   pairs["one"] = 1; // Create "one" key with 1 value
 	   pairs["two"] = 2;
 	   pairs["three"] = 4;
 	   pairs["three"] = 3; // Replace value at key "three"
-	   
+	
 	   std::cout << pairs << std::endl; // { { one, 1 }, { two, 2 }, { three, 3 } }
 	   @endcode
 	 *
 	 * @ingroup hopp_container
 	 */
-	template <class key_t, class T>
+	template <class key_t, class T, class hash_t = hopp::vector_pair_default_hash<key_t>>
 	class vector_pair
 	{
 	public:
@@ -95,27 +114,52 @@ namespace hopp
 		/// Size type
 		using size_type = size_t;
 		
+		/// Hash type
+		using hasher = hash_t;
+		
 	private:
 		
+		/// Slot of the hash index
+		struct slot
+		{
+			/// Position of the pair in m_pairs (null_position if the slot is empty)
+			size_t position;
+			
+			/// Hash of the key
+			size_t hash;
+		};
+		
+		/// Position of an empty slot
+		static constexpr size_t null_position = size_t(-1);
+		
+		/// Is there a hash index?
+		using is_indexed = std::integral_constant<bool, std::is_same<hash_t, hopp::vector_pair_no_hash>::value == false>;
+		
 		/// Vector of pairs (keys and values)
 		std::vector<std::pair<key_t, T>> m_pairs;
 		
+		/// Hash index (the size is 0 or a power of 2, at most half full)
+		std::vector<slot> m_slots;
+		
+		/// Hash function
+		hash_t m_hash;
+		
 	public:
 		
 		/// @brief Default constructor
-		vector_pair() = default;
+		vector_pair() : m_pairs(), m_slots(), m_hash() { }
 		
 		/// @brief Constructor from std::vector<std::pair<key_t, T>>
 		/// @param[in] pairs A std::vector<std::pair<key_t, T>>
 		vector_pair(std::vector<std::pair<key_t, T>> const & pairs) :
-			hopp::vector_pair<key_t, T>(std::begin(pairs), std::end(pairs))
+			vector_pair(std::begin(pairs), std::end(pairs))
 		{ }
 		
 		/// @brief Constructor from std::initializer_list<std::pair<key_t, T>>
 		/// @param[in] first Iterator to the first element
 		/// @param[in] last  Iterator to the last element (not included)
 		vector_pair(std::initializer_list<std::pair<key_t, T>> const & initializer_list) :
-			hopp::vector_pair<key_t, T>(std::begin(initializer_list), std::end(initializer_list))
+			vector_pair(std::begin(initializer_list), std::end(initializer_list))
 		{ }
 		
 		/// @brief Constructor from iterators
@@ -123,7 +167,7 @@ namespace hopp
 		/// @param[in] last  Iterator to the last element (not included)
 		template <class input_iterator_t>
 		vector_pair(input_iterator_t const & first, input_iterator_t const & last) :
-			m_pairs()
+			vector_pair()
 		{
 			static_assert(hopp::is_iterator<input_iterator_t>::value, "hopp::vector_pair<key_t, T>::vector_pair:  error: input_iterator_t is not an iterator");
 			
@@ -141,6 +185,7 @@ namespace hopp
 		
 		/// @brief Pairs values access
 		/// @return A std::vector<std::pair<key_t, T>>
+		/// @warning Call rehash() after modifying the keys or adding or removing pairs (push_back, erase, resize, ...), before any other call: until then the index has stale positions (out of bounds after a removal)
 		std::vector<std::pair<key_t, T>> & data() { return m_pairs; }
 		
 		// Size
@@ -161,6 +206,20 @@ namespace hopp
 		/// @return the maximum size
 		size_t max_size() const { return m_pairs.max_size(); }
 		
+		/// @brief Reserve memory for pairs
+		/// @param[in] size Number of pairs
+		void reserve(size_t const size)
+		{
+			m_pairs.reserve(size);
+			if (2 * size > m_slots.size()) { rehash(size); }
+		}
+		
+		// Hash index
+		
+		/// @brief Rebuild the hash index (after modifying keys through data() or iterators, or adding or removing pairs through data())
+		/// @pre The keys are unique
+		void rehash() { rehash(m_pairs.size()); }
+		
 		// Find
 		
 		/// @brief Find element with a key
@@ -168,7 +227,8 @@ namespace hopp
 		/// @return the iterator the element found, end iterator if not found
 		const_iterator find(key_t const & key) const
 		{
-			return std::find_if(m_pairs.cbegin(), m_pairs.cend(), [&key](value_type const & pair) -> bool { return pair.first == key; });
+			size_t const position = find_position(key, is_indexed());
+			return (position == null_position) ? m_pairs.cend() : m_pairs.cbegin() + difference_type(position);
 		}
 		
 		/// @brief Find element with a key
@@ -176,9 +236,15 @@ namespace hopp
 		/// @return the iterator the element found, end iterator if not found
 		iterator find(key_t const & key)
 		{
-			return std::find_if(m_pairs.begin(), m_pairs.end(), [&key](value_type const & pair) -> bool { return pair.first == key; });
+			size_t const position = find_position(key, is_indexed());
+			return (position == null_position) ? m_pairs.end() : m_pairs.begin() + difference_type(position);
 		}
 		
+		/// @brief Test if a key exists
+		/// @param[in] key A key
+		/// @return 1 if the key exists, 0 otherwise
+		size_t count(key_t const & key) const { return (find(key) == m_pairs.cend()) ? 0 : 1; }
+		
 		// Access
 		
 		/// @brief Value access
@@ -271,21 +337,7 @@ namespace hopp
 		/// @param[in] key   A key
 		/// @param[in] value A value
 		/// @return a iterator to the element inserted
-		iterator insert(key_t const & key, T const & value)
-		{
-			auto const it = find(key);
-			
-			if (it != m_pairs.end())
-			{
-				it->second = value;
-				return it;
-			}
-			else
-			{
-				m_pairs.emplace_back(key, value);
-				return --m_pairs.end();
-			}
-		}
+		iterator insert(key_t const & key, T const & value) { return insert(key, value, is_indexed()); }
 		
 		/// @brief Erase an element
 		/// @param Key A key
@@ -303,7 +355,9 @@ namespace hopp
 		/// @pre the iterator is valid
 		iterator erase(const_iterator const & it)
 		{
-			return m_pairs.erase(it);
+			auto const r = m_pairs.erase(it);
+			rehash();
+			return r;
 		}
 		
 		/// @brief Erase elements between two iterators
@@ -313,11 +367,13 @@ namespace hopp
 		/// @pre the iterators are valid
 		iterator erase(const_iterator const & first, const_iterator const & last)
 		{
-			return m_pairs.erase(first, last);
+			auto const r = m_pairs.erase(first, last);
+			rehash();
+			return r;
 		}
 		
 		/// @brief Remove all elements
-		void clear() { m_pairs.clear(); }
+		void clear() { m_pairs.clear(); m_slots.clear(); }
 		
 		// Iterator
 		
@@ -370,15 +426,131 @@ namespace hopp
 		/// @brief Get reverse iterator to reverse end
 		/// @return reverse iterator to reverse end
 		reverse_iterator rend() { return m_pairs.rend(); }
+		
+	private:
+		
+		/// @brief Find the position of a key with the hash index
+		/// @param[in] key A key
+		/// @return the position of the key in m_pairs, null_position if not found
+		size_t find_position(key_t const & key, std::true_type) const
+		{
+			if (m_slots.empty()) { return null_position; }
+			return m_slots[find_slot(key, m_hash(key))].position;
+		}
+		
+		/// @brief Find the position of a key with a linear search
+		/// @param[in] key A key
+		/// @return the position of the key in m_pairs, null_position if not found
+		size_t find_position(key_t const & key, std::false_type) const
+		{
+			for (size_t position = 0; position < m_pairs.size(); ++position)
+			{
+				if (m_pairs[position].first == key) { return position; }
+			}
+			return null_position;
+		}
+		
+		/// @brief Add an element at the end with the hash index
+		/// @param[in] key   A key
+		/// @param[in] value A value
+		/// @return a iterator to the element inserted
+		iterator insert(key_t const & key, T const & value, std::true_type)
+		{
+			if (2 * (m_pairs.size() + 1) > m_slots.size()) { rehash(m_pairs.size() + 1); }
+			
+			size_t const hash = m_hash(key);
+			slot & s = m_slots[find_slot(key, hash)];
+			
+			if (s.position != null_position)
+			{
+				m_pairs[s.position].second = value;
+				return m_pairs.begin() + difference_type(s.position);
+			}
+			else
+			{
+				m_pairs.emplace_back(key, value);
+				s = slot{ m_pairs.size() - 1, hash };
+				return --m_pairs.end();
+			}
+		}
+		
+		/// @brief Add an element at the end with a linear search
+		/// @param[in] key   A key
+		/// @param[in] value A value
+		/// @return a iterator to the element inserted
+		iterator insert(key_t const & key, T const & value, std::false_type)
+		{
+			auto const it = find(key);
+			
+			if (it != m_pairs.end())
+			{
+				it->second = value;
+				return it;
+			}
+			else
+			{
+				m_pairs.emplace_back(key, value);
+				return --m_pairs.end();
+			}
+		}
+		
+		/// @brief Get the first slot of a hash
+		/// @param[in] hash A hash
+		/// @return the first slot to probe
+		size_t first_slot(size_t const hash) const
+		{
+			// Fibonacci hashing (std::hash of integers is often the identity)
+			return size_t((std::uint64_t(hash) * 0x9E3779B97F4A7C15ull) >> 32) & (m_slots.size() - 1);
+		}
+		
+		/// @brief Find the slot of a key
+		/// @param[in] key  A key
+		/// @param[in] hash Hash of the key
+		/// @return the slot of the key if the key exists, the empty slot where it would be inserted otherwise
+		/// @pre The hash index is not empty
+		size_t find_slot(key_t const & key, size_t const hash) const
+		{
+			size_t const mask = m_slots.size() - 1;
+			for (size_t i = first_slot(hash); ; i = (i + 1) & mask)
+			{
+				slot const & s = m_slots[i];
+				if (s.position == null_position || (s.hash == hash && m_pairs[s.position].first == key)) { return i; }
+			}
+		}
+		
+		/// @brief Rebuild the hash index for at least size keys
+		/// @param[in] size Number of keys
+		void rehash(size_t const size) { rehash(size, is_indexed()); }
+		
+		/// @brief No hash index to rebuild
+		void rehash(size_t const, std::false_type) { }
+		
+		/// @brief Rebuild the hash index for at least size keys
+		/// @param[in] size Number of keys
+		void rehash(size_t const size, std::true_type)
+		{
+			size_t nb_slot = 16;
+			while (nb_slot < 2 * size) { nb_slot *= 2; }
+			m_slots.assign(nb_slot, slot{ null_position, 0 });
+			for (size_t position = 0; position < m_pairs.size(); ++position)
+			{
+				size_t const hash = m_hash(m_pairs[position].first);
+				m_slots[find_slot(m_pairs[position].first, hash)] = slot{ position, hash };
+			}
+		}
 	};
 	
+	// Out-of-class definition (the constant is odr-used)
+	template <class key_t, class T, class hash_t>
+	constexpr size_t hopp::vector_pair<key_t, T, hash_t>::null_position;
+	
 	/// @brief Operator << between a std::ostream and a hopp::vector_pair<key_t, T>
 	/// @param[in,out] out      A std::ostream
 	/// @param[in]     vector_pair A hopp::vector_pair<key_t, T>
 	/// @return out
 	/// @relates hopp::vector_pair
-	template <class key_t, class T>
-	std::ostream & operator <<(std::ostream & out, hopp::vector_pair<key_t, T> const & vector_pair)
+	template <class key_t, class T, class hash_t>
+	std::ostream & operator <<(std::ostream & out, hopp::vector_pair<key_t, T, hash_t> const & vector_pair)
 	{
 		out << hopp::ostreamable(vector_pair.data());
 		return out;
@@ -389,8 +561,8 @@ namespace hopp
 	/// @param[in] b A hopp::vector_pair<key_t, T>
 	/// @return true if a == b, false otherwise
 	/// @relates hopp::vector_pair
-	template <class key_t, class T>
-	bool operator ==(hopp::vector_pair<key_t, T> const & a, hopp::vector_pair<key_t, T> const & b)
+	template <class key_t, class T, class hash_t>
+	bool operator ==(hopp::vector_pair<key_t, T, hash_t> const & a, hopp::vector_pair<key_t, T, hash_t> const & b)
 	{
 		return a.data() == b.data();
 	}
@@ -400,12 +572,12 @@ namespace hopp
 	/// @param[in] b A hopp::vector_pair<key_t, T>
 	/// @return true if a != b, false otherwise
 	/// @relates hopp::vector_pair
-	template <class key_t, class T>
-	bool operator !=(hopp::vector_pair<key_t, T> const & a, hopp::vector_pair<key_t, T> const & b)
+	template <class key_t, class T, class hash_t>
+	bool operator !=(hopp::vector_pair<key_t, T, hash_t> const & a, hopp::vector_pair<key_t, T, hash_t> const & b)
 	{
 		return (a == b) == false;
 	}
 }
 
 #endif
- 
+
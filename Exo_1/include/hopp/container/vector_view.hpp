@@ -109,13 +109,15 @@ namespace hopp
 		/// @return data
 		T & vector() { return *p_vector; }
 		
-		/// @brief Get data
+		/// @brief Get data (pointer to the first value of the view)
+		/// @pre T is contiguous (like std::vector)
 		/// @return data
-		const_pointer data() const { return p_vector->data(); }
+		const_pointer data() const { return p_vector->data() + m_begin; }
 		
-		/// @brief Get data
+		/// @brief Get data (pointer to the first value of the view)
+		/// @pre T is contiguous (like std::vector)
 		/// @return data
-		pointer data() { return p_vector->data(); }
+		pointer data() { return p_vector->data() + m_begin; }
 		
 		// Access: operator [i]
 		
@@ -21,9 +21,13 @@
  * @copydoc hopp::geometry
  */
 
+#include "geometry/bvh.hpp"
+#include "geometry/grid_index.hpp"
 #include "geometry/is_inside.hpp"
 #include "geometry/overlap.hpp"
 #include "geometry/rectangle.hpp"
+#include "geometry/soa_rectangle.hpp"
+#include "geometry/sweep_and_prune.hpp"
 
 
 namespace hopp
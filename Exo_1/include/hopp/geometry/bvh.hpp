@@ -0,0 +1,588 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_GEOMETRY_BVH_HPP
+#define HOPP_GEOMETRY_BVH_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "rectangle.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Spatial index of hopp::rectangle<T> with a bounding volume hierarchy (dynamic AABB tree)
+	 *
+	 * Binary tree of bounding boxes: the bulk load splits the rectangles at the median of the longest axis, insert() descends to the sibling which increases the perimeters the least and the tree is rebalanced with rotations (the height stays in O(log n)). @n
+	 * Unlike hopp::grid_index<T>, the rectangles can have very different sizes and do not need bounds. @n
+	 * Two rectangles overlap if they intersect, borders included. @n
+	 * The identifiers are the indexes of the bulk loaded rectangles, then the values returned by insert() (the identifiers of the removed rectangles are reused).
+	 *
+	 * @code
+	   #include <hopp/geometry.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   std::vector<hopp::rectangle<float>> rectangles = ...;
+	   hopp::bvh<float> index(rectangles);
+	   size_t const id = index.insert(hopp::rectangle<float>(5, 5, 2, 2));
+	   std::vector<size_t> const ids = index.query(hopp::rectangle<float>(0, 0, 50, 50));
+	   index.for_each_overlap([](size_t const a, size_t const b) { std::cout << a << " overlaps " << b << std::endl; });
+	   index.remove(id);
+	   @endcode
+	 *
+	 * @ingroup hopp_geometry
+	 */
+	template <class T>
+	class bvh
+	{
+	private:
+		
+		/// No node
+		static constexpr size_t null_node = size_t(-1);
+		
+		/// Axis-aligned bounding box
+		class box
+		{
+		public:
+			
+			/// Left coordinate
+			T left;
+			
+			/// Top coordinate
+			T top;
+			
+			/// Right coordinate
+			T right;
+			
+			/// Bottom coordinate
+			T bottom;
+			
+			/// @brief Default constructor
+			box() : left(), top(), right(), bottom() { }
+			
+			/// @brief Constructor from a hopp::rectangle<T>
+			/// @param[in] rectangle A hopp::rectangle<T>
+			explicit box(hopp::rectangle<T> const & rectangle) :
+				left(rectangle.left), top(rectangle.top), right(rectangle.right()), bottom(rectangle.bottom())
+			{ }
+			
+			/// @brief Constructor (union of two boxes)
+			/// @param[in] a A box
+			/// @param[in] b A box
+			box(box const & a, box const & b) :
+				left(std::min(a.left, b.left)), top(std::min(a.top, b.top)), right(std::max(a.right, b.right)), bottom(std::max(a.bottom, b.bottom))
+			{ }
+			
+			/// @brief Return the perimeter (the cost of the box)
+			/// @return the perimeter
+			T perimeter() const { return T(2) * ((right - left) + (bottom - top)); }
+			
+			/// @brief Test if two boxes intersect (borders included)
+			/// @param[in] b A box
+			/// @return true if the boxes intersect, false otherwise
+			bool intersect(box const & b) const { return left <= b.right && b.left <= right && top <= b.bottom && b.top <= bottom; }
+		};
+		
+		/// Node of the tree (a leaf is a rectangle)
+		class node
+		{
+		public:
+			
+			/// Bounding box
+			box bounds;
+			
+			/// Identifier of the rectangle (leaf only)
+			size_t id;
+			
+			/// Parent (or next free node)
+			size_t parent;
+			
+			/// First child (null_node for a leaf)
+			size_t child_1;
+			
+			/// Second child (null_node for a leaf)
+			size_t child_2;
+			
+			/// Height (0 for a leaf)
+			int height;
+			
+			/// @brief Return true if the node is a leaf
+			/// @return true if the node is a leaf, false otherwise
+			bool is_leaf() const { return child_1 == null_node; }
+		};
+		
+		/// Nodes
+		std::vector<node> m_nodes;
+		
+		/// Root
+		size_t m_root;
+		
+		/// First free node
+		size_t m_free_node;
+		
+		/// Leaf of each identifier (null_node if the identifier is not used)
+		std::vector<size_t> m_leaves;
+		
+		/// Removed identifiers
+		std::vector<size_t> m_free_ids;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] rectangles Rectangles to bulk load (their identifiers are their indexes)
+		explicit bvh(std::vector<hopp::rectangle<T>> const & rectangles = std::vector<hopp::rectangle<T>>()) :
+			m_nodes(), m_root(null_node), m_free_node(null_node), m_leaves(rectangles.size()), m_free_ids()
+		{
+			if (rectangles.empty()) { return; }
+			
+			m_nodes.reserve(2 * rectangles.size() - 1);
+			m_nodes.resize(rectangles.size());
+			for (size_t id = 0; id < rectangles.size(); ++id)
+			{
+				node & leaf = m_nodes[id];
+				leaf.bounds = box(rectangles[id]);
+				leaf.id = id;
+				leaf.parent = null_node;
+				leaf.child_1 = null_node;
+				leaf.child_2 = null_node;
+				leaf.height = 0;
+				m_leaves[id] = id;
+			}
+			
+			std::vector<size_t> ids(rectangles.size());
+			for (size_t id = 0; id < ids.size(); ++id) { ids[id] = id; }
+			m_root = build(ids.data(), ids.data() + ids.size());
+		}
+		
+		/// @brief Return the number of rectangles
+		/// @return the number of rectangles
+		size_t size() const { return m_leaves.size() - m_free_ids.size(); }
+		
+		/// @brief Return the height of the tree (0 if there is 0 or 1 rectangle)
+		/// @return the height of the tree
+		size_t height() const { return (m_root == null_node) ? 0 : size_t(m_nodes[m_root].height); }
+		
+		/// @brief Check if an identifier is used
+		/// @param[in] id Identifier
+		/// @return true if the identifier is used, false otherwise
+		bool contains(size_t const id) const { return id < m_leaves.size() && m_leaves[id] != null_node; }
+		
+		/// @brief Get a rectangle
+		/// @param[in] id Identifier of the rectangle
+		/// @return the rectangle (computed from its bounding box, the width and the height can be rounded with floating point numbers)
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		hopp::rectangle<T> get(size_t const id) const
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::bvh<T>::get(id): invalid id"); }
+			#endif
+			
+			box const & b = m_nodes[m_leaves[id]].bounds;
+			return hopp::rectangle<T>(b.left, b.top, b.right - b.left, b.bottom - b.top);
+		}
+		
+		/// @brief Insert a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @return the identifier of the rectangle
+		size_t insert(hopp::rectangle<T> const & rectangle)
+		{
+			size_t id = m_leaves.size();
+			if (m_free_ids.empty()) { m_leaves.push_back(null_node); }
+			else
+			{
+				id = m_free_ids.back();
+				m_free_ids.pop_back();
+			}
+			
+			size_t const index = allocate_node();
+			node & leaf = m_nodes[index];
+			leaf.bounds = box(rectangle);
+			leaf.id = id;
+			leaf.child_1 = null_node;
+			leaf.child_2 = null_node;
+			leaf.height = 0;
+			m_leaves[id] = index;
+			insert_leaf(index);
+			return id;
+		}
+		
+		/// @brief Remove a rectangle
+		/// @param[in] id Identifier of the rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void remove(size_t const id)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::bvh<T>::remove(id): invalid id"); }
+			#endif
+			
+			remove_leaf(m_leaves[id]);
+			free_node(m_leaves[id]);
+			m_leaves[id] = null_node;
+			m_free_ids.push_back(id);
+		}
+		
+		/// @brief Move a rectangle (the identifier does not change)
+		/// @param[in] id        Identifier of the rectangle
+		/// @param[in] rectangle New rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void update(size_t const id, hopp::rectangle<T> const & rectangle)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::bvh<T>::update(id, rectangle): invalid id"); }
+			#endif
+			
+			size_t const index = m_leaves[id];
+			remove_leaf(index);
+			m_nodes[index].bounds = box(rectangle);
+			insert_leaf(index);
+		}
+		
+		/// @brief Call f(id) for each rectangle which overlaps a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @param[in] f         Function called with a size_t
+		template <class function_t>
+		void query(hopp::rectangle<T> const & rectangle, function_t f) const
+		{
+			if (m_root == null_node) { return; }
+			
+			box const b(rectangle);
+			std::vector<size_t> stack(1, m_root);
+			while (stack.empty() == false)
+			{
+				node const & n = m_nodes[stack.back()];
+				stack.pop_back();
+				
+				if (n.bounds.intersect(b) == false) { continue; }
+				if (n.is_leaf()) { f(n.id); }
+				else
+				{
+					stack.push_back(n.child_1);
+					stack.push_back(n.child_2);
+				}
+			}
+		}
+		
+		/// @brief Get the identifiers of the rectangles which overlap a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @return the identifiers (in an unspecified order)
+		std::vector<size_t> query(hopp::rectangle<T> const & rectangle) const
+		{
+			std::vector<size_t> r;
+			query(rectangle, [&r](size_t const id) { r.push_back(id); });
+			return r;
+		}
+		
+		/// @brief Call f(a, b) with a < b for each pair of overlapping rectangles (once per pair)
+		/// @param[in] f Function called with two size_t
+		template <class function_t>
+		void for_each_overlap(function_t f) const
+		{
+			if (m_root == null_node) { return; }
+			
+			// Traverse the tree against itself
+			std::vector<std::pair<size_t, size_t>> stack(1, std::make_pair(m_root, m_root));
+			while (stack.empty() == false)
+			{
+				size_t const a = stack.back().first;
+				size_t const b = stack.back().second;
+				stack.pop_back();
+				node const & node_a = m_nodes[a];
+				node const & node_b = m_nodes[b];
+				
+				if (a == b)
+				{
+					if (node_a.is_leaf()) { continue; }
+					stack.emplace_back(node_a.child_1, node_a.child_1);
+					stack.emplace_back(node_a.child_2, node_a.child_2);
+					stack.emplace_back(node_a.child_1, node_a.child_2);
+				}
+				else if (node_a.bounds.intersect(node_b.bounds) == false) { continue; }
+				else if (node_a.is_leaf() && node_b.is_leaf()) { f(std::min(node_a.id, node_b.id), std::max(node_a.id, node_b.id)); }
+				// Descend in the highest node
+				else if (node_b.is_leaf() || (node_a.is_leaf() == false && node_a.height >= node_b.height))
+				{
+					stack.emplace_back(node_a.child_1, b);
+					stack.emplace_back(node_a.child_2, b);
+				}
+				else
+				{
+					stack.emplace_back(a, node_b.child_1);
+					stack.emplace_back(a, node_b.child_2);
+				}
+			}
+		}
+		
+		/// @brief Get all the pairs of overlapping rectangles
+		/// @return the pairs (a, b) with a < b (in an unspecified order)
+		std::vector<std::pair<size_t, size_t>> overlaps() const
+		{
+			std::vector<std::pair<size_t, size_t>> r;
+			for_each_overlap([&r](size_t const a, size_t const b) { r.emplace_back(a, b); });
+			return r;
+		}
+		
+	private:
+		
+		/// @brief Build a subtree with the median split (bulk load)
+		/// @param[in] first First leaf
+		/// @param[in] last  End of the leaves (not included)
+		/// @return the root of the subtree
+		size_t build(size_t * const first, size_t * const last)
+		{
+			if (last - first == 1) { return *first; }
+			
+			// Bounds of the centers (doubled to stay exact with integers)
+			box centers(m_nodes[*first].bounds);
+			centers.left = centers.right = m_nodes[*first].bounds.left + m_nodes[*first].bounds.right;
+			centers.top = centers.bottom = m_nodes[*first].bounds.top + m_nodes[*first].bounds.bottom;
+			for (size_t * it = first; it != last; ++it)
+			{
+				box const & b = m_nodes[*it].bounds;
+				centers.left = std::min(centers.left, T(b.left + b.right));
+				centers.right = std::max(centers.right, T(b.left + b.right));
+				centers.top = std::min(centers.top, T(b.top + b.bottom));
+				centers.bottom = std::max(centers.bottom, T(b.top + b.bottom));
+			}
+			
+			size_t * const middle = first + (last - first) / 2;
+			if (centers.right - centers.left >= centers.bottom - centers.top)
+			{
+				std::nth_element
+				(
+					first, middle, last,
+					[this](size_t const a, size_t const b)
+					{ return m_nodes[a].bounds.left + m_nodes[a].bounds.right < m_nodes[b].bounds.left + m_nodes[b].bounds.right; }
+				);
+			}
+			else
+			{
+				std::nth_element
+				(
+					first, middle, last,
+					[this](size_t const a, size_t const b)
+					{ return m_nodes[a].bounds.top + m_nodes[a].bounds.bottom < m_nodes[b].bounds.top + m_nodes[b].bounds.bottom; }
+				);
+			}
+			
+			size_t const child_1 = build(first, middle);
+			size_t const child_2 = build(middle, last);
+			
+			node parent;
+			parent.bounds = box(m_nodes[child_1].bounds, m_nodes[child_2].bounds);
+			parent.id = null_node;
+			parent.parent = null_node;
+			parent.child_1 = child_1;
+			parent.child_2 = child_2;
+			parent.height = 1 + std::max(m_nodes[child_1].height, m_nodes[child_2].height);
+			m_nodes.push_back(parent);
+			
+			size_t const index = m_nodes.size() - 1;
+			m_nodes[child_1].parent = index;
+			m_nodes[child_2].parent = index;
+			return index;
+		}
+		
+		/// @brief Get a free node
+		/// @return the index of the node
+		size_t allocate_node()
+		{
+			if (m_free_node == null_node)
+			{
+				m_nodes.emplace_back();
+				m_nodes.back().parent = null_node;
+				return m_nodes.size() - 1;
+			}
+			
+			size_t const index = m_free_node;
+			m_free_node = m_nodes[index].parent;
+			m_nodes[index].parent = null_node;
+			return index;
+		}
+		
+		/// @brief Free a node
+		/// @param[in] index Index of the node
+		void free_node(size_t const index)
+		{
+			m_nodes[index].parent = m_free_node;
+			m_free_node = index;
+		}
+		
+		/// @brief Insert a leaf in the tree
+		/// @param[in] leaf Index of the leaf
+		void insert_leaf(size_t const leaf)
+		{
+			if (m_root == null_node)
+			{
+				m_root = leaf;
+				m_nodes[leaf].parent = null_node;
+				return;
+			}
+			
+			// Find the best sibling
+			box const leaf_box = m_nodes[leaf].bounds;
+			size_t index = m_root;
+			while (m_nodes[index].is_leaf() == false)
+			{
+				node const & n = m_nodes[index];
+				T const combined_cost = box(n.bounds, leaf_box).perimeter();
+				
+				// Cost of a new parent for this node and the leaf, and cost pushed down to the children
+				T const cost = combined_cost;
+				T const inheritance_cost = combined_cost - n.bounds.perimeter();
+				
+				auto const descend_cost = [&](size_t const child) -> T
+				{
+					node const & c = m_nodes[child];
+					T const child_cost = box(c.bounds, leaf_box).perimeter();
+					return (c.is_leaf()) ? child_cost + inheritance_cost : child_cost - c.bounds.perimeter() + inheritance_cost;
+				};
+				T const cost_1 = descend_cost(n.child_1);
+				T const cost_2 = descend_cost(n.child_2);
+				
+				if (cost < cost_1 && cost < cost_2) { break; }
+				index = (cost_1 < cost_2) ? n.child_1 : n.child_2;
+			}
+			size_t const sibling = index;
+			
+			// Create a new parent
+			size_t const old_parent = m_nodes[sibling].parent;
+			size_t const new_parent = allocate_node();
+			m_nodes[new_parent].parent = old_parent;
+			m_nodes[new_parent].bounds = box(leaf_box, m_nodes[sibling].bounds);
+			m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+			m_nodes[new_parent].child_1 = sibling;
+			m_nodes[new_parent].child_2 = leaf;
+			m_nodes[sibling].parent = new_parent;
+			m_nodes[leaf].parent = new_parent;
+			
+			if (old_parent == null_node) { m_root = new_parent; }
+			else if (m_nodes[old_parent].child_1 == sibling) { m_nodes[old_parent].child_1 = new_parent; }
+			else { m_nodes[old_parent].child_2 = new_parent; }
+			
+			refit(m_nodes[leaf].parent);
+		}
+		
+		/// @brief Remove a leaf from the tree (the node is not freed)
+		/// @param[in] leaf Index of the leaf
+		void remove_leaf(size_t const leaf)
+		{
+			if (leaf == m_root)
+			{
+				m_root = null_node;
+				return;
+			}
+			
+			size_t const parent = m_nodes[leaf].parent;
+			size_t const grand_parent = m_nodes[parent].parent;
+			size_t const sibling = (m_nodes[parent].child_1 == leaf) ? m_nodes[parent].child_2 : m_nodes[parent].child_1;
+			
+			// The sibling replaces the parent
+			if (grand_parent == null_node)
+			{
+				m_root = sibling;
+				m_nodes[sibling].parent = null_node;
+			}
+			else
+			{
+				if (m_nodes[grand_parent].child_1 == parent) { m_nodes[grand_parent].child_1 = sibling; }
+				else { m_nodes[grand_parent].child_2 = sibling; }
+				m_nodes[sibling].parent = grand_parent;
+			}
+			free_node(parent);
+			m_nodes[leaf].parent = null_node;
+			
+			refit(grand_parent);
+		}
+		
+		/// @brief Rebalance and update the boxes and the heights from a node to the root
+		/// @param[in] index Index of the node
+		void refit(size_t index)
+		{
+			while (index != null_node)
+			{
+				index = balance(index);
+				node & n = m_nodes[index];
+				n.height = 1 + std::max(m_nodes[n.child_1].height, m_nodes[n.child_2].height);
+				n.bounds = box(m_nodes[n.child_1].bounds, m_nodes[n.child_2].bounds);
+				index = n.parent;
+			}
+		}
+		
+		/// @brief Rotate a child up if the heights of the children of a node differ by more than 1
+		/// @param[in] a Index of the node
+		/// @return the index of the node now at the position of a
+		size_t balance(size_t const a)
+		{
+			if (m_nodes[a].is_leaf() || m_nodes[a].height < 2) { return a; }
+			
+			size_t const b = m_nodes[a].child_1;
+			size_t const c = m_nodes[a].child_2;
+			int const difference = m_nodes[c].height - m_nodes[b].height;
+			
+			if (difference > 1) { return rotate(a, c, b, false); }
+			if (difference < -1) { return rotate(a, b, c, true); }
+			return a;
+		}
+		
+		/// @brief Rotate the child up (it becomes the parent of a)
+		/// @param[in] a             Index of the node
+		/// @param[in] up            Index of the highest child of a
+		/// @param[in] other         Index of the other child of a
+		/// @param[in] up_is_child_1 true if up is the first child of a
+		/// @return up
+		size_t rotate(size_t const a, size_t const up, size_t const other, bool const up_is_child_1)
+		{
+			size_t const f = m_nodes[up].child_1;
+			size_t const g = m_nodes[up].child_2;
+			
+			// up becomes the parent of a
+			m_nodes[up].child_1 = a;
+			m_nodes[up].parent = m_nodes[a].parent;
+			m_nodes[a].parent = up;
+			
+			if (m_nodes[up].parent == null_node) { m_root = up; }
+			else if (m_nodes[m_nodes[up].parent].child_1 == a) { m_nodes[m_nodes[up].parent].child_1 = up; }
+			else { m_nodes[m_nodes[up].parent].child_2 = up; }
+			
+			// The highest grandchild stays with up, the other one replaces up in a
+			size_t const high = (m_nodes[f].height > m_nodes[g].height) ? f : g;
+			size_t const low = (high == f) ? g : f;
+			
+			m_nodes[up].child_2 = high;
+			if (up_is_child_1) { m_nodes[a].child_1 = low; }
+			else { m_nodes[a].child_2 = low; }
+			m_nodes[low].parent = a;
+			
+			m_nodes[a].bounds = box(m_nodes[other].bounds, m_nodes[low].bounds);
+			m_nodes[a].height = 1 + std::max(m_nodes[other].height, m_nodes[low].height);
+			m_nodes[up].bounds = box(m_nodes[a].bounds, m_nodes[high].bounds);
+			m_nodes[up].height = 1 + std::max(m_nodes[a].height, m_nodes[high].height);
+			
+			return up;
+		}
+	};
+	
+	/// No node
+	template <class T>
+	constexpr size_t hopp::bvh<T>::null_node;
+}
+
+#endif
@@ -0,0 +1,339 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_GEOMETRY_GRID_INDEX_HPP
+#define HOPP_GEOMETRY_GRID_INDEX_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+#include "rectangle.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Spatial index of hopp::rectangle<T> with a uniform grid
+	 *
+	 * Each rectangle is stored in all the cells it covers (the rectangles outside the bounds are stored in the border cells). @n
+	 * Efficient when the rectangles have similar sizes: choose a cell size close to the size of the rectangles, see hopp::bvh<T> otherwise. @n
+	 * Two rectangles overlap if they intersect, borders included. @n
+	 * The identifiers are the indexes of the bulk loaded rectangles, then the values returned by insert() (the identifiers of the removed rectangles are reused).
+	 *
+	 * @code
+	   #include <hopp/geometry.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   std::vector<hopp::rectangle<float>> rectangles = ...;
+	   hopp::grid_index<float> index(hopp::rectangle<float>(0, 0, 1000, 1000), 10, rectangles);
+	   size_t const id = index.insert(hopp::rectangle<float>(5, 5, 2, 2));
+	   std::vector<size_t> const ids = index.query(hopp::rectangle<float>(0, 0, 50, 50));
+	   index.for_each_overlap([](size_t const a, size_t const b) { std::cout << a << " overlaps " << b << std::endl; });
+	   index.remove(id);
+	   @endcode
+	 *
+	 * @ingroup hopp_geometry
+	 */
+	template <class T>
+	class grid_index
+	{
+	private:
+		
+		/// Bounds of the grid
+		hopp::rectangle<T> m_bounds;
+		
+		/// Size of a cell
+		T m_cell_size;
+		
+		/// Number of cells along x
+		size_t m_nb_cell_x;
+		
+		/// Number of cells along y
+		size_t m_nb_cell_y;
+		
+		/// Identifiers of the rectangles in each cell (row-major)
+		std::vector<std::vector<size_t>> m_cells;
+		
+		/// Rectangles (by identifier)
+		std::vector<hopp::rectangle<T>> m_rectangles;
+		
+		/// Identifier is used
+		std::vector<bool> m_used;
+		
+		/// Removed identifiers
+		std::vector<size_t> m_free_ids;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] bounds     Bounds of the grid
+		/// @param[in] cell_size  Size of a cell (> 0)
+		/// @param[in] rectangles Rectangles to bulk load (their identifiers are their indexes)
+		/// @exception std::invalid_argument if cell_size <= 0
+		grid_index
+		(
+			hopp::rectangle<T> const & bounds,
+			T const & cell_size,
+			std::vector<hopp::rectangle<T>> const & rectangles = std::vector<hopp::rectangle<T>>()
+		) :
+			m_bounds(bounds),
+			m_cell_size(cell_size),
+			m_nb_cell_x(0),
+			m_nb_cell_y(0),
+			m_cells(),
+			m_rectangles(rectangles),
+			m_used(rectangles.size(), true),
+			m_free_ids()
+		{
+			if ((cell_size > T(0)) == false) { throw std::invalid_argument("hopp::grid_index<T>::grid_index(bounds, cell_size, rectangles): cell_size must be > 0"); }
+			
+			m_nb_cell_x = std::max(size_t(1), size_t(std::ceil(double(bounds.width) / double(cell_size))));
+			m_nb_cell_y = std::max(size_t(1), size_t(std::ceil(double(bounds.height) / double(cell_size))));
+			m_cells.resize(m_nb_cell_x * m_nb_cell_y);
+			
+			// Count then fill to allocate each cell once
+			std::vector<size_t> count(m_cells.size(), 0);
+			for (auto const & r : m_rectangles) { for_each_cell(r, [&count](size_t const cell) { ++count[cell]; }); }
+			for (size_t cell = 0; cell < m_cells.size(); ++cell) { m_cells[cell].reserve(count[cell]); }
+			for (size_t id = 0; id < m_rectangles.size(); ++id) { add_to_cells(id); }
+		}
+		
+		/// @brief Return the number of rectangles
+		/// @return the number of rectangles
+		size_t size() const { return m_rectangles.size() - m_free_ids.size(); }
+		
+		/// @brief Return the number of cells along x
+		/// @return the number of cells along x
+		size_t nb_cell_x() const { return m_nb_cell_x; }
+		
+		/// @brief Return the number of cells along y
+		/// @return the number of cells along y
+		size_t nb_cell_y() const { return m_nb_cell_y; }
+		
+		/// @brief Check if an identifier is used
+		/// @param[in] id Identifier
+		/// @return true if the identifier is used, false otherwise
+		bool contains(size_t const id) const { return id < m_used.size() && m_used[id]; }
+		
+		/// @brief Get a rectangle
+		/// @param[in] id Identifier of the rectangle
+		/// @return the rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		hopp::rectangle<T> const & get(size_t const id) const
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::grid_index<T>::get(id): invalid id"); }
+			#endif
+			
+			return m_rectangles[id];
+		}
+		
+		/// @brief Insert a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @return the identifier of the rectangle
+		size_t insert(hopp::rectangle<T> const & rectangle)
+		{
+			size_t id = m_rectangles.size();
+			if (m_free_ids.empty())
+			{
+				m_rectangles.push_back(rectangle);
+				m_used.push_back(true);
+			}
+			else
+			{
+				id = m_free_ids.back();
+				m_free_ids.pop_back();
+				m_rectangles[id] = rectangle;
+				m_used[id] = true;
+			}
+			add_to_cells(id);
+			return id;
+		}
+		
+		/// @brief Remove a rectangle
+		/// @param[in] id Identifier of the rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void remove(size_t const id)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::grid_index<T>::remove(id): invalid id"); }
+			#endif
+			
+			remove_from_cells(id);
+			m_used[id] = false;
+			m_free_ids.push_back(id);
+		}
+		
+		/// @brief Move a rectangle (the identifier does not change)
+		/// @param[in] id        Identifier of the rectangle
+		/// @param[in] rectangle New rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void update(size_t const id, hopp::rectangle<T> const & rectangle)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::grid_index<T>::update(id, rectangle): invalid id"); }
+			#endif
+			
+			remove_from_cells(id);
+			m_rectangles[id] = rectangle;
+			add_to_cells(id);
+		}
+		
+		/// @brief Call f(id) for each rectangle which overlaps a rectangle (once per rectangle)
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @param[in] f         Function called with a size_t
+		template <class function_t>
+		void query(hopp::rectangle<T> const & rectangle, function_t f) const
+		{
+			for_each_cell
+			(
+				rectangle,
+				[&](size_t const cell)
+				{
+					for (size_t const id : m_cells[cell])
+					{
+						hopp::rectangle<T> const & r = m_rectangles[id];
+						// Report the rectangle in the cell of the top-left corner of the intersection only
+						if (intersect(r, rectangle) && cell_of(std::max(r.left, rectangle.left), std::max(r.top, rectangle.top)) == cell) { f(id); }
+					}
+				}
+			);
+		}
+		
+		/// @brief Get the identifiers of the rectangles which overlap a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @return the identifiers (in an unspecified order)
+		std::vector<size_t> query(hopp::rectangle<T> const & rectangle) const
+		{
+			std::vector<size_t> r;
+			query(rectangle, [&r](size_t const id) { r.push_back(id); });
+			return r;
+		}
+		
+		/// @brief Call f(a, b) with a < b for each pair of overlapping rectangles (once per pair)
+		/// @param[in] f Function called with two size_t
+		template <class function_t>
+		void for_each_overlap(function_t f) const
+		{
+			for (size_t cell = 0; cell < m_cells.size(); ++cell)
+			{
+				std::vector<size_t> const & ids = m_cells[cell];
+				for (size_t i = 0; i < ids.size(); ++i)
+				{
+					hopp::rectangle<T> const & a = m_rectangles[ids[i]];
+					for (size_t j = i + 1; j < ids.size(); ++j)
+					{
+						hopp::rectangle<T> const & b = m_rectangles[ids[j]];
+						// Report the pair in the cell of the top-left corner of the intersection only
+						if (intersect(a, b) && cell_of(std::max(a.left, b.left), std::max(a.top, b.top)) == cell)
+						{
+							f(std::min(ids[i], ids[j]), std::max(ids[i], ids[j]));
+						}
+					}
+				}
+			}
+		}
+		
+		/// @brief Get all the pairs of overlapping rectangles
+		/// @return the pairs (a, b) with a < b (in an unspecified order)
+		std::vector<std::pair<size_t, size_t>> overlaps() const
+		{
+			std::vector<std::pair<size_t, size_t>> r;
+			for_each_overlap([&r](size_t const a, size_t const b) { r.emplace_back(a, b); });
+			return r;
+		}
+		
+	private:
+		
+		/// @brief Test if two rectangles intersect (borders included)
+		/// @param[in] a A hopp::rectangle<T>
+		/// @param[in] b A hopp::rectangle<T>
+		/// @return true if the rectangles intersect, false otherwise
+		static bool intersect(hopp::rectangle<T> const & a, hopp::rectangle<T> const & b)
+		{
+			return a.left <= b.right() && b.left <= a.right() && a.top <= b.bottom() && b.top <= a.bottom();
+		}
+		
+		/// @brief Get the cell index along an axis (clamped)
+		/// @param[in] x        Coordinate
+		/// @param[in] origin   Coordinate of the grid
+		/// @param[in] nb_cell  Number of cells along the axis
+		/// @return the cell index
+		size_t cell_index(T const & x, T const & origin, size_t const nb_cell) const
+		{
+			double const k = std::floor(double(x - origin) / double(m_cell_size));
+			if (k <= 0) { return 0; }
+			if (k >= double(nb_cell - 1)) { return nb_cell - 1; }
+			return size_t(k);
+		}
+		
+		/// @brief Get the cell of a point
+		/// @param[in] x X coordinate
+		/// @param[in] y Y coordinate
+		/// @return the cell (row-major index)
+		size_t cell_of(T const & x, T const & y) const
+		{
+			return cell_index(y, m_bounds.top, m_nb_cell_y) * m_nb_cell_x + cell_index(x, m_bounds.left, m_nb_cell_x);
+		}
+		
+		/// @brief Call f(cell) for each cell covered by a rectangle
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @param[in] f         Function called with a size_t
+		template <class function_t>
+		void for_each_cell(hopp::rectangle<T> const & rectangle, function_t f) const
+		{
+			size_t const first_x = cell_index(rectangle.left, m_bounds.left, m_nb_cell_x);
+			size_t const last_x = cell_index(rectangle.right(), m_bounds.left, m_nb_cell_x);
+			size_t const first_y = cell_index(rectangle.top, m_bounds.top, m_nb_cell_y);
+			size_t const last_y = cell_index(rectangle.bottom(), m_bounds.top, m_nb_cell_y);
+			
+			for (size_t y = first_y; y <= last_y; ++y)
+			{
+				for (size_t x = first_x; x <= last_x; ++x) { f(y * m_nb_cell_x + x); }
+			}
+		}
+		
+		/// @brief Add a rectangle in its cells
+		/// @param[in] id Identifier of the rectangle
+		void add_to_cells(size_t const id)
+		{
+			for_each_cell(m_rectangles[id], [this, id](size_t const cell) { m_cells[cell].push_back(id); });
+		}
+		
+		/// @brief Remove a rectangle from its cells
+		/// @param[in] id Identifier of the rectangle
+		void remove_from_cells(size_t const id)
+		{
+			for_each_cell
+			(
+				m_rectangles[id],
+				[this, id](size_t const cell)
+				{
+					std::vector<size_t> & ids = m_cells[cell];
+					auto const it = std::find(ids.begin(), ids.end(), id);
+					*it = ids.back();
+					ids.pop_back();
+				}
+			);
+		}
+	};
+}
+
+#endif
@@ -27,6 +27,9 @@ namespace hopp
 		/**
 		 * @brief Check the intersection between two rectangles
 		 *
+		 * Min/max interval tests on both axes (borders included), the rectangles which cross without any corner inside the other one overlap. @n
+		 * See hopp::geometry::overlap(rectangle, soa_rectangle) to test one rectangle against many rectangles.
+		 *
 		 * @code
 		   #include <hopp/geometry.hpp>
 		   @endcode
@@ -42,17 +45,7 @@ namespace hopp
 		template <class T>
 		bool overlap(hopp::rectangle<T> const & a, hopp::rectangle<T> const & b)
 		{
-			if (hopp::geometry::is_inside(a.left, a.top, b)) { return true; }
-			if (hopp::geometry::is_inside(a.right(), a.top, b)) { return true; }
-			if (hopp::geometry::is_inside(a.left, a.bottom(), b)) { return true; }
-			if (hopp::geometry::is_inside(a.right(), a.bottom(), b)) { return true; }
-			
-			if (hopp::geometry::is_inside(b.left, b.top, a)) { return true; }
-			if (hopp::geometry::is_inside(b.right(), b.top, a)) { return true; }
-			if (hopp::geometry::is_inside(b.left, b.bottom(), a)) { return true; }
-			if (hopp::geometry::is_inside(b.right(), b.bottom(), a)) { return true; }
-			
-			return false;
+			return (a.left <= b.right()) & (b.left <= a.right()) & (a.top <= b.bottom()) & (b.top <= a.bottom());
 		}
 	}
 }
@@ -0,0 +1,374 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_GEOMETRY_SOA_RECTANGLE_HPP
+#define HOPP_GEOMETRY_SOA_RECTANGLE_HPP
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#endif
+
+#include "rectangle.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Structure of arrays of hopp::rectangle<T>: all the left, all the top, all the right and all the bottom coordinates
+	 *
+	 * Layout for hopp::geometry::overlap(rectangle, soa_rectangle) which tests one rectangle against all the rectangles at once.
+	 *
+	 * @code
+	   #include <hopp/geometry.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::soa_rectangle<float> candidates;
+	   candidates.push_back(hopp::rectangle<float>(0, 0, 10, 10));
+	   candidates.push_back(hopp::rectangle<float>(20, 20, 10, 10));
+	   std::vector<std::uint64_t> const mask = hopp::geometry::overlap(hopp::rectangle<float>(5, 5, 1, 1), candidates);
+	   // mask[0] == 0b01
+	   @endcode
+	 *
+	 * @ingroup hopp_geometry
+	 */
+	template <class T>
+	class soa_rectangle
+	{
+	private:
+		
+		/// Left coordinates
+		std::vector<T> m_left;
+		
+		/// Top coordinates
+		std::vector<T> m_top;
+		
+		/// Right coordinates
+		std::vector<T> m_right;
+		
+		/// Bottom coordinates
+		std::vector<T> m_bottom;
+		
+	public:
+		
+		/// @brief Default constructor
+		soa_rectangle() : m_left(), m_top(), m_right(), m_bottom() { }
+		
+		/// @brief Constructor from an array of structures
+		/// @param[in] rectangles A std::vector<hopp::rectangle<T>>
+		explicit soa_rectangle(std::vector<hopp::rectangle<T>> const & rectangles) :
+			soa_rectangle()
+		{
+			reserve(rectangles.size());
+			for (auto const & rectangle : rectangles) { push_back(rectangle); }
+		}
+		
+		/// @brief Return the number of rectangles
+		/// @return the number of rectangles
+		size_t size() const { return m_left.size(); }
+		
+		/// @brief Return true if there is no rectangle
+		/// @return true if there is no rectangle, false otherwise
+		bool empty() const { return m_left.empty(); }
+		
+		/// @brief Reserve memory
+		/// @param[in] capacity Number of rectangles
+		void reserve(size_t const capacity)
+		{
+			m_left.reserve(capacity);
+			m_top.reserve(capacity);
+			m_right.reserve(capacity);
+			m_bottom.reserve(capacity);
+		}
+		
+		/// @brief Remove all the rectangles
+		void clear()
+		{
+			m_left.clear();
+			m_top.clear();
+			m_right.clear();
+			m_bottom.clear();
+		}
+		
+		/// @brief Add a rectangle at the end
+		/// @param[in] rectangle A hopp::rectangle<T>
+		void push_back(hopp::rectangle<T> const & rectangle)
+		{
+			m_left.push_back(rectangle.left);
+			m_top.push_back(rectangle.top);
+			m_right.push_back(rectangle.right());
+			m_bottom.push_back(rectangle.bottom());
+		}
+		
+		/// @brief Set the rectangle i
+		/// @param[in] i         Index
+		/// @param[in] rectangle A hopp::rectangle<T>
+		void set(size_t const i, hopp::rectangle<T> const & rectangle)
+		{
+			m_left[i] = rectangle.left;
+			m_top[i] = rectangle.top;
+			m_right[i] = rectangle.right();
+			m_bottom[i] = rectangle.bottom();
+		}
+		
+		/// @brief Get the rectangle i (a copy)
+		/// @param[in] i Index
+		/// @return the rectangle i
+		hopp::rectangle<T> operator [](size_t const i) const
+		{
+			return hopp::rectangle<T>(m_left[i], m_top[i], m_right[i] - m_left[i], m_bottom[i] - m_top[i]);
+		}
+		
+		/// @brief Get the left coordinates
+		/// @return a pointer to the size() left coordinates
+		T const * left() const { return m_left.data(); }
+		
+		/// @brief Get the top coordinates
+		/// @return a pointer to the size() top coordinates
+		T const * top() const { return m_top.data(); }
+		
+		/// @brief Get the right coordinates
+		/// @return a pointer to the size() right coordinates
+		T const * right() const { return m_right.data(); }
+		
+		/// @brief Get the bottom coordinates
+		/// @return a pointer to the size() bottom coordinates
+		T const * bottom() const { return m_bottom.data(); }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::soa_rectangle<T>
+	/// @param[in,out] out        A std::ostream
+	/// @param[in]     rectangles A hopp::soa_rectangle<T>
+	/// @return out
+	/// @relates hopp::soa_rectangle
+	template <class T>
+	std::ostream & operator <<(std::ostream & out, hopp::soa_rectangle<T> const & rectangles)
+	{
+		out << "{";
+		for (size_t i = 0; i < rectangles.size(); ++i) { out << ((i == 0) ? " " : ", ") << rectangles[i]; }
+		out << " }";
+		return out;
+	}
+	
+	namespace
+	{
+		// Overlap bitmask of one rectangle against the rectangles [first, last) (branch-free)
+		template <class T>
+		void overlap_mask_scalar
+		(
+			T const & r_left, T const & r_top, T const & r_right, T const & r_bottom,
+			T const * const left, T const * const top, T const * const right, T const * const bottom,
+			size_t const first, size_t const last, std::uint64_t * const mask
+		)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				bool const overlap = (left[i] <= r_right) & (r_left <= right[i]) & (top[i] <= r_bottom) & (r_top <= bottom[i]);
+				mask[i / 64] |= std::uint64_t(overlap) << (i % 64);
+			}
+		}
+		
+		// Overlap bitmask of one rectangle against the rectangles [first, last)
+		template <class T>
+		class overlap_mask_
+		{
+		public:
+			
+			static void call
+			(
+				T const & r_left, T const & r_top, T const & r_right, T const & r_bottom,
+				T const * const left, T const * const top, T const * const right, T const * const bottom,
+				size_t const first, size_t const last, std::uint64_t * const mask
+			)
+			{
+				hopp::overlap_mask_scalar(r_left, r_top, r_right, r_bottom, left, top, right, bottom, first, last, mask);
+			}
+		};
+		
+		#if defined(__AVX__)
+		
+		// 8 float per instruction
+		template <>
+		class overlap_mask_<float>
+		{
+		public:
+			
+			static void call
+			(
+				float const r_left, float const r_top, float const r_right, float const r_bottom,
+				float const * const left, float const * const top, float const * const right, float const * const bottom,
+				size_t const first, size_t const last, std::uint64_t * const mask
+			)
+			{
+				__m256 const v_left = _mm256_set1_ps(r_left);
+				__m256 const v_top = _mm256_set1_ps(r_top);
+				__m256 const v_right = _mm256_set1_ps(r_right);
+				__m256 const v_bottom = _mm256_set1_ps(r_bottom);
+				
+				size_t i = first;
+				for (; i + 8 <= last; i += 8)
+				{
+					__m256 const overlap = _mm256_and_ps
+					(
+						_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(left + i), v_right, _CMP_LE_OQ), _mm256_cmp_ps(v_left, _mm256_loadu_ps(right + i), _CMP_LE_OQ)),
+						_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(top + i), v_bottom, _CMP_LE_OQ), _mm256_cmp_ps(v_top, _mm256_loadu_ps(bottom + i), _CMP_LE_OQ))
+					);
+					mask[i / 64] |= std::uint64_t(unsigned(_mm256_movemask_ps(overlap))) << (i % 64);
+				}
+				hopp::overlap_mask_scalar(r_left, r_top, r_right, r_bottom, left, top, right, bottom, i, last, mask);
+			}
+		};
+		
+		// 4 double per instruction
+		template <>
+		class overlap_mask_<double>
+		{
+		public:
+			
+			static void call
+			(
+				double const r_left, double const r_top, double const r_right, double const r_bottom,
+				double const * const left, double const * const top, double const * const right, double const * const bottom,
+				size_t const first, size_t const last, std::uint64_t * const mask
+			)
+			{
+				__m256d const v_left = _mm256_set1_pd(r_left);
+				__m256d const v_top = _mm256_set1_pd(r_top);
+				__m256d const v_right = _mm256_set1_pd(r_right);
+				__m256d const v_bottom = _mm256_set1_pd(r_bottom);
+				
+				size_t i = first;
+				for (; i + 4 <= last; i += 4)
+				{
+					__m256d const overlap = _mm256_and_pd
+					(
+						_mm256_and_pd(_mm256_cmp_pd(_mm256_loadu_pd(left + i), v_right, _CMP_LE_OQ), _mm256_cmp_pd(v_left, _mm256_loadu_pd(right + i), _CMP_LE_OQ)),
+						_mm256_and_pd(_mm256_cmp_pd(_mm256_loadu_pd(top + i), v_bottom, _CMP_LE_OQ), _mm256_cmp_pd(v_top, _mm256_loadu_pd(bottom + i), _CMP_LE_OQ))
+					);
+					mask[i / 64] |= std::uint64_t(unsigned(_mm256_movemask_pd(overlap))) << (i % 64);
+				}
+				hopp::overlap_mask_scalar(r_left, r_top, r_right, r_bottom, left, top, right, bottom, i, last, mask);
+			}
+		};
+		
+		#endif
+		
+		#if defined(__AVX2__)
+		
+		// 8 int per instruction
+		template <>
+		class overlap_mask_<int>
+		{
+		public:
+			
+			static void call
+			(
+				int const r_left, int const r_top, int const r_right, int const r_bottom,
+				int const * const left, int const * const top, int const * const right, int const * const bottom,
+				size_t const first, size_t const last, std::uint64_t * const mask
+			)
+			{
+				__m256i const v_left = _mm256_set1_epi32(r_left);
+				__m256i const v_top = _mm256_set1_epi32(r_top);
+				__m256i const v_right = _mm256_set1_epi32(r_right);
+				__m256i const v_bottom = _mm256_set1_epi32(r_bottom);
+				
+				size_t i = first;
+				for (; i + 8 <= last; i += 8)
+				{
+					auto const load = [i](int const * const p) { return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + i)); };
+					// a <= b is not (a > b)
+					__m256i const separated = _mm256_or_si256
+					(
+						_mm256_or_si256(_mm256_cmpgt_epi32(load(left), v_right), _mm256_cmpgt_epi32(v_left, load(right))),
+						_mm256_or_si256(_mm256_cmpgt_epi32(load(top), v_bottom), _mm256_cmpgt_epi32(v_top, load(bottom)))
+					);
+					unsigned const overlap = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(separated))) & 0xFFu;
+					mask[i / 64] |= std::uint64_t(overlap) << (i % 64);
+				}
+				hopp::overlap_mask_scalar(r_left, r_top, r_right, r_bottom, left, top, right, bottom, i, last, mask);
+			}
+		};
+		
+		#endif
+	}
+	
+	namespace geometry
+	{
+		/**
+		 * @brief Test one rectangle against n rectangles in structure of arrays form
+		 *
+		 * Branch-free min/max interval tests (borders included), vectorized with AVX for float and double and with AVX2 for int. @n
+		 * Unlike corner tests, the rectangles which cross without any corner inside the other one overlap.
+		 *
+		 * @code
+		   #include <hopp/geometry.hpp>
+		   @endcode
+		 *
+		 * @param[in]  rectangle A hopp::rectangle
+		 * @param[in]  left      Left coordinates of the n rectangles
+		 * @param[in]  top       Top coordinates of the n rectangles
+		 * @param[in]  right     Right coordinates of the n rectangles
+		 * @param[in]  bottom    Bottom coordinates of the n rectangles
+		 * @param[in]  n         Number of rectangles
+		 * @param[out] mask      (n + 63) / 64 words, the bit i % 64 of mask[i / 64] is 1 if the rectangle i overlaps
+		 *
+		 * @ingroup hopp_geometry
+		 * @relates hopp::soa_rectangle
+		 */
+		template <class T>
+		void overlap
+		(
+			hopp::rectangle<T> const & rectangle,
+			T const * const left, T const * const top, T const * const right, T const * const bottom,
+			size_t const n, std::uint64_t * const mask
+		)
+		{
+			std::fill(mask, mask + (n + 63) / 64, std::uint64_t(0));
+			hopp::overlap_mask_<T>::call(rectangle.left, rectangle.top, rectangle.right(), rectangle.bottom(), left, top, right, bottom, 0, n, mask);
+		}
+		
+		/**
+		 * @brief Test one rectangle against a hopp::soa_rectangle<T>
+		 *
+		 * @code
+		   #include <hopp/geometry.hpp>
+		   @endcode
+		 *
+		 * @param[in] rectangle  A hopp::rectangle
+		 * @param[in] rectangles A hopp::soa_rectangle
+		 *
+		 * @return the bitmask of the overlaps: the bit i % 64 of mask[i / 64] is 1 if the rectangle i overlaps
+		 *
+		 * @ingroup hopp_geometry
+		 * @relates hopp::soa_rectangle
+		 */
+		template <class T>
+		std::vector<std::uint64_t> overlap(hopp::rectangle<T> const & rectangle, hopp::soa_rectangle<T> const & rectangles)
+		{
+			std::vector<std::uint64_t> mask((rectangles.size() + 63) / 64);
+			hopp::geometry::overlap(rectangle, rectangles.left(), rectangles.top(), rectangles.right(), rectangles.bottom(), rectangles.size(), mask.data());
+			return mask;
+		}
+	}
+}
+
+#endif
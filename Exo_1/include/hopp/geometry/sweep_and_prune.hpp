@@ -0,0 +1,444 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_GEOMETRY_SWEEP_AND_PRUNE_HPP
+#define HOPP_GEOMETRY_SWEEP_AND_PRUNE_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_set>
+#include <initializer_list>
+#include <stdexcept>
+#include <cstdint>
+
+#include "rectangle.hpp"
+#include "overlap.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Incremental broad phase for moving hopp::rectangle<T> (sweep and prune)
+	 *
+	 * The intervals of the rectangles are kept sorted on both axes across the updates. @n
+	 * update() refreshes the coordinates and sorts the intervals with an insertion sort: when the rectangles move a little, it costs O(n + number of swaps + number of overlapping pairs). @n
+	 * A pair can start to overlap only if a min endpoint crossed a max endpoint of the other rectangle (only these pairs are tested), the overlapping pairs are tested again to find the ones which ended. @n
+	 * The pairs which started or ended to overlap during the last update are available with started() and ended(). @n
+	 * Two rectangles overlap if they intersect, borders included (see hopp::geometry::overlap). @n
+	 * The identifiers are the indexes of the bulk loaded rectangles, then the values returned by insert() (the identifiers of the removed rectangles are reused, less than 2^31: an endpoint stores the identifier and the min/max flag in 32 bits).
+	 *
+	 * @code
+	   #include <hopp/geometry.hpp>
+	   @endcode
+	 *
+	 * @b Example:
+	 * @code
+	   hopp::sweep_and_prune<float> broad_phase(rectangles);
+	   while (running)
+	   {
+	       for (size_t id = 0; id < rectangles.size(); ++id) { broad_phase.set(id, move(rectangles[id])); }
+	       broad_phase.update();
+	       for (auto const & pair : broad_phase.started()) { on_contact_begin(pair.first, pair.second); }
+	       for (auto const & pair : broad_phase.ended()) { on_contact_end(pair.first, pair.second); }
+	   }
+	   @endcode
+	 *
+	 * @ingroup hopp_geometry
+	 */
+	template <class T>
+	class sweep_and_prune
+	{
+	private:
+		
+		/// Endpoint of an interval (with a copy of the rectangle to test the overlaps during the sort without indirection)
+		class endpoint
+		{
+		public:
+			
+			/// Coordinate
+			T value;
+			
+			/// Other endpoint of the interval
+			T opposite;
+			
+			/// Min of the interval on the other axis
+			T other_min;
+			
+			/// Max of the interval on the other axis
+			T other_max;
+			
+			/// Identifier * 2 + 1 if the endpoint is a max
+			std::uint32_t id_max;
+			
+			/// @brief Return the identifier
+			/// @return the identifier
+			size_t id() const { return id_max >> 1; }
+			
+			/// @brief Return true if the endpoint is a max
+			/// @return true if the endpoint is a max, false otherwise
+			bool is_max() const { return (id_max & 1) != 0; }
+			
+			/// @brief Set the coordinates
+			/// @param[in] min       Min of the interval
+			/// @param[in] max       Max of the interval
+			/// @param[in] other_min Min of the interval on the other axis
+			/// @param[in] other_max Max of the interval on the other axis
+			void set(T const & min, T const & max, T const & other_min, T const & other_max)
+			{
+				value = (is_max()) ? max : min;
+				opposite = (is_max()) ? min : max;
+				this->other_min = other_min;
+				this->other_max = other_max;
+			}
+			
+			/// @brief Test if the rectangles of a min and a max endpoint overlap
+			/// @param[in] max A max endpoint
+			/// @return true if the rectangles overlap, false otherwise
+			bool overlap(endpoint const & max) const
+			{
+				return (value <= max.value) & (max.opposite <= opposite) & (other_min <= max.other_max) & (max.other_min <= other_max);
+			}
+			
+			/// @brief Operator < (the min are before the max at the same coordinate, the borders overlap)
+			/// @param[in] b An endpoint
+			/// @return true if the endpoint is before b, false otherwise
+			bool operator <(endpoint const & b) const { return value < b.value || (value == b.value && is_max() == false && b.is_max()); }
+		};
+		
+		/// Rectangles (by identifier)
+		std::vector<hopp::rectangle<T>> m_rectangles;
+		
+		/// Identifier is used
+		std::vector<bool> m_used;
+		
+		/// Removed identifiers
+		std::vector<size_t> m_free_ids;
+		
+		/// Sorted endpoints on x
+		std::vector<endpoint> m_x;
+		
+		/// Sorted endpoints on y
+		std::vector<endpoint> m_y;
+		
+		/// Overlapping pairs (a * 2^32 + b with a < b)
+		std::vector<std::uint64_t> m_pairs;
+		
+		/// Overlapping pairs (to test if a pair is in m_pairs)
+		std::unordered_set<std::uint64_t> m_pair_set;
+		
+		/// Pairs which can have started to overlap during the last update
+		std::vector<std::pair<size_t, size_t>> m_candidates;
+		
+		/// Pairs which started to overlap during the last update
+		std::vector<std::pair<size_t, size_t>> m_started;
+		
+		/// Pairs which ended to overlap during the last update
+		std::vector<std::pair<size_t, size_t>> m_ended;
+		
+	public:
+		
+		/// @brief Constructor
+		/// @param[in] rectangles Rectangles to bulk load (their identifiers are their indexes)
+		/// @exception std::length_error if there are more than 2^31 rectangles
+		explicit sweep_and_prune(std::vector<hopp::rectangle<T>> const & rectangles = std::vector<hopp::rectangle<T>>()) :
+			m_rectangles(rectangles),
+			m_used(rectangles.size(), true),
+			m_free_ids(),
+			m_x(),
+			m_y(),
+			m_pairs(),
+			m_pair_set(),
+			m_candidates(),
+			m_started(),
+			m_ended()
+		{
+			if (rectangles.empty() == false) { check_id(rectangles.size() - 1); }
+			m_x.reserve(2 * rectangles.size());
+			m_y.reserve(2 * rectangles.size());
+			for (size_t id = 0; id < rectangles.size(); ++id) { add_endpoints(id); }
+			std::sort(m_x.begin(), m_x.end());
+			std::sort(m_y.begin(), m_y.end());
+			
+			// Sweep on x, test y with the active intervals
+			std::vector<size_t> active;
+			std::vector<size_t> position(rectangles.size());
+			for (endpoint const & e : m_x)
+			{
+				size_t const id = e.id();
+				if (e.is_max())
+				{
+					size_t const last = active.back();
+					active[position[id]] = last;
+					position[last] = position[id];
+					active.pop_back();
+				}
+				else
+				{
+					for (size_t const other : active)
+					{
+						if (hopp::geometry::overlap(m_rectangles[id], m_rectangles[other])) { add_pair(id, other); }
+					}
+					position[id] = active.size();
+					active.push_back(id);
+				}
+			}
+		}
+		
+		/// @brief Return the number of rectangles
+		/// @return the number of rectangles
+		size_t size() const { return m_rectangles.size() - m_free_ids.size(); }
+		
+		/// @brief Check if an identifier is used
+		/// @param[in] id Identifier
+		/// @return true if the identifier is used, false otherwise
+		bool contains(size_t const id) const { return id < m_used.size() && m_used[id]; }
+		
+		/// @brief Get a rectangle
+		/// @param[in] id Identifier of the rectangle
+		/// @return the rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		hopp::rectangle<T> const & get(size_t const id) const
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::sweep_and_prune<T>::get(id): invalid id"); }
+			#endif
+			
+			return m_rectangles[id];
+		}
+		
+		/// @brief Insert a rectangle (its overlaps are reported by the next update())
+		/// @param[in] rectangle A hopp::rectangle<T>
+		/// @return the identifier of the rectangle
+		/// @exception std::length_error if there are already 2^31 rectangles
+		size_t insert(hopp::rectangle<T> const & rectangle)
+		{
+			size_t id = m_rectangles.size();
+			if (m_free_ids.empty())
+			{
+				check_id(id);
+				m_rectangles.push_back(rectangle);
+				m_used.push_back(true);
+			}
+			else
+			{
+				id = m_free_ids.back();
+				m_free_ids.pop_back();
+				m_rectangles[id] = rectangle;
+				m_used[id] = true;
+			}
+			
+			// The endpoints are at the end, the next update() sorts them
+			add_endpoints(id);
+			return id;
+		}
+		
+		/// @brief Remove a rectangle in O(n) (its overlapping pairs are removed without being reported in ended())
+		/// @param[in] id Identifier of the rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void remove(size_t const id)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::sweep_and_prune<T>::remove(id): invalid id"); }
+			#endif
+			
+			auto const is_removed = [id](endpoint const & e) { return e.id() == id; };
+			m_x.erase(std::remove_if(m_x.begin(), m_x.end(), is_removed), m_x.end());
+			m_y.erase(std::remove_if(m_y.begin(), m_y.end(), is_removed), m_y.end());
+			remove_pairs_if([id](size_t const a, size_t const b) { return a == id || b == id; });
+			
+			m_used[id] = false;
+			m_free_ids.push_back(id);
+		}
+		
+		/// @brief Move a rectangle (taken into account by the next update())
+		/// @param[in] id        Identifier of the rectangle
+		/// @param[in] rectangle New rectangle
+		/// @exception std::out_of_range if NDEBUG is not defined and if id is not used
+		void set(size_t const id, hopp::rectangle<T> const & rectangle)
+		{
+			#ifndef NDEBUG
+				if (contains(id) == false) { throw std::out_of_range("hopp::sweep_and_prune<T>::set(id, rectangle): invalid id"); }
+			#endif
+			
+			m_rectangles[id] = rectangle;
+		}
+		
+		/// @brief Sort the endpoints with the new coordinates and update the overlapping pairs
+		void update()
+		{
+			m_candidates.clear();
+			m_started.clear();
+			m_ended.clear();
+			
+			for (endpoint & e : m_x)
+			{
+				hopp::rectangle<T> const & r = m_rectangles[e.id()];
+				e.set(r.left, r.right(), r.top, r.bottom());
+			}
+			for (endpoint & e : m_y)
+			{
+				hopp::rectangle<T> const & r = m_rectangles[e.id()];
+				e.set(r.top, r.bottom(), r.left, r.right());
+			}
+			insertion_sort(m_x);
+			insertion_sort(m_y);
+			
+			// Ended
+			remove_pairs_if
+			(
+				[this](size_t const a, size_t const b)
+				{
+					if (hopp::geometry::overlap(m_rectangles[a], m_rectangles[b])) { return false; }
+					m_ended.emplace_back(a, b);
+					return true;
+				}
+			);
+			
+			// Started (a pair can be a candidate on both axes)
+			for (auto const & pair : m_candidates)
+			{
+				if (add_pair(pair.first, pair.second)) { m_started.push_back(pair); }
+			}
+		}
+		
+		/// @brief Get the pairs which started to overlap during the last update()
+		/// @return the pairs (a, b) with a < b
+		std::vector<std::pair<size_t, size_t>> const & started() const { return m_started; }
+		
+		/// @brief Get the pairs which ended to overlap during the last update()
+		/// @return the pairs (a, b) with a < b
+		std::vector<std::pair<size_t, size_t>> const & ended() const { return m_ended; }
+		
+		/// @brief Return the number of overlapping pairs
+		/// @return the number of overlapping pairs
+		size_t nb_overlap() const { return m_pairs.size(); }
+		
+		/// @brief Call f(a, b) with a < b for each pair of overlapping rectangles (as of the last update())
+		/// @param[in] f Function called with two size_t
+		template <class function_t>
+		void for_each_overlap(function_t f) const
+		{
+			for (std::uint64_t const k : m_pairs) { f(size_t(k >> 32), size_t(k & 0xFFFFFFFFu)); }
+		}
+		
+		/// @brief Get all the pairs of overlapping rectangles (as of the last update())
+		/// @return the pairs (a, b) with a < b (in an unspecified order)
+		std::vector<std::pair<size_t, size_t>> overlaps() const
+		{
+			std::vector<std::pair<size_t, size_t>> r;
+			r.reserve(m_pairs.size());
+			for_each_overlap([&r](size_t const a, size_t const b) { r.emplace_back(a, b); });
+			return r;
+		}
+		
+	private:
+		
+		/// @brief Key of a pair
+		/// @param[in] a Identifier
+		/// @param[in] b Identifier
+		/// @return min(a, b) * 2^32 + max(a, b)
+		static std::uint64_t key(size_t const a, size_t const b)
+		{
+			return (std::uint64_t(std::min(a, b)) << 32) | std::uint64_t(std::max(a, b));
+		}
+		
+		/// @brief Add an overlapping pair
+		/// @param[in] a Identifier
+		/// @param[in] b Identifier
+		/// @return true if the pair is added, false if it is already there
+		bool add_pair(size_t const a, size_t const b)
+		{
+			std::uint64_t const k = key(a, b);
+			if (m_pair_set.insert(k).second == false) { return false; }
+			m_pairs.push_back(k);
+			return true;
+		}
+		
+		/// @brief Remove the overlapping pairs (a, b) for which predicate(a, b) is true
+		/// @param[in] predicate Function called with two size_t
+		template <class predicate_t>
+		void remove_pairs_if(predicate_t predicate)
+		{
+			size_t k = 0;
+			for (std::uint64_t const pair : m_pairs)
+			{
+				if (predicate(size_t(pair >> 32), size_t(pair & 0xFFFFFFFFu))) { m_pair_set.erase(pair); }
+				else { m_pairs[k++] = pair; }
+			}
+			m_pairs.resize(k);
+		}
+		
+		/// @brief Check that an identifier fits in an endpoint (with the min/max flag in 32 bits)
+		/// @param[in] id Identifier of a rectangle
+		/// @exception std::length_error if the identifier is greater or equal to 2^31
+		static void check_id(size_t const id)
+		{
+			if (id > 0x7FFFFFFFu) { throw std::length_error("hopp::sweep_and_prune<T>: too many rectangles (the identifiers must be less than 2^31)"); }
+		}
+		
+		/// @brief Add the endpoints of a rectangle at the end
+		/// @param[in] id Identifier of the rectangle
+		/// @exception std::length_error if the identifier is greater or equal to 2^31
+		void add_endpoints(size_t const id)
+		{
+			check_id(id);
+			
+			hopp::rectangle<T> const & r = m_rectangles[id];
+			std::uint32_t const id_2 = std::uint32_t(id) << 1;
+			for (std::uint32_t const id_max : { id_2, id_2 | 1u })
+			{
+				endpoint e;
+				e.id_max = id_max;
+				e.set(r.left, r.right(), r.top, r.bottom());
+				m_x.push_back(e);
+				e.set(r.top, r.bottom(), r.left, r.right());
+				m_y.push_back(e);
+			}
+		}
+		
+		/// @brief Sort the endpoints, the overlapping pairs of a min which crosses a max are candidates
+		/// @param[in,out] endpoints Endpoints (almost sorted)
+		void insertion_sort(std::vector<endpoint> & endpoints)
+		{
+			for (size_t i = 1; i < endpoints.size(); ++i)
+			{
+				endpoint const e = endpoints[i];
+				size_t j = i;
+				if (e.is_max())
+				{
+					// A max which moves before a min: the intervals stop to overlap on this axis (see update())
+					for (; j > 0 && e < endpoints[j - 1]; --j) { endpoints[j] = endpoints[j - 1]; }
+				}
+				else
+				{
+					// A min which moves before a max: the intervals start to overlap on this axis
+					for (; j > 0 && e < endpoints[j - 1]; --j)
+					{
+						endpoint const & previous = endpoints[j - 1];
+						if (previous.is_max() && e.overlap(previous))
+						{
+							m_candidates.emplace_back(std::min(e.id(), previous.id()), std::max(e.id(), previous.id()));
+						}
+						endpoints[j] = previous;
+					}
+				}
+				endpoints[j] = e;
+			}
+		}
+	};
+}
+
+#endif
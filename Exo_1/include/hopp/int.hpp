@@ -16,6 +16,8 @@
 #ifndef HOPP_INT_HPP
 #define HOPP_INT_HPP
 
+#include "int/bigint.hpp"
+#include "int/divider.hpp"
 #include "int/int8.hpp"
 #include "int/ldouble.hpp"
 #include "int/lint.hpp"
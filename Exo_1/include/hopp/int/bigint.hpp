@@ -0,0 +1,1145 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_INT_BIGINT_HPP
+#define HOPP_INT_BIGINT_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "ullint.hpp"
+#include "uint128.hpp"
+#include "div_q_r.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Arbitrary-precision signed integer
+	 *
+	 * The magnitude is stored in 32-bit words (limbs), the least significant first, with the sign apart. Up to 128 bits, the limbs are stored in the object (no memory allocation).
+	 *
+	 * | Operation          | Algorithm                                                                    |
+	 * | ------------------ | ---------------------------------------------------------------------------- |
+	 * | *                  | schoolbook, Karatsuba from karatsuba_threshold limbs                         |
+	 * | /, %               | Knuth algorithm D, Newton reciprocal and Barrett from newton_threshold limbs |
+	 * | to_string, parsing | divide and conquer with the powers 10^(9 * 2^k)                              |
+	 *
+	 * The division truncates toward zero and the remainder has the sign of the numerator (like the built-in integers).
+	 *
+	 * @code
+	   hopp::bigint f = 1;
+	   for (int i = 2; i <= 100; ++i) { f *= i; }
+	   std::cout << f << std::endl;
+	   @endcode
+	 *
+	 * @code
+	   #include <hopp/int/bigint.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_int_and_float
+	 */
+	class bigint
+	{
+	public:
+		
+		/// Limb type
+		using limb_type = std::uint32_t;
+		
+		/// Number of limbs stored in the object
+		static constexpr size_t nb_inline_limbs = 4;
+		
+		/// Number of limbs from which Karatsuba multiplication is used (the schoolbook multiplication uses 64-bit words with a native 128-bit integer)
+		#ifdef HOPP_INT_UINT128_NATIVE
+		static constexpr size_t karatsuba_threshold = 128;
+		#else
+		static constexpr size_t karatsuba_threshold = 40;
+		#endif
+		
+		/// Number of limbs of the denominator from which the division uses a Newton reciprocal
+		static constexpr size_t newton_threshold = 100;
+		
+	private:
+		
+		/// Magnitude (least significant limb first)
+		using magnitude = std::vector<limb_type>;
+		
+		/// Number of limbs (without leading zeros)
+		size_t m_size;
+		
+		/// Limbs if m_size <= nb_inline_limbs
+		limb_type m_inline[nb_inline_limbs];
+		
+		/// Limbs if m_size > nb_inline_limbs
+		magnitude m_heap;
+		
+		/// Is the integer negative?
+		bool m_negative;
+		
+	public:
+		
+		/// @brief Default constructor (0)
+		bigint() : m_size(0), m_inline{ 0, 0, 0, 0 }, m_heap(), m_negative(false) { }
+		
+		/// @brief Constructor from a built-in integer
+		/// @param[in] i A built-in integer
+		template <class int_t, class = typename std::enable_if<std::is_integral<int_t>::value>::type>
+		bigint(int_t const i) : bigint()
+		{
+			m_negative = is_negative(i, std::is_signed<int_t>());
+			// |i| computed modulo 2^64 (correct for the minimum value)
+			hopp::ullint const value = m_negative ? hopp::ullint(0) - hopp::ullint(i) : hopp::ullint(i);
+			m_inline[0] = limb_type(value);
+			m_inline[1] = limb_type(value >> 32);
+			m_size = (m_inline[1] != 0) ? 2 : ((m_inline[0] != 0) ? 1 : 0);
+		}
+		
+		/// @brief Constructor from a hopp::uint128
+		/// @param[in] i A hopp::uint128
+		bigint(hopp::uint128 const & i) : bigint()
+		{
+			limb_type const limbs[4] = { limb_type(i.lo), limb_type(i.lo >> 32), limb_type(i.hi), limb_type(i.hi >> 32) };
+			assign(limbs, 4, false);
+		}
+		
+		/// @brief Constructor from a decimal string
+		/// @param[in] s A std::string with an optional sign ('+' or '-') and decimal digits
+		/// @exception std::invalid_argument if s is not a decimal number
+		explicit bigint(std::string const & s) : bigint()
+		{
+			size_t first = (s.empty() == false && (s[0] == '-' || s[0] == '+')) ? 1 : 0;
+			if (first == s.size()) { throw std::invalid_argument("hopp::bigint: \"" + s + "\" is not a decimal number"); }
+			for (size_t i = first; i < s.size(); ++i)
+			{
+				if (s[i] < '0' || s[i] > '9') { throw std::invalid_argument("hopp::bigint: \"" + s + "\" is not a decimal number"); }
+			}
+			while (first + 1 < s.size() && s[first] == '0') { ++first; }
+			
+			std::vector<magnitude> powers;
+			magnitude m = parse(s.data() + first, s.size() - first, powers);
+			assign(std::move(m), s[0] == '-');
+		}
+		
+		/// @brief Get the number of limbs
+		/// @return the number of limbs (0 for 0)
+		size_t size() const { return m_size; }
+		
+		/// @brief Get the limbs
+		/// @return the limbs of the magnitude (least significant first)
+		limb_type const * limbs() const { return (m_size <= nb_inline_limbs) ? m_inline : m_heap.data(); }
+		
+		/// @brief Is the integer negative?
+		/// @return true if the integer is negative, false otherwise
+		bool is_negative() const { return m_negative; }
+		
+		/// @brief Test if the integer is not 0
+		/// @return true if the integer is not 0, false otherwise
+		explicit operator bool() const { return m_size != 0; }
+		
+		/// @brief Get the number of bits of the magnitude
+		/// @return the number of bits of the magnitude (0 for 0)
+		size_t bit_length() const
+		{
+			if (m_size == 0) { return 0; }
+			return 32 * m_size - hopp::count_leading_zeros_32(limbs()[m_size - 1]);
+		}
+		
+		/// @brief Convert to a hopp::uint128
+		/// @return the hopp::uint128
+		/// @exception std::overflow_error if the integer is negative or does not fit in 128 bits
+		hopp::uint128 to_uint128() const
+		{
+			if (m_negative || m_size > 4) { throw std::overflow_error("hopp::bigint::to_uint128: the integer does not fit in a hopp::uint128"); }
+			limb_type l[4] = { 0, 0, 0, 0 };
+			std::copy(limbs(), limbs() + m_size, l);
+			return hopp::uint128((hopp::ullint(l[3]) << 32) | l[2], (hopp::ullint(l[1]) << 32) | l[0]);
+		}
+		
+		/// @brief Convert to a decimal std::string
+		/// @return the decimal std::string
+		std::string to_string() const
+		{
+			if (m_size == 0) { return "0"; }
+			
+			std::string r;
+			r.reserve(m_size * 10 + 1);
+			if (m_negative) { r += '-'; }
+			
+			// Powers 10^(9 * 2^k) until their square is larger than the integer
+			std::vector<magnitude> powers(1, magnitude(1, 1000000000));
+			while (2 * powers.back().size() - 1 <= m_size) { powers.push_back(square(powers.back())); }
+			
+			std::vector<divisor> divisors(powers.size());
+			to_string(magnitude(limbs(), limbs() + m_size), powers.size() - 1, 0, powers, divisors, r);
+			return r;
+		}
+		
+		// Free functions with access to the limbs
+		friend hopp::bigint operator -(hopp::bigint a);
+		friend hopp::bigint operator +(hopp::bigint const & a, hopp::bigint const & b);
+		friend hopp::bigint operator -(hopp::bigint const & a, hopp::bigint const & b);
+		friend hopp::bigint operator *(hopp::bigint const & a, hopp::bigint const & b);
+		friend hopp::q_r<hopp::bigint> div_q_r(hopp::bigint const & a, hopp::bigint const & b);
+		friend hopp::bigint operator <<(hopp::bigint const & a, size_t const n);
+		friend hopp::bigint operator >>(hopp::bigint const & a, size_t const n);
+		friend int compare(hopp::bigint const & a, hopp::bigint const & b);
+		
+	private:
+		
+		// Construction
+		
+		/// @brief Test if a signed integer is negative
+		/// @param[in] i A signed integer
+		/// @return true if i < 0, false otherwise
+		template <class int_t>
+		static bool is_negative(int_t const i, std::true_type /*is_signed*/) { return i < 0; }
+		
+		/// @brief Test if an unsigned integer is negative
+		/// @return false
+		template <class int_t>
+		static bool is_negative(int_t const, std::false_type /*is_signed*/) { return false; }
+		
+		/// @brief Set the magnitude and the sign
+		/// @param[in] l        Limbs
+		/// @param[in] n        Number of limbs (leading zeros allowed)
+		/// @param[in] negative Is the integer negative?
+		void assign(limb_type const * const l, size_t n, bool const negative)
+		{
+			n = normalized_size(l, n);
+			m_size = n;
+			m_negative = negative && n != 0;
+			if (n <= nb_inline_limbs)
+			{
+				std::copy(l, l + n, m_inline);
+				m_heap.clear();
+			}
+			else
+			{
+				m_heap.assign(l, l + n);
+			}
+		}
+		
+		/// @brief Set the magnitude and the sign
+		/// @param[in] l        Limbs (leading zeros allowed)
+		/// @param[in] negative Is the integer negative?
+		void assign(magnitude && l, bool const negative)
+		{
+			size_t const n = normalized_size(l.data(), l.size());
+			if (n <= nb_inline_limbs) { assign(l.data(), n, negative); return; }
+			l.resize(n);
+			m_heap = std::move(l);
+			m_size = n;
+			m_negative = negative;
+		}
+		
+		/// @brief Add or subtract two hopp::bigint
+		/// @param[in] a          A hopp::bigint
+		/// @param[in] b          A hopp::bigint
+		/// @param[in] b_negative Sign of b to use
+		/// @return a + b with the sign b_negative for b
+		static hopp::bigint add(hopp::bigint const & a, hopp::bigint const & b, bool const b_negative)
+		{
+			hopp::bigint r;
+			size_t const n = std::max(a.m_size, b.m_size) + 1;
+			limb_type small[nb_inline_limbs + 1];
+			magnitude large((n > nb_inline_limbs + 1) ? n : 0);
+			limb_type * const l = (n > nb_inline_limbs + 1) ? large.data() : small;
+			
+			if (a.m_negative == b_negative)
+			{
+				size_t const size = add(a.limbs(), a.m_size, b.limbs(), b.m_size, l);
+				r.assign(l, size, a.m_negative);
+			}
+			else if (compare(a.limbs(), a.m_size, b.limbs(), b.m_size) >= 0)
+			{
+				sub(a.limbs(), a.m_size, b.limbs(), b.m_size, l);
+				r.assign(l, a.m_size, a.m_negative);
+			}
+			else
+			{
+				sub(b.limbs(), b.m_size, a.limbs(), a.m_size, l);
+				r.assign(l, b.m_size, b_negative);
+			}
+			return r;
+		}
+		
+		// Magnitudes
+		
+		/// @brief Get the size without leading zeros
+		/// @param[in] l Limbs
+		/// @param[in] n Number of limbs
+		/// @return the number of limbs without leading zeros
+		static size_t normalized_size(limb_type const * const l, size_t n)
+		{
+			while (n != 0 && l[n - 1] == 0) { --n; }
+			return n;
+		}
+		
+		/// @brief Remove the leading zeros
+		/// @param[in,out] m A magnitude
+		static void normalize(magnitude & m) { m.resize(normalized_size(m.data(), m.size())); }
+		
+		/// @brief Compare two magnitudes
+		/// @param[in] a  Limbs of a
+		/// @param[in] an Number of limbs of a (leading zeros allowed)
+		/// @param[in] b  Limbs of b
+		/// @param[in] bn Number of limbs of b (leading zeros allowed)
+		/// @return a negative number if a < b, 0 if a == b, a positive number if a > b
+		static int compare(limb_type const * const a, size_t an, limb_type const * const b, size_t bn)
+		{
+			an = normalized_size(a, an);
+			bn = normalized_size(b, bn);
+			if (an != bn) { return (an < bn) ? -1 : 1; }
+			for (size_t i = an; i > 0; --i)
+			{
+				if (a[i - 1] != b[i - 1]) { return (a[i - 1] < b[i - 1]) ? -1 : 1; }
+			}
+			return 0;
+		}
+		
+		/// @brief Compare two magnitudes
+		/// @param[in] a A magnitude
+		/// @param[in] b A magnitude
+		/// @return a negative number if a < b, 0 if a == b, a positive number if a > b
+		static int compare(magnitude const & a, magnitude const & b) { return compare(a.data(), a.size(), b.data(), b.size()); }
+		
+		/// @brief Add two magnitudes
+		/// @param[in]  a   Limbs of a
+		/// @param[in]  an  Number of limbs of a
+		/// @param[in]  b   Limbs of b
+		/// @param[in]  bn  Number of limbs of b
+		/// @param[out] out max(an, bn) + 1 limbs
+		/// @return max(an, bn) + 1
+		static size_t add(limb_type const * a, size_t an, limb_type const * b, size_t bn, limb_type * const out)
+		{
+			if (an < bn) { std::swap(a, b); std::swap(an, bn); }
+			hopp::ullint carry = 0;
+			for (size_t i = 0; i < an; ++i)
+			{
+				hopp::ullint const t = hopp::ullint(a[i]) + ((i < bn) ? b[i] : 0) + carry;
+				out[i] = limb_type(t);
+				carry = t >> 32;
+			}
+			out[an] = limb_type(carry);
+			return an + 1;
+		}
+		
+		/// @brief Subtract two magnitudes
+		/// @param[in]  a   Limbs of a
+		/// @param[in]  an  Number of limbs of a
+		/// @param[in]  b   Limbs of b (b <= a)
+		/// @param[in]  bn  Number of limbs of b (bn <= an)
+		/// @param[out] out an limbs (can be a)
+		static void sub(limb_type const * const a, size_t const an, limb_type const * const b, size_t const bn, limb_type * const out)
+		{
+			hopp::ullint borrow = 0;
+			for (size_t i = 0; i < an; ++i)
+			{
+				hopp::ullint const s = ((i < bn) ? hopp::ullint(b[i]) : 0) + borrow;
+				borrow = (a[i] < s) ? 1 : 0;
+				out[i] = limb_type(hopp::ullint(a[i]) - s);
+			}
+		}
+		
+		/// @brief Add a magnitude to another one (in place)
+		/// @param[in,out] a  Limbs of a (the sum fits in an limbs)
+		/// @param[in]     an Number of limbs of a
+		/// @param[in]     b  Limbs of b
+		/// @param[in]     bn Number of limbs of b (bn <= an)
+		static void add_in_place(limb_type * const a, size_t const an, limb_type const * const b, size_t const bn)
+		{
+			hopp::ullint carry = 0;
+			size_t i = 0;
+			for (; i < bn; ++i)
+			{
+				hopp::ullint const t = hopp::ullint(a[i]) + b[i] + carry;
+				a[i] = limb_type(t);
+				carry = t >> 32;
+			}
+			for (; carry != 0 && i < an; ++i)
+			{
+				hopp::ullint const t = hopp::ullint(a[i]) + carry;
+				a[i] = limb_type(t);
+				carry = t >> 32;
+			}
+		}
+		
+		/// @brief Shift a magnitude to the left
+		/// @param[in]  a   Limbs
+		/// @param[in]  an  Number of limbs
+		/// @param[in]  n   Number of bits (only n % 32 is used)
+		/// @param[out] out an + 1 limbs (at least)
+		/// @param[in]  nb  Number of limbs of out
+		static void shift_left(limb_type const * const a, size_t const an, size_t const n, limb_type * const out, size_t const nb)
+		{
+			unsigned int const s = unsigned(n % 32);
+			limb_type carry = 0;
+			for (size_t i = 0; i < an; ++i)
+			{
+				hopp::ullint const t = hopp::ullint(a[i]) << s;
+				out[i] = limb_type(t) | carry;
+				carry = limb_type(t >> 32);
+			}
+			if (an < nb) { out[an] = carry; }
+		}
+		
+		/// @brief Multiply two magnitudes (schoolbook)
+		/// @param[in]  a   Limbs of a
+		/// @param[in]  an  Number of limbs of a
+		/// @param[in]  b   Limbs of b
+		/// @param[in]  bn  Number of limbs of b
+		/// @param[out] out an + bn limbs
+		static void mul_schoolbook(limb_type const * a, size_t an, limb_type const * b, size_t bn, limb_type * const out)
+		{
+			// The outer loop is on the shorter magnitude
+			if (an < bn) { std::swap(a, b); std::swap(an, bn); }
+			
+			#ifdef HOPP_INT_UINT128_NATIVE
+			if (bn >= 4) { mul_schoolbook_64(a, an, b, bn, out); return; }
+			#endif
+			
+			std::fill(out, out + an + bn, 0);
+			for (size_t i = 0; i < bn; ++i)
+			{
+				hopp::ullint const bi = b[i];
+				if (bi == 0) { continue; }
+				hopp::ullint carry = 0;
+				for (size_t j = 0; j < an; ++j)
+				{
+					hopp::ullint const t = bi * a[j] + out[i + j] + carry;
+					out[i + j] = limb_type(t);
+					carry = t >> 32;
+				}
+				out[i + an] = limb_type(carry);
+			}
+		}
+		
+		#ifdef HOPP_INT_UINT128_NATIVE
+		
+		/// @brief Multiply two magnitudes with 64-bit words and the native 128-bit integer (schoolbook)
+		/// @param[in]  a   Limbs of a
+		/// @param[in]  an  Number of limbs of a
+		/// @param[in]  b   Limbs of b
+		/// @param[in]  bn  Number of limbs of b
+		/// @param[out] out an + bn limbs
+		static void mul_schoolbook_64(limb_type const * const a, size_t const an, limb_type const * const b, size_t const bn, limb_type * const out)
+		{
+			using native_type = hopp::uint128::native_type;
+			
+			std::vector<hopp::ullint> const a64 = pack_64(a, an);
+			std::vector<hopp::ullint> const b64 = pack_64(b, bn);
+			std::vector<hopp::ullint> r(a64.size() + b64.size(), 0);
+			for (size_t i = 0; i < b64.size(); ++i)
+			{
+				native_type const bi = b64[i];
+				hopp::ullint carry = 0;
+				for (size_t j = 0; j < a64.size(); ++j)
+				{
+					native_type const t = bi * a64[j] + r[i + j] + carry;
+					r[i + j] = hopp::ullint(t);
+					carry = hopp::ullint(t >> 64);
+				}
+				r[i + a64.size()] = carry;
+			}
+			for (size_t i = 0; i < an + bn; ++i) { out[i] = limb_type(r[i / 2] >> (32 * (i % 2))); }
+		}
+		
+		/// @brief Pack limbs in 64-bit words
+		/// @param[in] a  Limbs
+		/// @param[in] an Number of limbs
+		/// @return the 64-bit words (least significant first)
+		static std::vector<hopp::ullint> pack_64(limb_type const * const a, size_t const an)
+		{
+			std::vector<hopp::ullint> r((an + 1) / 2, 0);
+			for (size_t i = 0; i < an; ++i) { r[i / 2] |= hopp::ullint(a[i]) << (32 * (i % 2)); }
+			return r;
+		}
+		
+		#endif
+		
+		/// @brief Multiply two magnitudes (Karatsuba above karatsuba_threshold limbs)
+		/// @param[in]  a   Limbs of a
+		/// @param[in]  an  Number of limbs of a
+		/// @param[in]  b   Limbs of b
+		/// @param[in]  bn  Number of limbs of b
+		/// @param[out] out an + bn limbs (must not overlap a or b)
+		static void mul(limb_type const * a, size_t an, limb_type const * b, size_t bn, limb_type * const out)
+		{
+			if (an < bn) { std::swap(a, b); std::swap(an, bn); }
+			
+			if (bn < karatsuba_threshold) { mul_schoolbook(a, an, b, bn, out); return; }
+			
+			// Unbalanced: a is cut in pieces of bn limbs
+			if (an >= 2 * bn)
+			{
+				std::fill(out, out + an + bn, 0);
+				magnitude piece(2 * bn);
+				for (size_t i = 0; i < an; i += bn)
+				{
+					size_t const n = (an - i < bn) ? an - i : bn;
+					mul(a + i, n, b, bn, piece.data());
+					add_in_place(out + i, an + bn - i, piece.data(), n + bn);
+				}
+				return;
+			}
+			
+			// a = a1 B^h + a0, b = b1 B^h + b0
+			// a b = z2 B^2h + (z1 - z2 - z0) B^h + z0 with z0 = a0 b0, z2 = a1 b1, z1 = (a0 + a1) (b0 + b1)
+			size_t const h = an / 2;
+			limb_type const * const a1 = a + h;
+			limb_type const * const b1 = b + h;
+			size_t const a1n = an - h;
+			size_t const b1n = bn - h;
+			
+			magnitude z0(2 * h);
+			mul(a, h, b, h, z0.data());
+			magnitude z2(a1n + b1n);
+			mul(a1, a1n, b1, b1n, z2.data());
+			
+			magnitude sa(std::max(h, a1n) + 1);
+			magnitude sb(std::max(h, b1n) + 1);
+			add(a, h, a1, a1n, sa.data());
+			add(b, h, b1, b1n, sb.data());
+			magnitude z1(sa.size() + sb.size());
+			mul(sa.data(), sa.size(), sb.data(), sb.size(), z1.data());
+			sub(z1.data(), z1.size(), z0.data(), z0.size(), z1.data());
+			sub(z1.data(), z1.size(), z2.data(), z2.size(), z1.data());
+			
+			std::fill(out, out + an + bn, 0);
+			std::copy(z0.begin(), z0.end(), out);
+			add_in_place(out + 2 * h, an + bn - 2 * h, z2.data(), normalized_size(z2.data(), z2.size()));
+			add_in_place(out + h, an + bn - h, z1.data(), normalized_size(z1.data(), z1.size()));
+		}
+		
+		/// @brief Multiply two magnitudes
+		/// @param[in] a A magnitude
+		/// @param[in] b A magnitude
+		/// @return a * b (without leading zeros)
+		static magnitude mul(magnitude const & a, magnitude const & b)
+		{
+			if (a.empty() || b.empty()) { return magnitude(); }
+			magnitude r(a.size() + b.size());
+			mul(a.data(), a.size(), b.data(), b.size(), r.data());
+			normalize(r);
+			return r;
+		}
+		
+		/// @brief Square a magnitude
+		/// @param[in] a A magnitude
+		/// @return a * a (without leading zeros)
+		static magnitude square(magnitude const & a) { return mul(a, a); }
+		
+		// Division
+		
+		/// Denominator with its normalization and its reciprocal (computed once for several divisions)
+		class divisor
+		{
+		private:
+			
+			/// Normalized denominator (the most significant bit is set)
+			magnitude m_d;
+			
+			/// Shift of the normalization
+			unsigned int m_shift;
+			
+			/// Reciprocal floor(B^(2n) / m_d) if n >= newton_threshold
+			magnitude m_reciprocal;
+			
+		public:
+			
+			/// @brief Default constructor (uninitialized)
+			divisor() : m_d(), m_shift(0), m_reciprocal() { }
+			
+			/// @brief Constructor
+			/// @param[in] d  Limbs of the denominator
+			/// @param[in] dn Number of limbs of the denominator (without leading zeros)
+			divisor(limb_type const * const d, size_t const dn) : m_d(dn + 1), m_shift(hopp::count_leading_zeros_32(d[dn - 1])), m_reciprocal()
+			{
+				shift_left(d, dn, m_shift, m_d.data(), m_d.size());
+				m_d.resize(dn);
+				if (dn >= newton_threshold) { m_reciprocal = reciprocal(m_d.data(), dn); }
+			}
+			
+			/// @brief Is the divisor initialized?
+			/// @return true if the divisor is initialized, false otherwise
+			bool empty() const { return m_d.empty(); }
+			
+			/// @brief Divide
+			/// @param[in]  a  Limbs of the numerator
+			/// @param[in]  an Number of limbs of the numerator (without leading zeros)
+			/// @param[out] q  Quotient
+			/// @param[out] r  Remainder
+			void div_q_r(limb_type const * const a, size_t const an, magnitude & q, magnitude & r) const
+			{
+				size_t const n = m_d.size();
+				
+				// Normalized numerator
+				magnitude u(an + 1);
+				shift_left(a, an, m_shift, u.data(), u.size());
+				normalize(u);
+				if (compare(u.data(), u.size(), m_d.data(), n) < 0)
+				{
+					q.clear();
+					r.assign(a, a + an);
+					return;
+				}
+				
+				if (m_reciprocal.empty())
+				{
+					q.assign(u.size() - n + 1, 0);
+					r.assign(n, 0);
+					magnitude scratch(u.size() + n + 1);
+					hopp::div_q_r_words(u.data(), u.size(), m_d.data(), n, q.data(), r.data(), scratch.data());
+				}
+				else
+				{
+					// Blocks of n limbs from the most significant: each partial numerator is < d B^n
+					q.assign(u.size() + n, 0);
+					r.clear();
+					size_t const nb_block = (u.size() + n - 1) / n;
+					for (size_t i = nb_block; i > 0; --i)
+					{
+						size_t const first = (i - 1) * n;
+						size_t const last = std::min(first + n, u.size());
+						magnitude current(u.begin() + std::ptrdiff_t(first), u.begin() + std::ptrdiff_t(last));
+						if (r.empty() == false) { current.resize(n, 0); current.insert(current.end(), r.begin(), r.end()); }
+						normalize(current);
+						magnitude block_q;
+						div_2n_by_n(current, block_q, r);
+						std::copy(block_q.begin(), block_q.end(), q.begin() + std::ptrdiff_t(first));
+					}
+				}
+				
+				// Unnormalize the remainder
+				normalize(q);
+				normalize(r);
+				if (m_shift != 0 && r.empty() == false)
+				{
+					for (size_t i = 0; i < r.size(); ++i)
+					{
+						hopp::ullint const two = (hopp::ullint((i + 1 < r.size()) ? r[i + 1] : 0) << 32) | r[i];
+						r[i] = limb_type(two >> m_shift);
+					}
+					normalize(r);
+				}
+			}
+			
+		private:
+			
+			/// @brief Divide a numerator smaller than d B^n with the reciprocal (Barrett)
+			/// @param[in]  a A magnitude (a < d B^n)
+			/// @param[out] q Quotient
+			/// @param[out] r Remainder (normalized)
+			void div_2n_by_n(magnitude const & a, magnitude & q, magnitude & r) const
+			{
+				size_t const n = m_d.size();
+				if (compare(a, m_d) < 0) { q.clear(); r = a; return; }
+				
+				// q = floor(floor(a / B^(n-1)) reciprocal / B^(n+1)) is at most 3 too small
+				magnitude const p = mul(magnitude(a.begin() + std::ptrdiff_t(n - 1), a.end()), m_reciprocal);
+				q.assign(p.begin() + std::ptrdiff_t(std::min(n + 1, p.size())), p.end());
+				r = a;
+				magnitude const qd = mul(q, m_d);
+				sub(r.data(), r.size(), qd.data(), qd.size(), r.data());
+				normalize(r);
+				while (compare(r, m_d) >= 0)
+				{
+					sub(r.data(), r.size(), m_d.data(), n, r.data());
+					normalize(r);
+					increment(q);
+				}
+			}
+		};
+		
+		/// @brief Add 1 to a magnitude
+		/// @param[in,out] a A magnitude
+		static void increment(magnitude & a)
+		{
+			for (limb_type & l : a) { if (++l != 0) { return; } }
+			a.push_back(1);
+		}
+		
+		/// @brief Compute the reciprocal of a normalized denominator (Newton iteration)
+		/// @param[in] d Limbs of the denominator (the most significant bit is set)
+		/// @param[in] n Number of limbs of the denominator
+		/// @return floor(B^(2n) / d)
+		static magnitude reciprocal(limb_type const * const d, size_t const n)
+		{
+			// B^2n
+			magnitude b2n(2 * n + 1, 0);
+			b2n[2 * n] = 1;
+			
+			magnitude x;
+			if (n < newton_threshold)
+			{
+				x.assign(n + 2, 0);
+				magnitude scratch(2 * n + 1 + n + 1);
+				hopp::div_q_r_words(b2n.data(), b2n.size(), d, n, x.data(), nullptr, scratch.data());
+				normalize(x);
+				return x;
+			}
+			
+			// Reciprocal of the h most significant limbs: y = floor(B^2h / d_high)
+			size_t const h = (n + 1) / 2;
+			size_t const l = n - h;
+			magnitude const y = reciprocal(d + l, h);
+			magnitude const dm(d, d + n);
+			
+			// Newton: x = y B^l + y e / B^2h with e = B^(n+h) - d y
+			// e is small: only its h + 2 most significant limbs are used
+			magnitude const t = mul(dm, y);
+			magnitude e(n + h + 1, 0);
+			e[n + h] = 1;
+			bool const positive = compare(t, e) <= 0;
+			if (positive) { sub(e.data(), e.size(), t.data(), t.size(), e.data()); }
+			else { magnitude t_minus_e = t; sub(t_minus_e.data(), t_minus_e.size(), e.data(), e.size(), t_minus_e.data()); e = std::move(t_minus_e); }
+			normalize(e);
+			size_t const nb_dropped = std::min((e.size() > h + 2) ? e.size() - (h + 2) : 0, 2 * h);
+			magnitude const ye = mul(y, magnitude(e.begin() + std::ptrdiff_t(nb_dropped), e.end()));
+			magnitude const c(ye.begin() + std::ptrdiff_t(std::min(2 * h - nb_dropped, ye.size())), ye.end());
+			
+			// x = y B^l +- c and p = d x = t B^l +- d c
+			x.assign(l, 0);
+			x.insert(x.end(), y.begin(), y.end());
+			magnitude p(l, 0);
+			p.insert(p.end(), t.begin(), t.end());
+			magnitude const dc = mul(dm, c);
+			if (positive)
+			{
+				x.resize(std::max(x.size(), c.size()) + 1, 0);
+				add_in_place(x.data(), x.size(), c.data(), c.size());
+				p.resize(std::max(p.size(), dc.size()) + 1, 0);
+				add_in_place(p.data(), p.size(), dc.data(), dc.size());
+			}
+			else
+			{
+				sub(x.data(), x.size(), c.data(), c.size(), x.data());
+				sub(p.data(), p.size(), dc.data(), dc.size(), p.data());
+			}
+			normalize(x);
+			normalize(p);
+			
+			// Corrections (a few units): d x <= B^2n < d (x + 1)
+			while (compare(p, b2n) > 0)
+			{
+				decrement(x);
+				sub(p.data(), p.size(), d, n, p.data());
+				normalize(p);
+			}
+			magnitude rest = b2n;
+			sub(rest.data(), rest.size(), p.data(), p.size(), rest.data());
+			normalize(rest);
+			while (compare(rest, dm) >= 0)
+			{
+				increment(x);
+				sub(rest.data(), rest.size(), d, n, rest.data());
+				normalize(rest);
+			}
+			return x;
+		}
+		
+		/// @brief Subtract 1 from a magnitude
+		/// @param[in,out] a A magnitude (not 0)
+		static void decrement(magnitude & a)
+		{
+			for (limb_type & l : a) { if (l-- != 0) { break; } }
+			normalize(a);
+		}
+		
+		// Decimal conversion
+		
+		/// @brief Write a magnitude in decimal (divide and conquer)
+		/// @param[in]     m        A magnitude (m < powers[level]^2)
+		/// @param[in]     level    Level of the power to divide with
+		/// @param[in]     nb_digit Number of digits to write (leading zeros), 0 for no padding
+		/// @param[in]     powers   Powers 10^(9 * 2^k)
+		/// @param[in,out] divisors Divisors of the powers (computed at the first use)
+		/// @param[in,out] out      Output
+		static void to_string(magnitude const & m, size_t const level, size_t const nb_digit, std::vector<magnitude> const & powers, std::vector<divisor> & divisors, std::string & out)
+		{
+			// Small magnitude: chunks of 9 digits
+			if (level == 0 || m.size() < 2 * karatsuba_threshold)
+			{
+				std::vector<limb_type> chunks;
+				magnitude x = m;
+				normalize(x);
+				while (x.empty() == false)
+				{
+					hopp::ullint rest = 0;
+					for (size_t i = x.size(); i > 0; --i)
+					{
+						hopp::ullint const current = (rest << 32) | x[i - 1];
+						x[i - 1] = limb_type(current / 1000000000);
+						rest = current % 1000000000;
+					}
+					chunks.push_back(limb_type(rest));
+					normalize(x);
+				}
+				
+				std::string digits;
+				for (size_t i = chunks.size(); i > 0; --i)
+				{
+					std::string chunk = std::to_string(chunks[i - 1]);
+					if (i != chunks.size()) { chunk.insert(0, 9 - chunk.size(), '0'); }
+					digits += chunk;
+				}
+				if (nb_digit > digits.size()) { out.append(nb_digit - digits.size(), '0'); }
+				out += digits;
+				return;
+			}
+			
+			// m = q 10^(9 * 2^level) + r
+			size_t const nb_low_digit = size_t(9) << level;
+			if (compare(m, powers[level]) < 0)
+			{
+				to_string(m, level - 1, nb_digit, powers, divisors, out);
+				return;
+			}
+			if (divisors[level].empty()) { divisors[level] = divisor(powers[level].data(), powers[level].size()); }
+			magnitude q;
+			magnitude r;
+			divisors[level].div_q_r(m.data(), m.size(), q, r);
+			to_string(q, level - 1, (nb_digit > nb_low_digit) ? nb_digit - nb_low_digit : 0, powers, divisors, out);
+			to_string(r, level - 1, nb_low_digit, powers, divisors, out);
+		}
+		
+		/// @brief Parse decimal digits (divide and conquer)
+		/// @param[in]     digits   Decimal digits
+		/// @param[in]     n        Number of digits
+		/// @param[in,out] powers   Powers 10^(9 * 2^k) (computed at the first use)
+		/// @return the magnitude
+		static magnitude parse(char const * const digits, size_t const n, std::vector<magnitude> & powers)
+		{
+			// Small number: chunks of 9 digits
+			if (n <= 9 * 2 * karatsuba_threshold)
+			{
+				magnitude m;
+				// The first chunk has n % 9 digits (or 9)
+				for (size_t first = 0, last = (n % 9 == 0) ? 9 : n % 9; first < n; first = last, last += 9)
+				{
+					limb_type chunk = 0;
+					limb_type scale = 1;
+					for (size_t i = first; i < last; ++i) { chunk = chunk * 10 + limb_type(digits[i] - '0'); scale *= 10; }
+					// m = m * scale + chunk
+					hopp::ullint carry = chunk;
+					for (limb_type & l : m)
+					{
+						hopp::ullint const t = hopp::ullint(l) * scale + carry;
+						l = limb_type(t);
+						carry = t >> 32;
+					}
+					if (carry != 0) { m.push_back(limb_type(carry)); }
+				}
+				normalize(m);
+				return m;
+			}
+			
+			// value = high 10^(9 * 2^k) + low with 9 * 2^k < n
+			if (powers.empty()) { powers.push_back(magnitude(1, 1000000000)); }
+			size_t k = 0;
+			while ((size_t(9) << (k + 1)) < n)
+			{
+				++k;
+				if (powers.size() <= k) { powers.push_back(square(powers.back())); }
+			}
+			size_t const nb_low_digit = size_t(9) << k;
+			magnitude const high = parse(digits, n - nb_low_digit, powers);
+			magnitude const low = parse(digits + n - nb_low_digit, nb_low_digit, powers);
+			magnitude r = mul(high, powers[k]);
+			r.resize(std::max(r.size(), low.size()) + 1, 0);
+			add_in_place(r.data(), r.size(), low.data(), low.size());
+			normalize(r);
+			return r;
+		}
+	};
+	
+	// Out-of-class definitions (the constants are odr-used)
+	constexpr size_t bigint::nb_inline_limbs;
+	constexpr size_t bigint::karatsuba_threshold;
+	constexpr size_t bigint::newton_threshold;
+	
+	// Arithmetic
+	
+	/// @brief Operator - (unary)
+	/// @param[in] a A hopp::bigint
+	/// @return -a
+	/// @relates hopp::bigint
+	inline hopp::bigint operator -(hopp::bigint a)
+	{
+		if (a.m_size != 0) { a.m_negative = (a.m_negative == false); }
+		return a;
+	}
+	
+	/// @brief Operator + between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a + b
+	/// @relates hopp::bigint
+	inline hopp::bigint operator +(hopp::bigint const & a, hopp::bigint const & b)
+	{
+		return hopp::bigint::add(a, b, b.m_negative);
+	}
+	
+	/// @brief Operator - between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a - b
+	/// @relates hopp::bigint
+	inline hopp::bigint operator -(hopp::bigint const & a, hopp::bigint const & b)
+	{
+		return hopp::bigint::add(a, b, b.m_size != 0 && b.m_negative == false);
+	}
+	
+	/// @brief Operator * between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a * b
+	/// @relates hopp::bigint
+	inline hopp::bigint operator *(hopp::bigint const & a, hopp::bigint const & b)
+	{
+		hopp::bigint r;
+		if (a.m_size == 0 || b.m_size == 0) { return r; }
+		size_t const n = a.m_size + b.m_size;
+		if (n <= hopp::bigint::nb_inline_limbs)
+		{
+			hopp::bigint::limb_type l[hopp::bigint::nb_inline_limbs];
+			hopp::bigint::mul_schoolbook(a.limbs(), a.m_size, b.limbs(), b.m_size, l);
+			r.assign(l, n, a.m_negative != b.m_negative);
+		}
+		else
+		{
+			hopp::bigint::magnitude l(n);
+			hopp::bigint::mul(a.limbs(), a.m_size, b.limbs(), b.m_size, l.data());
+			r.assign(std::move(l), a.m_negative != b.m_negative);
+		}
+		return r;
+	}
+	
+	/// @brief Divide two hopp::bigint
+	/// @param[in] a Numerator
+	/// @param[in] b Denominator
+	/// @return quotient (truncated toward zero) and remainder (with the sign of a)
+	/// @exception std::domain_error if b == 0
+	/// @relates hopp::bigint
+	inline hopp::q_r<hopp::bigint> div_q_r(hopp::bigint const & a, hopp::bigint const & b)
+	{
+		if (b.m_size == 0) { throw std::domain_error("hopp::div_q_r: divide by zero"); }
+		hopp::q_r<hopp::bigint> r;
+		if (hopp::bigint::compare(a.limbs(), a.m_size, b.limbs(), b.m_size) < 0) { r.r = a; return r; }
+		if (a.m_size <= hopp::bigint::nb_inline_limbs)
+		{
+			hopp::bigint::limb_type q[hopp::bigint::nb_inline_limbs] = { 0, 0, 0, 0 };
+			hopp::bigint::limb_type rem[hopp::bigint::nb_inline_limbs] = { 0, 0, 0, 0 };
+			hopp::bigint::limb_type scratch[2 * hopp::bigint::nb_inline_limbs + 1];
+			hopp::div_q_r_words(a.limbs(), a.m_size, b.limbs(), b.m_size, q, rem, scratch);
+			r.q.assign(q, a.m_size - b.m_size + 1, a.m_negative != b.m_negative);
+			r.r.assign(rem, b.m_size, a.m_negative);
+		}
+		else
+		{
+			hopp::bigint::magnitude q;
+			hopp::bigint::magnitude rem;
+			hopp::bigint::divisor(b.limbs(), b.m_size).div_q_r(a.limbs(), a.m_size, q, rem);
+			r.q.assign(std::move(q), a.m_negative != b.m_negative);
+			r.r.assign(std::move(rem), a.m_negative);
+		}
+		return r;
+	}
+	
+	/// @brief Operator << between a hopp::bigint and a number of bits
+	/// @param[in] a A hopp::bigint
+	/// @param[in] n Number of bits
+	/// @return a * 2^n
+	/// @relates hopp::bigint
+	inline hopp::bigint operator <<(hopp::bigint const & a, size_t const n)
+	{
+		hopp::bigint r;
+		if (a.m_size == 0) { return r; }
+		hopp::bigint::magnitude l(a.m_size + n / 32 + 1, 0);
+		hopp::bigint::shift_left(a.limbs(), a.m_size, n, l.data() + n / 32, l.size() - n / 32);
+		r.assign(std::move(l), a.m_negative);
+		return r;
+	}
+	
+	/// @brief Operator >> between a hopp::bigint and a number of bits
+	/// @param[in] a A hopp::bigint
+	/// @param[in] n Number of bits
+	/// @return the magnitude of a divided by 2^n, with the sign of a
+	/// @relates hopp::bigint
+	inline hopp::bigint operator >>(hopp::bigint const & a, size_t const n)
+	{
+		hopp::bigint r;
+		if (n / 32 >= a.m_size) { return r; }
+		size_t const size = a.m_size - n / 32;
+		hopp::bigint::magnitude l(size);
+		unsigned int const s = unsigned(n % 32);
+		hopp::bigint::limb_type const * const p = a.limbs() + n / 32;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hopp::ullint const two = (hopp::ullint((i + 1 < size) ? p[i + 1] : 0) << 32) | p[i];
+			l[i] = hopp::bigint::limb_type(two >> s);
+		}
+		r.assign(std::move(l), a.m_negative);
+		return r;
+	}
+	
+	/// @brief Compare two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a negative number if a < b, 0 if a == b, a positive number if a > b
+	/// @relates hopp::bigint
+	inline int compare(hopp::bigint const & a, hopp::bigint const & b)
+	{
+		if (a.m_negative != b.m_negative) { return a.m_negative ? -1 : 1; }
+		int const c = hopp::bigint::compare(a.limbs(), a.m_size, b.limbs(), b.m_size);
+		return a.m_negative ? -c : c;
+	}
+	
+	// Compound assignments
+	
+	/// @brief Operator += between two hopp::bigint
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     b A hopp::bigint
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator +=(hopp::bigint & a, hopp::bigint const & b) { a = a + b; return a; }
+	
+	/// @brief Operator -= between two hopp::bigint
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     b A hopp::bigint
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator -=(hopp::bigint & a, hopp::bigint const & b) { a = a - b; return a; }
+	
+	/// @brief Operator *= between two hopp::bigint
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     b A hopp::bigint
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator *=(hopp::bigint & a, hopp::bigint const & b) { a = a * b; return a; }
+	
+	/// @brief Operator / between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a / b (truncated toward zero)
+	/// @relates hopp::bigint
+	inline hopp::bigint operator /(hopp::bigint const & a, hopp::bigint const & b) { return div_q_r(a, b).q; }
+	
+	/// @brief Operator /= between two hopp::bigint
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     b A hopp::bigint
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator /=(hopp::bigint & a, hopp::bigint const & b) { a = a / b; return a; }
+	
+	/// @brief Operator % between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return a % b (with the sign of a)
+	/// @relates hopp::bigint
+	inline hopp::bigint operator %(hopp::bigint const & a, hopp::bigint const & b) { return div_q_r(a, b).r; }
+	
+	/// @brief Operator %= between two hopp::bigint
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     b A hopp::bigint
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator %=(hopp::bigint & a, hopp::bigint const & b) { a = a % b; return a; }
+	
+	/// @brief Operator <<= between a hopp::bigint and a number of bits
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     n Number of bits
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator <<=(hopp::bigint & a, size_t const n) { a = a << n; return a; }
+	
+	/// @brief Operator >>= between a hopp::bigint and a number of bits
+	/// @param[in,out] a A hopp::bigint
+	/// @param[in]     n Number of bits
+	/// @return a
+	/// @relates hopp::bigint
+	inline hopp::bigint & operator >>=(hopp::bigint & a, size_t const n) { a = a >> n; return a; }
+	
+	// ==, !=, <, >, <=, >=
+	
+	/// @brief Operator == between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a == b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator ==(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) == 0; }
+	
+	/// @brief Operator != between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator !=(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) != 0; }
+	
+	/// @brief Operator < between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a < b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator <(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) < 0; }
+	
+	/// @brief Operator > between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a > b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator >(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) > 0; }
+	
+	/// @brief Operator <= between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a <= b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator <=(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) <= 0; }
+	
+	/// @brief Operator >= between two hopp::bigint
+	/// @param[in] a A hopp::bigint
+	/// @param[in] b A hopp::bigint
+	/// @return true if a >= b, false otherwise
+	/// @relates hopp::bigint
+	inline bool operator >=(hopp::bigint const & a, hopp::bigint const & b) { return compare(a, b) >= 0; }
+	
+	// to_string, <<
+	
+	/// @brief Convert a hopp::bigint into a decimal std::string
+	/// @param[in] i A hopp::bigint
+	/// @return the decimal std::string
+	/// @relates hopp::bigint
+	inline std::string to_string(hopp::bigint const & i) { return i.to_string(); }
+	
+	/// @brief Operator << between a std::ostream and a hopp::bigint
+	/// @param[in,out] out A std::ostream
+	/// @param[in]     i   A hopp::bigint
+	/// @return out
+	/// @relates hopp::bigint
+	inline std::ostream & operator <<(std::ostream & out, hopp::bigint const & i)
+	{
+		out << i.to_string();
+		return out;
+	}
+}
+
+#endif
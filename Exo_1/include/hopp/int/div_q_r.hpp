@@ -16,8 +16,13 @@
 #ifndef HOPP_INT_DIV_Q_R_HPP
 #define HOPP_INT_DIV_Q_R_HPP
 
+#include <iostream>
 #include <stdexcept>
 #include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <type_traits>
 
 
 namespace hopp
@@ -61,17 +66,66 @@ namespace hopp
 	template <class T>
 	std::ostream & operator <<(std::ostream & out, hopp::q_r<T> const & q_r)
 	{
-		out << "{ " << q_r.x << ", " << q_r.y << " }";
+		out << "{ " << q_r.q << ", " << q_r.r << " }";
 		return out;
 	}
 	
+	/// @brief Divide two integers with the built-in / and % operators
+	/// @param[in] a Numerator
+	/// @param[in] b Denominator
+	/// @return quotient and remainder
+	template <class int_t>
+	hopp::q_r<int_t> div_q_r_impl(int_t const & a, int_t const & b, std::true_type /*is_integral*/)
+	{
+		return { int_t(a / b), int_t(a % b) };
+	}
+	
+	/// @brief Divide two integers bit by bit
+	/// @param[in] a Numerator
+	/// @param[in] b Denominator
+	/// @return quotient and remainder
+	template <class int_t>
+	hopp::q_r<int_t> div_q_r_impl(int_t const & a, int_t const & b, std::false_type /*is_integral*/)
+	{
+		// From http://stackoverflow.com/questions/1188939/representing-128-bit-numbers-in-c
+		// Copyright © 2008 Evan Teran
+		
+		constexpr int const bits = sizeof(int_t) * CHAR_BIT;
+		
+		int_t r = a;
+		int_t b_copy = b;
+		int_t x = 1;
+		int_t q = 0;
+		
+		while ((r >= b_copy) && (((b_copy >> (bits - 1)) & 1) == 0))
+		{
+			x <<= 1;
+			b_copy <<= 1;
+		}
+		
+		while (x != 0)
+		{
+			if (r >= b_copy)
+			{
+				r -= b_copy;
+				q |= x;
+			}
+			x >>= 1;
+			b_copy >>= 1;
+		}
+		
+		return { q, r };
+	}
+	
 	/**
-	 * @brief Divide two integer using >=, >>, &, ==, <<=, !=, -= and |= operators
+	 * @brief Divide two integers
 	 *
 	 * @code
 	   #include <hopp/int.hpp>
 	   @endcode
 	 *
+	 * The built-in integers use the / and % operators. The other types are divided bit by bit using >=, >>, &, ==, <<=, !=, -= and |= operators (hopp::uint128 has its own overload).
+	 *
 	 * @param[in] a Numerator
 	 * @param[in] b Denominator
 	 *
@@ -79,46 +133,161 @@ namespace hopp
 	 *
 	 * @return quotient and remainder in hopp::q_r<T>
 	 *
+	 * @exception std::domain_error if b == 0
+	 *
+	 * @see hopp::divider for repeated divisions by the same denominator
+	 *
 	 * @ingroup hopp_int_and_float
 	 */
 	template <class int_t>
 	hopp::q_r<int_t> div_q_r(int_t const & a, int_t const & b)
 	{
-		// From http://stackoverflow.com/questions/1188939/representing-128-bit-numbers-in-c
-		// Copyright © 2008 Evan Teran
+		if (b == 0) { throw std::domain_error("hopp::div_q_r: divide by zero"); }
+		return hopp::div_q_r_impl(a, b, std::is_integral<int_t>());
+	}
+	
+	/// @brief Get the number of leading zero bits of a 32-bit word
+	/// @param[in] w A word (not 0)
+	/// @return the number of leading zero bits
+	/// @ingroup hopp_int_and_float
+	inline unsigned int count_leading_zeros_32(std::uint32_t w)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned int>(__builtin_clz(w));
+		#else
+			unsigned int n = 0;
+			while ((w & 0x80000000u) == 0) { w <<= 1; ++n; }
+			return n;
+		#endif
+	}
+	
+	/**
+	 * @brief Divide two multi-word integers (Knuth, The Art of Computer Programming, Volume 2, algorithm D)
+	 *
+	 * @code
+	   #include <hopp/int.hpp>
+	   @endcode
+	 *
+	 * The integers are arrays of 32-bit words, the least significant word first.
+	 *
+	 * @param[in]  u       Numerator (m words)
+	 * @param[in]  m       Number of words of u
+	 * @param[in]  v       Denominator (n words)
+	 * @param[in]  n       Number of words of v
+	 * @param[out] q       Quotient (m - n + 1 words, can be nullptr)
+	 * @param[out] r       Remainder (n words, can be nullptr)
+	 * @param[out] scratch Temporary words (m + n + 1 words)
+	 *
+	 * @pre m >= n >= 1 and v[n - 1] != 0
+	 *
+	 * @ingroup hopp_int_and_float
+	 */
+	inline void div_q_r_words
+	(
+		std::uint32_t const * const u, size_t const m,
+		std::uint32_t const * const v, size_t const n,
+		std::uint32_t * const q, std::uint32_t * const r,
+		std::uint32_t * const scratch
+	)
+	{
+		std::uint64_t const base = std::uint64_t(1) << 32;
 		
-		if (b == 0)
+		// Division by one word
+		if (n == 1)
 		{
-			throw std::domain_error("hopp::div_q_r: divide by zero");
+			std::uint64_t remainder = 0;
+			for (size_t j = m; j > 0; --j)
+			{
+				std::uint64_t const current = (remainder << 32) | u[j - 1];
+				if (q != nullptr) { q[j - 1] = std::uint32_t(current / v[0]); }
+				remainder = current % v[0];
+			}
+			if (r != nullptr) { r[0] = std::uint32_t(remainder); }
+			return;
 		}
-		else
+		
+		// Normalize: the most significant bit of vn[n - 1] is set
+		unsigned int const s = hopp::count_leading_zeros_32(v[n - 1]);
+		std::uint32_t * const un = scratch;
+		std::uint32_t * const vn = scratch + m + 1;
+		for (size_t i = n - 1; i > 0; --i) { vn[i] = (v[i] << s) | std::uint32_t((std::uint64_t(v[i - 1]) >> (32 - s))); }
+		vn[0] = v[0] << s;
+		un[m] = std::uint32_t(std::uint64_t(u[m - 1]) >> (32 - s));
+		for (size_t i = m - 1; i > 0; --i) { un[i] = (u[i] << s) | std::uint32_t((std::uint64_t(u[i - 1]) >> (32 - s))); }
+		un[0] = u[0] << s;
+		
+		for (size_t j = m - n + 1; j > 0; --j)
 		{
-			constexpr int const bits = sizeof(int_t) * CHAR_BIT;
+			size_t const k = j - 1;
 			
-			int_t r = a;
-			int_t b_copy = b;
-			int_t x = 1;
-			int_t q = 0;
+			// Estimate the quotient word (at most 2 too large)
+			std::uint64_t const top = (std::uint64_t(un[k + n]) << 32) | un[k + n - 1];
+			std::uint64_t qhat = top / vn[n - 1];
+			std::uint64_t rhat = top % vn[n - 1];
+			while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[k + n - 2]))
+			{
+				--qhat;
+				rhat += vn[n - 1];
+				if (rhat >= base) { break; }
+			}
 			
-			while ((r >= b_copy) && (((b_copy >> (bits - 1)) & 1) == 0))
+			// Multiply and subtract
+			std::uint64_t borrow = 0;
+			for (size_t i = 0; i < n; ++i)
 			{
-				x <<= 1;
-				b_copy <<= 1;
+				std::uint64_t const p = qhat * vn[i] + borrow;
+				std::uint32_t const p_lo = std::uint32_t(p);
+				borrow = (p >> 32) + ((un[i + k] < p_lo) ? 1 : 0);
+				un[i + k] -= p_lo;
 			}
+			bool const negative = un[k + n] < borrow;
+			un[k + n] = std::uint32_t(un[k + n] - borrow);
 			
-			while (x != 0)
+			// Add back (rare)
+			if (negative)
 			{
-				if (r >= b_copy)
+				--qhat;
+				std::uint64_t carry = 0;
+				for (size_t i = 0; i < n; ++i)
 				{
-					r -= b_copy;
-					q |= x;
+					std::uint64_t const t = std::uint64_t(un[i + k]) + vn[i] + carry;
+					un[i + k] = std::uint32_t(t);
+					carry = t >> 32;
 				}
-				x >>= 1;
-				b_copy >>= 1;
+				un[k + n] = std::uint32_t(un[k + n] + carry);
 			}
 			
-			return { q, r };
+			if (q != nullptr) { q[k] = std::uint32_t(qhat); }
 		}
+		
+		// Unnormalize the remainder
+		if (r != nullptr)
+		{
+			for (size_t i = 0; i < n; ++i) { r[i] = std::uint32_t((un[i] >> s) | (std::uint64_t(un[i + 1]) << (32 - s))); }
+		}
+	}
+	
+	/// @brief Divide two multi-word integers (Knuth algorithm D)
+	/// @param[in] u Numerator (least significant word first)
+	/// @param[in] v Denominator (least significant word first)
+	/// @return quotient and remainder, without leading zero words
+	/// @exception std::domain_error if v == 0
+	/// @ingroup hopp_int_and_float
+	inline hopp::q_r<std::vector<std::uint32_t>> div_q_r_words(std::vector<std::uint32_t> u, std::vector<std::uint32_t> v)
+	{
+		while (u.empty() == false && u.back() == 0) { u.pop_back(); }
+		while (v.empty() == false && v.back() == 0) { v.pop_back(); }
+		if (v.empty()) { throw std::domain_error("hopp::div_q_r_words: divide by zero"); }
+		if (u.size() < v.size()) { return { std::vector<std::uint32_t>(), u }; }
+		
+		hopp::q_r<std::vector<std::uint32_t>> r;
+		r.q.resize(u.size() - v.size() + 1);
+		r.r.resize(v.size());
+		std::vector<std::uint32_t> scratch(u.size() + v.size() + 1);
+		hopp::div_q_r_words(u.data(), u.size(), v.data(), v.size(), r.q.data(), r.r.data(), scratch.data());
+		while (r.q.empty() == false && r.q.back() == 0) { r.q.pop_back(); }
+		while (r.r.empty() == false && r.r.back() == 0) { r.r.pop_back(); }
+		return r;
 	}
 }
 
@@ -0,0 +1,195 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_INT_DIVIDER_HPP
+#define HOPP_INT_DIVIDER_HPP
+
+#include <stdexcept>
+#include <type_traits>
+#include <limits>
+
+#include "ullint.hpp"
+#include "uint128.hpp"
+#include "div_q_r.hpp"
+
+
+namespace hopp
+{
+	/**
+	 * @brief Divider by a fixed denominator with a precomputed reciprocal
+	 *
+	 * The denominator is given at run time; the divisions are replaced by multiplications and shifts:
+	 * - T / denominator: Granlund & Montgomery, "Division by invariant integers using multiplication" (1994)
+	 * - hopp::uint128 / denominator: Möller & Granlund, "Improved division by invariant integers" (2011)
+	 *
+	 * T is an unsigned built-in integer of at most 64 bits.
+	 *
+	 * @code
+	   hopp::divider<hopp::ullint> const by_7(7);
+	   hopp::ullint const q = 100 / by_7; // 14
+	   hopp::ullint const r = 100 % by_7; // 2
+	   auto const q_r = by_7.div_q_r(hopp::uint128("340282366920938463463374607431768211455"));
+	   @endcode
+	 *
+	 * @code
+	   #include <hopp/int/divider.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_int_and_float
+	 */
+	template <class T>
+	class divider
+	{
+		static_assert
+		(
+			std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= sizeof(hopp::ullint),
+			"hopp::divider<T>: T must be an unsigned built-in integer of at most 64 bits"
+		);
+
+	private:
+
+		/// Denominator
+		T m_denominator;
+
+		/// Magic number: floor(2^64 * (2^l - d) / d) + 1 with l = ceil(log2(d))
+		hopp::ullint m_magic;
+
+		/// First shift: min(l, 1)
+		unsigned int m_shift_1;
+
+		/// Second shift: max(l - 1, 0)
+		unsigned int m_shift_2;
+
+		/// Number of leading zeros of the denominator (on 64 bits)
+		unsigned int m_normalization;
+
+		/// Normalized denominator (d << m_normalization)
+		hopp::ullint m_normalized;
+
+		/// Reciprocal of the normalized denominator: floor((2^128 - 1) / m_normalized) - 2^64
+		hopp::ullint m_reciprocal;
+
+	public:
+
+		/// @brief Constructor
+		/// @param[in] denominator Denominator
+		/// @exception std::domain_error if denominator == 0
+		explicit divider(T const denominator) :
+			m_denominator(denominator), m_magic(0), m_shift_1(0), m_shift_2(0), m_normalization(0), m_normalized(0), m_reciprocal(0)
+		{
+			if (denominator == 0) { throw std::domain_error("hopp::divider: divide by zero"); }
+
+			hopp::ullint const d = denominator;
+
+			// l = ceil(log2(d))
+			unsigned int const l = (d == 1) ? 0 : 64 - hopp::uint128::count_leading_zeros_64(d - 1);
+			m_shift_1 = (l < 1) ? l : 1;
+			m_shift_2 = (l > 1) ? l - 1 : 0;
+			// 2^64 * (2^l - d) / d, with 2^l - d < 2^64
+			hopp::ullint const two_l_minus_d = (l == 64) ? (0 - d) : ((hopp::ullint(1) << l) - d);
+			m_magic = (hopp::div_q_r(hopp::uint128(two_l_minus_d, 0), hopp::uint128(d)).q + 1).lo;
+
+			m_normalization = hopp::uint128::count_leading_zeros_64(d);
+			m_normalized = d << m_normalization;
+			// floor((2^128 - 1) / dn) - 2^64 = floor((2^128 - 1 - 2^64 dn) / dn)
+			m_reciprocal = hopp::div_q_r(hopp::uint128(~m_normalized, ~hopp::ullint(0)), hopp::uint128(m_normalized)).q.lo;
+		}
+
+		/// @brief Get the denominator
+		/// @return the denominator
+		T denominator() const { return m_denominator; }
+
+		/// @brief Divide
+		/// @param[in] n Numerator
+		/// @return n / denominator
+		T quotient(T const n) const
+		{
+			hopp::ullint const t = hopp::uint128::mul_64_64(m_magic, n).hi;
+			return T((t + ((hopp::ullint(n) - t) >> m_shift_1)) >> m_shift_2);
+		}
+
+		/// @brief Get the remainder
+		/// @param[in] n Numerator
+		/// @return n % denominator
+		T remainder(T const n) const { return T(n - quotient(n) * m_denominator); }
+
+		/// @brief Divide and get the remainder
+		/// @param[in] n Numerator
+		/// @return quotient and remainder
+		hopp::q_r<T> div_q_r(T const n) const
+		{
+			T const q = quotient(n);
+			return { q, T(n - q * m_denominator) };
+		}
+
+		/// @brief Divide a hopp::uint128
+		/// @param[in] n Numerator
+		/// @return quotient and remainder
+		hopp::q_r<hopp::uint128> div_q_r(hopp::uint128 const & n) const
+		{
+			// Normalize the numerator in three words: n2 < m_normalized
+			unsigned int const s = m_normalization;
+			hopp::ullint const n2 = (s == 0) ? 0 : n.hi >> (64 - s);
+			hopp::ullint const n1 = (s == 0) ? n.hi : (n.hi << s) | (n.lo >> (64 - s));
+			hopp::ullint const n0 = n.lo << s;
+
+			hopp::ullint r = 0;
+			hopp::ullint const q1 = div_2_by_1(n2, n1, r);
+			hopp::ullint const q0 = div_2_by_1(r, n0, r);
+			return { hopp::uint128(q1, q0), hopp::uint128(r >> s) };
+		}
+
+	private:
+
+		/// @brief Divide a two-word integer by the normalized denominator
+		/// @param[in]  u1 High word (u1 < m_normalized)
+		/// @param[in]  u0 Lower word
+		/// @param[out] r  Remainder (normalized)
+		/// @return the quotient
+		hopp::ullint div_2_by_1(hopp::ullint const u1, hopp::ullint const u0, hopp::ullint & r) const
+		{
+			hopp::uint128 q = hopp::uint128::mul_64_64(m_reciprocal, u1) + hopp::uint128(u1, u0);
+			++q.hi;
+			r = u0 - q.hi * m_normalized;
+			if (r > q.lo) { --q.hi; r += m_normalized; }
+			if (r >= m_normalized) { ++q.hi; r -= m_normalized; }
+			return q.hi;
+		}
+	};
+
+	/// @brief Operator / between a T and a hopp::divider<T>
+	/// @param[in] n Numerator
+	/// @param[in] d A hopp::divider<T>
+	/// @return n / d.denominator()
+	/// @relates hopp::divider
+	template <class T>
+	T operator /(T const n, hopp::divider<T> const & d)
+	{
+		return d.quotient(n);
+	}
+
+	/// @brief Operator % between a T and a hopp::divider<T>
+	/// @param[in] n Numerator
+	/// @param[in] d A hopp::divider<T>
+	/// @return n % d.denominator()
+	/// @relates hopp::divider
+	template <class T>
+	T operator %(T const n, hopp::divider<T> const & d)
+	{
+		return d.remainder(n);
+	}
+}
+
+#endif
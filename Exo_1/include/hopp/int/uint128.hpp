@@ -1,4 +1,4 @@
-// Copyright © 2014, 2016 Lénaïc Bagnères, hnc@singularity.fr
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
 
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,16 +17,28 @@
 #define HOPP_INT_UINT128_HPP
 
 #include <iostream>
+#include <string>
 #include <limits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
 
 #include "ullint.hpp"
 #include "div_q_r.hpp"
 
+// Native 128-bit integer (GCC, Clang)
+#ifdef __SIZEOF_INT128__
+	#define HOPP_INT_UINT128_NATIVE
+#endif
+
 
 namespace hopp
 {
 	/**
-	 * @brief unsigned int with values between 0 and 255
+	 * @brief unsigned int with values between 0 and 2^128 - 1
+	 *
+	 * The arithmetic is modulo 2^128. When the compiler has a native 128-bit integer (unsigned __int128), the operators use it (the compiler generates add/adc, sub/sbb and mul/mulx); otherwise they are computed on the two 64-bit halves.
 	 *
 	 * @code
 	   #include <hopp/int.hpp>
@@ -38,6 +50,11 @@ namespace hopp
 	{
 	public:
 		
+		#ifdef HOPP_INT_UINT128_NATIVE
+		/// Native 128-bit integer
+		__extension__ typedef unsigned __int128 native_type;
+		#endif
+		
 		/// Lower part
 		hopp::ullint lo;
 		
@@ -47,14 +64,119 @@ namespace hopp
 	public:
 		
 		/// @brief Constructor from hopp::ullint
-		/// @param[in] i Integer between 0 and 255
-		uint128(hopp::ullint const i = 0) : lo(i), hi(0) { }
+		/// @param[in] i Integer between 0 and 2^64 - 1
+		constexpr uint128(hopp::ullint const i = 0) : lo(i), hi(0) { }
+		
+		/// @brief Constructor from the two 64-bit halves
+		/// @param[in] hi High part
+		/// @param[in] lo Lower part
+		constexpr uint128(hopp::ullint const hi, hopp::ullint const lo) : lo(lo), hi(hi) { }
+		
+		/// @brief Constructor from a decimal or hexadecimal string
+		/// @param[in] i    A std::string of digits (without prefix for the hexadecimal)
+		/// @param[in] base Base (10 or 16)
+		/// @exception std::invalid_argument if i is not a number in this base or if the base is not 10 or 16
+		/// @exception std::out_of_range if the number is greater than 2^128 - 1
+		explicit uint128(std::string const & i, unsigned int const base = 10);
+		
+		/// @brief Test if the integer is not 0
+		/// @return true if the integer is not 0, false otherwise
+		explicit operator bool() const { return (lo | hi) != 0; }
+		
+		#ifdef HOPP_INT_UINT128_NATIVE
+		
+		/// @brief Get the native 128-bit integer
+		/// @return the native 128-bit integer
+		native_type native() const { return (native_type(hi) << 64) | lo; }
+		
+		/// @brief Create a hopp::uint128 from a native 128-bit integer
+		/// @param[in] i A native 128-bit integer
+		/// @return the hopp::uint128
+		static hopp::uint128 from_native(native_type const i) { return hopp::uint128(hopp::ullint(i >> 64), hopp::ullint(i)); }
+		
+		#endif
+		
+		/// @brief Multiply two 64-bit integers
+		/// @param[in] a A hopp::ullint
+		/// @param[in] b A hopp::ullint
+		/// @return the 128-bit product a * b
+		static hopp::uint128 mul_64_64(hopp::ullint const a, hopp::ullint const b)
+		{
+			#ifdef HOPP_INT_UINT128_NATIVE
+				return hopp::uint128::from_native(native_type(a) * b);
+			#else
+				// Four 32x32 -> 64 products
+				hopp::ullint const a_lo = a & 0xFFFFFFFF;
+				hopp::ullint const a_hi = a >> 32;
+				hopp::ullint const b_lo = b & 0xFFFFFFFF;
+				hopp::ullint const b_hi = b >> 32;
+				
+				hopp::ullint const lo_lo = a_lo * b_lo;
+				hopp::ullint const hi_lo = a_hi * b_lo;
+				hopp::ullint const lo_hi = a_lo * b_hi;
+				hopp::ullint const hi_hi = a_hi * b_hi;
+				
+				hopp::ullint const middle = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+				return hopp::uint128(hi_hi + (hi_lo >> 32) + (middle >> 32), (middle << 32) | (lo_lo & 0xFFFFFFFF));
+			#endif
+		}
+		
+		/// @brief Get a power of 10 that fits in a hopp::ullint
+		/// @param[in] n Exponent (n <= 19)
+		/// @return 10^n
+		static hopp::ullint pow_10(size_t const n)
+		{
+			static constexpr hopp::ullint p[20] =
+			{
+				1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+				10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+				1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+			};
+			return p[n];
+		}
+		
+		/// @brief Divide by 10^19 (decimal conversion in chunks of 19 digits)
+		/// @param[in]  n A hopp::uint128
+		/// @param[out] r n % 10^19
+		/// @return n / 10^19
+		static hopp::uint128 div_10_19(hopp::uint128 const & n, hopp::ullint & r)
+		{
+			// 10^19 has its most significant bit set: Möller & Granlund division with a precomputed reciprocal
+			hopp::ullint const d = 10000000000000000000ull;
+			hopp::ullint const v = 0xD83C94FB6D2AC34Aull; // floor((2^128 - 1) / d) - 2^64
+			hopp::ullint const q_hi = (n.hi >= d) ? 1 : 0;
+			hopp::ullint const u1 = n.hi - q_hi * d;
+			// q = v u1 + (u1, u0)
+			hopp::uint128 q = mul_64_64(v, u1);
+			q.lo += n.lo;
+			q.hi += u1 + ((q.lo < n.lo) ? 1 : 0) + 1;
+			r = n.lo - q.hi * d;
+			if (r > q.lo) { --q.hi; r += d; }
+			if (r >= d) { ++q.hi; r -= d; }
+			return hopp::uint128(q_hi, q.hi);
+		}
+		
+		/// @brief Get the number of leading zero bits
+		/// @return the number of leading zero bits (128 for 0)
+		unsigned int count_leading_zeros() const
+		{
+			if (hi != 0) { return count_leading_zeros_64(hi); }
+			if (lo != 0) { return 64 + count_leading_zeros_64(lo); }
+			return 128;
+		}
 		
-		/// @brief Constructor from string
-		/// @param[in] i A std::string
-		uint128(std::string const & i) : lo(0), hi(0)
+		/// @brief Get the number of leading zero bits of a hopp::ullint
+		/// @param[in] i A hopp::ullint (not 0)
+		/// @return the number of leading zero bits
+		static unsigned int count_leading_zeros_64(hopp::ullint i)
 		{
-			// TODO
+			#if defined(__GNUC__) || defined(__clang__)
+				return static_cast<unsigned int>(__builtin_clzll(i));
+			#else
+				unsigned int n = 0;
+				while ((i & (hopp::ullint(1) << 63)) == 0) { i <<= 1; ++n; }
+				return n;
+			#endif
 		}
 	};
 	
@@ -87,8 +209,7 @@ namespace hopp
 	/// @relates hopp::uint128
 	inline bool operator <(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		if (a.hi < b.hi) { return true; }
-		if (a.hi == b.hi) { return a.lo < b.lo; }
+		return (a.hi < b.hi) || ((a.hi == b.hi) && (a.lo < b.lo));
 	}
 	
 	/// @brief Operator > between two hopp::uint128
@@ -108,20 +229,20 @@ namespace hopp
 	/// @relates hopp::uint128
 	inline bool operator <=(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		return (a == b) || (a < b);
+		return (b < a) == false;
 	}
 	
-	/// @brief Operator > between two hopp::uint128
+	/// @brief Operator >= between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
 	/// @return true if a >= b, false otherwise
 	/// @relates hopp::uint128
 	inline bool operator >=(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		return b >= a;
+		return (a < b) == false;
 	}
 	
-	// &, |, <<, >>
+	// &, |, ^, ~, <<, >>
 	
 	/// @brief Operator & between two hopp::uint128
 	/// @param[in] a A hopp::uint128
@@ -130,10 +251,7 @@ namespace hopp
 	/// @relates hopp::uint128
 	inline hopp::uint128 operator &(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		hopp::uint128 r = a;
-		r.lo &= b.lo;
-		r.hi &= b.hi;
-		return r;
+		return hopp::uint128(a.hi & b.hi, a.lo & b.lo);
 	}
 	
 	/// @brief Operator &= between two hopp::uint128
@@ -154,10 +272,7 @@ namespace hopp
 	/// @relates hopp::uint128
 	inline hopp::uint128 operator |(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		hopp::uint128 r = a;
-		r.lo |= b.lo;
-		r.hi |= b.hi;
-		return r;
+		return hopp::uint128(a.hi | b.hi, a.lo | b.lo);
 	}
 	
 	/// @brief Operator |= between two hopp::uint128
@@ -171,81 +286,81 @@ namespace hopp
 		return a;
 	}
 	
-	/// @brief Operator << between two hopp::uint128
+	/// @brief Operator ^ between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
-	/// @return a << b
+	/// @return a ^ b
 	/// @relates hopp::uint128
-	inline hopp::uint128 operator <<(hopp::uint128 const & a, hopp::uint128 const & b)
+	inline hopp::uint128 operator ^(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		if (b >= 128) { return 0; }
-		
-		hopp::uint128 r = a;
-		
-		if (b >= 64)
-		{
-			r.hi = r.lo;
-			r.lo = 0;
-			r.hi <<= b.lo - 64;
-		}
-		else
-		{
-			hopp::ullint tmp = a.lo & (std::numeric_limits<hopp::ullint>::max() << (64 - b.lo));
-			r.lo <<= b.lo;
-			r.hi <<= b.lo;
-			r.hi += tmp;
-		}
-		
-		return r;
+		return hopp::uint128(a.hi ^ b.hi, a.lo ^ b.lo);
 	}
 	
-	/// @brief Operator << between two hopp::uint128
+	/// @brief Operator ^= between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
-	/// @return a <<= b
+	/// @return a ^= b
 	/// @relates hopp::uint128
-	inline hopp::uint128 & operator <<=(hopp::uint128 & a, hopp::uint128 const & b)
+	inline hopp::uint128 & operator ^=(hopp::uint128 & a, hopp::uint128 const & b)
 	{
-		a = a << b;
+		a = a ^ b;
 		return a;
 	}
 	
-	/// @brief Operator >> between two hopp::uint128
+	/// @brief Operator ~ with a hopp::uint128
 	/// @param[in] a A hopp::uint128
-	/// @param[in] b A hopp::uint128
-	/// @return a << b
+	/// @return ~a
 	/// @relates hopp::uint128
-	inline hopp::uint128 operator >>(hopp::uint128 const & a, hopp::uint128 const & b)
+	inline hopp::uint128 operator ~(hopp::uint128 const & a)
 	{
-		if (b >= 128) { return 0; }
-		
-		hopp::uint128 r = a;
-		
-		if (b >= 64)
-		{
-			r.lo = r.hi;
-			r.hi = 0;
-			r.lo >>= b.lo - 64;
-		}
-		else
-		{
-			hopp::ullint tmp = a.lo & (std::numeric_limits<hopp::ullint>::max() >> b.lo);
-			r.lo >>= b.lo;
-			r.hi >>= b.lo;
-			r.lo += tmp;
-		}
-		
-		return r;
+		return hopp::uint128(~a.hi, ~a.lo);
 	}
 	
-	/// @brief Operator >> between two hopp::uint128
+	/// @brief Operator << between a hopp::uint128 and a number of bits
 	/// @param[in] a A hopp::uint128
-	/// @param[in] b A hopp::uint128
-	/// @return a >>= b
+	/// @param[in] n Number of bits
+	/// @return a << n (0 if n >= 128)
+	/// @relates hopp::uint128
+	inline hopp::uint128 operator <<(hopp::uint128 const & a, unsigned int const n)
+	{
+		if (n >= 128) { return 0; }
+		if (n >= 64) { return hopp::uint128(a.lo << (n - 64), 0); }
+		if (n == 0) { return a; }
+		return hopp::uint128((a.hi << n) | (a.lo >> (64 - n)), a.lo << n);
+	}
+	
+	/// @brief Operator <<= between a hopp::uint128 and a number of bits
+	/// @param[in] a A hopp::uint128
+	/// @param[in] n Number of bits
+	/// @return a <<= n
+	/// @relates hopp::uint128
+	inline hopp::uint128 & operator <<=(hopp::uint128 & a, unsigned int const n)
+	{
+		a = a << n;
+		return a;
+	}
+	
+	/// @brief Operator >> between a hopp::uint128 and a number of bits
+	/// @param[in] a A hopp::uint128
+	/// @param[in] n Number of bits
+	/// @return a >> n (0 if n >= 128)
 	/// @relates hopp::uint128
-	inline hopp::uint128 & operator >>=(hopp::uint128 & a, hopp::uint128 const & b)
+	inline hopp::uint128 operator >>(hopp::uint128 const & a, unsigned int const n)
 	{
-		a = a >> b;
+		if (n >= 128) { return 0; }
+		if (n >= 64) { return hopp::uint128(0, a.hi >> (n - 64)); }
+		if (n == 0) { return a; }
+		return hopp::uint128(a.hi >> n, (a.lo >> n) | (a.hi << (64 - n)));
+	}
+	
+	/// @brief Operator >>= between a hopp::uint128 and a number of bits
+	/// @param[in] a A hopp::uint128
+	/// @param[in] n Number of bits
+	/// @return a >>= n
+	/// @relates hopp::uint128
+	inline hopp::uint128 & operator >>=(hopp::uint128 & a, unsigned int const n)
+	{
+		a = a >> n;
 		return a;
 	}
 	
@@ -254,14 +369,16 @@ namespace hopp
 	/// @brief Operator + between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
-	/// @return a + b
+	/// @return a + b (modulo 2^128)
 	/// @relates hopp::uint128
 	inline hopp::uint128 operator +(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		hopp::uint128 r = a;
-		r.lo += b.lo;
-		r.hi += b.hi + ((r.lo < a.lo) || (r.lo < b.lo)) ? 1 : 0;
-		return r;
+		#ifdef HOPP_INT_UINT128_NATIVE
+			return hopp::uint128::from_native(a.native() + b.native());
+		#else
+			hopp::ullint const lo = a.lo + b.lo;
+			return hopp::uint128(a.hi + b.hi + ((lo < a.lo) ? 1 : 0), lo);
+		#endif
 	}
 	
 	/// @brief Operator += between two hopp::uint128
@@ -277,7 +394,7 @@ namespace hopp
 	
 	/// @brief Operator ++ (prefix) with a hopp::uint128
 	/// @param[in] i A hopp::uint128
-	/// @return i++
+	/// @return ++i
 	/// @relates hopp::uint128
 	inline hopp::uint128 & operator ++(hopp::uint128 & i)
 	{
@@ -302,21 +419,15 @@ namespace hopp
 	/// @brief Operator - between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
-	/// @return a - b
+	/// @return a - b (modulo 2^128)
 	/// @relates hopp::uint128
 	inline hopp::uint128 operator -(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		hopp::uint128 r;
-		if (a >= b)
-		{
-			r.lo = a.lo - b.lo;
-			r.hi = a.hi - b.hi;
-		}
-		else
-		{
-			r = std::numeric_limits<hopp::uint128>::max() - (b - a) - 1;
-		}
-		return r;
+		#ifdef HOPP_INT_UINT128_NATIVE
+			return hopp::uint128::from_native(a.native() - b.native());
+		#else
+			return hopp::uint128(a.hi - b.hi - ((a.lo < b.lo) ? 1 : 0), a.lo - b.lo);
+		#endif
 	}
 	
 	/// @brief Operator -= between two hopp::uint128
@@ -332,16 +443,12 @@ namespace hopp
 	
 	/// @brief Operator -- (prefix) with a hopp::uint128
 	/// @param[in] i A hopp::uint128
-	/// @return i--
+	/// @return --i
 	/// @relates hopp::uint128
 	inline hopp::uint128 & operator --(hopp::uint128 & i)
 	{
-		if (i.lo != 0) { --i.lo; }
-		else if (i.lo == 0)
-		{
-			if (i.hi == 0) { i = std::numeric_limits<hopp::uint128>::max(); }
-			else { --i.hi; i.lo = std::numeric_limits<hopp::ullint>::max(); }
-		}
+		if (i.lo == 0) { --i.hi; }
+		--i.lo;
 		return i;
 	}
 	
@@ -361,21 +468,18 @@ namespace hopp
 	/// @brief Operator * between two hopp::uint128
 	/// @param[in] a A hopp::uint128
 	/// @param[in] b A hopp::uint128
-	/// @return a * b
+	/// @return a * b (modulo 2^128)
 	/// @relates hopp::uint128
 	inline hopp::uint128 operator *(hopp::uint128 const & a, hopp::uint128 const & b)
 	{
-		if ((a == 0) || (b == 0)) { return 0; }
-		if (a == 1) { return b; }
-		if (b == 1) { return a; }
-		if (a == 2) { return b + b; }
-		if (b == 2) { return a + a; }
-		
-		// TODO: Use logical shift
-		hopp::uint128 r;
-		//for ()
-		
-		return r;
+		#ifdef HOPP_INT_UINT128_NATIVE
+			return hopp::uint128::from_native(a.native() * b.native());
+		#else
+			// The products a.hi * b.hi and the high parts of a.hi * b.lo and a.lo * b.hi are above 2^128
+			hopp::uint128 r = hopp::uint128::mul_64_64(a.lo, b.lo);
+			r.hi += a.hi * b.lo + a.lo * b.hi;
+			return r;
+		#endif
 	}
 	
 	/// @brief Operator *= between two hopp::uint128
@@ -389,7 +493,42 @@ namespace hopp
 		return a;
 	}
 	
-	// /
+	// /, %
+	
+	/// @brief Divide two hopp::uint128
+	/// @param[in] a Numerator
+	/// @param[in] b Denominator
+	/// @pre b != 0
+	/// @return quotient and remainder in hopp::q_r<hopp::uint128>
+	/// @relates hopp::uint128
+	inline hopp::q_r<hopp::uint128> div_q_r(hopp::uint128 const & a, hopp::uint128 const & b)
+	{
+		#ifdef HOPP_INT_UINT128_NATIVE
+			if (b == 0) { throw std::domain_error("hopp::div_q_r: divide by zero"); }
+			return { hopp::uint128::from_native(a.native() / b.native()), hopp::uint128::from_native(a.native() % b.native()) };
+		#else
+			if (b == 0) { throw std::domain_error("hopp::div_q_r: divide by zero"); }
+			if (a < b) { return { hopp::uint128(0), a }; }
+			if (a.hi == 0) { return { hopp::uint128(a.lo / b.lo), hopp::uint128(a.lo % b.lo) }; }
+			
+			// Knuth algorithm D on 32-bit words
+			std::uint32_t const u[4] = { std::uint32_t(a.lo), std::uint32_t(a.lo >> 32), std::uint32_t(a.hi), std::uint32_t(a.hi >> 32) };
+			std::uint32_t const v[4] = { std::uint32_t(b.lo), std::uint32_t(b.lo >> 32), std::uint32_t(b.hi), std::uint32_t(b.hi >> 32) };
+			size_t m = 4;
+			while (u[m - 1] == 0) { --m; }
+			size_t n = 4;
+			while (v[n - 1] == 0) { --n; }
+			std::uint32_t q[4] = { 0, 0, 0, 0 };
+			std::uint32_t r[4] = { 0, 0, 0, 0 };
+			std::uint32_t scratch[9];
+			hopp::div_q_r_words(u, m, v, n, q, r, scratch);
+			return
+			{
+				hopp::uint128((hopp::ullint(q[3]) << 32) | q[2], (hopp::ullint(q[1]) << 32) | q[0]),
+				hopp::uint128((hopp::ullint(r[3]) << 32) | r[2], (hopp::ullint(r[1]) << 32) | r[0])
+			};
+		#endif
+	}
 	
 	/// @brief Operator / between two hopp::uint128
 	/// @param[in] a A hopp::uint128
@@ -412,22 +551,243 @@ namespace hopp
 		return a;
 	}
 	
-	// <<
+	/// @brief Operator % between two hopp::uint128
+	/// @param[in] a A hopp::uint128
+	/// @param[in] b A hopp::uint128
+	/// @return a % b
+	/// @relates hopp::uint128
+	inline hopp::uint128 operator %(hopp::uint128 const & a, hopp::uint128 const & b)
+	{
+		return hopp::div_q_r(a, b).r;
+	}
+	
+	/// @brief Operator %= between two hopp::uint128
+	/// @param[in] a A hopp::uint128
+	/// @param[in] b A hopp::uint128
+	/// @return a %= b
+	/// @relates hopp::uint128
+	inline hopp::uint128 & operator %=(hopp::uint128 & a, hopp::uint128 const & b)
+	{
+		a = a % b;
+		return a;
+	}
+	
+	// to_chars, from_chars, to_string, <<
+	
+	/// @brief Write a hopp::uint128 in a buffer (without std::ostream nor memory allocation)
+	/// @param[in] first Beginning of the buffer
+	/// @param[in] last  End of the buffer (39 characters are enough in base 10, 32 in base 16)
+	/// @param[in] i     A hopp::uint128
+	/// @param[in] base  Base (10 or 16, the hexadecimal is in lowercase without prefix)
+	/// @return the end of the written characters, nullptr if the buffer is too small
+	/// @exception std::invalid_argument if the base is not 10 or 16
+	/// @relates hopp::uint128
+	inline char * to_chars(char * const first, char * const last, hopp::uint128 const & i, unsigned int const base = 10)
+	{
+		if (base == 16)
+		{
+			size_t const nb_digit = (i == 0) ? 1 : (128 - i.count_leading_zeros() + 3) / 4;
+			if (last - first < std::ptrdiff_t(nb_digit)) { return nullptr; }
+			char * end = first + nb_digit;
+			hopp::ullint x = i.lo;
+			for (size_t d = 0; d < nb_digit; ++d)
+			{
+				if (d == 16) { x = i.hi; }
+				*--end = "0123456789abcdef"[x & 0xF];
+				x >>= 4;
+			}
+			return first + nb_digit;
+		}
+		if (base != 10) { throw std::invalid_argument("hopp::to_chars: the base must be 10 or 16"); }
+		
+		// i = (c2 10^19 + c1) 10^19 + c0
+		hopp::ullint chunks[3] = { i.lo, 0, 0 };
+		size_t nb_chunk = 1;
+		if (i.hi != 0)
+		{
+			hopp::uint128 const q = hopp::uint128::div_10_19(i, chunks[0]);
+			chunks[2] = hopp::uint128::div_10_19(q, chunks[1]).lo;
+			nb_chunk = (chunks[2] != 0) ? 3 : 2;
+		}
+		else if (i.lo >= hopp::uint128::pow_10(19))
+		{
+			chunks[0] = i.lo - hopp::uint128::pow_10(19);
+			chunks[1] = 1;
+			nb_chunk = 2;
+		}
+		
+		// Number of digits of the most significant chunk: log10(x) ~= log2(x) * 1233 / 4096
+		hopp::ullint const top = chunks[nb_chunk - 1];
+		size_t nb_top_digit = (top == 0) ? 1 : (size_t(64 - hopp::uint128::count_leading_zeros_64(top)) * 1233 >> 12) + 1;
+		if (nb_top_digit > 1 && top < hopp::uint128::pow_10(nb_top_digit - 1)) { --nb_top_digit; }
+		size_t const nb_digit = nb_top_digit + 19 * (nb_chunk - 1);
+		if (last - first < std::ptrdiff_t(nb_digit)) { return nullptr; }
+		
+		// Two digits at a time, from the end
+		static char const digits_2[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+		char * end = first + nb_digit;
+		for (size_t c = 0; c < nb_chunk; ++c)
+		{
+			hopp::ullint x = chunks[c];
+			size_t n = (c + 1 == nb_chunk) ? nb_top_digit : 19;
+			for (; n >= 2; n -= 2)
+			{
+				size_t const k = size_t(x % 100) * 2;
+				x /= 100;
+				end -= 2;
+				end[0] = digits_2[k];
+				end[1] = digits_2[k + 1];
+			}
+			if (n == 1) { *--end = char('0' + x); }
+		}
+		return first + nb_digit;
+	}
+	
+	/// @brief Read a hopp::uint128 from characters (without std::istream nor memory allocation)
+	/// @param[in]  first Beginning of the characters
+	/// @param[in]  last  End of the characters
+	/// @param[out] value The hopp::uint128 read, unchanged if there is no digit
+	/// @param[in]  base  Base (10 or 16, the hexadecimal without prefix)
+	/// @return the first character that is not a digit or the first digit that would overflow 2^128 - 1 (first if there is no digit)
+	/// @exception std::invalid_argument if the base is not 10 or 16
+	/// @relates hopp::uint128
+	inline char const * from_chars(char const * const first, char const * const last, hopp::uint128 & value, unsigned int const base = 10)
+	{
+		hopp::uint128 r = 0;
+		char const * p = first;
+		
+		if (base == 16)
+		{
+			// Values of the characters (16 if the character is not a hexadecimal digit)
+			struct hex_table
+			{
+				unsigned char value[256];
+				constexpr hex_table() : value()
+				{
+					for (unsigned int c = 0; c < 256; ++c)
+					{
+						value[c] =
+							(c >= '0' && c <= '9') ? static_cast<unsigned char>(c - '0') :
+							(c >= 'a' && c <= 'f') ? static_cast<unsigned char>(c - 'a' + 10) :
+							(c >= 'A' && c <= 'F') ? static_cast<unsigned char>(c - 'A' + 10) :
+							16;
+					}
+				}
+			};
+			static constexpr hex_table table{};
+			
+			for (; p != last; ++p)
+			{
+				hopp::ullint const d = table.value[static_cast<unsigned char>(*p)];
+				if (d == 16 || (r.hi >> 60) != 0) { break; }
+				r.hi = (r.hi << 4) | (r.lo >> 60);
+				r.lo = (r.lo << 4) | d;
+			}
+			if (p != first) { value = r; }
+			return p;
+		}
+		if (base != 10) { throw std::invalid_argument("hopp::from_chars: the base must be 10 or 16"); }
+		
+		// r = r 10^k + chunk, false if the result overflows (r is unchanged)
+		auto const multiply_add = [](hopp::uint128 & r, hopp::ullint const scale, hopp::ullint const chunk) -> bool
+		{
+			hopp::uint128 const hi_scale = hopp::uint128::mul_64_64(r.hi, scale);
+			hopp::uint128 const lo_scale = hopp::uint128::mul_64_64(r.lo, scale);
+			hopp::ullint hi = hi_scale.lo + lo_scale.hi;
+			if (hi_scale.hi != 0 || hi < lo_scale.hi) { return false; }
+			hopp::ullint const lo = lo_scale.lo + chunk;
+			if (lo < chunk && ++hi == 0) { return false; }
+			r.hi = hi;
+			r.lo = lo;
+			return true;
+		};
+		
+		// Chunks of 19 digits
+		while (true)
+		{
+			char const * const chunk_first = p;
+			hopp::ullint chunk = 0;
+			size_t k = 0;
+			#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			// 8 digits at a time (SWAR): 8 characters in a hopp::ullint, 3 multiplications
+			for (; k + 8 <= 19 && last - p >= 8; k += 8, p += 8)
+			{
+				hopp::ullint eight;
+				std::memcpy(&eight, p, 8);
+				if ((((eight & 0xF0F0F0F0F0F0F0F0) | (((eight + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) != 0x3333333333333333)) { break; }
+				eight -= 0x3030303030303030;
+				eight = (eight * 10) + (eight >> 8);
+				eight = (((eight & 0x000000FF000000FF) * (100 + (1000000ull << 32))) + (((eight >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32)))) >> 32;
+				chunk = chunk * 100000000 + eight;
+			}
+			#endif
+			for (; k < 19 && p != last; ++k, ++p)
+			{
+				hopp::ullint const digit = hopp::ullint(static_cast<unsigned char>(*p - '0'));
+				if (digit > 9) { break; }
+				chunk = chunk * 10 + digit;
+			}
+			if (k == 0) { break; }
+			if (multiply_add(r, hopp::uint128::pow_10(k), chunk) == false)
+			{
+				// Overflow: stop at the digit which overflows
+				for (p = chunk_first; multiply_add(r, 10, hopp::ullint(*p - '0')); ++p) { }
+				break;
+			}
+			if (k < 19) { break; }
+		}
+		if (p != first) { value = r; }
+		return p;
+	}
+	
+	// Constructor from a std::string (after hopp::from_chars)
+	inline uint128::uint128(std::string const & i, unsigned int const base) : lo(0), hi(0)
+	{
+		char const * const last = i.data() + i.size();
+		char const * const p = hopp::from_chars(i.data(), last, *this, base);
+		if (i.empty() || p != last)
+		{
+			// Stopped on a digit: overflow
+			char const c = *p;
+			if (p != i.data() && ((c >= '0' && c <= '9') || (base == 16 && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))))
+			{
+				throw std::out_of_range("hopp::uint128: \"" + i + "\" is greater than 2^128 - 1");
+			}
+			throw std::invalid_argument("hopp::uint128: \"" + i + "\" is not a " + ((base == 16) ? "hexadecimal" : "decimal") + " number");
+		}
+	}
+	
+	/// @brief Convert a hopp::uint128 into a std::string
+	/// @param[in] i    A hopp::uint128
+	/// @param[in] base Base (10 or 16)
+	/// @return the std::string
+	/// @relates hopp::uint128
+	inline std::string to_string(hopp::uint128 const & i, unsigned int const base = 10)
+	{
+		char buffer[39];
+		return std::string(buffer, hopp::to_chars(buffer, buffer + 39, i, base));
+	}
 	
 	/// @brief Operator << between a std::ostream and a hopp::uint128
-	/// @param[in,out] o     Output stream
-	/// @param[in]     uint128 A hopp::uint128
-	/// @return the output stream
+	/// @param[in,out] out A std::ostream (in hexadecimal with std::hex)
+	/// @param[in]     i   A hopp::uint128
+	/// @return out
 	/// @relates hopp::uint128
-	inline std::ostream & operator <<(std::ostream & o, hopp::uint128 const uint128)
+	inline std::ostream & operator <<(std::ostream & out, hopp::uint128 const & i)
 	{
-		// TODO
-		o << "TODO{hopp::uint128}";
-		return o;
+		char buffer[39];
+		unsigned int const base = ((out.flags() & std::ios_base::basefield) == std::ios_base::hex) ? 16 : 10;
+		char * const end = hopp::to_chars(buffer, buffer + 39, i, base);
+		if (out.width() == 0) { out.write(buffer, end - buffer); }
+		else { out << std::string(buffer, end); }
+		return out;
 	}
 }
 
-/*namespace std
+namespace std
 {
 	/// @brief Specialization of std::numeric_limits<hopp::uint128>
 	/// @relates hopp::uint128
@@ -438,47 +798,50 @@ namespace hopp
 		
 		// http://en.cppreference.com/w/cpp/types/numeric_limits
 		
-		/// Identifies types for which std::numeric_limits is specialized 
+		/// Identifies types for which std::numeric_limits is specialized
 		static constexpr bool is_specialized = true;
 		
-		/// Identifies signed types 
+		/// Identifies signed types
 		static constexpr bool is_signed = false;
 		
-		/// Identifies integer types 
+		/// Identifies integer types
 		static constexpr bool is_integer = true;
 		
-		/// Identifies exact types 
+		/// Identifies exact types
 		static constexpr bool is_exact = true;
 		
 		/// Identifies floating-point types that can represent the special value "positive infinity"
 		static constexpr bool has_infinity = false;
 		
+		/// Identifies floating-point types that can represent the special value "quiet not-a-number" (NaN)
+		static constexpr bool has_quiet_NaN = false;
+		
 		/// Identifies floating-point types that can represent the special value "signaling not-a-number" (NaN)
 		static constexpr bool has_signaling_NaN = false;
 		
 		/// Identifies the denormalization style used by the floating-point type
-		static constexpr bool has_denorm = std::denorm_absent;
+		static constexpr std::float_denorm_style has_denorm = std::denorm_absent;
 		
 		/// Identifies the floating-point types that detect loss of precision as denormalization loss rather than inexact result
 		static constexpr bool has_denorm_loss = false;
 		
 		/// Identifies the rounding style used by the type
-		static constexpr bool round_style = std::round_toward_zero;
+		static constexpr std::float_round_style round_style = std::round_toward_zero;
 		
 		/// Identifies the IEC 559/IEEE 754 floating-point types
 		static constexpr bool is_iec559 = false;
 		
 		/// Identifies the types that represent a finite set of values
-		static constexpr bool is_bounded = false;
+		static constexpr bool is_bounded = true;
 		
 		/// Identifies the types that handle overflows with modulo arithmetic
 		static constexpr bool is_modulo = true;
 		
 		/// Number of radix digits that can be represented without change
-		static constexpr int digits = 8;
+		static constexpr int digits = 128;
 		
 		/// Number of decimal digits that can be represented without change
-		static constexpr int digits10 = std::numeric_limits<unsigned char>::digits10;
+		static constexpr int digits10 = 38;
 		
 		/// Number of decimal digits necessary to differentiate all values of this type
 		static constexpr int max_digits10 = 0;
@@ -499,7 +862,7 @@ namespace hopp
 		static constexpr int max_exponent10 = 0;
 		
 		/// Identifies types which can cause arithmetic operations to trap
-		static constexpr bool traps = std::numeric_limits<unsigned char>::traps;
+		static constexpr bool traps = std::numeric_limits<hopp::ullint>::traps;
 		
 		/// Identifies floating-point types that detect tinyness before rounding
 		static constexpr bool tinyness_before = false;
@@ -508,40 +871,40 @@ namespace hopp
 		
 		/// @brief Returns the smallest finite value of the given type
 		/// @return the smallest finite value of the given type
-		static hopp::uint128 min() { return 0u; }
+		static constexpr hopp::uint128 min() { return hopp::uint128(0); }
 		
 		/// @brief Returns the lowest finite value of the given type
 		/// @return the lowest finite value of the given type
-		static hopp::uint128 lowest() { return 0u; }
+		static constexpr hopp::uint128 lowest() { return hopp::uint128(0); }
 		
 		/// @brief Returns the largest finite value of the given type
 		/// @return the largest finite value of the given type
-		static hopp::uint128 max() { return 255u; }
+		static constexpr hopp::uint128 max() { return hopp::uint128(std::numeric_limits<hopp::ullint>::max(), std::numeric_limits<hopp::ullint>::max()); }
 		
 		/// @brief Returns the difference between 1.0 and the next representable value of the given floating-point type
 		/// @return the difference between 1.0 and the next representable value of the given floating-point type
-		static hopp::uint128 epsilon() { return 0u; }
+		static constexpr hopp::uint128 epsilon() { return hopp::uint128(0); }
 		
 		/// @brief Returns the maximum rounding error of the given floating-point type
 		/// @return the maximum rounding error of the given floating-point type
-		static hopp::uint128 round_error() { return 0u; }
+		static constexpr hopp::uint128 round_error() { return hopp::uint128(0); }
 		
 		/// @brief Returns the positive infinity value of the given floating-point type
 		/// @return the positive infinity value of the given floating-point type
-		static hopp::uint128 infinity() { return 0u; }
+		static constexpr hopp::uint128 infinity() { return hopp::uint128(0); }
 		
 		/// @brief Returns a quiet NaN value of the given floating-point type
 		/// @return a quiet NaN value of the given floating-point type
-		static hopp::uint128 quiet_NaN() { return 0u; }
+		static constexpr hopp::uint128 quiet_NaN() { return hopp::uint128(0); }
 		
 		/// @brief Returns a signaling NaN value of the given floating-point type
 		/// @return a signaling NaN value of the given floating-point type
-		static hopp::uint128 signaling_NaN() { return 0u; }
+		static constexpr hopp::uint128 signaling_NaN() { return hopp::uint128(0); }
 		
 		/// @brief Returns the smallest positive subnormal value of the given floating-point type
 		/// @return the smallest positive subnormal value of the given floating-point type
-		static hopp::uint128 denorm_min() { return 0u; }
+		static constexpr hopp::uint128 denorm_min() { return hopp::uint128(0); }
 	};
-}*/
+}
 
 #endif
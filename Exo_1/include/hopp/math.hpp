@@ -22,6 +22,7 @@
  */
 
 #include "math/integer_factorization.hpp"
+#include "math/matrix.hpp"
 #include "math/pi.hpp"
 #include "math/primes.hpp"
 
@@ -0,0 +1,341 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_MATH_MATRIX_HPP
+#define HOPP_MATH_MATRIX_HPP
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../algo/parallel.hpp"
+#include "../container/coo_matrix.hpp"
+#include "../container/csr_matrix.hpp"
+#include "../container/vector2D.hpp"
+#include "../container/vector2D_view.hpp"
+
+
+namespace hopp
+{
+	namespace math
+	{
+		/**
+		 * @brief Block sizes (in number of values) used by the cache-blocked matrix kernels
+		 *
+		 * @code
+		   #include <hopp/math/matrix.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_math
+		 */
+		namespace matrix_block
+		{
+			/// Tile size of hopp::math::transpose
+			constexpr size_t transpose = 32;
+			
+			/// Number of rows of A in a block of hopp::math::multiply
+			constexpr size_t row = 64;
+			
+			/// Number of columns of A (rows of B) in a block of hopp::math::multiply
+			constexpr size_t depth = 128;
+			
+			/// Number of columns of B in a block of hopp::math::multiply
+			constexpr size_t col = 256;
+		}
+		
+		/**
+		 * @brief Transpose a matrix with a cache-blocked (tiled) traversal
+		 *
+		 * Tiles are processed in parallel if OpenMP is enabled.
+		 *
+		 * @code
+		   #include <hopp/math/matrix.hpp>
+		   @endcode
+		 *
+		 * @param[in]  a A nb_row × nb_col matrix
+		 * @param[out] r A nb_col × nb_row matrix (must not overlap a)
+		 *
+		 * @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		 *
+		 * @ingroup hopp_math
+		 */
+		template <class T>
+		void transpose(hopp::vector2D_view<std::remove_const_t<T> const> const & a, hopp::vector2D_view<T> r)
+		{
+			#ifndef NDEBUG
+				if (r.nb_row() != a.nb_col() || r.nb_col() != a.nb_row()) { throw std::invalid_argument("hopp::math::transpose(a, r): invalid sizes"); }
+			#endif
+			
+			size_t const block = hopp::math::matrix_block::transpose;
+			size_t const nb_row = a.nb_row();
+			size_t const nb_col = a.nb_col();
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t ii = 0; ii < nb_row; ii += block)
+			{
+				size_t const i_end = std::min(ii + block, nb_row);
+				for (size_t jj = 0; jj < nb_col; jj += block)
+				{
+					size_t const j_end = std::min(jj + block, nb_col);
+					for (size_t i = ii; i < i_end; ++i)
+					{
+						for (size_t j = jj; j < j_end; ++j) { r(j, i) = a(i, j); }
+					}
+				}
+			}
+		}
+		
+		/// @brief Transpose a hopp::vector2D<T> (cache-blocked)
+		/// @param[in] a A hopp::vector2D<T>
+		/// @return the transposed hopp::vector2D<T>
+		/// @ingroup hopp_math
+		template <class T>
+		hopp::vector2D<T> transpose(hopp::vector2D<T> const & a)
+		{
+			hopp::vector2D<T> r(a.nb_col(), a.nb_row());
+			hopp::math::transpose<T>(a.view(), r.view());
+			return r;
+		}
+		
+		/**
+		 * @brief Matrix multiplication c = a × b with cache blocking
+		 *
+		 * The inner loop is a contiguous c[i][j] += a[i][k] * b[k][j] on a row of b (vectorizable). @n
+		 * Blocks of rows of c are computed in parallel if OpenMP is enabled.
+		 *
+		 * @code
+		   #include <hopp/math/matrix.hpp>
+		   @endcode
+		 *
+		 * @param[in]  a A m × k matrix
+		 * @param[in]  b A k × n matrix
+		 * @param[out] c A m × n matrix (must not overlap a or b)
+		 *
+		 * @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		 *
+		 * @ingroup hopp_math
+		 */
+		template <class T>
+		void multiply
+		(
+			hopp::vector2D_view<std::remove_const_t<T> const> const & a,
+			hopp::vector2D_view<std::remove_const_t<T> const> const & b,
+			hopp::vector2D_view<T> c
+		)
+		{
+			#ifndef NDEBUG
+				if (a.nb_col() != b.nb_row() || c.nb_row() != a.nb_row() || c.nb_col() != b.nb_col())
+				{ throw std::invalid_argument("hopp::math::multiply(a, b, c): invalid sizes"); }
+			#endif
+			
+			size_t const m = a.nb_row();
+			size_t const depth = a.nb_col();
+			size_t const n = b.nb_col();
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(dynamic)
+			#endif
+			for (size_t ii = 0; ii < m; ii += hopp::math::matrix_block::row)
+			{
+				size_t const i_end = std::min(ii + hopp::math::matrix_block::row, m);
+				
+				for (size_t i = ii; i < i_end; ++i) { std::fill(c.row(i).begin(), c.row(i).end(), T()); }
+				
+				for (size_t kk = 0; kk < depth; kk += hopp::math::matrix_block::depth)
+				{
+					size_t const k_end = std::min(kk + hopp::math::matrix_block::depth, depth);
+					
+					for (size_t jj = 0; jj < n; jj += hopp::math::matrix_block::col)
+					{
+						size_t const nb_j = std::min(jj + hopp::math::matrix_block::col, n) - jj;
+						
+						for (size_t i = ii; i < i_end; ++i)
+						{
+							T * const c_i = c.data() + i * c.row_pitch() + jj;
+							
+							for (size_t k = kk; k < k_end; ++k)
+							{
+								T const a_ik = a(i, k);
+								T const * const b_k = b.data() + k * b.row_pitch() + jj;
+								
+								#ifdef _OPENMP
+									#pragma omp simd
+								#endif
+								for (size_t j = 0; j < nb_j; ++j) { c_i[j] += a_ik * b_k[j]; }
+							}
+						}
+					}
+				}
+			}
+		}
+		
+		/// @brief Matrix multiplication a × b of two hopp::vector2D<T> (cache-blocked)
+		/// @param[in] a A m × k hopp::vector2D<T>
+		/// @param[in] b A k × n hopp::vector2D<T>
+		/// @return the m × n hopp::vector2D<T> a × b
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_math
+		template <class T>
+		hopp::vector2D<T> multiply(hopp::vector2D<T> const & a, hopp::vector2D<T> const & b)
+		{
+			hopp::vector2D<T> c(a.nb_row(), b.nb_col());
+			hopp::math::multiply<T>(a.view(), b.view(), c.view());
+			return c;
+		}
+		
+		/**
+		 * @brief Matrix-vector multiplication y = a × x
+		 *
+		 * Each y[i] is a contiguous dot product (vectorizable), rows are computed in parallel if OpenMP is enabled.
+		 *
+		 * @code
+		   #include <hopp/math/matrix.hpp>
+		   @endcode
+		 *
+		 * @param[in]  a A m × n matrix
+		 * @param[in]  x A vector of n values
+		 * @param[out] y A vector of m values (must not overlap a or x)
+		 *
+		 * @ingroup hopp_math
+		 */
+		template <class T>
+		void multiply(hopp::vector2D_view<std::remove_const_t<T> const> const & a, std::remove_const_t<T> const * const x, T * const y)
+		{
+			size_t const m = a.nb_row();
+			size_t const n = a.nb_col();
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static)
+			#endif
+			for (size_t i = 0; i < m; ++i)
+			{
+				T const * const a_i = a.data() + i * a.row_pitch();
+				T sum = T();
+				
+				#ifdef _OPENMP
+					#pragma omp simd reduction(+:sum)
+				#endif
+				for (size_t j = 0; j < n; ++j) { sum += a_i[j] * x[j]; }
+				
+				y[i] = sum;
+			}
+		}
+		
+		/// @brief Matrix-vector multiplication a × x
+		/// @param[in] a A m × n hopp::vector2D<T>
+		/// @param[in] x A std::vector<T> of n values
+		/// @return the std::vector<T> of m values a × x
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_math
+		template <class T>
+		std::vector<T> multiply(hopp::vector2D<T> const & a, std::vector<T> const & x)
+		{
+			#ifndef NDEBUG
+				if (x.size() != a.nb_col()) { throw std::invalid_argument("hopp::math::multiply(a, x): invalid sizes"); }
+			#endif
+			
+			std::vector<T> y(a.nb_row());
+			hopp::math::multiply<T>(a.view(), x.data(), y.data());
+			return y;
+		}
+		
+		/**
+		 * @brief Sparse matrix-vector multiplication y = a × x
+		 *
+		 * The rows are split in one chunk per thread with the same number of stored values if OpenMP is enabled.
+		 *
+		 * @code
+		   #include <hopp/math/matrix.hpp>
+		   @endcode
+		 *
+		 * @param[in]  a A m × n hopp::csr_matrix<T, index_t>
+		 * @param[in]  x A vector of n values
+		 * @param[out] y A vector of m values (must not overlap x)
+		 *
+		 * @ingroup hopp_math
+		 */
+		template <class T, class index_t>
+		void multiply(hopp::csr_matrix<T, index_t> const & a, T const * const x, T * const y)
+		{
+			size_t const * const offsets = a.row_offsets().data();
+			index_t const * const cols = a.cols().data();
+			T const * const values = a.values().data();
+			
+			size_t const nb_row = a.nb_row();
+			size_t const nb_chunk = hopp::parallel::nb_chunk(a.nb_nonzero() + nb_row);
+			
+			#ifdef _OPENMP
+				#pragma omp parallel for schedule(static) if (nb_chunk > 1)
+			#endif
+			for (size_t c = 0; c < nb_chunk; ++c)
+			{
+				// Rows of the chunk: about a.nb_nonzero() / nb_chunk stored values
+				size_t const i_begin = (c == 0) ? 0 : size_t(std::lower_bound(offsets, offsets + nb_row, a.nb_nonzero() * c / nb_chunk) - offsets);
+				size_t const i_end = (c + 1 == nb_chunk) ? nb_row : size_t(std::lower_bound(offsets, offsets + nb_row, a.nb_nonzero() * (c + 1) / nb_chunk) - offsets);
+				
+				for (size_t i = i_begin; i < i_end; ++i)
+				{
+					T sum = T();
+					#ifdef _OPENMP
+						#pragma omp simd reduction(+:sum)
+					#endif
+					for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) { sum += values[k] * x[cols[k]]; }
+					y[i] = sum;
+				}
+			}
+		}
+		
+		/// @brief Sparse matrix-vector multiplication a × x (parallel if OpenMP is enabled)
+		/// @param[in] a A m × n hopp::csr_matrix<T, index_t>
+		/// @param[in] x A std::vector<T> of n values
+		/// @return the std::vector<T> of m values a × x
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_math
+		template <class T, class index_t>
+		std::vector<T> multiply(hopp::csr_matrix<T, index_t> const & a, std::vector<T> const & x)
+		{
+			#ifndef NDEBUG
+				if (x.size() != a.nb_col()) { throw std::invalid_argument("hopp::math::multiply(a, x): invalid sizes"); }
+			#endif
+			
+			std::vector<T> y(a.nb_row());
+			hopp::math::multiply(a, x.data(), y.data());
+			return y;
+		}
+		
+		/// @brief Sparse matrix-vector multiplication a × x (sequential, prefer hopp::csr_matrix<T, index_t>)
+		/// @param[in] a A m × n hopp::coo_matrix<T, index_t>
+		/// @param[in] x A std::vector<T> of n values
+		/// @return the std::vector<T> of m values a × x
+		/// @exception std::invalid_argument if NDEBUG is not defined and if the sizes do not match
+		/// @ingroup hopp_math
+		template <class T, class index_t>
+		std::vector<T> multiply(hopp::coo_matrix<T, index_t> const & a, std::vector<T> const & x)
+		{
+			#ifndef NDEBUG
+				if (x.size() != a.nb_col()) { throw std::invalid_argument("hopp::math::multiply(a, x): invalid sizes"); }
+			#endif
+			
+			std::vector<T> y(a.nb_row());
+			for (size_t k = 0; k < a.nb_nonzero(); ++k) { y[a.rows()[k]] += a.values()[k] * x[a.cols()[k]]; }
+			return y;
+		}
+	}
+}
+
+#endif
@@ -26,6 +26,7 @@
    @endcode
  */
 
+#include "memory/pool.hpp"
 #include "memory/view_ptr.hpp"
 
 #endif
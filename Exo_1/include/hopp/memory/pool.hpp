@@ -0,0 +1,445 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_MEMORY_POOL_HPP
+#define HOPP_MEMORY_POOL_HPP
+
+#include <iostream>
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <utility>
+
+
+namespace hopp
+{
+	/**
+	 * @brief Statistics of a hopp::size_class_pool
+	 *
+	 * @code
+	   #include <hopp/memory/pool.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_memory
+	 */
+	class pool_statistics
+	{
+	public:
+		
+		/// Size of a block (in bytes)
+		size_t block_size;
+		
+		/// Number of blocks currently allocated
+		size_t live;
+		
+		/// Maximum number of blocks allocated at the same time
+		size_t peak;
+		
+		/// Number of chunks allocated from the system
+		size_t nb_chunk;
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::pool_statistics
+	/// @param[in,out] out        A std::ostream
+	/// @param[in]     statistics A hopp::pool_statistics
+	/// @return out
+	/// @relates hopp::pool_statistics
+	inline std::ostream & operator <<(std::ostream & out, hopp::pool_statistics const & statistics)
+	{
+		out << "{ block_size = " << statistics.block_size
+		    << ", live = " << statistics.live
+		    << ", peak = " << statistics.peak
+		    << ", nb_chunk = " << statistics.nb_chunk << " }";
+		return out;
+	}
+	
+	/**
+	 * @brief Pool of blocks of block_size bytes
+	 *
+	 * Each thread has its own free lists (no lock to allocate or deallocate). @n
+	 * When a thread has more than 2 * nb_block_per_chunk deallocated blocks (or when it exits), they go to a lock-free return list shared by all threads (a block deallocated by a thread_local object destroyed after the free lists of its thread goes there directly); a thread takes the whole return list when its lists are empty, before allocating a new chunk. @n
+	 * Chunks are shared by all threads and are never released (the memory is reused by the pool). @n
+	 * A block can be deallocated by another thread than the one which allocated it.
+	 *
+	 * @code
+	   #include <hopp/memory/pool.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_memory
+	 */
+	template <size_t block_size>
+	class size_class_pool
+	{
+		static_assert(block_size >= sizeof(void *), "hopp::size_class_pool: block_size must be greater or equal to sizeof(void *)");
+		static_assert(block_size % alignof(std::max_align_t) == 0, "hopp::size_class_pool: block_size must be a multiple of alignof(std::max_align_t)");
+		
+	private:
+		
+		/// Free block
+		class node_t
+		{
+		public:
+			
+			/// Next free block
+			node_t * next;
+		};
+		
+		/// Chunks and statistics (shared by all threads)
+		class shared_t
+		{
+		public:
+			
+			/// Mutex for chunks
+			std::mutex mutex;
+			
+			/// Chunks
+			std::vector<std::unique_ptr<char[]>> chunks;
+			
+			/// Number of blocks currently allocated
+			std::atomic<size_t> live;
+			
+			/// Maximum number of blocks allocated at the same time
+			std::atomic<size_t> peak;
+			
+			/// Blocks returned by the threads (lock-free stack, pushed with compare_exchange and taken entirely with exchange, so there is no ABA problem)
+			std::atomic<node_t *> returned;
+			
+			/// @brief Default constructor
+			shared_t() : mutex(), chunks(), live(0), peak(0), returned(nullptr) { }
+		};
+		
+		/// Free lists of a thread
+		class thread_lists_t
+		{
+		public:
+			
+			/// Blocks deallocated by the thread (first block)
+			node_t * first;
+			
+			/// Blocks deallocated by the thread (last block)
+			node_t * last;
+			
+			/// Number of blocks deallocated by the thread
+			size_t size;
+			
+			/// Blocks of a new chunk or of the return list
+			node_t * refilled;
+			
+			/// @brief Default constructor
+			thread_lists_t() : first(nullptr), last(nullptr), size(0), refilled(nullptr) { }
+			
+			/// @brief Non-copyable
+			thread_lists_t(thread_lists_t const &) = delete;
+			
+			/// @brief Non-copyable
+			thread_lists_t & operator =(thread_lists_t const &) = delete;
+			
+			/// @brief Destructor (the free blocks go to the return list when the thread exits)
+			~thread_lists_t()
+			{
+				thread_free_lists_destroyed() = true;
+				if (first != nullptr) { give_back(first, last); }
+				if (refilled != nullptr)
+				{
+					node_t * refilled_last = refilled;
+					while (refilled_last->next != nullptr) { refilled_last = refilled_last->next; }
+					give_back(refilled, refilled_last);
+				}
+				first = nullptr;
+				last = nullptr;
+				size = 0;
+				refilled = nullptr;
+			}
+		};
+		
+	public:
+		
+		/// Number of blocks in a chunk
+		static constexpr size_t nb_block_per_chunk = (64 * 1024) / block_size < 64 ? 64 : (64 * 1024) / block_size;
+		
+	public:
+		
+		/// @brief Allocate a block
+		/// @return a block of block_size bytes aligned on alignof(std::max_align_t)
+		/// @exception std::bad_alloc if the chunk allocation fails
+		static void * allocate()
+		{
+			node_t * block;
+			if (thread_free_lists_destroyed())
+			{
+				// The thread is exiting: take a block of the return list and give back the others
+				block = refill();
+				if (block->next != nullptr)
+				{
+					node_t * others_last = block->next;
+					while (others_last->next != nullptr) { others_last = others_last->next; }
+					give_back(block->next, others_last);
+				}
+				count_allocation();
+				return block;
+			}
+			
+			thread_lists_t & lists = thread_free_lists();
+			
+			if (lists.first != nullptr)
+			{
+				// Recently deallocated block
+				block = lists.first;
+				lists.first = block->next;
+				--lists.size;
+				if (lists.first == nullptr) { lists.last = nullptr; }
+			}
+			else
+			{
+				if (lists.refilled == nullptr) { lists.refilled = refill(); }
+				block = lists.refilled;
+				lists.refilled = block->next;
+			}
+			
+			count_allocation();
+			return block;
+		}
+		
+		/// @brief Deallocate a block
+		/// @param[in] p A block allocated by allocate() (can be nullptr)
+		static void deallocate(void * const p)
+		{
+			if (p == nullptr) { return; }
+			
+			node_t * const block = static_cast<node_t *>(p);
+			
+			// The thread is exiting (destructor of a thread_local object): the block goes to the return list
+			if (thread_free_lists_destroyed())
+			{
+				give_back(block, block);
+				shared().live.fetch_sub(1, std::memory_order_relaxed);
+				return;
+			}
+			
+			thread_lists_t & lists = thread_free_lists();
+			
+			block->next = lists.first;
+			if (lists.first == nullptr) { lists.last = block; }
+			lists.first = block;
+			++lists.size;
+			
+			// Too many deallocated blocks (blocks allocated by other threads): give them back
+			if (lists.size > 2 * nb_block_per_chunk)
+			{
+				give_back(lists.first, lists.last);
+				lists.first = nullptr;
+				lists.last = nullptr;
+				lists.size = 0;
+			}
+			
+			shared().live.fetch_sub(1, std::memory_order_relaxed);
+		}
+		
+		/// @brief Get statistics
+		/// @return statistics
+		static hopp::pool_statistics statistics()
+		{
+			shared_t & s = shared();
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return hopp::pool_statistics
+			{
+				block_size,
+				s.live.load(std::memory_order_relaxed),
+				s.peak.load(std::memory_order_relaxed),
+				s.chunks.size()
+			};
+		}
+		
+	private:
+		
+		/// @brief Get free lists of the current thread
+		/// @return free lists of the current thread
+		static thread_lists_t & thread_free_lists()
+		{
+			static thread_local thread_lists_t lists;
+			return lists;
+		}
+		
+		/// @brief Are the free lists of the current thread destroyed? (a bool is not destroyed, it can be read by the destructors of the thread_local objects destroyed after the free lists)
+		/// @return a reference on the flag of the current thread
+		static bool & thread_free_lists_destroyed()
+		{
+			static thread_local bool destroyed = false;
+			return destroyed;
+		}
+		
+		/// @brief Update the statistics after an allocation
+		static void count_allocation()
+		{
+			shared_t & s = shared();
+			size_t const live = s.live.fetch_add(1, std::memory_order_relaxed) + 1;
+			size_t peak = s.peak.load(std::memory_order_relaxed);
+			while (live > peak && s.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed) == false) { }
+		}
+		
+		/// @brief Push a list of blocks on the return list
+		/// @param[in] first First block of the list
+		/// @param[in] last  Last block of the list
+		static void give_back(node_t * const first, node_t * const last)
+		{
+			std::atomic<node_t *> & returned = shared().returned;
+			node_t * head = returned.load(std::memory_order_relaxed);
+			do { last->next = head; }
+			while (returned.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed) == false);
+		}
+		
+		/// @brief Take the return list or allocate a new chunk
+		/// @return a list of free blocks (not empty)
+		/// @exception std::bad_alloc if the chunk allocation fails
+		static node_t * refill()
+		{
+			node_t * const returned = shared().returned.exchange(nullptr, std::memory_order_acquire);
+			return (returned != nullptr) ? returned : new_chunk();
+		}
+		
+		/// @brief Get chunks and statistics
+		/// @return chunks and statistics
+		static shared_t & shared()
+		{
+			// Never destroyed: blocks can be deallocated during the destruction of static objects
+			static shared_t * const s = new shared_t();
+			return *s;
+		}
+		
+		/// @brief Allocate a new chunk
+		/// @return the list of the blocks of the new chunk
+		static node_t * new_chunk()
+		{
+			std::unique_ptr<char[]> chunk(new char[nb_block_per_chunk * block_size]);
+			char * const data = chunk.get();
+			
+			{
+				shared_t & s = shared();
+				std::lock_guard<std::mutex> lock(s.mutex);
+				s.chunks.push_back(std::move(chunk));
+			}
+			
+			for (size_t i = 0; i + 1 < nb_block_per_chunk; ++i)
+			{
+				reinterpret_cast<node_t *>(data + i * block_size)->next = reinterpret_cast<node_t *>(data + (i + 1) * block_size);
+			}
+			reinterpret_cast<node_t *>(data + (nb_block_per_chunk - 1) * block_size)->next = nullptr;
+			
+			return reinterpret_cast<node_t *>(data);
+		}
+	};
+	
+	template <size_t block_size>
+	constexpr size_t size_class_pool<block_size>::nb_block_per_chunk;
+	
+	/// @brief Size class (in bytes) used to allocate a T
+	/// @return the size of T rounded up to a multiple of alignof(std::max_align_t)
+	/// @relates hopp::size_class_pool
+	template <class T>
+	constexpr size_t pool_size_class()
+	{
+		return ((sizeof(T) < sizeof(void *) ? sizeof(void *) : sizeof(T)) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+	}
+	
+	/**
+	 * @brief Pool for T (all T with the same size class share the same hopp::size_class_pool)
+	 *
+	 * @code
+	   #include <hopp/memory/pool.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_memory
+	 */
+	template <class T>
+	class pool
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "hopp::pool<T>: over-aligned T is not supported");
+		
+	public:
+		
+		/// Size class pool
+		using size_class_pool_t = hopp::size_class_pool<hopp::pool_size_class<T>()>;
+		
+	public:
+		
+		/// @brief Allocate memory for one T (the T is not constructed)
+		/// @return memory for one T
+		/// @exception std::bad_alloc if the chunk allocation fails
+		static T * allocate() { return static_cast<T *>(size_class_pool_t::allocate()); }
+		
+		/// @brief Deallocate memory of one T (the T is not destroyed)
+		/// @param[in] p Memory allocated by allocate() (can be nullptr)
+		static void deallocate(T * const p) { size_class_pool_t::deallocate(p); }
+		
+		/// @brief Get statistics (of the size class of T)
+		/// @return statistics
+		static hopp::pool_statistics statistics() { return size_class_pool_t::statistics(); }
+	};
+	
+	/**
+	 * @brief Deleter for std::unique_ptr<T> to destroy a T allocated with hopp::make_pooled
+	 *
+	 * @code
+	   #include <hopp/memory/pool.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_memory
+	 */
+	template <class T>
+	class pool_deleter
+	{
+	public:
+		
+		/// @brief Destroy the T and deallocate its memory
+		/// @param[in] p A T allocated with hopp::make_pooled
+		void operator ()(T * const p) const
+		{
+			if (p == nullptr) { return; }
+			p->~T();
+			hopp::pool<T>::deallocate(p);
+		}
+	};
+	
+	/// @brief std::unique_ptr<T> with a hopp::pool_deleter<T>
+	/// @note The T is destroyed as a T, there is no conversion to pooled_ptr<base_of_T>
+	/// @ingroup hopp_memory
+	template <class T>
+	using pooled_ptr = std::unique_ptr<T, hopp::pool_deleter<T>>;
+	
+	/// @brief Like std::make_unique<T> but allocate the T from hopp::pool<T>
+	/// @param[in] args Arguments for the T constructor
+	/// @return a hopp::pooled_ptr<T>
+	/// @ingroup hopp_memory
+	template <class T, class ... args_t>
+	hopp::pooled_ptr<T> make_pooled(args_t && ... args)
+	{
+		T * const p = hopp::pool<T>::allocate();
+		try
+		{
+			new (p) T(std::forward<args_t>(args)...);
+		}
+		catch (...)
+		{
+			hopp::pool<T>::deallocate(p);
+			throw;
+		}
+		return hopp::pooled_ptr<T>(p);
+	}
+}
+
+#endif
@@ -27,5 +27,8 @@
  */
 
 #include "parser/ini.hpp"
+#include "parser/ini_view.hpp"
+#include "parser/ini_config.hpp"
+#include "parser/ini_schema.hpp"
 
 #endif
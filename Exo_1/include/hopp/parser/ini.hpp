@@ -36,6 +36,8 @@ namespace hopp
 		/// @brief Parse INI file https://en.wikipedia.org/wiki/INI_file
 		/// @param[in] filename INI filename
 		/// @return a hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>>
+		/// @see hopp::parser::ini_view for large files (zero-copy parser)
+		/// @see hopp::parser::ini_typed for values converted once with a schema
 		/// @ingroup hopp_parser
 		inline hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>> ini(std::string const & filename)
 		{
@@ -0,0 +1,627 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_PARSER_INI_CONFIG_HPP
+#define HOPP_PARSER_INI_CONFIG_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#if defined(hopp_unix) || defined(__unix__) || defined(__APPLE__)
+	#include <sys/stat.h>
+	#include <sys/types.h>
+	#define HOPP_PARSER_INI_CONFIG_STAT
+#endif
+
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <fcntl.h>
+	#define HOPP_PARSER_INI_CONFIG_INOTIFY
+#endif
+
+#include "ini_view.hpp"
+#include "../compiler/unused.hpp"
+
+
+namespace hopp
+{
+	namespace parser
+	{
+		/**
+		 * @brief Hot-reloadable INI configuration
+		 *
+		 * The file is read in memory (not mapped, so a modification of the file does not change the published snapshots) and parsed with hopp::parser::ini_view. reload() (or the watcher thread started by watch()) parses the file again only if it changed (size, modification time, inode, then content), computes the changes and publishes the new snapshot with an atomic pointer exchange.
+		 *
+		 * Readers do not take the reload mutex and do not copy: read() returns a hopp::parser::ini_config::reader, which announces the current epoch in one of 64 reader slots (one compare-and-swap and one fence, it waits if the 64 slots are used) and loads the current snapshot (one atomic pointer load). Then snapshot(), at() and contains() are lookups in this snapshot (consistent between lookups, create a new reader to see the reloads) and at() returns a hopp::string_view into it. The views stay valid until the reader is destroyed, even after reloads.
+		 *
+		 * A replaced snapshot is retired with the current epoch and freed by a later reload (the watcher checks at each event or poll interval) when no reader created before the replacement remains (epoch-based reclamation). A reader held for a long time delays the destruction of the replaced snapshots. Readers must be destroyed before the hopp::parser::ini_config.
+		 *
+		 * A file read less than 2 s after its modification time is compared byte by byte at the next reload (it can be rewritten with the same size, modification time and inode). A file modified while it is read is not published.
+		 *
+		 * The watcher uses inotify on Linux (close after write and rename of the file, watched in its directory so editors which replace the file are supported) and polls the file otherwise. Every poll interval, the file is also reloaded if its signature did not change since the previous poll (a file being written is not published).
+		 *
+		 * Example:
+		 * @code
+		   hopp::parser::ini_config config("config.ini");
+		   config.on_change([](hopp::parser::ini_view const &, std::vector<hopp::parser::ini_config::change> const & changes) { std::cout << changes.size() << " changes" << std::endl; });
+		   config.watch();
+		
+		   // In any thread
+		   auto const reader = config.read(); // The views are valid while it exists
+		   std::cout << reader.at("network", "host") << ":" << reader.at("network", "port") << std::endl;
+		   @endcode
+		 *
+		 * @code
+		   #include <hopp/parser/ini_config.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_parser
+		 */
+		class ini_config
+		{
+		public:
+			
+			/// Change of a key between two snapshots
+			struct change
+			{
+				/// Kind of change
+				enum class kind_type { added, removed, modified };
+				
+				/// Kind
+				kind_type kind;
+				
+				/// Section
+				std::string section;
+				
+				/// Key
+				std::string key;
+				
+				/// Old value (empty if added)
+				std::string old_value;
+				
+				/// New value (empty if removed)
+				std::string new_value;
+			};
+			
+			/// Callback called after a new snapshot is published (without the reload mutex)
+			using callback_type = std::function<void(hopp::parser::ini_view const &, std::vector<change> const &)>;
+			
+		private:
+			
+			/// Signature of the file (to detect changes without reading it)
+			struct signature
+			{
+				/// Size
+				long long size;
+				
+				/// Modification time (ns since the epoch)
+				long long mtime;
+				
+				/// Inode
+				long long inode;
+				
+				/// @brief Operator ==
+				/// @param[in] s A signature
+				/// @return true if the signatures are equal, false otherwise
+				bool operator ==(signature const & s) const { return size == s.size && mtime == s.mtime && inode == s.inode; }
+			};
+			
+			/// Snapshot: content of the file and its view
+			struct snapshot_data
+			{
+				/// Content of the file
+				std::string content;
+				
+				/// View on the content
+				hopp::parser::ini_view view;
+				
+				/// @brief Constructor (read and parse the file)
+				/// @param[in] filename INI filename
+				/// @exception hopp::except::file_not_found if the file can not be opened
+				explicit snapshot_data(std::string const & filename) :
+					content(read(filename)), view(content.data(), content.size())
+				{ }
+				
+				/// @brief Read a file
+				/// @param[in] filename A filename
+				/// @return the content of the file
+				/// @exception hopp::except::file_not_found if the file can not be opened
+				static std::string read(std::string const & filename)
+				{
+					std::ifstream file(filename, std::ios::in | std::ios::binary);
+					if (file.good() == false) { throw hopp::except::file_not_found("hopp::parser::ini_config: can not open \"" + filename + "\""); }
+					return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+				}
+			};
+			
+			/// Reader slot: epoch announced by a reader (0 if the slot is free), alone in its cache line
+			struct reader_slot
+			{
+				/// Epoch
+				std::atomic<std::uint64_t> epoch;
+				
+				/// Padding
+				char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+			};
+			
+			/// Number of reader slots
+			static constexpr size_t nb_reader_slot = 64;
+			
+			/// Filename
+			std::string m_filename;
+			
+			/// Poll interval
+			std::chrono::milliseconds m_poll_interval;
+			
+			/// Current snapshot (owned)
+			std::atomic<snapshot_data const *> m_current;
+			
+			/// Current epoch (incremented when a snapshot is retired, starts at 1)
+			std::atomic<std::uint64_t> m_epoch;
+			
+			/// Reader slots
+			mutable reader_slot m_reader_slots[nb_reader_slot];
+			
+			/// Retired snapshots (owned) with their epoch, protected by m_mutex
+			std::vector<std::pair<std::uint64_t, snapshot_data const *>> m_retired;
+			
+			/// Signature of the file of the current snapshot
+			signature m_signature;
+			
+			/// Was the file of the current snapshot read during the tick of its modification time? (it can be rewritten with the same signature)
+			bool m_racy;
+			
+			/// Number of snapshots published
+			std::atomic<size_t> m_version;
+			
+			/// Changes of the last reload
+			std::vector<change> m_changes;
+			
+			/// Callback
+			callback_type m_callback;
+			
+			/// Mutex for reload, retired snapshots, changes and callback
+			mutable std::mutex m_mutex;
+			
+			/// Watcher thread
+			std::thread m_watcher;
+			
+			/// Stop the watcher?
+			bool m_stop;
+			
+			/// Mutex for m_stop
+			std::mutex m_stop_mutex;
+			
+			/// Condition variable to wake the watcher (polling)
+			std::condition_variable m_stop_condition;
+			
+			/// Pipe to wake the watcher (inotify)
+			int m_wake_pipe[2];
+			
+		public:
+			
+			/**
+			 * @brief Reader of the snapshots of a hopp::parser::ini_config (lock-free)
+			 *
+			 * The reader reads the snapshot current at its creation. The views returned are valid until the reader is destroyed. A reader is used by one thread at a time and must be destroyed before the hopp::parser::ini_config.
+			 */
+			class reader
+			{
+			private:
+				
+				/// Reader slot (nullptr if moved)
+				reader_slot * m_slot;
+				
+				/// Snapshot
+				snapshot_data const * m_data;
+				
+			public:
+				
+				/// @brief Constructor (announce the current epoch and load the current snapshot)
+				/// @param[in] config A hopp::parser::ini_config
+				explicit reader(hopp::parser::ini_config const & config) :
+					m_slot(config.pin()), m_data(config.m_current.load(std::memory_order_acquire))
+				{ }
+				
+				/// @brief Move constructor
+				/// @param[in] r A reader
+				reader(reader && r) : m_slot(r.m_slot), m_data(r.m_data) { r.m_slot = nullptr; }
+				
+				/// @brief Non-copyable
+				reader(reader const &) = delete;
+				
+				/// @brief Non-copyable
+				reader & operator =(reader const &) = delete;
+				
+				/// @brief Destructor (free the reader slot)
+				~reader() { if (m_slot != nullptr) { m_slot->epoch.store(0, std::memory_order_release); } }
+				
+				/// @brief Get the snapshot
+				/// @return the snapshot current at the creation of the reader (valid until the reader is destroyed)
+				hopp::parser::ini_view const & snapshot() const { return m_data->view; }
+				
+				/// @brief Get a value in the snapshot
+				/// @param[in] section A section
+				/// @param[in] key     A key
+				/// @return the value of the key in the section (valid until the reader is destroyed)
+				/// @exception std::out_of_range if the key does not exist
+				hopp::string_view at(hopp::string_view const & section, hopp::string_view const & key) const { return snapshot().at(section, key); }
+				
+				/// @brief Test if a key exists in the snapshot
+				/// @param[in] section A section
+				/// @param[in] key     A key
+				/// @return true if the key exists in the section, false otherwise
+				bool contains(hopp::string_view const & section, hopp::string_view const & key) const { return snapshot().contains(section, key); }
+			};
+			
+			/// @brief Constructor (the file is loaded)
+			/// @param[in] filename      INI filename
+			/// @param[in] poll_interval Poll interval of the watcher
+			/// @exception hopp::except::file_not_found if the file can not be opened
+			explicit ini_config(std::string const & filename, std::chrono::milliseconds const poll_interval = std::chrono::milliseconds(1000)) :
+				m_filename(filename), m_poll_interval(poll_interval),
+				m_current(nullptr), m_epoch(1), m_reader_slots(), m_retired(), m_signature{ -1, -1, -1 }, m_racy(true), m_version(0), m_changes(), m_callback(),
+				m_mutex(), m_watcher(), m_stop(false), m_stop_mutex(), m_stop_condition(), m_wake_pipe{ -1, -1 }
+			{
+				for (reader_slot & slot : m_reader_slots) { slot.epoch.store(0, std::memory_order_relaxed); }
+				m_signature = file_signature();
+				publish(new snapshot_data const(m_filename));
+				m_racy = is_racy(m_signature);
+			}
+			
+			/// @brief Non-copyable
+			ini_config(hopp::parser::ini_config const &) = delete;
+			
+			/// @brief Non-copyable
+			hopp::parser::ini_config & operator =(hopp::parser::ini_config const &) = delete;
+			
+			/// @brief Destructor (stop the watcher and destroy the snapshots)
+			~ini_config()
+			{
+				stop();
+				delete m_current.load();
+				for (auto const & retired : m_retired) { delete retired.second; }
+			}
+			
+			/// @brief Get the filename
+			/// @return the filename
+			std::string const & filename() const { return m_filename; }
+			
+			// Read (lock-free)
+			
+			/// @brief Get a reader of the snapshots
+			/// @return a hopp::parser::ini_config::reader (the views it returns are valid until it is destroyed)
+			reader read() const { return reader(*this); }
+			
+			/// @brief Get the number of snapshots published
+			/// @return the number of snapshots published (1 after the construction)
+			size_t version() const { return m_version.load(std::memory_order_acquire); }
+			
+			// Reload
+			
+			/// @brief Get the changes of the last reload
+			/// @return the changes of the last reload
+			std::vector<change> changes() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_changes;
+			}
+			
+			/// @brief Set the callback called (by the thread which reloads, without the reload mutex) after a new snapshot is published
+			/// @param[in] callback Callback (it can call changes(), on_change() and reload())
+			void on_change(callback_type const & callback)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_callback = callback;
+			}
+			
+			/// @brief Parse the file again if it changed and publish the new snapshot
+			/// @return true if a new snapshot is published, false otherwise
+			/// @exception hopp::except::file_not_found if the file can not be opened (the current snapshot is kept)
+			bool reload()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				reclaim();
+				
+				// Same size, modification time and inode (and not read during the tick of the modification time): no change
+				signature const s = file_signature();
+				if (s == m_signature && s.size >= 0 && m_racy == false) { return false; }
+				
+				// The file is being written: it will be reloaded later
+				std::unique_ptr<snapshot_data const> data(new snapshot_data const(m_filename));
+				if ((file_signature() == s) == false) { return false; }
+				m_signature = s;
+				m_racy = is_racy(s);
+				
+				// Same content: no change
+				snapshot_data const * const current = m_current.load(std::memory_order_relaxed);
+				if (data->view.buffer() == current->view.buffer()) { return false; }
+				
+				std::vector<change> changes = diff(current->view, data->view);
+				if (changes.empty()) { return false; }
+				
+				m_changes = std::move(changes);
+				publish(data.release());
+				if (bool(m_callback) == false) { return true; }
+				
+				// Call the callback without the mutex (the reader keeps the snapshot alive)
+				callback_type const callback = m_callback;
+				std::vector<change> const published_changes = m_changes;
+				reader const published(*this);
+				lock.unlock();
+				callback(published.snapshot(), published_changes);
+				return true;
+			}
+			
+			// Watcher
+			
+			/// @brief Start a thread which reloads the file when it changes
+			void watch()
+			{
+				if (m_watcher.joinable()) { return; }
+				m_stop = false;
+				
+				#ifdef HOPP_PARSER_INI_CONFIG_INOTIFY
+					if (::pipe(m_wake_pipe) != 0) { m_wake_pipe[0] = -1; m_wake_pipe[1] = -1; }
+				#endif
+				
+				m_watcher = std::thread([this]() { watcher(); });
+			}
+			
+			/// @brief Stop the watcher thread
+			void stop()
+			{
+				if (m_watcher.joinable() == false) { return; }
+				
+				{
+					std::lock_guard<std::mutex> lock(m_stop_mutex);
+					m_stop = true;
+				}
+				m_stop_condition.notify_all();
+				#ifdef HOPP_PARSER_INI_CONFIG_INOTIFY
+					if (m_wake_pipe[1] >= 0) { char const c = 0; ssize_t const r = ::write(m_wake_pipe[1], &c, 1); hopp_unused(r); }
+				#endif
+				
+				m_watcher.join();
+				
+				#ifdef HOPP_PARSER_INI_CONFIG_INOTIFY
+					for (int & fd : m_wake_pipe) { if (fd >= 0) { ::close(fd); fd = -1; } }
+				#endif
+			}
+			
+			/// @brief Compute the changes between two snapshots
+			/// @param[in] from Old snapshot
+			/// @param[in] to   New snapshot
+			/// @return the added, modified and removed keys
+			static std::vector<change> diff(hopp::parser::ini_view const & from, hopp::parser::ini_view const & to)
+			{
+				std::vector<change> changes;
+				
+				// Added and modified
+				for (auto const & section : to.index())
+				{
+					auto const old_section = from.index().find(section.first);
+					for (auto const & key : section.second)
+					{
+						if (old_section == from.index().end() || old_section->second.count(key.first) == 0)
+						{
+							changes.push_back(change{ change::kind_type::added, section.first.to_string(), key.first.to_string(), std::string(), key.second.to_string() });
+						}
+						else if (old_section->second.at(key.first) != key.second)
+						{
+							changes.push_back(change{ change::kind_type::modified, section.first.to_string(), key.first.to_string(), old_section->second.at(key.first).to_string(), key.second.to_string() });
+						}
+					}
+				}
+				
+				// Removed
+				for (auto const & section : from.index())
+				{
+					auto const new_section = to.index().find(section.first);
+					for (auto const & key : section.second)
+					{
+						if (new_section == to.index().end() || new_section->second.count(key.first) == 0)
+						{
+							changes.push_back(change{ change::kind_type::removed, section.first.to_string(), key.first.to_string(), key.second.to_string(), std::string() });
+						}
+					}
+				}
+				
+				return changes;
+			}
+			
+		private:
+			
+			/// @brief Claim a reader slot and announce the current epoch in it
+			/// @return the reader slot
+			reader_slot * pin() const
+			{
+				static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+				while (true)
+				{
+					for (size_t i = 0; i < nb_reader_slot; ++i)
+					{
+						reader_slot & slot = m_reader_slots[(hint + i) % nb_reader_slot];
+						std::uint64_t expected = 0;
+						if (slot.epoch.load(std::memory_order_relaxed) == 0 && slot.epoch.compare_exchange_strong(expected, m_epoch.load()))
+						{
+							// The snapshot loads can not move before the announce
+							std::atomic_thread_fence(std::memory_order_seq_cst);
+							hint += i;
+							return &slot;
+						}
+					}
+					std::this_thread::yield();
+				}
+			}
+			
+			/// @brief Publish a snapshot (with m_mutex held or in the constructor) and retire the previous one
+			/// @param[in] data New snapshot (owned)
+			void publish(snapshot_data const * const data)
+			{
+				snapshot_data const * const old = m_current.exchange(data);
+				if (old != nullptr) { m_retired.emplace_back(m_epoch.fetch_add(1), old); }
+				m_version.fetch_add(1, std::memory_order_release);
+				reclaim();
+			}
+			
+			/// @brief Destroy the retired snapshots which can not be read (with m_mutex held)
+			/// @details A reader which loaded a retired snapshot announced an epoch less than or equal to the epoch of the snapshot
+			void reclaim()
+			{
+				if (m_retired.empty()) { return; }
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				std::uint64_t min_epoch = std::numeric_limits<std::uint64_t>::max();
+				for (reader_slot const & slot : m_reader_slots)
+				{
+					std::uint64_t const epoch = slot.epoch.load();
+					if (epoch != 0 && epoch < min_epoch) { min_epoch = epoch; }
+				}
+				auto const end = std::remove_if
+				(
+					m_retired.begin(), m_retired.end(),
+					[min_epoch](std::pair<std::uint64_t, snapshot_data const *> const & retired)
+					{
+						if (retired.first >= min_epoch) { return false; }
+						delete retired.second;
+						return true;
+					}
+				);
+				m_retired.erase(end, m_retired.end());
+			}
+			
+			/// @brief Test if a file can be rewritten without changing its signature
+			/// @param[in] s Signature of the file when it was read
+			/// @return true if the file was read less than 2 s after its modification time (coarse timestamps), false otherwise
+			static bool is_racy(signature const & s)
+			{
+				long long const now = (long long)(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+				return s.mtime < 0 || now - s.mtime < 2000000000ll;
+			}
+			
+			/// @brief Get the signature of the file
+			/// @return the signature of the file ({ -1, -1, -1 } if it is not available)
+			signature file_signature() const
+			{
+				#ifdef HOPP_PARSER_INI_CONFIG_STAT
+					struct stat s;
+					if (::stat(m_filename.c_str(), &s) != 0) { return signature{ -1, -1, -1 }; }
+					#ifdef __APPLE__
+						long long const mtime = (long long)(s.st_mtimespec.tv_sec) * 1000000000ll + (long long)(s.st_mtimespec.tv_nsec);
+					#else
+						long long const mtime = (long long)(s.st_mtim.tv_sec) * 1000000000ll + (long long)(s.st_mtim.tv_nsec);
+					#endif
+					return signature{ (long long)(s.st_size), mtime, (long long)(s.st_ino) };
+				#else
+					return signature{ -1, -1, -1 };
+				#endif
+			}
+			
+			/// @brief Reload without throwing (the file can be missing while it is replaced)
+			void try_reload()
+			{
+				try { reload(); }
+				catch (std::exception const &) { }
+			}
+			
+			/// @brief Reload the file if its signature did not change since the previous poll (the file is not being written)
+			/// @param[in,out] previous Signature of the file at the previous poll
+			void poll_reload(signature & previous)
+			{
+				signature const s = file_signature();
+				if (s == previous) { try_reload(); }
+				previous = s;
+			}
+			
+			/// @brief Watcher loop
+			void watcher()
+			{
+				#ifdef HOPP_PARSER_INI_CONFIG_INOTIFY
+					
+					// Watch the directory (editors often write a new file and rename it)
+					// Only a close after write or a rename to the file reloads it (not each write)
+					std::string directory = ".";
+					std::string name = m_filename;
+					auto const slash = m_filename.find_last_of('/');
+					if (slash != std::string::npos)
+					{
+						directory = (slash == 0) ? "/" : m_filename.substr(0, slash);
+						name = m_filename.substr(slash + 1);
+					}
+					
+					int const fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+					if (fd >= 0 && m_wake_pipe[0] >= 0 && ::inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0)
+					{
+						alignas(inotify_event) char buffer[4096];
+						pollfd fds[2] = { { fd, POLLIN, 0 }, { m_wake_pipe[0], POLLIN, 0 } };
+						signature previous = file_signature();
+						while (true)
+						{
+							int const r = ::poll(fds, 2, int(m_poll_interval.count()));
+							if (r > 0 && (fds[1].revents & POLLIN)) { break; }
+							bool file_event = false;
+							if (r > 0 && (fds[0].revents & POLLIN))
+							{
+								ssize_t n;
+								while ((n = ::read(fd, buffer, sizeof(buffer))) > 0)
+								{
+									for (char const * p = buffer; p < buffer + n; )
+									{
+										inotify_event const * const event = reinterpret_cast<inotify_event const *>(p);
+										if (event->len != 0 && name == event->name) { file_event = true; }
+										p += sizeof(inotify_event) + event->len;
+									}
+								}
+							}
+							if (file_event) { try_reload(); }
+							else if (r == 0) { poll_reload(previous); }
+						}
+						::close(fd);
+						return;
+					}
+					if (fd >= 0) { ::close(fd); }
+					
+				#endif
+				
+				// Polling
+				signature previous = file_signature();
+				std::unique_lock<std::mutex> lock(m_stop_mutex);
+				while (m_stop_condition.wait_for(lock, m_poll_interval, [this]() { return m_stop; }) == false)
+				{
+					lock.unlock();
+					poll_reload(previous);
+					lock.lock();
+				}
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,506 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_PARSER_INI_SCHEMA_HPP
+#define HOPP_PARSER_INI_SCHEMA_HPP
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(hopp_unix) || defined(__unix__) || defined(__APPLE__)
+	#include <stdlib.h>
+	#include <locale.h>
+	#ifdef __APPLE__
+		#include <xlocale.h>
+	#endif
+	#define HOPP_PARSER_INI_SCHEMA_STRTOD_L
+#elif defined(_WIN32)
+	#include <stdlib.h>
+	#include <locale.h>
+	#define HOPP_PARSER_INI_SCHEMA_STRTOD_L_WIN
+#endif
+
+#include "ini_view.hpp"
+#include "../string/string_view.hpp"
+#include "../container/vector_pair.hpp"
+#include "../except/parse_error.hpp"
+#include "../except/bad_cast.hpp"
+
+
+namespace hopp
+{
+	namespace parser
+	{
+		class ini_schema;
+		class ini_typed;
+		
+		/**
+		 * @brief Handle on a typed key of a hopp::parser::ini_schema
+		 *
+		 * The handle is returned by hopp::parser::ini_schema::add and gives the value in O(1) with hopp::parser::ini_typed::get.
+		 *
+		 * @code
+		   #include <hopp/parser/ini_schema.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_parser
+		 */
+		template <class T>
+		class ini_field
+		{
+			friend class hopp::parser::ini_schema;
+			friend class hopp::parser::ini_typed;
+			
+		private:
+			
+			/// Index of the value in the values of type T
+			size_t m_index;
+			
+			/// @brief Constructor
+			/// @param[in] index Index of the value in the values of type T
+			explicit ini_field(size_t const index) : m_index(index) { }
+		};
+		
+		/**
+		 * @brief Schema of an INI file: the typed keys (int, double, bool or std::string) of each section
+		 *
+		 * A key is required or has a default value. The schema is given to hopp::parser::ini_typed, which converts and validates the values once.
+		 *
+		 * @code
+		   #include <hopp/parser/ini_schema.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_parser
+		 */
+		class ini_schema
+		{
+			friend class hopp::parser::ini_typed;
+			
+		public:
+			
+			/// Type of a key
+			enum class type { integer, floating_point, boolean, string };
+			
+		private:
+			
+			/// Values of each type
+			struct values_type
+			{
+				/// int values
+				std::vector<int> ints;
+				
+				/// double values
+				std::vector<double> doubles;
+				
+				/// bool values
+				std::vector<bool> bools;
+				
+				/// std::string values
+				std::vector<std::string> strings;
+				
+				/// @brief Get the int values
+				/// @return the int values
+				std::vector<int> & of(int const *) { return ints; }
+				
+				/// @brief Get the double values
+				/// @return the double values
+				std::vector<double> & of(double const *) { return doubles; }
+				
+				/// @brief Get the bool values
+				/// @return the bool values
+				std::vector<bool> & of(bool const *) { return bools; }
+				
+				/// @brief Get the std::string values
+				/// @return the std::string values
+				std::vector<std::string> & of(std::string const *) { return strings; }
+				
+				/// @copydoc of(int const *)
+				std::vector<int> const & of(int const *) const { return ints; }
+				
+				/// @copydoc of(double const *)
+				std::vector<double> const & of(double const *) const { return doubles; }
+				
+				/// @copydoc of(bool const *)
+				std::vector<bool> const & of(bool const *) const { return bools; }
+				
+				/// @copydoc of(std::string const *)
+				std::vector<std::string> const & of(std::string const *) const { return strings; }
+			};
+			
+			/// Typed key
+			struct field
+			{
+				/// Section
+				std::string section;
+				
+				/// Key
+				std::string key;
+				
+				/// Type
+				ini_schema::type kind;
+				
+				/// Index of the value in the values of its type
+				size_t index;
+				
+				/// Is the key required?
+				bool required;
+			};
+			
+			/// Typed keys in declaration order
+			std::vector<field> m_fields;
+			
+			/// Index of the typed keys: section -> key -> position in m_fields
+			hopp::vector_pair<std::string, hopp::vector_pair<std::string, size_t>> m_index;
+			
+			/// Default values
+			values_type m_defaults;
+			
+		public:
+			
+			/// @brief Default constructor (empty schema)
+			ini_schema() : m_fields(), m_index(), m_defaults() { }
+			
+			/// @brief Get the number of typed keys
+			/// @return the number of typed keys
+			size_t size() const { return m_fields.size(); }
+			
+			/// @brief Add a required key
+			/// @param[in] section A section
+			/// @param[in] key     A key
+			/// @return the handle on the key
+			/// @exception std::invalid_argument if the key is already in the schema
+			template <class T>
+			hopp::parser::ini_field<T> add(std::string const & section, std::string const & key)
+			{
+				return add_field<T>(section, key, T(), true);
+			}
+			
+			/// @brief Add an optional key
+			/// @param[in] section       A section
+			/// @param[in] key           A key
+			/// @param[in] default_value Value if the key is not in the file
+			/// @return the handle on the key
+			/// @exception std::invalid_argument if the key is already in the schema
+			template <class T>
+			hopp::parser::ini_field<T> add(std::string const & section, std::string const & key, T const & default_value)
+			{
+				return add_field<T>(section, key, default_value, false);
+			}
+			
+			/// @brief Get the name of a type
+			/// @param[in] kind A type
+			/// @return the name of the type
+			static char const * type_name(ini_schema::type const kind)
+			{
+				switch (kind)
+				{
+					case ini_schema::type::integer: return "int";
+					case ini_schema::type::floating_point: return "double";
+					case ini_schema::type::boolean: return "bool";
+					case ini_schema::type::string: return "std::string";
+				}
+				return "";
+			}
+			
+		private:
+			
+			/// @brief Get the type of T
+			/// @return the type of T
+			static ini_schema::type type_of(int const *) { return ini_schema::type::integer; }
+			
+			/// @copydoc type_of(int const *)
+			static ini_schema::type type_of(double const *) { return ini_schema::type::floating_point; }
+			
+			/// @copydoc type_of(int const *)
+			static ini_schema::type type_of(bool const *) { return ini_schema::type::boolean; }
+			
+			/// @copydoc type_of(int const *)
+			static ini_schema::type type_of(std::string const *) { return ini_schema::type::string; }
+			
+			/// @brief Add a key
+			/// @param[in] section       A section
+			/// @param[in] key           A key
+			/// @param[in] default_value Default value
+			/// @param[in] required      Is the key required?
+			/// @return the handle on the key
+			template <class T>
+			hopp::parser::ini_field<T> add_field(std::string const & section, std::string const & key, T const & default_value, bool const required)
+			{
+				static_assert
+				(
+					std::is_same<T, int>::value || std::is_same<T, double>::value || std::is_same<T, bool>::value || std::is_same<T, std::string>::value,
+					"hopp::parser::ini_schema::add<T>: T must be int, double, bool or std::string"
+				);
+				
+				auto & keys = m_index[section];
+				if (keys.count(key) != 0)
+				{
+					throw std::invalid_argument("hopp::parser::ini_schema::add: \"" + section + "." + key + "\" is already in the schema");
+				}
+				keys.insert(key, m_fields.size());
+				
+				auto & defaults = m_defaults.of(static_cast<T const *>(nullptr));
+				m_fields.push_back(field{ section, key, type_of(static_cast<T const *>(nullptr)), defaults.size(), required });
+				defaults.push_back(default_value);
+				
+				return hopp::parser::ini_field<T>(defaults.size() - 1);
+			}
+		};
+		
+		/**
+		 * @brief INI values converted and validated once with a hopp::parser::ini_schema
+		 *
+		 * All the keys of the schema are converted at the construction (without std::stringstream), the errors (missing required key, invalid value) are reported together. A lookup with a hopp::parser::ini_field is an access in an array; the keys which are not in the schema are ignored.
+		 *
+		 * Syntax of the values:
+		 * - int: optional sign and decimal digits
+		 * - double: std::strtod syntax in the "C" locale (the decimal separator is always '.', whatever LC_NUMERIC)
+		 * - bool: true, false, yes, no, on, off, 1 or 0 (case insensitive)
+		 *
+		 * Example:
+		 * @code
+		   hopp::parser::ini_schema schema;
+		   auto const port = schema.add<int>("network", "port");
+		   auto const timeout = schema.add<double>("network", "timeout", 2.5);
+		   auto const verbose = schema.add<bool>("log", "verbose", false);
+		   
+		   hopp::parser::ini_typed const config(hopp::parser::ini_view("config.ini"), schema);
+		   int const p = config.get(port);
+		   double const t = config.get<double>("network", "timeout");
+		   @endcode
+		 *
+		 * With a hopp::parser::ini_config, build a hopp::parser::ini_typed from the snapshot in the on_change callback.
+		 *
+		 * @code
+		   #include <hopp/parser/ini_schema.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_parser
+		 */
+		class ini_typed
+		{
+		private:
+			
+			/// Schema
+			hopp::parser::ini_schema const * m_schema;
+			
+			/// Values
+			hopp::parser::ini_schema::values_type m_values;
+			
+		public:
+			
+			/// @brief Constructor from a hopp::parser::ini_view
+			/// @param[in] ini    A hopp::parser::ini_view
+			/// @param[in] schema A hopp::parser::ini_schema (it must outlive the hopp::parser::ini_typed)
+			/// @exception hopp::except::parse_error if a required key is missing or if a value is invalid
+			ini_typed(hopp::parser::ini_view const & ini, hopp::parser::ini_schema const & schema) :
+				m_schema(&schema), m_values(schema.m_defaults)
+			{
+				load(ini.index());
+			}
+			
+			/// @brief Constructor from the result of hopp::parser::ini
+			/// @param[in] ini    A hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>>
+			/// @param[in] schema A hopp::parser::ini_schema (it must outlive the hopp::parser::ini_typed)
+			/// @exception hopp::except::parse_error if a required key is missing or if a value is invalid
+			ini_typed(hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>> const & ini, hopp::parser::ini_schema const & schema) :
+				m_schema(&schema), m_values(schema.m_defaults)
+			{
+				load(ini);
+			}
+			
+			/// @brief Get the schema
+			/// @return the schema
+			hopp::parser::ini_schema const & schema() const { return *m_schema; }
+			
+			/// @brief Get a value
+			/// @param[in] field A handle of the schema
+			/// @return the value
+			template <class T>
+			typename std::conditional<std::is_arithmetic<T>::value, T, T const &>::type get(hopp::parser::ini_field<T> const & field) const
+			{
+				auto const & values = m_values.of(static_cast<T const *>(nullptr));
+				#ifndef NDEBUG
+				if (field.m_index >= values.size())
+				{
+					throw std::out_of_range("hopp::parser::ini_typed::get: the field is not in the schema");
+				}
+				#endif
+				return values[field.m_index];
+			}
+			
+			/// @brief Get a value (slower than with a handle)
+			/// @param[in] section A section
+			/// @param[in] key     A key
+			/// @return the value
+			/// @exception std::out_of_range if the key is not in the schema
+			/// @exception hopp::except::bad_cast if the type of the key is not T
+			template <class T>
+			typename std::conditional<std::is_arithmetic<T>::value, T, T const &>::type get(std::string const & section, std::string const & key) const
+			{
+				auto const & field = m_schema->m_fields[m_schema->m_index.at(section).at(key)];
+				if (field.kind != hopp::parser::ini_schema::type_of(static_cast<T const *>(nullptr)))
+				{
+					throw hopp::except::bad_cast
+					(
+						"hopp::parser::ini_typed::get: \"" + section + "." + key + "\" is declared as " + hopp::parser::ini_schema::type_name(field.kind) +
+						", not as " + hopp::parser::ini_schema::type_name(hopp::parser::ini_schema::type_of(static_cast<T const *>(nullptr)))
+					);
+				}
+				return m_values.of(static_cast<T const *>(nullptr))[field.index];
+			}
+			
+		private:
+			
+			/// @brief Convert and validate the keys of the schema
+			/// @param[in] index Index section -> key -> value
+			template <class index_t>
+			void load(index_t const & index)
+			{
+				std::string errors;
+				
+				for (auto const & field : m_schema->m_fields)
+				{
+					auto const section = index.find(field.section);
+					if (section == index.end() || section->second.count(field.key) == 0)
+					{
+						if (field.required) { errors += "\n- \"" + field.section + "." + field.key + "\" is missing"; }
+						continue;
+					}
+					
+					hopp::string_view const value = section->second.at(field.key);
+					bool ok = true;
+					switch (field.kind)
+					{
+						case hopp::parser::ini_schema::type::integer: ok = parse(value, m_values.ints[field.index]); break;
+						case hopp::parser::ini_schema::type::floating_point: ok = parse(value, m_values.doubles[field.index]); break;
+						case hopp::parser::ini_schema::type::boolean:
+						{
+							bool b = false;
+							ok = parse(value, b);
+							if (ok) { m_values.bools[field.index] = b; }
+							break;
+						}
+						case hopp::parser::ini_schema::type::string: m_values.strings[field.index] = value.to_string(); break;
+					}
+					
+					if (ok == false)
+					{
+						errors += "\n- \"" + field.section + "." + field.key + "\" = \"" + value.to_string() + "\" is not a valid " + hopp::parser::ini_schema::type_name(field.kind);
+					}
+				}
+				
+				if (errors.empty() == false)
+				{
+					throw hopp::except::parse_error("hopp::parser::ini_typed: invalid configuration:" + errors);
+				}
+			}
+			
+			/// @brief Parse an int
+			/// @param[in]  value A value
+			/// @param[out] out   The int
+			/// @return true if the value is an int, false otherwise
+			static bool parse(hopp::string_view const & value, int & out)
+			{
+				size_t i = 0;
+				bool const negative = value.size() != 0 && value[0] == '-';
+				if (value.size() != 0 && (value[0] == '-' || value[0] == '+')) { ++i; }
+				if (i == value.size()) { return false; }
+				
+				long long const limit = (long long)(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+				long long r = 0;
+				for (; i < value.size(); ++i)
+				{
+					char const c = value[i];
+					if (c < '0' || c > '9') { return false; }
+					r = r * 10 + (c - '0');
+					if (r > limit) { return false; }
+				}
+				
+				out = int(negative ? -r : r);
+				return true;
+			}
+			
+			/// @brief Parse a double (in the "C" locale, the decimal separator is always '.')
+			/// @param[in]  value A value
+			/// @param[out] out   The double
+			/// @return true if the value is a double, false otherwise (or if its magnitude is too large)
+			static bool parse(hopp::string_view const & value, double & out)
+			{
+				if (value.empty()) { return false; }
+				
+				// strtod needs a null-terminated string
+				std::string const s = value.to_string();
+				char * end = nullptr;
+				errno = 0;
+				double const r = strtod_c(s.c_str(), &end);
+				if (end != s.c_str() + s.size()) { return false; }
+				
+				// ERANGE is an error for an overflow only (an underflow gives a subnormal or 0)
+				if (errno == ERANGE && (r == HUGE_VAL || r == -HUGE_VAL)) { return false; }
+				
+				out = r;
+				return true;
+			}
+			
+			/// @brief std::strtod in the "C" locale (independent of LC_NUMERIC)
+			/// @param[in]  s   A null-terminated string
+			/// @param[out] end End of the double
+			/// @return the double
+			static double strtod_c(char const * const s, char * * const end)
+			{
+				#if defined(HOPP_PARSER_INI_SCHEMA_STRTOD_L)
+					
+					// Never freed (used until the end of the program)
+					static locale_t const c_locale = ::newlocale(LC_NUMERIC_MASK, "C", locale_t(0));
+					if (c_locale != locale_t(0)) { return ::strtod_l(s, end, c_locale); }
+					
+				#elif defined(HOPP_PARSER_INI_SCHEMA_STRTOD_L_WIN)
+					
+					// Never freed (used until the end of the program)
+					static _locale_t const c_locale = ::_create_locale(LC_NUMERIC, "C");
+					if (c_locale != nullptr) { return ::_strtod_l(s, end, c_locale); }
+					
+				#endif
+				
+				return std::strtod(s, end);
+			}
+			
+			/// @brief Parse a bool
+			/// @param[in]  value A value
+			/// @param[out] out   The bool
+			/// @return true if the value is a bool, false otherwise
+			static bool parse(hopp::string_view const & value, bool & out)
+			{
+				if (value.size() > 5) { return false; }
+				
+				std::string s;
+				for (char const c : value) { s += (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c; }
+				
+				if (s == "true" || s == "yes" || s == "on" || s == "1") { out = true; return true; }
+				if (s == "false" || s == "no" || s == "off" || s == "0") { out = false; return true; }
+				return false;
+			}
+		};
+	}
+}
+
+#endif
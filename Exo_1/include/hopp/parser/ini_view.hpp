@@ -0,0 +1,307 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_PARSER_INI_VIEW_HPP
+#define HOPP_PARSER_INI_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(hopp_unix) || defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/types.h>
+	#define HOPP_PARSER_INI_VIEW_MMAP
+#else
+	#include <fstream>
+#endif
+
+#include "../string/string_view.hpp"
+#include "../container/vector_pair.hpp"
+#include "../except/file_not_found.hpp"
+
+
+namespace hopp
+{
+	namespace parser
+	{
+		/**
+		 * @brief Zero-copy INI parser https://en.wikipedia.org/wiki/INI_file
+		 *
+		 * The file is mapped in memory (or read once if mmap is not available) and parsed in a single pass. The sections, keys and values are hopp::string_view on the buffer, which is shared by the copies of the hopp::parser::ini_view.
+		 *
+		 * The syntax is the one of hopp::parser::ini:
+		 * - leading and trailing white-spaces are removed
+		 * - a line which starts with ';' or '#' is a comment, a value ends at ';', '#' or at the end of the line
+		 * - the keys before the first section are in the "" section
+		 * - if a key is repeated in a section, the index keeps the last value
+		 *
+		 * Unlike hopp::parser::ini, a key and its value never continue on the next line:
+		 * - "key =" at the end of a line is a key with an empty value (hopp::parser::ini reads the next line as the value)
+		 * - a line without '=' is a key with an empty value (hopp::parser::ini reads the key until the next '=', on the following lines)
+		 *
+		 * Example:
+		 * @code
+		   hopp::parser::ini_view const ini("config.ini");
+		   
+		   std::cout << ini.at("network", "port") << std::endl;
+		   for (auto const & entry : ini.entries()) { std::cout << entry.section << "." << entry.key << " = " << entry.value << std::endl; }
+		   @endcode
+		 *
+		 * @code
+		   #include <hopp/parser/ini_view.hpp>
+		   @endcode
+		 *
+		 * @ingroup hopp_parser
+		 */
+		class ini_view
+		{
+		public:
+			
+			/// Key-value pair of the file
+			struct entry
+			{
+				/// Section
+				hopp::string_view section;
+				
+				/// Key
+				hopp::string_view key;
+				
+				/// Value
+				hopp::string_view value;
+			};
+			
+			/// Hashed index: section -> key -> value
+			using index_type = hopp::vector_pair<hopp::string_view, hopp::vector_pair<hopp::string_view, hopp::string_view>>;
+			
+		private:
+			
+			/// Owner of the buffer (nullptr if the buffer is borrowed)
+			std::shared_ptr<void const> m_owner;
+			
+			/// Buffer
+			char const * m_data;
+			
+			/// Size of the buffer
+			size_t m_size;
+			
+			/// Entries in file order
+			std::vector<entry> m_entries;
+			
+			/// Index
+			index_type m_index;
+			
+		public:
+			
+			/// @brief Constructor from a file (mapped in memory)
+			/// @param[in] filename INI filename
+			/// @exception hopp::except::file_not_found if the file can not be opened
+			explicit ini_view(std::string const & filename) :
+				m_owner(), m_data(""), m_size(0), m_entries(), m_index()
+			{
+				load(filename);
+				parse();
+			}
+			
+			/// @brief Constructor from a buffer
+			/// @param[in] data Buffer (it must outlive the hopp::parser::ini_view)
+			/// @param[in] size Size of the buffer
+			ini_view(char const * const data, size_t const size) :
+				m_owner(), m_data(data), m_size(size), m_entries(), m_index()
+			{
+				parse();
+			}
+			
+			/// @brief Get the buffer
+			/// @return the buffer
+			hopp::string_view buffer() const { return hopp::string_view(m_data, m_size); }
+			
+			/// @brief Get the key-value pairs in file order (repeated keys included)
+			/// @return the key-value pairs in file order
+			std::vector<entry> const & entries() const { return m_entries; }
+			
+			/// @brief Get the hashed index
+			/// @return the hashed index
+			index_type const & index() const { return m_index; }
+			
+			/// @brief Test if a key exists
+			/// @param[in] section A section
+			/// @param[in] key     A key
+			/// @return true if the key exists in the section, false otherwise
+			bool contains(hopp::string_view const & section, hopp::string_view const & key) const
+			{
+				auto const it = m_index.find(section);
+				return it != m_index.end() && it->second.count(key) != 0;
+			}
+			
+			/// @brief Get a value
+			/// @param[in] section A section
+			/// @param[in] key     A key
+			/// @return the value of the key in the section
+			/// @exception std::out_of_range if the key does not exist
+			hopp::string_view at(hopp::string_view const & section, hopp::string_view const & key) const
+			{
+				return m_index.at(section).at(key);
+			}
+			
+			/// @brief Copy the sections, keys and values in std::string (result of hopp::parser::ini)
+			/// @return a hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>>
+			hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>> to_vector_pair() const
+			{
+				hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>> r;
+				r.reserve(m_index.size());
+				for (auto const & section : m_index)
+				{
+					auto & keys = r[section.first.to_string()];
+					keys.reserve(section.second.size());
+					for (auto const & key : section.second) { keys.push_back(key.first.to_string(), key.second.to_string()); }
+				}
+				return r;
+			}
+			
+		private:
+			
+			/// @brief Map (or read) the file
+			/// @param[in] filename INI filename
+			void load(std::string const & filename)
+			{
+				#ifdef HOPP_PARSER_INI_VIEW_MMAP
+					
+					int const fd = ::open(filename.c_str(), O_RDONLY);
+					if (fd < 0) { throw hopp::except::file_not_found("hopp::parser::ini_view: can not open \"" + filename + "\""); }
+					
+					struct stat s;
+					if (::fstat(fd, &s) != 0)
+					{
+						::close(fd);
+						throw std::runtime_error("hopp::parser::ini_view: can not stat \"" + filename + "\"");
+					}
+					size_t const size = size_t(s.st_size);
+					if (size == 0) { ::close(fd); return; }
+					
+					void * const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+					::close(fd);
+					if (mapping == MAP_FAILED) { throw std::runtime_error("hopp::parser::ini_view: can not map \"" + filename + "\""); }
+					
+					::madvise(mapping, size, MADV_SEQUENTIAL);
+					m_owner = std::shared_ptr<void const>(mapping, [size](void const * const p) { ::munmap(const_cast<void *>(p), size); });
+					m_data = static_cast<char const *>(mapping);
+					m_size = size;
+					
+				#else
+					
+					std::ifstream file(filename, std::ios::in | std::ios::binary);
+					if (file.good() == false) { throw hopp::except::file_not_found("hopp::parser::ini_view: can not open \"" + filename + "\""); }
+					file.seekg(0, std::ios::end);
+					auto const buffer = std::make_shared<std::vector<char>>(size_t(file.tellg()));
+					file.seekg(0, std::ios::beg);
+					file.read(buffer->data(), std::streamsize(buffer->size()));
+					m_owner = buffer;
+					m_data = buffer->data();
+					m_size = buffer->size();
+					
+				#endif
+			}
+			
+			/// @brief Test if a char is a white-space (like std::isspace in the "C" locale)
+			/// @param[in] c A char
+			/// @return true if c is a white-space, false otherwise
+			static bool is_space(char const c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+			
+			/// @brief Test if a char is a white-space in a line
+			/// @param[in] c A char
+			/// @return true if c is a white-space and not '\n', false otherwise
+			static bool is_blank(char const c) { return c != '\n' && is_space(c); }
+			
+			/// @brief Get a view without trailing white-spaces
+			/// @param[in] first First char
+			/// @param[in] last  Last char (not included)
+			/// @return the view on [first, last) without trailing white-spaces
+			static hopp::string_view trim(char const * const first, char const * last)
+			{
+				while (last != first && is_space(*(last - 1))) { --last; }
+				return hopp::string_view(first, size_t(last - first));
+			}
+			
+			/// @brief Parse the buffer in a single pass
+			void parse()
+			{
+				char const * p = m_data;
+				char const * const end = m_data + m_size;
+				
+				// Go to the next line
+				auto const next_line = [end](char const * const q) -> char const *
+				{
+					auto const newline = static_cast<char const *>(std::memchr(q, '\n', size_t(end - q)));
+					return (newline == nullptr) ? end : newline + 1;
+				};
+				
+				hopp::string_view section;
+				hopp::vector_pair<hopp::string_view, hopp::string_view> * keys = nullptr;
+				
+				while (true)
+				{
+					while (p != end && is_space(*p)) { ++p; }
+					if (p == end) { break; }
+					
+					// Comment
+					if (*p == ';' || *p == '#') { p = next_line(p); continue; }
+					
+					// Section
+					if (*p == '[')
+					{
+						++p;
+						while (p != end && is_blank(*p)) { ++p; }
+						char const * const first = p;
+						while (p != end && *p != ']' && *p != '\n') { ++p; }
+						section = trim(first, p);
+						keys = nullptr;
+						p = next_line(p);
+						continue;
+					}
+					
+					// Key
+					char const * const key_first = p;
+					while (p != end && *p != '=' && *p != '\n') { ++p; }
+					hopp::string_view const key = trim(key_first, p);
+					
+					// Value
+					hopp::string_view value(p, 0);
+					if (p != end && *p == '=')
+					{
+						++p;
+						while (p != end && is_blank(*p)) { ++p; }
+						char const * const value_first = p;
+						while (p != end && *p != ';' && *p != '#' && *p != '\n') { ++p; }
+						value = trim(value_first, p);
+					}
+					p = next_line(p);
+					
+					// Add (the index of the section is searched once per section)
+					m_entries.push_back(entry{ section, key, value });
+					if (keys == nullptr) { keys = &m_index[section]; }
+					keys->insert(key, value);
+				}
+			}
+		};
+	}
+}
+
+#endif
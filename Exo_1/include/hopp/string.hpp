@@ -26,6 +26,7 @@
 #include "string/remove_leading_whitespaces.hpp"
 #include "string/remove_multiple_whitespaces.hpp"
 #include "string/remove_trailing_whitespaces.hpp"
+#include "string/string_view.hpp"
 
 
 namespace hopp
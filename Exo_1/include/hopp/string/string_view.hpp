@@ -0,0 +1,176 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_STRING_STRING_VIEW_HPP
+#define HOPP_STRING_STRING_VIEW_HPP
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+
+namespace hopp
+{
+	/**
+	 * @brief Non-owning view on a sequence of chars (like std::string_view of C++17)
+	 *
+	 * @code
+	   #include <hopp/string/string_view.hpp>
+	   @endcode
+	 *
+	 * @ingroup hopp_string
+	 */
+	class string_view
+	{
+	public:
+		
+		/// Const iterator type
+		using const_iterator = char const *;
+		
+		/// Iterator type
+		using iterator = char const *;
+		
+	private:
+		
+		/// First char
+		char const * m_data;
+		
+		/// Number of chars
+		size_t m_size;
+		
+	public:
+		
+		/// @brief Default constructor (empty view)
+		string_view() : m_data(""), m_size(0) { }
+		
+		/// @brief Constructor
+		/// @param[in] data First char
+		/// @param[in] size Number of chars
+		string_view(char const * const data, size_t const size) : m_data(data), m_size(size) { }
+		
+		/// @brief Constructor from a null-terminated string
+		/// @param[in] string A null-terminated string
+		string_view(char const * const string) : m_data(string), m_size(std::strlen(string)) { }
+		
+		/// @brief Constructor from a std::string
+		/// @param[in] string A std::string (it must outlive the view)
+		string_view(std::string const & string) : m_data(string.data()), m_size(string.size()) { }
+		
+		/// @brief Get the first char
+		/// @return the first char
+		char const * data() const { return m_data; }
+		
+		/// @brief Get the number of chars
+		/// @return the number of chars
+		size_t size() const { return m_size; }
+		
+		/// @brief Is empty?
+		/// @return true if the view is empty, false otherwise
+		bool empty() const { return m_size == 0; }
+		
+		/// @brief Get a char
+		/// @param[in] i Index
+		/// @return the char at index i
+		char operator [](size_t const i) const { return m_data[i]; }
+		
+		/// @brief Get iterator to beginning
+		/// @return iterator to beginning
+		const_iterator begin() const { return m_data; }
+		
+		/// @brief Get iterator to end
+		/// @return iterator to end
+		const_iterator end() const { return m_data + m_size; }
+		
+		/// @brief Get a part of the view
+		/// @param[in] position First char
+		/// @param[in] size     Number of chars (clamped)
+		/// @return the view on [position, position + size)
+		/// @pre position <= size()
+		hopp::string_view substr(size_t const position, size_t const size = size_t(-1)) const
+		{
+			return hopp::string_view(m_data + position, std::min(size, m_size - position));
+		}
+		
+		/// @brief Copy the chars in a std::string
+		/// @return a std::string
+		std::string to_string() const { return std::string(m_data, m_size); }
+	};
+	
+	/// @brief Operator << between a std::ostream and a hopp::string_view
+	/// @param[in,out] out  A std::ostream
+	/// @param[in]     view A hopp::string_view
+	/// @return out
+	/// @relates hopp::string_view
+	inline std::ostream & operator <<(std::ostream & out, hopp::string_view const & view)
+	{
+		out.write(view.data(), std::streamsize(view.size()));
+		return out;
+	}
+	
+	/// @brief Operator == between two hopp::string_view
+	/// @param[in] a A hopp::string_view
+	/// @param[in] b A hopp::string_view
+	/// @return true if a and b have the same chars, false otherwise
+	/// @relates hopp::string_view
+	inline bool operator ==(hopp::string_view const & a, hopp::string_view const & b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+	}
+	
+	/// @brief Operator != between two hopp::string_view
+	/// @param[in] a A hopp::string_view
+	/// @param[in] b A hopp::string_view
+	/// @return true if a != b, false otherwise
+	/// @relates hopp::string_view
+	inline bool operator !=(hopp::string_view const & a, hopp::string_view const & b)
+	{
+		return (a == b) == false;
+	}
+	
+	/// @brief Operator < between two hopp::string_view (lexicographic order)
+	/// @param[in] a A hopp::string_view
+	/// @param[in] b A hopp::string_view
+	/// @return true if a < b, false otherwise
+	/// @relates hopp::string_view
+	inline bool operator <(hopp::string_view const & a, hopp::string_view const & b)
+	{
+		int const r = std::memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+		return r < 0 || (r == 0 && a.size() < b.size());
+	}
+}
+
+namespace std
+{
+	/// @brief Specialization of std::hash for hopp::string_view (FNV-1a)
+	/// @ingroup hopp_string
+	template <>
+	struct hash<hopp::string_view>
+	{
+		/// @brief Hash a hopp::string_view
+		/// @param[in] view A hopp::string_view
+		/// @return the hash of view
+		size_t operator ()(hopp::string_view const & view) const
+		{
+			std::uint64_t h = 14695981039346656037ull;
+			for (char const c : view) { h = (h ^ std::uint64_t(static_cast<unsigned char>(c))) * 1099511628211ull; }
+			return size_t(h);
+		}
+	};
+}
+
+#endif
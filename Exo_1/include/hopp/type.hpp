@@ -25,6 +25,7 @@
    @endcode
  */
 
+#include "type/is_hashable.hpp"
 #include "type/is_iterator.hpp"
 #include "type/sfinae.hpp"
 
@@ -0,0 +1,53 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HOPP_TYPE_IS_HASHABLE_HPP
+#define HOPP_TYPE_IS_HASHABLE_HPP
+
+#include <functional>
+#include <utility>
+
+#include "sfinae.hpp"
+
+
+namespace hopp
+{
+	// is_hashable
+	
+	/// @brief Is std::hash<T> usable? (default constructible and callable with a T)
+	/// @ingroup hopp_type
+	template <class T, class = void>
+	struct is_hashable : public std::false_type
+	{
+		/// no type
+		using no = void;
+	};
+	
+	/// @brief Is std::hash<T> usable? (specialization of hopp::is_hashable<T>)
+	/// @ingroup hopp_type
+	template <class T>
+	struct is_hashable
+	<
+		T,
+		typename hopp::this_type<decltype(std::hash<T>()(std::declval<T const &>()))>::is_valid
+	> :
+		public std::true_type
+	{
+		/// yes type
+		using yes = void;
+	};
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef TESTS_CHECK_HPP
+#define TESTS_CHECK_HPP
+
+#include <iostream>
+
+
+/// @brief Number of failed checks
+/// @return a reference on the number of failed checks
+inline int & nb_failed_check()
+{
+	static int n = 0;
+	return n;
+}
+
+/// @brief Check a condition (print it if it is false)
+#define test_check(condition) \
+	do \
+	{ \
+		if (bool(condition) == false) \
+		{ \
+			++nb_failed_check(); \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+		} \
+	} \
+	while (false)
+
+/// @brief Check that an expression throws an exception
+#define test_check_throw(expression, exception_t) \
+	do \
+	{ \
+		bool thrown = false; \
+		try { expression; } \
+		catch (exception_t const &) { thrown = true; } \
+		if (thrown == false) \
+		{ \
+			++nb_failed_check(); \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": " << #expression << " does not throw " << #exception_t << std::endl; \
+		} \
+	} \
+	while (false)
+
+/// @brief Print the number of failed checks
+/// @return the exit code of the test (0 if all the checks passed)
+inline int test_result()
+{
+	if (nb_failed_check() == 0) { std::cout << "All checks passed" << std::endl; return 0; }
+	std::cout << nb_failed_check() << " checks failed" << std::endl;
+	return 1;
+}
+
+#endif
@@ -0,0 +1,328 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <hopp/container/tree.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Pseudo-random number (linear congruential generator)
+/// @param[in,out] state State of the generator
+/// @param[in]     n     Upper bound (not included)
+/// @return a number in [0, n)
+static std::size_t next_random(std::uint64_t & state, std::size_t const n)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return std::size_t(state >> 33) % n;
+}
+
+/// @brief Naive tree: the children of each node in a std::vector (reference for hopp::tree)
+class naive_tree
+{
+public:
+	
+	/// Null node
+	static constexpr std::size_t null_node = hopp::tree<int>::null_node;
+	
+	/// Root
+	std::size_t root = null_node;
+	
+	/// Parent of each node
+	std::vector<std::size_t> parents;
+	
+	/// Children of each node
+	std::vector<std::vector<std::size_t>> children;
+	
+	/// Is the node in the tree?
+	std::vector<bool> alive;
+	
+	/// @brief Add a node
+	/// @param[in] node   The node
+	/// @param[in] parent Its parent (null_node for the root)
+	void add(std::size_t const node, std::size_t const parent)
+	{
+		if (node >= parents.size()) { parents.resize(node + 1, null_node); children.resize(node + 1); alive.resize(node + 1, false); }
+		parents[node] = parent;
+		children[node].clear();
+		alive[node] = true;
+		if (parent == null_node) { root = node; }
+		else { children[parent].push_back(node); }
+	}
+	
+	/// @brief Erase a subtree
+	/// @param[in] node Root of the subtree
+	void erase(std::size_t const node)
+	{
+		if (parents[node] != null_node)
+		{
+			auto & siblings = children[parents[node]];
+			siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+		}
+		else { root = null_node; }
+		for (std::size_t const n : preorder(node)) { alive[n] = false; }
+	}
+	
+	/// @brief Get the nodes of the tree
+	/// @return the nodes of the tree
+	std::vector<std::size_t> nodes() const
+	{
+		std::vector<std::size_t> r;
+		for (std::size_t n = 0; n < alive.size(); ++n) { if (alive[n]) { r.push_back(n); } }
+		return r;
+	}
+	
+	/// @brief Get the depth of a node by walking up to the root
+	/// @param[in] node A node
+	/// @return the depth of the node
+	std::size_t depth(std::size_t node) const
+	{
+		std::size_t r = 0;
+		while (parents[node] != null_node) { node = parents[node]; ++r; }
+		return r;
+	}
+	
+	/// @brief Pre-order traversal
+	/// @param[in] node Root of the subtree
+	/// @return the nodes in pre-order
+	std::vector<std::size_t> preorder(std::size_t const node) const
+	{
+		std::vector<std::size_t> r = { node };
+		for (std::size_t const child : children[node]) { auto const sub = preorder(child); r.insert(r.end(), sub.begin(), sub.end()); }
+		return r;
+	}
+	
+	/// @brief Post-order traversal
+	/// @param[in] node Root of the subtree
+	/// @return the nodes in post-order
+	std::vector<std::size_t> postorder(std::size_t const node) const
+	{
+		std::vector<std::size_t> r;
+		for (std::size_t const child : children[node]) { auto const sub = postorder(child); r.insert(r.end(), sub.begin(), sub.end()); }
+		r.push_back(node);
+		return r;
+	}
+	
+	/// @brief Breadth-first traversal
+	/// @param[in] node Root of the subtree
+	/// @return the nodes level by level
+	std::vector<std::size_t> breadth_first(std::size_t const node) const
+	{
+		std::vector<std::size_t> r;
+		std::deque<std::size_t> queue = { node };
+		while (queue.empty() == false)
+		{
+			r.push_back(queue.front());
+			queue.insert(queue.end(), children[queue.front()].begin(), children[queue.front()].end());
+			queue.pop_front();
+		}
+		return r;
+	}
+};
+
+constexpr std::size_t naive_tree::null_node;
+
+/// @brief Get the indices of a traversal
+/// @param[in] range A range of a hopp::tree
+/// @return the indices of the nodes
+template <class range_t>
+static std::vector<std::size_t> indices(range_t const & range)
+{
+	std::vector<std::size_t> r;
+	for (auto it = range.begin(); it != range.end(); ++it) { r.push_back(it.index()); }
+	return r;
+}
+
+/// @brief Check a hopp::tree against a naive tree
+/// @param[in] tree  A hopp::tree
+/// @param[in] naive The naive tree
+static void check_tree(hopp::tree<int> const & tree, naive_tree const & naive)
+{
+	auto const nodes = naive.nodes();
+	test_check(tree.size() == nodes.size());
+	test_check(tree.empty() == nodes.empty());
+	test_check(tree.root() == naive.root);
+	
+	for (std::size_t n = 0; n < tree.nodes().size(); ++n)
+	{
+		test_check(tree.contains(n) == (n < naive.alive.size() && naive.alive[n]));
+	}
+	test_check(tree.contains(tree.nodes().size()) == false);
+	
+	for (std::size_t const n : nodes)
+	{
+		test_check(tree[n] == int(n) && tree.at(n) == int(n));
+		test_check(tree.parent(n) == naive.parents[n]);
+		test_check(tree.depth(n) == naive.depth(n));
+		test_check(tree.nb_children(n) == naive.children[n].size());
+		test_check(tree.is_leaf(n) == naive.children[n].empty());
+		test_check(tree.first_child(n) == (naive.children[n].empty() ? naive_tree::null_node : naive.children[n].front()));
+		test_check(tree.last_child(n) == (naive.children[n].empty() ? naive_tree::null_node : naive.children[n].back()));
+		test_check(indices(tree.children(n)) == naive.children[n]);
+		
+		auto const preorder = naive.preorder(n);
+		test_check(tree.subtree_size(n) == preorder.size());
+		test_check(indices(tree.preorder(n)) == preorder);
+		test_check(indices(tree.postorder(n)) == naive.postorder(n));
+		test_check(indices(tree.breadth_first(n)) == naive.breadth_first(n));
+	}
+	
+	if (naive.root != naive_tree::null_node)
+	{
+		std::vector<std::size_t> preorder;
+		for (auto it = tree.begin(); it != tree.end(); ++it) { preorder.push_back(it.index()); }
+		test_check(preorder == naive.preorder(naive.root));
+	}
+	else
+	{
+		test_check(tree.begin() == tree.end());
+	}
+}
+
+int main()
+{
+	// Empty tree
+	
+	{
+		hopp::tree<int> const tree;
+		test_check(tree.empty() && tree.size() == 0 && tree.root() == hopp::tree<int>::null_node);
+		test_check(tree.begin() == tree.end());
+		test_check_throw(tree.at(0), std::out_of_range);
+	}
+	
+	// Random additions and erasures against the naive tree
+	
+	std::uint64_t state = 42;
+	for (int test = 0; test < 20; ++test)
+	{
+		hopp::tree<int> tree;
+		naive_tree naive;
+		
+		std::size_t const root = tree.add_root(0);
+		test_check(root == 0);
+		naive.add(root, naive_tree::null_node);
+		
+		for (int step = 0; step < 300; ++step)
+		{
+			auto const nodes = naive.nodes();
+			std::size_t const version = tree.version();
+			
+			if (nodes.empty())
+			{
+				std::size_t const node = tree.add_root(0);
+				tree[node] = int(node);
+				naive.add(node, naive_tree::null_node);
+				continue;
+			}
+			
+			std::size_t const action = next_random(state, 10);
+			if (action < 7)
+			{
+				// Add a child (the deeper nodes are more likely with the last nodes)
+				std::size_t const parent = (next_random(state, 2) == 0) ? nodes[next_random(state, nodes.size())] : nodes.back();
+				std::size_t const node = tree.add_child(parent, 0);
+				tree[node] = int(node);
+				naive.add(node, parent);
+			}
+			else if (action == 7 && nodes.size() < 50)
+			{
+				// New root above the old one
+				std::size_t const old_root = naive.root;
+				std::size_t const node = tree.add_root(0);
+				tree[node] = int(node);
+				naive.add(node, naive_tree::null_node);
+				naive.parents[old_root] = node;
+				naive.children[node].push_back(old_root);
+			}
+			else
+			{
+				// Erase a subtree (the root rarely)
+				std::size_t const node = nodes[next_random(state, nodes.size())];
+				if (node == naive.root && next_random(state, 4) != 0) { continue; }
+				tree.erase(node);
+				naive.erase(node);
+			}
+			test_check(tree.version() != version);
+			
+			if (step % 10 == 0) { check_tree(tree, naive); }
+		}
+		check_tree(tree, naive);
+		
+		// Erased nodes do not exist
+		
+		for (std::size_t n = 0; n < tree.nodes().size(); ++n)
+		{
+			if (tree.contains(n) == false) { test_check_throw(tree.at(n), std::out_of_range); }
+		}
+		
+		// Compact keeps the shape, the values and the pre-order
+		
+		if (tree.empty() == false)
+		{
+			hopp::tree<int> const copy = tree;
+			std::vector<int> values_before;
+			for (int const value : tree) { values_before.push_back(value); }
+			
+			auto const new_index = tree.compact();
+			test_check(tree == copy);
+			test_check(tree.root() == 0 && tree.nodes().size() == tree.size());
+			
+			std::vector<int> values_after;
+			for (int const value : tree) { values_after.push_back(value); }
+			test_check(values_after == values_before);
+			
+			for (std::size_t n = 0; n < new_index.size(); ++n)
+			{
+				if (copy.contains(n)) { test_check(new_index[n] < tree.size() && tree[new_index[n]] == copy[n]); }
+				else { test_check(new_index[n] == hopp::tree<int>::null_node); }
+			}
+			for (std::size_t n = 0; n < tree.size(); ++n) { test_check(tree.preorder(n).begin().index() == n); }
+			std::size_t i = 0;
+			for (auto it = tree.begin(); it != tree.end(); ++it, ++i) { test_check(it.index() == i); }
+		}
+	}
+	
+	// Comparison, clear and reuse of the erased nodes
+	
+	{
+		hopp::tree<int> a(1);
+		std::size_t const a_2 = a.add_child(a.root(), 2);
+		a.add_child(a.root(), 3);
+		a.add_child(a_2, 4);
+		
+		hopp::tree<int> b(1);
+		std::size_t const b_2 = b.add_child(b.root(), 2);
+		std::size_t const b_3 = b.add_child(b.root(), 3);
+		test_check(a != b);
+		b.add_child(b_3, 4);
+		test_check(a != b);
+		b.erase(b_3);
+		test_check(b.size() == 2);
+		b.add_child(b.root(), 3);
+		b.add_child(b_2, 4);
+		test_check(a == b);
+		test_check(b.nodes().size() == 4); // the erased nodes are reused
+		
+		b.clear();
+		test_check(b.empty() && b.root() == hopp::tree<int>::null_node && b.nodes().empty());
+		test_check(a != b);
+	}
+	
+	return test_result();
+}
@@ -0,0 +1,209 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <hopp/container/tree_index.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Pseudo-random number (linear congruential generator)
+/// @param[in,out] state State of the generator
+/// @param[in]     n     Upper bound (not included)
+/// @return a number in [0, n)
+static std::size_t next_random(std::uint64_t & state, std::size_t const n)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return std::size_t(state >> 33) % n;
+}
+
+/// @brief Get the nodes of a hopp::tree
+/// @param[in] tree A hopp::tree
+/// @return the nodes
+static std::vector<std::size_t> nodes(hopp::tree<long> const & tree)
+{
+	std::vector<std::size_t> r;
+	for (std::size_t n = 0; n < tree.nodes().size(); ++n) { if (tree.contains(n)) { r.push_back(n); } }
+	return r;
+}
+
+/// @brief Get the ancestors of a node by walking up to the root
+/// @param[in] tree A hopp::tree
+/// @param[in] node A node
+/// @return the node, its parent, ..., the root
+static std::vector<std::size_t> ancestors(hopp::tree<long> const & tree, std::size_t node)
+{
+	std::vector<std::size_t> r = { node };
+	while (tree.parent(node) != hopp::tree<long>::null_node) { node = tree.parent(node); r.push_back(node); }
+	return r;
+}
+
+/// @brief Naive lowest common ancestor with the parent walks
+/// @param[in] tree A hopp::tree
+/// @param[in] a    A node
+/// @param[in] b    A node
+/// @return the lowest common ancestor of a and b
+static std::size_t naive_lca(hopp::tree<long> const & tree, std::size_t const a, std::size_t const b)
+{
+	auto const ancestors_b = ancestors(tree, b);
+	for (std::size_t const n : ancestors(tree, a))
+	{
+		if (std::find(ancestors_b.begin(), ancestors_b.end(), n) != ancestors_b.end()) { return n; }
+	}
+	return hopp::tree<long>::null_node;
+}
+
+/// @brief Naive sum of the values of a subtree
+/// @param[in] tree A hopp::tree
+/// @param[in] node Root of the subtree
+/// @return the sum of the values of the subtree
+static long naive_subtree_sum(hopp::tree<long> const & tree, std::size_t const node)
+{
+	long r = 0;
+	for (long const value : tree.preorder(node)) { r += value; }
+	return r;
+}
+
+/// @brief Check a hopp::tree_index against the parent walks
+/// @param[in] index A hopp::tree_index
+/// @param[in,out] state State of the generator
+static void check_index(hopp::tree_index<long> const & index, std::uint64_t & state)
+{
+	hopp::tree<long> const & tree = index.tree();
+	auto const all = nodes(tree);
+	
+	// Pre-order and subtrees
+	std::vector<std::size_t> preorder;
+	for (auto it = tree.begin(); it != tree.end(); ++it) { preorder.push_back(it.index()); }
+	test_check(index.preorder() == preorder);
+	
+	for (std::size_t const n : all)
+	{
+		test_check(index.depth(n) == ancestors(tree, n).size() - 1);
+		test_check(index.subtree_size(n) == tree.subtree_size(n));
+		test_check(index.subtree_sum(n) == naive_subtree_sum(tree, n));
+		
+		auto const range = index.subtree_range(n);
+		test_check(range.second - range.first == tree.subtree_size(n));
+		test_check(preorder[range.first] == n);
+		std::vector<std::size_t> subtree(preorder.begin() + std::ptrdiff_t(range.first), preorder.begin() + std::ptrdiff_t(range.second));
+		std::vector<std::size_t> expected;
+		for (auto it = tree.preorder(n).begin(); it != tree.preorder(n).end(); ++it) { expected.push_back(it.index()); }
+		test_check(subtree == expected);
+	}
+	
+	// Pairs of nodes (all of them in small trees)
+	std::size_t const nb_pair = std::min<std::size_t>(all.size() * all.size(), 2000);
+	for (std::size_t i = 0; i < nb_pair; ++i)
+	{
+		std::size_t const a = (nb_pair == all.size() * all.size()) ? all[i / all.size()] : all[next_random(state, all.size())];
+		std::size_t const b = (nb_pair == all.size() * all.size()) ? all[i % all.size()] : all[next_random(state, all.size())];
+		
+		std::size_t const lca = naive_lca(tree, a, b);
+		test_check(index.lca(a, b) == lca);
+		test_check(index.lca(b, a) == lca);
+		test_check(index.distance(a, b) == (ancestors(tree, a).size() - 1) + (ancestors(tree, b).size() - 1) - 2 * (ancestors(tree, lca).size() - 1));
+		test_check(index.is_ancestor(a, b) == (lca == a));
+		test_check(index.is_ancestor(b, a) == (lca == b));
+	}
+}
+
+int main()
+{
+	// Empty tree and single node
+	
+	{
+		hopp::tree<long> tree;
+		hopp::tree_index<long> const index(tree);
+		test_check(index.preorder().empty());
+		
+		std::size_t const root = tree.add_root(5);
+		test_check(index.preorder().size() == 1);
+		test_check(index.lca(root, root) == root && index.depth(root) == 0 && index.distance(root, root) == 0);
+		test_check(index.subtree_size(root) == 1 && index.subtree_sum(root) == 5);
+		test_check(index.is_ancestor(root, root));
+	}
+	
+	// Path (the deepest tree) and star (the widest tree)
+	
+	{
+		hopp::tree<long> path(0);
+		std::size_t node = path.root();
+		for (long i = 1; i < 1000; ++i) { node = path.add_child(node, i); }
+		hopp::tree_index<long> const index(path);
+		test_check(index.depth(node) == 999);
+		test_check(index.lca(node, path.root()) == path.root());
+		test_check(index.lca(node, path.parent(node)) == path.parent(node));
+		test_check(index.distance(node, path.root()) == 999);
+		test_check(index.subtree_sum(path.root()) == 999 * 1000 / 2);
+		
+		hopp::tree<long> star(0);
+		for (long i = 1; i < 1000; ++i) { star.add_child(star.root(), i); }
+		hopp::tree_index<long> const star_index(star);
+		test_check(star_index.lca(1, 999) == star.root());
+		test_check(star_index.distance(1, 999) == 2);
+		test_check(star_index.is_ancestor(1, 999) == false);
+	}
+	
+	// Random trees, modified between the queries (the index is rebuilt)
+	
+	std::uint64_t state = 42;
+	for (int test = 0; test < 10; ++test)
+	{
+		hopp::tree<long> tree(long(next_random(state, 100)));
+		hopp::tree_index<long> index(tree);
+		
+		for (int round = 0; round < 8; ++round)
+		{
+			std::size_t const nb_add = next_random(state, 200) + 1;
+			for (std::size_t i = 0; i < nb_add; ++i)
+			{
+				auto const all = nodes(tree);
+				std::size_t const parent = (next_random(state, 3) == 0) ? all.back() : all[next_random(state, all.size())];
+				tree.add_child(parent, long(next_random(state, 1000)) - 500);
+			}
+			if (round % 2 == 1)
+			{
+				auto const all = nodes(tree);
+				std::size_t const node = all[next_random(state, all.size())];
+				if (node != tree.root()) { tree.erase(node); }
+			}
+			if (round == 4) { tree.compact(); }
+			
+			check_index(index, state);
+			
+			// The values are not tracked: invalidate
+			for (std::size_t const n : nodes(tree)) { tree[n] += 1; }
+			index.invalidate();
+			check_index(index, state);
+		}
+		
+		// Erased nodes are not in the index (checked without NDEBUG)
+		
+		#ifndef NDEBUG
+		auto const all = nodes(tree);
+		std::size_t const leaf = *std::find_if(all.begin(), all.end(), [&](std::size_t const n) { return tree.is_leaf(n); });
+		tree.erase(leaf);
+		test_check_throw(index.depth(leaf), std::out_of_range);
+		test_check_throw(index.lca(tree.root(), leaf), std::out_of_range);
+		test_check_throw(index.subtree_sum(tree.nodes().size()), std::out_of_range);
+		#endif
+	}
+	
+	return test_result();
+}
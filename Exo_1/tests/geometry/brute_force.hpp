@@ -0,0 +1,206 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef TESTS_GEOMETRY_BRUTE_FORCE_HPP
+#define TESTS_GEOMETRY_BRUTE_FORCE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <hopp/geometry/rectangle.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Pseudo-random number (linear congruential generator)
+/// @param[in,out] state State of the generator
+/// @param[in]     n     Upper bound (not included)
+/// @return a number in [0, n)
+inline std::size_t next_random(std::uint64_t & state, std::size_t const n)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return std::size_t(state >> 33) % n;
+}
+
+/// @brief Random rectangle with integer coordinates (the borders often touch)
+/// @param[in,out] state    State of the generator
+/// @param[in]     min      Minimum coordinate
+/// @param[in]     max      Maximum coordinate
+/// @param[in]     max_size Maximum width and height
+/// @return the rectangle
+inline hopp::rectangle<double> random_rectangle(std::uint64_t & state, int const min, int const max, int const max_size)
+{
+	double const left = double(min + int(next_random(state, std::size_t(max - min))));
+	double const top = double(min + int(next_random(state, std::size_t(max - min))));
+	double const width = double(next_random(state, std::size_t(max_size) + 1));
+	double const height = double(next_random(state, std::size_t(max_size) + 1));
+	return hopp::rectangle<double>(left, top, width, height);
+}
+
+/// @brief Test if two rectangles intersect, borders included (reference for the spatial indexes)
+/// @param[in] a A rectangle
+/// @param[in] b A rectangle
+/// @return true if the intervals overlap on both axes
+inline bool brute_force_overlap(hopp::rectangle<double> const & a, hopp::rectangle<double> const & b)
+{
+	bool const x = (a.left <= b.left + b.width) && (b.left <= a.left + a.width);
+	bool const y = (a.top <= b.top + b.height) && (b.top <= a.top + a.height);
+	return x && y;
+}
+
+/// @brief Get the rectangles which overlap a rectangle by testing all of them
+/// @param[in] rectangles Rectangles (by identifier)
+/// @param[in] used       Identifier is used
+/// @param[in] rectangle  A rectangle
+/// @return the sorted identifiers
+inline std::vector<std::size_t> brute_force_query
+(
+	std::vector<hopp::rectangle<double>> const & rectangles,
+	std::vector<bool> const & used,
+	hopp::rectangle<double> const & rectangle
+)
+{
+	std::vector<std::size_t> r;
+	for (std::size_t id = 0; id < rectangles.size(); ++id)
+	{
+		if (used[id] && brute_force_overlap(rectangles[id], rectangle)) { r.push_back(id); }
+	}
+	return r;
+}
+
+/// @brief Get the pairs of overlapping rectangles by testing all the pairs
+/// @param[in] rectangles Rectangles (by identifier)
+/// @param[in] used       Identifier is used
+/// @return the sorted pairs (a, b) with a < b
+inline std::vector<std::pair<std::size_t, std::size_t>> brute_force_overlaps
+(
+	std::vector<hopp::rectangle<double>> const & rectangles,
+	std::vector<bool> const & used
+)
+{
+	std::vector<std::pair<std::size_t, std::size_t>> r;
+	for (std::size_t a = 0; a < rectangles.size(); ++a)
+	{
+		if (used[a] == false) { continue; }
+		for (std::size_t b = a + 1; b < rectangles.size(); ++b)
+		{
+			if (used[b] && brute_force_overlap(rectangles[a], rectangles[b])) { r.emplace_back(a, b); }
+		}
+	}
+	return r;
+}
+
+/// @brief Sort a std::vector
+/// @param[in] v A std::vector
+/// @return the sorted std::vector
+template <class T>
+std::vector<T> sorted(std::vector<T> v)
+{
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+/// @brief Check a spatial index (hopp::grid_index or hopp::bvh) against the brute force
+/// @param[in]     index      A spatial index
+/// @param[in]     rectangles Rectangles (by identifier)
+/// @param[in]     used       Identifier is used
+/// @param[in,out] state      State of the generator
+/// @param[in]     min        Minimum coordinate of the queries
+/// @param[in]     max        Maximum coordinate of the queries
+template <class index_t>
+void check_spatial_index
+(
+	index_t const & index,
+	std::vector<hopp::rectangle<double>> const & rectangles,
+	std::vector<bool> const & used,
+	std::uint64_t & state,
+	int const min,
+	int const max
+)
+{
+	test_check(index.size() == std::size_t(std::count(used.begin(), used.end(), true)));
+	for (std::size_t id = 0; id < rectangles.size(); ++id)
+	{
+		test_check(index.contains(id) == used[id]);
+		if (used[id]) { test_check(index.get(id) == rectangles[id]); }
+	}
+	test_check(index.contains(rectangles.size()) == false);
+	
+	for (int i = 0; i < 50; ++i)
+	{
+		hopp::rectangle<double> const query = random_rectangle(state, min, max, (max - min) / 4);
+		test_check(sorted(index.query(query)) == brute_force_query(rectangles, used, query));
+	}
+	
+	auto const overlaps = sorted(index.overlaps());
+	test_check(overlaps == brute_force_overlaps(rectangles, used));
+	for (auto const & pair : overlaps) { test_check(pair.first < pair.second); }
+	test_check(std::adjacent_find(overlaps.begin(), overlaps.end()) == overlaps.end());
+}
+
+/// @brief Insert, remove and move random rectangles in a spatial index (hopp::grid_index or hopp::bvh) and in the reference
+/// @param[in,out] index      A spatial index
+/// @param[in,out] rectangles Rectangles (by identifier)
+/// @param[in,out] used       Identifier is used
+/// @param[in,out] state      State of the generator
+/// @param[in]     nb         Number of operations
+/// @param[in]     min        Minimum coordinate
+/// @param[in]     max        Maximum coordinate
+/// @param[in]     max_size   Maximum width and height
+template <class index_t>
+void random_operations
+(
+	index_t & index,
+	std::vector<hopp::rectangle<double>> & rectangles,
+	std::vector<bool> & used,
+	std::uint64_t & state,
+	std::size_t const nb,
+	int const min,
+	int const max,
+	int const max_size
+)
+{
+	for (std::size_t i = 0; i < nb; ++i)
+	{
+		std::size_t const action = next_random(state, 3);
+		std::size_t const id = next_random(state, rectangles.size() + 1);
+		if (action == 0 || id == rectangles.size() || used[id] == false)
+		{
+			hopp::rectangle<double> const rectangle = random_rectangle(state, min, max, max_size);
+			std::size_t const new_id = index.insert(rectangle);
+			test_check(new_id <= rectangles.size());
+			if (new_id == rectangles.size()) { rectangles.push_back(rectangle); used.push_back(true); }
+			else { test_check(used[new_id] == false); rectangles[new_id] = rectangle; used[new_id] = true; }
+		}
+		else if (action == 1)
+		{
+			index.remove(id);
+			used[id] = false;
+		}
+		else
+		{
+			// Small move or jump
+			hopp::rectangle<double> rectangle = rectangles[id];
+			if (next_random(state, 2) == 0) { rectangle.left += double(int(next_random(state, 5)) - 2); rectangle.top += double(int(next_random(state, 5)) - 2); }
+			else { rectangle = random_rectangle(state, min, max, max_size); }
+			index.update(id, rectangle);
+			rectangles[id] = rectangle;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,97 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cmath>
+#include <vector>
+
+#include <hopp/geometry/bvh.hpp>
+
+#include "brute_force.hpp"
+
+
+/// @brief Test if the height of a hopp::bvh is in O(log n)
+/// @param[in] index A hopp::bvh
+/// @return true if the height is at most 2 log2(n) + 2
+static bool is_balanced(hopp::bvh<double> const & index)
+{
+	return double(index.height()) <= 2.0 * std::log2(double(index.size()) + 1.0) + 2.0;
+}
+
+int main()
+{
+	// Empty and single rectangle
+	
+	{
+		hopp::bvh<double> index;
+		test_check(index.size() == 0 && index.height() == 0);
+		test_check(index.query(hopp::rectangle<double>(0, 0, 100, 100)).empty() && index.overlaps().empty());
+		
+		std::size_t const id = index.insert(hopp::rectangle<double>(1, 1, 0, 0));
+		test_check(id == 0 && index.height() == 0);
+		test_check(index.query(hopp::rectangle<double>(0, 0, 1, 1)) == std::vector<std::size_t>{ id });
+		test_check(index.query(hopp::rectangle<double>(2, 2, 1, 1)).empty());
+		index.remove(id);
+		test_check(index.size() == 0 && index.query(hopp::rectangle<double>(0, 0, 100, 100)).empty());
+	}
+	
+	// Random rectangles (very different sizes) against the brute force
+	
+	std::uint64_t state = 42;
+	for (int test = 0; test < 10; ++test)
+	{
+		std::vector<hopp::rectangle<double>> rectangles;
+		std::size_t const nb = next_random(state, 300);
+		for (std::size_t i = 0; i < nb; ++i)
+		{
+			int const max_size = (next_random(state, 10) == 0) ? 500 : 5;
+			rectangles.push_back(random_rectangle(state, -1000, 1000, max_size));
+		}
+		std::vector<bool> used(rectangles.size(), true);
+		
+		hopp::bvh<double> index(rectangles);
+		check_spatial_index(index, rectangles, used, state, -1100, 1100);
+		test_check(is_balanced(index));
+		
+		for (int round = 0; round < 5; ++round)
+		{
+			random_operations(index, rectangles, used, state, 100, -1000, 1000, (round % 2 == 0) ? 5 : 300);
+			check_spatial_index(index, rectangles, used, state, -1100, 1100);
+			test_check(is_balanced(index));
+		}
+	}
+	
+	// Sorted insertions stay balanced
+	
+	{
+		hopp::bvh<double> index;
+		std::vector<hopp::rectangle<double>> rectangles;
+		for (int i = 0; i < 1000; ++i)
+		{
+			rectangles.emplace_back(double(i), 0, 1, 1);
+			index.insert(rectangles.back());
+		}
+		test_check(is_balanced(index));
+		std::vector<bool> const used(rectangles.size(), true);
+		check_spatial_index(index, rectangles, used, state, -10, 1010);
+		test_check(index.overlaps().size() == 999);
+		
+		#ifndef NDEBUG
+		test_check_throw(index.get(1000), std::out_of_range);
+		test_check_throw(index.update(1000, hopp::rectangle<double>()), std::out_of_range);
+		#endif
+	}
+	
+	return test_result();
+}
@@ -0,0 +1,82 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vector>
+
+#include <hopp/geometry/grid_index.hpp>
+
+#include "brute_force.hpp"
+
+
+int main()
+{
+	// Invalid cell size
+	
+	test_check_throw(hopp::grid_index<double>(hopp::rectangle<double>(0, 0, 100, 100), 0), std::invalid_argument);
+	test_check_throw(hopp::grid_index<double>(hopp::rectangle<double>(0, 0, 100, 100), -1), std::invalid_argument);
+	
+	// Number of cells
+	
+	{
+		hopp::grid_index<double> const index(hopp::rectangle<double>(0, 0, 100, 45), 10);
+		test_check(index.nb_cell_x() == 10 && index.nb_cell_y() == 5);
+		test_check(index.size() == 0 && index.query(hopp::rectangle<double>(0, 0, 100, 100)).empty() && index.overlaps().empty());
+	}
+	
+	// Random rectangles (some outside the bounds, some larger than a cell) against the brute force
+	
+	std::uint64_t state = 42;
+	for (int test = 0; test < 10; ++test)
+	{
+		std::vector<hopp::rectangle<double>> rectangles;
+		std::size_t const nb = next_random(state, 300);
+		int const max_size = (test % 2 == 0) ? 10 : 40;
+		for (std::size_t i = 0; i < nb; ++i) { rectangles.push_back(random_rectangle(state, -50, 150, max_size)); }
+		std::vector<bool> used(rectangles.size(), true);
+		
+		hopp::grid_index<double> index(hopp::rectangle<double>(0, 0, 100, 100), 10, rectangles);
+		check_spatial_index(index, rectangles, used, state, -60, 160);
+		
+		for (int round = 0; round < 5; ++round)
+		{
+			random_operations(index, rectangles, used, state, 100, -50, 150, max_size);
+			check_spatial_index(index, rectangles, used, state, -60, 160);
+		}
+	}
+	
+	// A large rectangle is reported once per query and once per pair
+	
+	{
+		hopp::grid_index<double> index(hopp::rectangle<double>(0, 0, 100, 100), 10);
+		std::size_t const a = index.insert(hopp::rectangle<double>(-10, -10, 120, 120));
+		std::size_t const b = index.insert(hopp::rectangle<double>(0, 0, 100, 100));
+		std::size_t const c = index.insert(hopp::rectangle<double>(100, 100, 0, 0));
+		test_check(sorted(index.query(hopp::rectangle<double>(0, 0, 100, 100))) == (std::vector<std::size_t>{ a, b, c }));
+		test_check(index.overlaps().size() == 3);
+		
+		// Identifiers of the removed rectangles are reused
+		index.remove(b);
+		test_check(index.contains(b) == false && index.size() == 2);
+		test_check(index.insert(hopp::rectangle<double>(200, 200, 1, 1)) == b);
+		test_check(sorted(index.overlaps()) == (std::vector<std::pair<std::size_t, std::size_t>>{ { a, c } }));
+		
+		#ifndef NDEBUG
+		test_check_throw(index.get(3), std::out_of_range);
+		test_check_throw(index.remove(3), std::out_of_range);
+		#endif
+	}
+	
+	return test_result();
+}
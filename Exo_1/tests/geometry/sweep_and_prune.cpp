@@ -0,0 +1,175 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <hopp/geometry/sweep_and_prune.hpp>
+
+#include "brute_force.hpp"
+
+
+/// Pairs of identifiers
+using pairs_t = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/// @brief Get the pairs of a which are not in b
+/// @param[in] a Sorted pairs
+/// @param[in] b Sorted pairs
+/// @return a - b
+static pairs_t difference(pairs_t const & a, pairs_t const & b)
+{
+	pairs_t r;
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(r));
+	return r;
+}
+
+/// @brief Remove the pairs of a rectangle
+/// @param[in,out] pairs Pairs
+/// @param[in]     id    Identifier of the rectangle
+static void remove_pairs(pairs_t & pairs, std::size_t const id)
+{
+	pairs.erase
+	(
+		std::remove_if(pairs.begin(), pairs.end(), [id](std::pair<std::size_t, std::size_t> const & p) { return p.first == id || p.second == id; }),
+		pairs.end()
+	);
+}
+
+/// @brief Check the overlapping pairs, the started and the ended pairs after an update against the brute force
+/// @param[in]     broad_phase A hopp::sweep_and_prune
+/// @param[in]     rectangles  Rectangles (by identifier)
+/// @param[in]     used        Identifier is used
+/// @param[in,out] previous    Overlapping pairs before the update (after the update as output)
+static void check_update
+(
+	hopp::sweep_and_prune<double> const & broad_phase,
+	std::vector<hopp::rectangle<double>> const & rectangles,
+	std::vector<bool> const & used,
+	pairs_t & previous
+)
+{
+	pairs_t const current = brute_force_overlaps(rectangles, used);
+	test_check(sorted(broad_phase.overlaps()) == current);
+	test_check(broad_phase.nb_overlap() == current.size());
+	test_check(sorted(broad_phase.started()) == difference(current, previous));
+	test_check(sorted(broad_phase.ended()) == difference(previous, current));
+	for (auto const & pair : broad_phase.started()) { test_check(pair.first < pair.second); }
+	for (auto const & pair : broad_phase.ended()) { test_check(pair.first < pair.second); }
+	
+	test_check(broad_phase.size() == std::size_t(std::count(used.begin(), used.end(), true)));
+	for (std::size_t id = 0; id < rectangles.size(); ++id)
+	{
+		test_check(broad_phase.contains(id) == used[id]);
+		if (used[id]) { test_check(broad_phase.get(id) == rectangles[id]); }
+	}
+	
+	previous = current;
+}
+
+int main()
+{
+	// Borders included
+	
+	{
+		std::vector<hopp::rectangle<double>> const rectangles =
+		{
+			hopp::rectangle<double>(0, 0, 10, 10),
+			hopp::rectangle<double>(10, 10, 5, 5),
+			hopp::rectangle<double>(15.5, 0, 1, 1),
+			hopp::rectangle<double>(5, 5, 0, 0)
+		};
+		hopp::sweep_and_prune<double> broad_phase(rectangles);
+		test_check(sorted(broad_phase.overlaps()) == (pairs_t{ { 0, 1 }, { 0, 3 } }));
+		test_check(broad_phase.started().empty() && broad_phase.ended().empty());
+		
+		broad_phase.set(2, hopp::rectangle<double>(15, 0, 1, 10));
+		broad_phase.update();
+		test_check(broad_phase.started() == (pairs_t{ { 1, 2 } }));
+		test_check(broad_phase.ended().empty());
+		
+		broad_phase.update();
+		test_check(broad_phase.started().empty() && broad_phase.ended().empty());
+		test_check(broad_phase.nb_overlap() == 3);
+	}
+	
+	// Random moves, insertions and removals against the brute force
+	
+	std::uint64_t state = 42;
+	for (int test = 0; test < 10; ++test)
+	{
+		std::vector<hopp::rectangle<double>> rectangles;
+		std::size_t const nb = next_random(state, 200);
+		for (std::size_t i = 0; i < nb; ++i) { rectangles.push_back(random_rectangle(state, 0, 500, 20)); }
+		std::vector<bool> used(rectangles.size(), true);
+		
+		hopp::sweep_and_prune<double> broad_phase(rectangles);
+		pairs_t previous = brute_force_overlaps(rectangles, used);
+		test_check(sorted(broad_phase.overlaps()) == previous);
+		
+		for (int frame = 0; frame < 50; ++frame)
+		{
+			// Move (mostly a little)
+			for (std::size_t id = 0; id < rectangles.size(); ++id)
+			{
+				if (used[id] == false || next_random(state, 2) == 0) { continue; }
+				hopp::rectangle<double> & r = rectangles[id];
+				if (next_random(state, 20) == 0) { r = random_rectangle(state, 0, 500, 20); }
+				else
+				{
+					r.left += double(int(next_random(state, 7)) - 3);
+					r.top += double(int(next_random(state, 7)) - 3);
+					if (next_random(state, 10) == 0) { r.width = double(next_random(state, 21)); }
+				}
+				broad_phase.set(id, r);
+			}
+			
+			// Insert and remove (the pairs of a removed rectangle are not reported as ended)
+			std::size_t const nb_change = next_random(state, 4);
+			for (std::size_t i = 0; i < nb_change; ++i)
+			{
+				std::size_t const id = next_random(state, rectangles.size() + 1);
+				if (id < rectangles.size() && used[id])
+				{
+					broad_phase.remove(id);
+					used[id] = false;
+					remove_pairs(previous, id);
+				}
+				else
+				{
+					hopp::rectangle<double> const r = random_rectangle(state, 0, 500, 20);
+					std::size_t const new_id = broad_phase.insert(r);
+					test_check(new_id <= rectangles.size());
+					if (new_id == rectangles.size()) { rectangles.push_back(r); used.push_back(true); }
+					else { test_check(used[new_id] == false); rectangles[new_id] = r; used[new_id] = true; }
+				}
+			}
+			
+			broad_phase.update();
+			check_update(broad_phase, rectangles, used, previous);
+		}
+	}
+	
+	#ifndef NDEBUG
+	{
+		hopp::sweep_and_prune<double> broad_phase;
+		test_check_throw(broad_phase.get(0), std::out_of_range);
+		test_check_throw(broad_phase.set(0, hopp::rectangle<double>()), std::out_of_range);
+		test_check_throw(broad_phase.remove(0), std::out_of_range);
+	}
+	#endif
+	
+	return test_result();
+}
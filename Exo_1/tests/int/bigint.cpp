@@ -0,0 +1,137 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <string>
+#include <vector>
+
+#include <hopp/int/bigint.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Build a hopp::bigint from 32-bit limbs (least significant first)
+/// @param[in] limbs Limbs
+/// @return the hopp::bigint
+static hopp::bigint from_limbs(std::vector<std::uint32_t> const & limbs)
+{
+	hopp::bigint r = 0;
+	for (size_t i = limbs.size(); i > 0; --i) { r = (r << 32) + limbs[i - 1]; }
+	return r;
+}
+
+/// @brief Check a division against the expected quotient and remainder
+/// @param[in] a Numerator
+/// @param[in] b Denominator
+/// @param[in] q Expected quotient
+/// @param[in] r Expected remainder
+/// @return true if the quotient and the remainder are the expected ones
+static bool check_div(hopp::bigint const & a, hopp::bigint const & b, std::string const & q, std::string const & r)
+{
+	auto const qr = hopp::div_q_r(a, b);
+	return qr.q.to_string() == q && qr.r.to_string() == r && qr.q * b + qr.r == a;
+}
+
+/// @brief Get the last 18 decimal digits and the number of digits
+/// @param[in] i A hopp::bigint (positive)
+/// @return the number of digits and the last 18 digits
+static std::pair<size_t, std::string> digits(hopp::bigint const & i)
+{
+	std::string const s = i.to_string();
+	return { s.size(), (i % hopp::bigint(1000000000000000000ull)).to_string() };
+}
+
+int main()
+{
+	// Parse and print
+	
+	test_check(hopp::bigint("0").to_string() == "0");
+	test_check(hopp::bigint("-0").to_string() == "0");
+	test_check(hopp::bigint("+000123").to_string() == "123");
+	test_check(hopp::bigint("-98765432109876543210987654321").to_string() == "-98765432109876543210987654321");
+	test_check(hopp::bigint(-9223372036854775807ll - 1).to_string() == "-9223372036854775808");
+	test_check(hopp::bigint(18446744073709551615ull).to_string() == "18446744073709551615");
+	test_check_throw(hopp::bigint(""), std::invalid_argument);
+	test_check_throw(hopp::bigint("-"), std::invalid_argument);
+	test_check_throw(hopp::bigint("12a"), std::invalid_argument);
+	
+	// Known values
+	
+	hopp::bigint factorial = 1;
+	for (int i = 2; i <= 100; ++i) { factorial *= i; }
+	test_check(factorial.to_string() == "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976156518286253697920827223758251185210916864000000000000000000000000");
+	
+	hopp::bigint const mersenne = (hopp::bigint(1) << 521) - 1;
+	test_check(mersenne.to_string() == "6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151");
+	test_check(mersenne.bit_length() == 521);
+	test_check(hopp::bigint(mersenne.to_string()) == mersenne);
+	
+	for (int i = 2; i <= 100; ++i) { factorial /= i; }
+	test_check(factorial == 1);
+	
+	// Sign of the quotient and of the remainder (like the built-in integers)
+	
+	test_check(check_div(7, 2, "3", "1"));
+	test_check(check_div(-7, 2, "-3", "-1"));
+	test_check(check_div(7, -2, "-3", "1"));
+	test_check(check_div(-7, -2, "3", "-1"));
+	test_check(check_div(hopp::bigint("-10000000000000000000000000000000000000007"), hopp::bigint("100000000000000000003"), "-99999999999999999997", "-16"));
+	test_check(check_div(3, 7, "0", "3"));
+	test_check_throw(hopp::div_q_r(hopp::bigint(1), hopp::bigint(0)), std::domain_error);
+	
+	// Knuth algorithm D: estimated quotient digit too large, add back, normalization
+	
+	test_check(check_div(from_limbs({ 0x00000000, 0x00000000, 0x80000000, 0x7FFFFFFF }), from_limbs({ 0x00000001, 0x00000000, 0x80000000 }), "4294967294", "39614081257132168792477007874"));
+	test_check(check_div(from_limbs({ 0x00000003, 0x00000000, 0x80000000 }), from_limbs({ 0x00000001, 0x00000000, 0x20000000 }), "3", "9903520314283042199192993792"));
+	test_check(check_div(from_limbs({ 0x00000000, 0x00000000, 0x00008000, 0x00007FFF }), from_limbs({ 0x00000001, 0x00000000, 0x00008000 }), "4294836224", "604462909807310292516864"));
+	test_check(check_div(from_limbs({ 0x00000000, 0x0000FFFE, 0x00000000, 0x00008000 }), from_limbs({ 0x0000FFFF, 0x00000000, 0x00008000 }), "4294967295", "604462909807310292451327"));
+	test_check(check_div(from_limbs({ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF }), from_limbs({ 0xFFFFFFFF, 0xFFFFFFFF }), "18446744073709551617", "0"));
+	test_check(check_div(from_limbs({ 0x00000000, 0x00000000, 0x00000000, 0x80000000, 0x00000001 }), from_limbs({ 0xFFFFFFFF, 0xFFFFFFFF, 0x80000000 }), "12884901882", "110680464455142211578"));
+	
+	// Knuth algorithm D (heap limbs) and Newton reciprocal (large denominator)
+	
+	{
+		hopp::bigint const a = (hopp::bigint(1) << 3000) - 1;
+		hopp::bigint const b = (hopp::bigint(1) << 1000) + 12345;
+		auto const qr = hopp::div_q_r(a, b);
+		test_check(qr.q * b + qr.r == a);
+		test_check(qr.r < b);
+		test_check(digits(qr.q) == std::make_pair(size_t(603), std::string("256880878984981680")));
+		test_check(digits(qr.r) == std::make_pair(size_t(302), std::string("386835324302118095")));
+	}
+	{
+		hopp::bigint a = 1;
+		for (int i = 0; i < 5000; ++i) { a *= 3; }
+		hopp::bigint b = 1;
+		for (int i = 0; i < 2000; ++i) { b *= 7; }
+		b += 1;
+		test_check(b.size() > hopp::bigint::newton_threshold);
+		auto const qr = hopp::div_q_r(a, b);
+		test_check(qr.q * b + qr.r == a);
+		test_check(qr.r < b);
+		test_check(digits(qr.q) == std::make_pair(size_t(696), std::string("288567016849229771")));
+		test_check(digits(qr.r) == std::make_pair(size_t(1691), std::string("955722455092440459")));
+	}
+	
+	// Shifts and conversions
+	
+	test_check(((hopp::bigint(1) << 1000) >> 999) == 2);
+	test_check((hopp::bigint(5) >> 3) == 0);
+	test_check(hopp::bigint(hopp::uint128(~0ull, ~0ull)).to_string() == "340282366920938463463374607431768211455");
+	test_check(hopp::bigint(hopp::uint128(~0ull, ~0ull)).to_uint128() == hopp::uint128(~0ull, ~0ull));
+	test_check_throw((hopp::bigint(hopp::uint128(~0ull, ~0ull)) + 1).to_uint128(), std::overflow_error);
+	test_check_throw(hopp::bigint(-1).to_uint128(), std::overflow_error);
+	
+	return test_result();
+}
@@ -0,0 +1,161 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <hopp/int/divider.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Pseudo-random 64-bit number (linear congruential generator)
+/// @param[in,out] state State of the generator
+/// @return the next number
+static std::uint64_t next_random(std::uint64_t & state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return state ^ (state >> 29);
+}
+
+/// @brief Check hopp::divider<T> against the built-in / and %
+/// @param[in] denominators Denominators
+/// @param[in] nb_random    Number of random numerators per denominator
+template <class T>
+static void check_divider(std::vector<T> const & denominators, std::size_t const nb_random)
+{
+	T const max = std::numeric_limits<T>::max();
+	std::uint64_t state = 42;
+	
+	for (T const d : denominators)
+	{
+		hopp::divider<T> const divider(d);
+		test_check(divider.denominator() == d);
+		
+		std::vector<T> numerators = { 0, 1, T(d - 1), d, T(d + 1), T(max - d), T(max - 1), max };
+		if (d <= max / 2) { numerators.push_back(T(2 * d - 1)); numerators.push_back(T(2 * d)); }
+		numerators.push_back(T(max - max % d));
+		numerators.push_back(T(max - max % d - 1));
+		for (std::size_t i = 0; i < nb_random; ++i) { numerators.push_back(T(next_random(state))); }
+		
+		for (T const n : numerators)
+		{
+			test_check(n / divider == n / d);
+			test_check(n % divider == n % d);
+			hopp::q_r<T> const q_r = divider.div_q_r(n);
+			test_check(q_r.q == n / d && q_r.r == n % d);
+		}
+	}
+}
+
+/// @brief Usual denominators and random ones
+/// @param[in] nb_random Number of random denominators
+/// @return the denominators
+template <class T>
+static std::vector<T> denominators(std::size_t const nb_random)
+{
+	T const max = std::numeric_limits<T>::max();
+	std::vector<T> r = { 1, 2, 3, 5, 6, 7, 10, 11, 13, 100, 125, 641, T(max / 2), T(max / 2 + 1), T(max / 2 + 2), T(max / 3), T(max - 1), max };
+	for (unsigned int s = 0; s < std::numeric_limits<T>::digits; ++s)
+	{
+		r.push_back(T(T(1) << s));
+		r.push_back(T((T(1) << s) + 1));
+		r.push_back(T((T(1) << s) - 1));
+	}
+	std::uint64_t state = 7;
+	for (std::size_t i = 0; i < nb_random; ++i)
+	{
+		T const d = T(next_random(state) >> (next_random(state) % std::numeric_limits<T>::digits));
+		if (d != 0) { r.push_back(d); }
+	}
+	r.erase(std::remove(r.begin(), r.end(), T(0)), r.end());
+	return r;
+}
+
+int main()
+{
+	// All the 8-bit divisions
+	
+	for (unsigned int d = 1; d <= 255; ++d)
+	{
+		hopp::divider<std::uint8_t> const divider{ std::uint8_t(d) };
+		for (unsigned int n = 0; n <= 255; ++n)
+		{
+			test_check(std::uint8_t(n) / divider == n / d);
+			test_check(std::uint8_t(n) % divider == n % d);
+		}
+	}
+	
+	// All the 16-bit denominators, usual and random numerators for 16, 32 and 64 bits
+	
+	{
+		std::vector<std::uint16_t> all;
+		for (unsigned int d = 1; d <= 65535; ++d) { all.push_back(std::uint16_t(d)); }
+		check_divider<std::uint16_t>(all, 16);
+	}
+	check_divider<std::uint32_t>(denominators<std::uint32_t>(1000), 200);
+	check_divider<std::uint64_t>(denominators<std::uint64_t>(1000), 200);
+	
+	// hopp::uint128 numerators
+	
+	{
+		std::uint64_t state = 1;
+		for (std::uint64_t const d : denominators<std::uint64_t>(200))
+		{
+			hopp::divider<std::uint64_t> const divider(d);
+			std::vector<hopp::uint128> numerators =
+			{
+				0, 1, d, hopp::uint128(d, 0), hopp::uint128(d - 1, ~0ull), hopp::uint128(~0ull, ~0ull), hopp::uint128(1, 0)
+			};
+			for (int i = 0; i < 100; ++i) { numerators.emplace_back(next_random(state), next_random(state)); }
+			
+			for (hopp::uint128 const & n : numerators)
+			{
+				hopp::q_r<hopp::uint128> const q_r = divider.div_q_r(n);
+				test_check(q_r.q == n / d && q_r.r == n % d);
+				hopp::q_r<hopp::uint128> const q_r_generic = hopp::div_q_r(n, hopp::uint128(d));
+				test_check(q_r_generic.q == q_r.q && q_r_generic.r == q_r.r);
+				test_check(q_r.r < d && q_r.q * d + q_r.r == n);
+			}
+		}
+	}
+	
+	// hopp::div_q_r between two hopp::uint128
+	
+	{
+		std::uint64_t state = 3;
+		for (int i = 0; i < 10000; ++i)
+		{
+			hopp::uint128 const a(next_random(state), next_random(state));
+			hopp::uint128 const b = hopp::uint128(next_random(state), next_random(state)) >> (unsigned int)(next_random(state) % 128);
+			if (b == 0) { continue; }
+			hopp::q_r<hopp::uint128> const q_r = hopp::div_q_r(a, b);
+			test_check(q_r.q == a / b && q_r.r == a % b);
+			test_check(q_r.r < b && q_r.q * b + q_r.r == a);
+		}
+		test_check(hopp::div_q_r(17, 5).q == 3 && hopp::div_q_r(17, 5).r == 2);
+	}
+	
+	// Divide by zero
+	
+	test_check_throw(hopp::divider<std::uint32_t>(0), std::domain_error);
+	test_check_throw(hopp::divider<std::uint64_t>(0), std::domain_error);
+	test_check_throw(hopp::div_q_r(hopp::uint128(1), hopp::uint128(0)), std::domain_error);
+	test_check_throw(hopp::div_q_r(1, 0), std::domain_error);
+	
+	return test_result();
+}
@@ -0,0 +1,135 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <string>
+#include <sstream>
+#include <cstring>
+
+#include <hopp/int/uint128.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Convert a hopp::uint128 into a std::string with divisions only (reference for hopp::to_string)
+/// @param[in] i    A hopp::uint128
+/// @param[in] base Base (10 or 16)
+/// @return the std::string
+static std::string to_string_reference(hopp::uint128 i, unsigned int const base)
+{
+	if (i == 0) { return "0"; }
+	std::string r;
+	while (i != 0)
+	{
+		r.insert(r.begin(), "0123456789abcdef"[(i % base).lo]);
+		i /= base;
+	}
+	return r;
+}
+
+int main()
+{
+	hopp::uint128 const max(~0ull, ~0ull);
+	
+	// Arithmetic (modulo 2^128)
+	
+	test_check(max + 1 == 0);
+	test_check(hopp::uint128(0) - 1 == max);
+	test_check(hopp::uint128(~0ull) * hopp::uint128(~0ull) == hopp::uint128(0xFFFFFFFFFFFFFFFE, 0x0000000000000001));
+	test_check(max * max == 1);
+	test_check((hopp::uint128(1) << 127) >> 127 == 1);
+	test_check((hopp::uint128(1) << 64) == hopp::uint128(1, 0));
+	test_check(max / 10 == hopp::uint128("34028236692093846346337460743176821145"));
+	test_check(max % 10 == 5);
+	test_check(hopp::uint128(1, 0) / hopp::uint128(0xFFFFFFFF, 0xFFFFFFFFFFFFFFFF) == 0);
+	test_check(max / hopp::uint128(1, 0) == ~0ull);
+	
+	// Print in base 10 and 16
+	
+	test_check(hopp::to_string(0) == "0");
+	test_check(hopp::to_string(0, 16) == "0");
+	test_check(hopp::to_string(max) == "340282366920938463463374607431768211455");
+	test_check(hopp::to_string(max, 16) == "ffffffffffffffffffffffffffffffff");
+	test_check(hopp::to_string(hopp::uint128(1, 0)) == "18446744073709551616");
+	test_check(hopp::to_string(hopp::uint128(1, 0), 16) == "10000000000000000");
+	test_check(hopp::to_string(hopp::uint128(0x4B3B4CA85A86C47A, 0x098A224000000000)) == "100000000000000000000000000000000000000");
+	{
+		std::ostringstream out;
+		out << max << " " << std::hex << hopp::uint128(0xABC, 0x1);
+		test_check(out.str() == "340282366920938463463374607431768211455 abc0000000000000001");
+	}
+	{
+		char buffer[38];
+		test_check(hopp::to_chars(buffer, buffer + 38, max) == nullptr);
+		test_check(hopp::to_chars(buffer, buffer + 31, max, 16) == nullptr);
+		test_check(hopp::to_chars(buffer, buffer + 2, 42) == buffer + 2 && std::memcmp(buffer, "42", 2) == 0);
+	}
+	
+	// Parse in base 10 and 16
+	
+	test_check(hopp::uint128("0") == 0);
+	test_check(hopp::uint128("340282366920938463463374607431768211455") == max);
+	test_check(hopp::uint128("000000340282366920938463463374607431768211455") == max);
+	test_check(hopp::uint128("18446744073709551616") == hopp::uint128(1, 0));
+	test_check(hopp::uint128("ffffffffffffffffffffffffffffffff", 16) == max);
+	test_check(hopp::uint128("FFFFffff", 16) == 0xFFFFFFFF);
+	test_check(hopp::uint128("10000000000000000", 16) == hopp::uint128(1, 0));
+	
+	// Overflow
+	
+	test_check_throw(hopp::uint128("340282366920938463463374607431768211456"), std::out_of_range);
+	test_check_throw(hopp::uint128("999999999999999999999999999999999999999"), std::out_of_range);
+	test_check_throw(hopp::uint128("3402823669209384634633746074317682114550"), std::out_of_range);
+	test_check_throw(hopp::uint128("100000000000000000000000000000000", 16), std::out_of_range);
+	
+	// Invalid numbers and bases
+	
+	test_check_throw(hopp::uint128(""), std::invalid_argument);
+	test_check_throw(hopp::uint128("12a"), std::invalid_argument);
+	test_check_throw(hopp::uint128(" 12"), std::invalid_argument);
+	test_check_throw(hopp::uint128("-1"), std::invalid_argument);
+	test_check_throw(hopp::uint128("12g", 16), std::invalid_argument);
+	test_check_throw(hopp::uint128("0x12", 16), std::invalid_argument);
+	test_check_throw(hopp::uint128("17", 8), std::invalid_argument);
+	
+	// from_chars stops at the first character which is not a digit or which overflows
+	
+	{
+		std::string const s = "123abc";
+		hopp::uint128 value = 7;
+		test_check(hopp::from_chars(s.data(), s.data() + s.size(), value) == s.data() + 3 && value == 123);
+		test_check(hopp::from_chars(s.data() + 3, s.data() + s.size(), value) == s.data() + 3 && value == 123);
+		test_check(hopp::from_chars(s.data(), s.data() + s.size(), value, 16) == s.data() + s.size() && value == 0x123ABC);
+		
+		std::string const big = "3402823669209384634633746074317682114559";
+		test_check(hopp::from_chars(big.data(), big.data() + big.size(), value) == big.data() + 39 && value == max);
+	}
+	
+	// Round trip against the conversion with divisions
+	
+	hopp::uint128 x(0x0123456789ABCDEF, 0xFEDCBA9876543210);
+	for (int k = 0; k < 1000; ++k)
+	{
+		x = x * hopp::uint128(0x2360ED051FC65DA4, 0x4385DF649FCCF645) + hopp::uint128(0x5851F42D4C957F2D, 0x14057B7EF767814F);
+		hopp::uint128 const value = x >> (unsigned int)(k % 128);
+		std::string const decimal = hopp::to_string(value);
+		std::string const hexadecimal = hopp::to_string(value, 16);
+		test_check(decimal == to_string_reference(value, 10));
+		test_check(hexadecimal == to_string_reference(value, 16));
+		test_check(hopp::uint128(decimal) == value);
+		test_check(hopp::uint128(hexadecimal, 16) == value);
+	}
+	
+	return test_result();
+}
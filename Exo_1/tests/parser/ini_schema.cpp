@@ -0,0 +1,201 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <clocale>
+#include <limits>
+#include <string>
+
+#include <hopp/parser/ini_schema.hpp>
+
+#include "../check.hpp"
+
+
+/// @brief Convert a buffer with a schema
+/// @param[in] buffer An INI buffer
+/// @param[in] schema A hopp::parser::ini_schema
+/// @return the hopp::parser::ini_typed
+static hopp::parser::ini_typed typed(std::string const & buffer, hopp::parser::ini_schema const & schema)
+{
+	return hopp::parser::ini_typed(hopp::parser::ini_view(buffer.data(), buffer.size()), schema);
+}
+
+/// @brief Get the error message of the conversion of a buffer
+/// @param[in] buffer An INI buffer
+/// @param[in] schema A hopp::parser::ini_schema
+/// @return the message of the hopp::except::parse_error ("" if there is no error)
+static std::string error(std::string const & buffer, hopp::parser::ini_schema const & schema)
+{
+	try { typed(buffer, schema); }
+	catch (hopp::except::parse_error const & e) { return e.what(); }
+	return "";
+}
+
+/// @brief Test if a value is a valid value of type T
+/// @param[in] value A value
+/// @return true if "[s]\nk = value" is converted with a required T key
+template <class T>
+static bool is_valid(std::string const & value)
+{
+	hopp::parser::ini_schema schema;
+	schema.add<T>("s", "k");
+	return error("[s]\nk = " + value, schema).empty();
+}
+
+/// @brief Convert a value
+/// @param[in] value A value
+/// @return the value converted in T
+template <class T>
+static T convert(std::string const & value)
+{
+	hopp::parser::ini_schema schema;
+	auto const field = schema.add<T>("s", "k");
+	return typed("[s]\nk = " + value, schema).get(field);
+}
+
+int main()
+{
+	// Values and defaults
+	
+	hopp::parser::ini_schema schema;
+	auto const port = schema.add<int>("network", "port");
+	auto const host = schema.add<std::string>("network", "host");
+	auto const timeout = schema.add<double>("network", "timeout", 2.5);
+	auto const verbose = schema.add<bool>("log", "verbose", false);
+	auto const level = schema.add<int>("log", "level", 3);
+	auto const name = schema.add<std::string>("", "name", std::string("default"));
+	test_check(schema.size() == 6);
+	
+	std::string const buffer = "[network]\nport = 8080\nhost = example.org\nignored = not in the schema\n[log]\nverbose = Yes\n[other]\nkey = value\n";
+	{
+		hopp::parser::ini_typed const config = typed(buffer, schema);
+		test_check(&config.schema() == &schema);
+		test_check(config.get(port) == 8080);
+		test_check(config.get(host) == "example.org");
+		test_check(config.get(timeout) == 2.5);
+		test_check(config.get(verbose) == true);
+		test_check(config.get(level) == 3);
+		test_check(config.get(name) == "default");
+		test_check(config.get<int>("network", "port") == 8080);
+		test_check(config.get<double>("network", "timeout") == 2.5);
+		test_check(config.get<std::string>("", "name") == "default");
+		
+		// Wrong type or key not in the schema
+		test_check_throw(config.get<double>("network", "port"), hopp::except::bad_cast);
+		test_check_throw(config.get<std::string>("log", "verbose"), hopp::except::bad_cast);
+		test_check_throw(config.get<int>("network", "ignored"), std::out_of_range);
+		test_check_throw(config.get<int>("other", "key"), std::out_of_range);
+	}
+	
+	// Same values from hopp::parser::ini_view and from the result of hopp::parser::ini
+	{
+		hopp::vector_pair<std::string, hopp::vector_pair<std::string, std::string>> ini;
+		ini["network"]["port"] = "8080";
+		ini["network"]["host"] = "example.org";
+		ini["log"]["verbose"] = "Yes";
+		hopp::parser::ini_typed const config(ini, schema);
+		test_check(config.get(port) == 8080 && config.get(host) == "example.org" && config.get(timeout) == 2.5 && config.get(verbose));
+	}
+	
+	// Schema errors
+	
+	test_check_throw(schema.add<int>("network", "port"), std::invalid_argument);
+	test_check_throw(schema.add<double>("network", "port", 1.0), std::invalid_argument);
+	test_check_throw(schema.add<std::string>("", "name"), std::invalid_argument);
+	test_check(schema.size() == 6);
+	schema.add<int>("Network", "port");
+	schema.add<int>("network", "Port", 0);
+	test_check(schema.size() == 8);
+	
+	// All the errors are reported together
+	
+	{
+		hopp::parser::ini_schema s;
+		s.add<int>("a", "missing");
+		s.add<int>("a", "int");
+		s.add<double>("a", "double", 0.0);
+		s.add<bool>("a", "bool", true);
+		s.add<std::string>("a", "string");
+		s.add<int>("a", "optional", 0);
+		
+		std::string const message = error("[a]\nint = 1.5\ndouble = x\nbool = maybe\nstring =\n", s);
+		test_check(message.find("\"a.missing\" is missing") != std::string::npos);
+		test_check(message.find("\"a.int\" = \"1.5\" is not a valid int") != std::string::npos);
+		test_check(message.find("\"a.double\" = \"x\" is not a valid double") != std::string::npos);
+		test_check(message.find("\"a.bool\" = \"maybe\" is not a valid bool") != std::string::npos);
+		test_check(message.find("string") == std::string::npos);
+		test_check(message.find("optional") == std::string::npos);
+		
+		test_check(error("[a]\nmissing = 0\nint = -1\nstring = \n", s).empty());
+		test_check_throw(typed("", s), hopp::except::parse_error);
+	}
+	
+	// int
+	
+	test_check(convert<int>("0") == 0);
+	test_check(convert<int>("+42") == 42);
+	test_check(convert<int>("-42") == -42);
+	test_check(convert<int>("007") == 7);
+	test_check(convert<int>("2147483647") == std::numeric_limits<int>::max());
+	test_check(convert<int>("-2147483648") == std::numeric_limits<int>::min());
+	test_check(is_valid<int>("2147483648") == false);
+	test_check(is_valid<int>("-2147483649") == false);
+	test_check(is_valid<int>("99999999999999999999") == false);
+	test_check(is_valid<int>("") == false);
+	test_check(is_valid<int>("-") == false);
+	test_check(is_valid<int>("+") == false);
+	test_check(is_valid<int>("1 2") == false);
+	test_check(is_valid<int>("0x10") == false);
+	test_check(is_valid<int>("1e3") == false);
+	
+	// double
+	
+	test_check(convert<double>("1.5") == 1.5);
+	test_check(convert<double>("-0.25") == -0.25);
+	test_check(convert<double>("1e3") == 1000.0);
+	test_check(convert<double>("1.7976931348623157e308") == std::numeric_limits<double>::max());
+	test_check(convert<double>("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min());
+	test_check(convert<double>("1e-400") == 0.0);
+	test_check(is_valid<double>("1e400") == false);
+	test_check(is_valid<double>("-1e400") == false);
+	test_check(is_valid<double>("") == false);
+	test_check(is_valid<double>("1,5") == false);
+	test_check(is_valid<double>("1.5x") == false);
+	
+	// double in the "C" locale, whatever LC_NUMERIC
+	
+	for (char const * const locale : { "de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR" })
+	{
+		if (std::setlocale(LC_NUMERIC, locale) != nullptr)
+		{
+			test_check(convert<double>("1.5") == 1.5);
+			test_check(is_valid<double>("1,5") == false);
+			std::setlocale(LC_NUMERIC, "C");
+			break;
+		}
+	}
+	
+	// bool
+	
+	for (char const * const value : { "true", "TRUE", "yes", "Yes", "on", "ON", "1" }) { test_check(convert<bool>(value) == true); }
+	for (char const * const value : { "false", "False", "no", "NO", "off", "Off", "0" }) { test_check(convert<bool>(value) == false); }
+	for (char const * const value : { "", "2", "y", "n", "truee", "enabled", "-1" }) { test_check(is_valid<bool>(value) == false); }
+	
+	// std::string (the value of hopp::parser::ini_view)
+	
+	test_check(convert<std::string>("  hello world  ; comment") == "hello world");
+	test_check(convert<std::string>("") == "");
+	
+	return test_result();
+}
@@ -0,0 +1,211 @@
+// Copyright © 2016 Lénaïc Bagnères, hnc@singularity.fr
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <hopp/parser/ini.hpp>
+#include <hopp/parser/ini_view.hpp>
+
+#include "../check.hpp"
+
+
+/// Temporary INI file
+static char const * const filename = "test__parser_ini_view.ini";
+
+/// @brief Write the temporary INI file
+/// @param[in] content Content of the file
+static void write(std::string const & content)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::binary);
+	file << content;
+}
+
+/// @brief Test if hopp::parser::ini_view and hopp::parser::ini give the same result on the temporary INI file
+/// @return true if hopp::parser::ini_view and hopp::parser::ini give the same result
+static bool same_as_ini()
+{
+	return hopp::parser::ini_view(filename).to_vector_pair() == hopp::parser::ini(filename);
+}
+
+/// @brief Pseudo-random number (linear congruential generator)
+/// @param[in,out] state State of the generator
+/// @param[in]     n     Upper bound (not included)
+/// @return a number in [0, n)
+static std::size_t next_random(std::uint64_t & state, std::size_t const n)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return std::size_t(state >> 33) % n;
+}
+
+/// @brief Generate a random INI file without the differences between hopp::parser::ini_view and hopp::parser::ini
+/// @param[in,out] state State of the generator
+/// @return the content of the INI file
+static std::string random_ini(std::uint64_t & state)
+{
+	char const * const blanks[] = { "", " ", "\t", "  \t " };
+	char const * const names[] = { "a", "b", "key", "long key", "k.1", "x_y", "Key" };
+	char const * const values[] = { "1", "42", "hello world", "a=b", "  spaced  ", "3.14", "\"quoted\"", "[not a section]" };
+	char const * const comments[] = { "", " ; comment", "# comment", ";", " #" };
+	char const * const ends[] = { "\n", "\r\n", "\n\n", "\n \t \n" };
+	
+	std::string r;
+	std::size_t const nb_line = next_random(state, 40);
+	for (std::size_t i = 0; i < nb_line; ++i)
+	{
+		r += blanks[next_random(state, 4)];
+		std::size_t const kind = next_random(state, 10);
+		if (kind == 0)
+		{
+			r += (next_random(state, 2) == 0) ? "; comment = line" : "# [comment]";
+		}
+		else if (kind == 1)
+		{
+			r += "[";
+			r += blanks[next_random(state, 4)];
+			r += names[next_random(state, 7)];
+			r += blanks[next_random(state, 4)];
+			r += "]";
+			r += comments[next_random(state, 5)];
+		}
+		else
+		{
+			r += names[next_random(state, 7)];
+			r += blanks[next_random(state, 4)];
+			r += "=";
+			r += blanks[next_random(state, 4)];
+			// An empty value needs a comment on the same line
+			std::size_t const value = next_random(state, 9);
+			if (value == 8) { r += " ;"; }
+			else { r += values[value]; r += comments[next_random(state, 5)]; }
+		}
+		r += ends[next_random(state, 4)];
+	}
+	return r;
+}
+
+int main()
+{
+	// Same result as hopp::parser::ini
+	
+	write
+	(
+		"global = 1\n"
+		"; comment\n"
+		"# comment\n"
+		"  [ section one ]  \n"
+		"key=value\n"
+		"  spaced key   =   spaced value   \n"
+		"commented = value ; comment\n"
+		"hashed = value # comment\n"
+		"empty = ; comment\n"
+		"equal = a=b\n"
+		"\n"
+		"[section two]\r\n"
+		"crlf = value\r\n"
+		"tab\t=\tvalue\t\r\n"
+		"[section one]\n"
+		"key = last\n"
+		"new = key"
+	);
+	test_check(same_as_ini());
+	{
+		hopp::parser::ini_view const ini(filename);
+		test_check(ini.at("", "global") == "1");
+		test_check(ini.at("section one", "key") == "last");
+		test_check(ini.at("section one", "spaced key") == "spaced value");
+		test_check(ini.at("section one", "commented") == "value");
+		test_check(ini.at("section one", "hashed") == "value");
+		test_check(ini.at("section one", "empty") == "");
+		test_check(ini.at("section one", "equal") == "a=b");
+		test_check(ini.at("section one", "new") == "key");
+		test_check(ini.at("section two", "crlf") == "value");
+		test_check(ini.at("section two", "tab") == "value");
+		test_check(ini.contains("section two", "tab"));
+		test_check(ini.contains("section two", "key") == false);
+		test_check(ini.contains("section three", "key") == false);
+		test_check_throw(ini.at("section two", "key"), std::out_of_range);
+		test_check_throw(ini.at("section three", "key"), std::out_of_range);
+		
+		// Entries in file order, repeated keys included
+		test_check(ini.entries().size() == 11);
+		test_check(ini.entries().front().section == "" && ini.entries().front().key == "global");
+		test_check(ini.entries()[1].section == "section one" && ini.entries()[1].key == "key" && ini.entries()[1].value == "value");
+		test_check(ini.entries()[9].section == "section one" && ini.entries()[9].key == "key" && ini.entries()[9].value == "last");
+		test_check(ini.index().size() == 3);
+	}
+	
+	write("");
+	test_check(same_as_ini());
+	test_check(hopp::parser::ini_view(filename).entries().empty());
+	
+	write(" \n\t\n; only a comment");
+	test_check(same_as_ini());
+	test_check(hopp::parser::ini_view(filename).entries().empty());
+	
+	{
+		std::uint64_t state = 42;
+		for (int i = 0; i < 500; ++i)
+		{
+			write(random_ini(state));
+			test_check(same_as_ini());
+		}
+	}
+	
+	// Documented differences with hopp::parser::ini: a key and its value never continue on the next line
+	
+	write("[s]\nkey =\nnext = 1\n");
+	{
+		hopp::parser::ini_view const ini(filename);
+		test_check(ini.at("s", "key") == "" && ini.at("s", "next") == "1");
+		test_check(hopp::parser::ini(filename).at("s").at("key") == "next = 1");
+	}
+	
+	write("[s]\nflag\nnext = 1\n");
+	{
+		hopp::parser::ini_view const ini(filename);
+		test_check(ini.at("s", "flag") == "" && ini.at("s", "next") == "1");
+		test_check(hopp::parser::ini(filename).at("s").count("flag") == 0);
+	}
+	
+	// The copies share the buffer
+	
+	write("[s]\nkey = value\n");
+	{
+		hopp::parser::ini_view copy("", 0);
+		{
+			hopp::parser::ini_view const ini(filename);
+			copy = ini;
+		}
+		std::remove(filename);
+		test_check(copy.at("s", "key") == "value");
+		test_check(copy.buffer() == "[s]\nkey = value\n");
+	}
+	
+	// Buffer
+	
+	{
+		std::string const buffer = "a = 1\n[s]\nb = 2";
+		hopp::parser::ini_view const ini(buffer.data(), buffer.size());
+		test_check(ini.at("", "a") == "1" && ini.at("s", "b") == "2");
+		test_check(ini.at("s", "b").data() == buffer.data() + buffer.size() - 1);
+	}
+	
+	test_check_throw(hopp::parser::ini_view("test__parser_ini_view_does_not_exist.ini"), hopp::except::file_not_found);
+	
+	return test_result();
+}